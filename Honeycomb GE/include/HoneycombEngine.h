@@ -43,6 +43,8 @@
 #include "graphics/Material.h"
 #include "graphics/Texture2D.h"
 
+#include "job/JobSystem.h"
+
 #include "math/MathUtils.h"
 #include "math/Matrix4f.h"
 #include "math/Quaternion.h"
@@ -50,8 +52,11 @@
 #include "math/Vector3f.h"
 #include "math/Vector4f.h"
 
+#include "memory/PoolAllocator.h"
+
 #include "object/GameObjectFactory.h"
 #include "object/GameObject.h"
+#include "object/Prefab.h"
 
 #include "render/Renderer.h"
 #include "render/RenderingEngine.h"
@@ -80,9 +85,13 @@ namespace HoneycombEngine {
 
 	using namespace Honeycomb::Graphics;
 
+	using namespace Honeycomb::Job;
+
 	using namespace Honeycomb::Math;
 	using namespace Honeycomb::Math::Utils;
 
+	using namespace Honeycomb::Memory;
+
 	using namespace Honeycomb::Object;
 
 	using namespace Honeycomb::Render;
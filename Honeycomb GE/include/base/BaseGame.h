@@ -17,7 +17,9 @@ namespace Honeycomb { namespace Base {
 		/// This method handles any rendering which should be done by the game.
 		/// Typically, this method need not be overwritten or used, unless the
 		/// game utilizes some rendering technique which is not included in the
-		/// base engine.
+		/// base engine. If the frames are pipelined, this is called on the
+		/// rendering thread while the simulation thread waits, so it is where
+		/// the game should write its meshes.
 		/// </summary>
 		virtual void render();
 
@@ -2,7 +2,15 @@
 #ifndef BASE_MAIN_H
 #define BASE_MAIN_H
 
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "../render/RenderFrame.h"
+
 namespace Honeycomb { namespace Base { class BaseGame; } }
+namespace Honeycomb { namespace Job { class JobSystem; } }
 namespace Honeycomb { namespace Render { class RenderingEngine; } }
 
 namespace Honeycomb { namespace Base {
@@ -26,12 +34,46 @@ namespace Honeycomb { namespace Base {
 	private:
 		BaseGame *game;
 		Honeycomb::Render::RenderingEngine *renderingEngine;
+		Honeycomb::Job::JobSystem *jobSystem;
 
 		bool isGameRunning;                 // Is the main game loop running?
 		const bool DRAW_BACK_FACES = false; // Draw back faces?
+		const bool PIPELINE_FRAMES = false; // Update the next frame while the
+                                            // last one is being rendered?
 
 		const int FRAME_RATE_CAP = 999;     // The maximum frames per second to
                                             // be drawn (or zero for unlimited)
+		const int MAX_UPDATES_PER_FRAME = 5; // The maximum fixed updates per
+                                             // frame, before time is dropped
+		const int SLEEP_MARGIN = 100;       // Time (in us) before the end of
+                                            // a frame at which to stop sleeping
+
+		int64_t accumulator; // Time (in us) yet to be simulated by updates
+
+		// If the frames are pipelined, the game is updated on the simulation
+		// thread, which extracts each updated frame into the back frame, while
+		// the front frame is rendered on the main thread. The two threads
+		// meet once per frame to exchange the frames.
+		std::thread simulationThread;
+		std::mutex frameMutex;
+		std::condition_variable frameCondition;
+		Honeycomb::Render::RenderFrame frames[2];
+		Honeycomb::Render::RenderFrame *frontFrame; // Frame being rendered
+		Honeycomb::Render::RenderFrame *backFrame;  // Frame being updated
+		bool isFrameReady;         // Has the back frame been extracted?
+		int64_t pendingFrameTime;  // Time (in us) for the next simulation
+
+		/// <summary>
+		/// Waits until the simulation thread has extracted the back frame and
+		/// exchanges it with the front frame. While the simulation thread is
+		/// waiting, the window events are polled and the game is rendered,
+		/// since both may touch the scene. Afterwards, the simulation thread
+		/// is released to simulate the specified time into the new back frame.
+		/// </summary>
+		/// <param name="frameTime">
+		/// The time (in microseconds) which has passed since the last frame.
+		/// </param>
+		void exchangeFrames(const int64_t &frameTime);
 
 		/// <summary>
 		/// Conducts a single render pass for the game which is being run. The
@@ -41,32 +83,65 @@ namespace Honeycomb { namespace Base {
 		void render();
 
 		/// <summary>
-		/// The main game loop. Calls the appropriate render, update, and input
-		/// functions each frame, and regulates how many frames exist in a 
-		/// given second. After this function is complete, the stop function 
-		/// is called to clean up the game.
+		/// The main game loop. Updates the game (and its input) in fixed time
+		/// steps for the time which has passed since the last frame, renders
+		/// the game once per frame, and waits out the remainder of each frame
+		/// so that the frame rate cap is not exceeded. If the frames are
+		/// pipelined, the updates run on the simulation thread, one frame
+		/// ahead of the rendering. After this function is complete, the stop
+		/// function is called to clean up the game.
 		/// </summary>
 		void run();
 
+		/// <summary>
+		/// Updates the game in fixed time steps for the specified time, along
+		/// with the time which was left over by the last call. If the updates
+		/// fall too far behind (e.g. after a stall), the remaining steps are
+		/// dropped rather than spiraling into ever longer frames.
+		/// </summary>
+		/// <param name="frameTime">
+		/// The time (in microseconds) which has passed since the last frame.
+		/// </param>
+		void simulate(const int64_t &frameTime);
+
+		/// <summary>
+		/// The loop of the simulation thread, if the frames are pipelined.
+		/// Simulates the time of each frame and extracts the updated scene
+		/// into the back frame, until the main game loop stops.
+		/// </summary>
+		void simulateFrames();
+
 		/// <summary>
 		/// Starts the game by initializing the GLEW, Window and GLFW 
-		/// components (in that particular order). After all initializations 
-		/// are complete, the run function will be called to begin the game 
-		/// loop.
+		/// components (in that particular order), and the Job System. After
+		/// all initializations are complete, the run function will be called
+		/// to begin the game loop.
 		/// </summary>
 		void start();
 
 		/// <summary>
-		/// Stops the game by destroying the game components and terminating 
-		/// the OpenGL libraries.
+		/// Stops the game by destroying the game components, stopping the
+		/// workers of the Job System and terminating the OpenGL libraries.
 		/// </summary>
 		void stop();
 
 		/// <summary>
-		/// Updates the game and the game window. The method is only called 
-		/// once per frame.
+		/// Updates the game and the game window by one fixed time step. The
+		/// method may be called any number of times per frame (including
+		/// none at all).
 		/// </summary>
 		void update();
+
+		/// <summary>
+		/// Waits until the specified game time. The thread repeatedly sleeps
+		/// for half of the remaining time, so that a sleep which overshoots
+		/// (by the granularity of the scheduler) rarely overshoots the end of
+		/// the wait, and only yields for the last SLEEP_MARGIN microseconds.
+		/// </summary>
+		/// <param name="time">
+		/// The game time (in microseconds) until which to wait.
+		/// </param>
+		void waitUntil(const int64_t &time);
 	};
 } }
 
@@ -2,30 +2,46 @@
 #ifndef GAME_TIME_H
 #define GAME_TIME_H
 
+#include <chrono>
+#include <cstdint>
+
 namespace Honeycomb { namespace Base {
 	class GameTime {
 		friend class BaseMain; // Only allow BaseMain to set the delta time
 	public:
 		const static float SECOND; // Number of milliseconds in a second
-		
+
 		/// <summary>
-		/// Gets the time between the current frame and the last frame in
-		/// milliseconds.
+		/// Gets the time step of the current phase of the game loop in
+		/// milliseconds. While the game is updated, this is the fixed delta
+		/// time; while the game is rendered, this is the time between the
+		/// current frame and the last frame.
 		/// </summary>
 		/// <returns>
-		/// The time between the frames (in milliseconds).
+		/// The time step (in milliseconds).
 		/// </returns>
 		const float& getDeltaTimeMS() const;
 
 		/// <summary>
-		/// Gets the time between the current frame and the last frame in
-		/// seconds.
+		/// Gets the time step of the current phase of the game loop in
+		/// seconds (see getDeltaTimeMS).
 		/// </summary>
 		/// <returns>
-		/// The time between the frames (in seconds).
+		/// The time step (in seconds).
 		/// </returns>
 		float getDeltaTimeS() const;
 
+		/// <summary>
+		/// Gets the elapsed game time (since the initialization of the game
+		/// engine) in microseconds. Unlike the processor time, this time is
+		/// monotonic wall clock time, which does not lose precision over long
+		/// runs.
+		/// </summary>
+		/// <returns>
+		/// The game time (in microseconds).
+		/// </returns>
+		int64_t getElapsedTimeUS() const;
+
 		/// <summary>
 		/// Gets the elapsed game time (since the initialization of the game
 		/// engine) in milliseconds.
@@ -33,7 +49,7 @@ namespace Honeycomb { namespace Base {
 		/// <returns>
 		/// The game time (in milliseconds).
 		/// </returns>
-		float getElapsedTimeMS() const;
+		double getElapsedTimeMS() const;
 
 		/// <summary>
 		/// Gets the elapsed game time (since the initialization of the game
@@ -42,7 +58,37 @@ namespace Honeycomb { namespace Base {
 		/// <returns>
 		/// The game time (in seconds).
 		/// </returns>
-		float getElapsedTimeS() const;
+		double getElapsedTimeS() const;
+
+		/// <summary>
+		/// Gets the fixed time step with which the game is updated, in
+		/// milliseconds.
+		/// </summary>
+		/// <returns>
+		/// The fixed delta time (in milliseconds).
+		/// </returns>
+		const float& getFixedDeltaTimeMS() const;
+
+		/// <summary>
+		/// Gets the fixed time step with which the game is updated, in
+		/// seconds.
+		/// </summary>
+		/// <returns>
+		/// The fixed delta time (in seconds).
+		/// </returns>
+		float getFixedDeltaTimeS() const;
+
+		/// <summary>
+		/// Gets how far the frame being rendered is between the last update
+		/// and the next update, as a fraction of the fixed delta time. Rendered
+		/// state may be interpolated from its previous to its current value by
+		/// this amount, so that motion appears smooth regardless of how the
+		/// frame rate relates to the update rate.
+		/// </summary>
+		/// <returns>
+		/// The interpolation factor, in the range [0, 1).
+		/// </returns>
+		const float& getInterpolationAlpha() const;
 
 		/// <summary>
 		/// Returns the Game Time instance of this Singleton.
@@ -51,19 +97,48 @@ namespace Honeycomb { namespace Base {
 		/// The Game Time instance.
 		/// </returns>
 		static GameTime* getGameTime();
+
+		/// <summary>
+		/// Sets the fixed time step with which the game is updated, in
+		/// milliseconds.
+		/// </summary>
+		/// <param name="ms">
+		/// The fixed delta time (in milliseconds), which must be positive.
+		/// </param>
+		void setFixedDeltaTimeMS(const float &ms);
 	private:
-		float deltaTime; // The time between frames (in ms) for the last
-                         // two frames rendered.
+		const static float DEFAULT_FIXED_DELTA_TIME; // The default update
+                                                     // time step (in ms)
+
+		// The time at which the game engine was initialized
+		std::chrono::steady_clock::time_point startTime;
+
+		float deltaTime;      // The time step (in ms) of the current phase
+		float fixedDeltaTime; // The time step (in ms) of each update
+		float alpha;          // The interpolation factor of the frame
+
+		/// <summary>
+		/// Initializes the Game Time, starting the game time at zero.
+		/// </summary>
+		GameTime();
 
 		/// <summary>
-		/// Sets the time between the current frame and the last frame in
+		/// Sets the time step of the current phase of the game loop in
 		/// milliseconds.
 		/// </summary>
 		/// <param name="ms">
 		/// The delta time (in milliseconds).
 		/// </param>
 		void setDeltaTimeMS(const float &ms);
+
+		/// <summary>
+		/// Sets the interpolation factor of the frame being rendered.
+		/// </summary>
+		/// <param name="alpha">
+		/// The interpolation factor, in the range [0, 1).
+		/// </param>
+		void setInterpolationAlpha(const float &alpha);
 	};
 } }
 
-#endif
\ No newline at end of file
+#endif
@@ -71,6 +71,12 @@ namespace Honeycomb { namespace Base {
 		/// </returns>
 		bool isCloseRequested() const;
 
+		/// <summary>
+		/// Updates the window input (which also raises the resize event, if
+		/// the window was resized).
+		/// </summary>
+		void pollEvents();
+
 		/// <summary>
 		/// Updates the window input and swaps the window buffers.
 		/// </summary>
@@ -96,6 +102,11 @@ namespace Honeycomb { namespace Base {
 		/// The new window title.
 		/// </param>
 		void setWindowTitle(const std::string &title);
+
+		/// <summary>
+		/// Swaps the window buffers, which presents the rendered frame.
+		/// </summary>
+		void swapBuffers();
 	private:
 		const GLFWvidmode *videoMode;              // GLFW Video Mode
 		GLFWwindow *glfwWindow;                    // Reference to GLFW window
@@ -2,18 +2,40 @@
 #ifndef GAME_COMPONENT_H
 #define GAME_COMPONENT_H
 
+#include <atomic>
 #include <memory>
 #include <string>
 
+#include "GameComponentPool.h"
 #include "../shader/ShaderProgram.h"
 
-namespace Honeycomb { namespace Object { class GameObject; } }
+namespace Honeycomb { namespace Object {
+	class GameObject;
+	class Prefab;
+} }
 
 namespace Honeycomb { namespace Component {
 	typedef unsigned int GameComponentID;
 
+	/// <summary>
+	/// The data which a Game Component may access in its onUpdate method,
+	/// which decides whether it may be updated in parallel with the other
+	/// components of its type.
+	/// </summary>
+	enum UpdateAccess {
+		// The component may access anything, so it is updated sequentially,
+		// in the order of the Game Object hierarchy.
+		UPDATE_ACCESS_ANY,
+
+		// The component only writes its own state, and only reads the
+		// Transforms, the Game Time and the active camera, so it is updated
+		// in parallel once all of the sequential components were updated.
+		UPDATE_ACCESS_OWN_STATE
+	};
+
 	class GameComponent {
 		friend class Honeycomb::Object::GameObject;
+		friend class Honeycomb::Object::Prefab;
 	public:
 		/// <summary>
 		/// Returns the Game Component Type ID of the specified type.
@@ -40,6 +62,47 @@ namespace Honeycomb { namespace Component {
 			return type;
 		}
 
+		/// <summary>
+		/// Checks if the specified component is of type T (i.e. of type T or
+		/// of a type derived from T). Since all of the components of a Game
+		/// Component ID are of the same type, this is only checked with RTTI
+		/// once per pair of type T and Game Component ID, and the result is
+		/// cached from then on (unless there are more component types than
+		/// can be cached). This may be called concurrently.
+		/// </summary>
+		/// <typeparam name="T">
+		/// The type against which to check the component.
+		/// </typeparam>
+		/// <param name="component">
+		/// The component.
+		/// </param>
+		/// <returns>
+		/// True if the component may be downcast to type T with a static_cast,
+		/// false otherwise.
+		/// </returns>
+		template <typename T>
+		static bool getIsOfType(const GameComponent &component) noexcept {
+			GameComponent::assertIsBaseOf<T>();
+
+			// The table of which Component IDs are of type T, in which each
+			// entry is unknown (zero), of type T (positive) or not (negative).
+			static std::atomic<signed char> isOfType[MAX_CACHED_TYPES];
+
+			GameComponentID id = component.getGameComponentID();
+			if (id == GameComponent::getGameComponentTypeID<T>()) return true;
+			if (id >= MAX_CACHED_TYPES)
+				return dynamic_cast<const T*>(&component) != nullptr;
+
+			signed char cached = isOfType[id].load(std::memory_order_relaxed);
+			if (cached == 0) {
+				bool isT = dynamic_cast<const T*>(&component) != nullptr;
+				cached = isT ? 1 : -1;
+				isOfType[id].store(cached, std::memory_order_relaxed);
+			}
+
+			return cached > 0;
+		}
+
 		/// <summary>
 		/// Performs a static assertion which checks if the specified type T
 		/// is inherited from this Game Component class. The assertion fails if
@@ -127,7 +190,8 @@ namespace Honeycomb { namespace Component {
 		/// <summary>
 		/// Gets a boolean representation of whether or not the Game Component
 		/// is currently active. A component is to be considered active if it
-		/// is both self active and its parent is active.
+		/// is both self active and its parent is active. The activeness is
+		/// cached, so this does not walk up the hierarchy.
 		/// </summary>
 		/// <returns>
 		/// True if the component is active.
@@ -144,6 +208,18 @@ namespace Honeycomb { namespace Component {
 		/// </returns>
 		const bool& getIsSelfActive() const;
 
+		/// <summary>
+		/// Returns the handle to this Game Component in the component pool of
+		/// its type in the scene of the Game Object to which it is attached.
+		/// The handle may be kept to look the component up later on, through
+		/// <see cref="GameScene::getComponentPool"/>. It is only valid while
+		/// the component is attached to a Game Object which is in a scene.
+		/// </summary>
+		/// <returns>
+		/// The handle to this component in the pool of its scene.
+		/// </returns>
+		const GameComponentHandle& getPoolHandle() const;
+
 		/// <summary>
 		/// Checks if this Game Component is attached to any Game Object.
 		/// </summary>
@@ -211,9 +287,46 @@ namespace Honeycomb { namespace Component {
 		/// <summary>
 		/// Handles any update events for this component, if necessary. This
 		/// method should only perform its task when the object is active.
+		/// If the [UpdateAccess] property of the component is Own State, this
+		/// method may be called concurrently with the updates of other
+		/// components.
 		/// </summary>
 		virtual void onUpdate();
 
+		/// <summary>
+		/// Commits the results of the parallel update of this component to
+		/// the rest of the game, if necessary. This is only called for the
+		/// components whose [UpdateAccess] property is Own State, once all of
+		/// them were updated, one at a time, ordered by the Game Component ID
+		/// and then by the order of the Game Object hierarchy.
+		/// </summary>
+		virtual void onUpdateCommit();
+
+		/// <summary>
+		/// Allocates the memory of a new Game Component from the Pool
+		/// Allocator, so that the Game Components of a type share slabs, rather
+		/// than each being a separate heap allocation.
+		/// </summary>
+		/// <param name="size">
+		/// The size of the Game Component, in bytes.
+		/// </param>
+		/// <returns>
+		/// The pointer to the memory.
+		/// </returns>
+		static void* operator new(std::size_t size);
+
+		/// <summary>
+		/// Returns the memory of a destroyed Game Component to the Pool
+		/// Allocator.
+		/// </summary>
+		/// <param name="block">
+		/// The pointer to the memory.
+		/// </param>
+		/// <param name="size">
+		/// The size of the Game Component, in bytes.
+		/// </param>
+		static void operator delete(void *block, std::size_t size);
+
 		/// <summary>
 		/// No assignment operator exists for the Game Component class.
 		/// </summary>
@@ -227,6 +340,19 @@ namespace Honeycomb { namespace Component {
 
 		bool isSelfActive;         // Is this game component itself active?
 	private:
+		// Is this self active and attached to an active Game Object? This is
+		// kept up to date by the Game Object, so that it is not recalculated
+		// on every check.
+		bool isActive;
+
+		// The number of Game Component IDs for which getIsOfType caches
+		// whether they are of a type.
+		const static GameComponentID MAX_CACHED_TYPES = 256;
+
+		// The handle to this component in the component pool of its scene
+		// (only valid while the component is in a scene).
+		GameComponentHandle poolHandle;
+
 		/// <summary>
 		/// Returns the static Game Component ID variable and increments it
 		/// after returning.
@@ -273,6 +399,24 @@ namespace Honeycomb { namespace Component {
 		/// attached.
 		/// </returns>
 		virtual bool getProperty_Permanent() const noexcept;
+
+		/// <summary>
+		/// Returns the data which this Game Component may access in its
+		/// onUpdate method. If not overriden, this will return Any by default,
+		/// so that the component is updated sequentially.
+		/// </summary>
+		/// <returns>
+		/// Any if the component may access anything while it is updated. Own
+		/// State if the component may be updated in parallel.
+		/// </returns>
+		virtual UpdateAccess getProperty_UpdateAccess() const noexcept;
+
+		/// <summary>
+		/// Recalculates the cached activeness of this Game Component from its
+		/// self-activeness and the cached activeness of the Game Object to
+		/// which it is attached.
+		/// </summary>
+		void updateIsActive();
 	};
 
 	/// <summary>
@@ -0,0 +1,89 @@
+#pragma once
+#ifndef GAME_COMPONENT_POOL_H
+#define GAME_COMPONENT_POOL_H
+
+#include <vector>
+
+namespace Honeycomb { namespace Component { class GameComponent; } }
+
+namespace Honeycomb { namespace Component {
+	/// <summary>
+	/// A stable reference to a Game Component in a Game Component Pool. The
+	/// handle stays valid while the component is in the pool, even though the
+	/// component may move within the pool, and it is invalidated for good
+	/// once the component is removed (the generation of its slot changes).
+	/// </summary>
+	struct GameComponentHandle {
+		unsigned int slot;       // Index of the slot of the component
+		unsigned int generation; // Generation of the slot, when referenced
+	};
+
+	/// <summary>
+	/// Stores all of the Game Components of a single type (Game Component ID)
+	/// in a densely packed array, so that a system may iterate over all of
+	/// them linearly, rather than walking the Game Object hierarchy. The
+	/// components are referenced through the slots of the pool, which map a
+	/// Game Component Handle to the current index of the component in the
+	/// packed array.
+	/// </summary>
+	class GameComponentPool {
+	public:
+		/// <summary>
+		/// Adds the specified component to the back of the packed array of
+		/// this pool, reusing a free slot if there is one.
+		/// </summary>
+		/// <param name="component">
+		/// The component, which must not already be in this pool.
+		/// </param>
+		/// <returns>
+		/// The handle to the component.
+		/// </returns>
+		GameComponentHandle add(GameComponent *component);
+
+		/// <summary>
+		/// Returns the component referenced by the specified handle.
+		/// </summary>
+		/// <param name="handle">
+		/// The handle to the component.
+		/// </param>
+		/// <returns>
+		/// The pointer to the component, or a nullptr if the component was
+		/// removed from this pool.
+		/// </returns>
+		GameComponent* get(const GameComponentHandle &handle) const;
+
+		/// <summary>
+		/// Returns the packed array of the components of this pool. The order
+		/// of the components is unspecified, since removing a component moves
+		/// the last component into its place.
+		/// </summary>
+		/// <returns>
+		/// The constant reference to the list of components.
+		/// </returns>
+		const std::vector<GameComponent*>& getComponents() const;
+
+		/// <summary>
+		/// Removes the component referenced by the specified handle from this
+		/// pool, and invalidates all handles to it. This has no effect if the
+		/// handle is already invalid.
+		/// </summary>
+		/// <param name="handle">
+		/// The handle to the component.
+		/// </param>
+		void remove(const GameComponentHandle &handle);
+	private:
+		// A slot of the pool, which is either in use by a component or free
+		// (in which case it is in the free slots list).
+		struct Slot {
+			unsigned int index;      // Index of the component in the array
+			unsigned int generation; // Incremented when the slot is freed
+		};
+
+		std::vector<GameComponent*> components; // Packed components
+		std::vector<unsigned int> slotOf;       // Slot of each component
+		std::vector<Slot> slots;
+		std::vector<unsigned int> freeSlots;
+	};
+} }
+
+#endif
@@ -55,23 +55,26 @@ namespace Honeycomb { namespace Component { namespace Light {
 		std::unique_ptr<BaseLight> clone() const;
 		
 		/// Downcasts this light depending on the type of the light. The
-		/// type passed to the template function must match the type of this
-		/// light. If the type passed in does not match the type of this light,
-		/// a nullptr will be returned instead.
+		/// type passed to the template function must be the type of this
+		/// light or one of its bases. If this light is not of the type passed
+		/// in, a nullptr will be returned instead.
 		/// return : A constant pointer to the downcast instance; nullptr if 
 		///			 the light could not be downcast.
 		template<typename T> const T* downcast() const {
-			return dynamic_cast<const T*>(this);
+			if (!GameComponent::getIsOfType<T>(*this)) return nullptr;
+
+			return static_cast<const T*>(this);
 		}
 
 		/// Downcasts this light depending on the type of the light. The
-		/// type passed to the template function must match the type of this
-		/// light. If the type passed in does not match the type of this light,
-		/// a nullptr will be returned instead.
+		/// type passed to the template function must be the type of this
+		/// light or one of its bases. If this light is not of the type passed
+		/// in, a nullptr will be returned instead.
 		/// return : A pointer to the downcast instance; nullptr if the light
 		///			 could not be downcast.
 		template<typename T> T* downcast() {
-			return dynamic_cast<T*>(this);
+			return const_cast<T*>(static_cast<const BaseLight*>(this)->
+				downcast<T>());
 		}
 
 		/// Returns a reference to the color of this Base Light.
@@ -101,10 +104,6 @@ namespace Honeycomb { namespace Component { namespace Light {
 		/// Returns a constant reference to the type of this Light.
 		/// return : The type of this light.
 		const LightType& getType() const;
-		//todo
-		void onAttach() override;
-		//todo
-		void onDetach() override;
 
 		/// Sets the color of this Base Light.
 		/// const Vector4f &col : The new color of this BaseLight.
@@ -101,6 +101,13 @@ namespace Honeycomb { namespace Component { namespace Light {
 		const Honeycomb::Math::Vector3f *position; // Transform Position
 
 		virtual PointLight* cloneInternal() const override;
+
+		/// Overrides the [UpdateAccess] property to return Own State, since
+		/// the update only copies the position of the Transform into the
+		/// uniform values of this light.
+		/// return : Own State.
+		virtual Honeycomb::Component::UpdateAccess getProperty_UpdateAccess()
+				const noexcept override;
 	};
 } } }
 
@@ -16,6 +16,7 @@ namespace Honeycomb { namespace Component { namespace Physics {
 
 	class Transform : public GameComponent {
 		friend class Honeycomb::Object::GameObject;
+		friend class Honeycomb::Object::Prefab;
 	public:
 		/// <summary>
 		/// Default Constructor which initializes the position, rotation and
@@ -15,6 +15,7 @@ namespace Honeycomb { namespace Component { namespace Render {
 		public Honeycomb::Shader::GenericStruct {
 	public:
 		const static std::string PROJECTION_MAT4;
+		const static std::string PROJECTION_INVERSE_MAT4;
 		const static std::string VIEW_MAT4;
 		const static std::string TRANSLATION_VEC3;
 		const static std::string WIDTH_F;
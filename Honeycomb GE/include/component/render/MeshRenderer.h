@@ -6,6 +6,7 @@
 #include "../physics/Transform.h"
 #include "../../../include/geometry/Mesh.h"
 #include "../../../include/graphics/Material.h"
+#include "../../../include/render/RenderFrame.h"
 #include "../../../include/shader/ShaderProgram.h"
 
 namespace Honeycomb { namespace Component { namespace Render {
@@ -38,6 +39,27 @@ namespace Honeycomb { namespace Component { namespace Render {
 		/// </param>
 		void addMesh(const std::shared_ptr<Honeycomb::Geometry::Mesh> &mesh);
 
+		/// <summary>
+		/// Adds a coarser level of detail to this Mesh Renderer. The meshes
+		/// added through <see cref="addMesh"/> form the finest level (level
+		/// zero), and each level of detail must contain a mesh for each of
+		/// them, in the same order, so that the materials still apply.
+		/// 
+		/// A level is used once the projected size of the bounds of this Mesh
+		/// Renderer drops below its screen size (with some hysteresis, so
+		/// that the levels do not flicker around the threshold). The levels
+		/// are kept sorted from the largest to the smallest screen size.
+		/// </summary>
+		/// <param name="meshes">
+		/// The meshes of the level of detail.
+		/// </param>
+		/// <param name="screenSize">
+		/// The fraction of the screen height, in the (0, 1] range, below
+		/// which the level is used.
+		/// </param>
+		void addLevelOfDetail(const std::vector<std::shared_ptr<
+				Honeycomb::Geometry::Mesh>> &meshes, const float &screenSize);
+
 		/// <summary>
 		/// Clones this Mesh Renderer into a new Mesh Renderer. Each mesh and
 		/// material of this Mesh Renderer will be re-added to the cloned
@@ -48,6 +70,74 @@ namespace Honeycomb { namespace Component { namespace Render {
 		/// </returns>
 		std::unique_ptr<MeshRenderer> clone() const;
 
+		/// <summary>
+		/// Computes the world space axis aligned bounding box which contains
+		/// all of the meshes of this Mesh Renderer, using the transform to
+		/// which this is attached. If there are no meshes attached, the box
+		/// is collapsed to the position of the transform.
+		/// </summary>
+		/// <param name="min">
+		/// The vector into which the minimum corner of the box is written.
+		/// </param>
+		/// <param name="max">
+		/// The vector into which the maximum corner of the box is written.
+		/// </param>
+		void getBounds(Honeycomb::Math::Vector3f &min, 
+				Honeycomb::Math::Vector3f &max) const;
+
+		/// <summary>
+		/// Returns the level of detail which is currently rendered, where
+		/// zero is the finest level.
+		/// </summary>
+		/// <returns>
+		/// The current level of detail.
+		/// </returns>
+		const int& getLevelOfDetail() const;
+
+		/// <summary>
+		/// Returns the number of levels of detail of this Mesh Renderer,
+		/// including the finest level.
+		/// </summary>
+		/// <returns>
+		/// The number of levels of detail.
+		/// </returns>
+		int getLevelOfDetailCount() const;
+
+		/// <summary>
+		/// Returns the meshes of the specified level of detail.
+		/// </summary>
+		/// <param name="level">
+		/// The level of detail, where zero is the finest level.
+		/// </param>
+		/// <returns>
+		/// The meshes of the level.
+		/// </returns>
+		const std::vector<std::shared_ptr<Honeycomb::Geometry::Mesh>>& 
+				getLevelMeshes(const int &level) const;
+
+		/// <summary>
+		/// Returns whether this Mesh Renderer may be drawn as part of a
+		/// multi-draw batch instead of through <see cref="onRender"/>. This is
+		/// the case if all of the meshes of its current level of detail are
+		/// stored in the Geometry Arena, it has a material for them, it is not
+		/// cross-fading between two levels and its transform does not flip
+		/// the winding order.
+		/// </summary>
+		/// <returns>
+		/// True if this Mesh Renderer may be batched, false otherwise.
+		/// </returns>
+		bool getIsBatchable() const;
+
+		/// <summary>
+		/// Returns whether this Mesh Renderer is an occluder. The meshes of
+		/// occluders are rasterized into the software occlusion buffer, and
+		/// other objects hidden behind them are not rendered.
+		/// </summary>
+		/// <returns>
+		/// True if this Mesh Renderer is an occluder, false otherwise.
+		/// </returns>
+		const bool& getIsOccluder() const;
+
 		/// <summary>
 		/// Returns the Component ID integer representation of the Mesh
 		/// Renderer.
@@ -58,7 +148,34 @@ namespace Honeycomb { namespace Component { namespace Render {
 		virtual GameComponentID getGameComponentID() const noexcept override;
 
 		/// <summary>
-		/// Returns the materials of this Mesh Renderer.
+		/// Returns the material at the specified index, for reading only. A
+		/// shared material (see <see cref="shareMaterials"/>) is not copied.
+		/// </summary>
+		/// <param name="index">
+		/// The index of the material.
+		/// </param>
+		/// <returns>
+		/// The constant material.
+		/// </returns>
+		std::shared_ptr<const Honeycomb::Graphics::Material> getMaterial(
+				const std::size_t &index) const;
+
+		/// <summary>
+		/// Returns the number of materials of this Mesh Renderer.
+		/// </summary>
+		/// <returns>
+		/// The number of materials.
+		/// </returns>
+		std::size_t getMaterialCount() const;
+
+		/// <summary>
+		/// Returns the materials of this Mesh Renderer, which may be written
+		/// to, along with the list itself. The materials which are shared
+		/// (see <see cref="shareMaterials"/>) are first replaced by copies of
+		/// their own, so that writing to them does not affect the other Mesh
+		/// Renderers. To read the materials without copying them, or to write
+		/// to a single material, use <see cref="getMaterial"/> or
+		/// <see cref="getWritableMaterial"/> instead.
 		/// </summary>
 		/// <returns>
 		/// The materials list, returned by reference.
@@ -67,12 +184,13 @@ namespace Honeycomb { namespace Component { namespace Render {
 				getMaterials();
 
 		/// <summary>
-		/// Returns the materials of this Mesh Renderer.
+		/// Returns the materials of this Mesh Renderer, for reading only.
+		/// Shared materials are not copied.
 		/// </summary>
 		/// <returns>
-		/// The materials list, returned by constant reference.
+		/// The list of the constant materials.
 		/// </returns>
-		const std::vector<std::shared_ptr<Honeycomb::Graphics::Material>>& 
+		std::vector<std::shared_ptr<const Honeycomb::Graphics::Material>>
 				getMaterials() const;
 
 		/// <summary>
@@ -92,6 +210,22 @@ namespace Honeycomb { namespace Component { namespace Render {
 		const std::vector<std::shared_ptr<Honeycomb::Geometry::Mesh>>& 
 				getMeshes() const;
 
+		/// <summary>
+		/// Returns the material at the specified index, which may be written
+		/// to. If the material is shared (see <see cref="shareMaterials"/>),
+		/// it is first replaced by a copy of its own, so that writing to it
+		/// does not affect the other Mesh Renderers. The other materials are
+		/// not copied.
+		/// </summary>
+		/// <param name="index">
+		/// The index of the material.
+		/// </param>
+		/// <returns>
+		/// The material.
+		/// </returns>
+		std::shared_ptr<Honeycomb::Graphics::Material> getWritableMaterial(
+				const std::size_t &index);
+
 		/// <summary>
 		/// When attached, the Mesh Renderer gets a reference to the transform
 		/// to which this is attached to.
@@ -117,6 +251,10 @@ namespace Honeycomb { namespace Component { namespace Render {
 		/// the number of meshes equals the number of materials, each mesh is
 		/// rendered with its corresponding material; else a runtime assertion
 		/// will be raised.
+		/// 
+		/// Only the meshes of the current level of detail are rendered. While
+		/// the levels are being cross-faded, both the new and the old level
+		/// are rendered with complementary dither patterns.
 		/// </summary>
 		/// <param name="shader">
 		/// The Shader to be used when rendering the Mesh. The material data
@@ -125,6 +263,27 @@ namespace Honeycomb { namespace Component { namespace Render {
 		/// </param>
 		void onRender(Honeycomb::Shader::ShaderProgram &shader) override;
 
+		/// <summary>
+		/// Selects the level of detail to be rendered from the projected size
+		/// of the bounds of this Mesh Renderer with respect to the active
+		/// camera, and advances the cross-fade between the levels.
+		/// </summary>
+		void onUpdate() override;
+
+		/// <summary>
+		/// Renders the specified snapshot of a Mesh Renderer using the
+		/// specified Shader, exactly like <see cref="onRender"/> renders the
+		/// Mesh Renderer from which the snapshot was taken.
+		/// </summary>
+		/// <param name="shader">
+		/// The Shader to be used when rendering the meshes.
+		/// </param>
+		/// <param name="object">
+		/// The snapshot of the Mesh Renderer.
+		/// </param>
+		static void render(Honeycomb::Shader::ShaderProgram &shader,
+				const Honeycomb::Render::RenderFrame::Object &object);
+
 		/// <summary>
 		/// Removes the specified Material from this Mesh Renderer. If the
 		/// material is not attached to this Mesh Renderer, no further action
@@ -145,14 +304,105 @@ namespace Honeycomb { namespace Component { namespace Render {
 		/// </param>
 		void removeMesh(const std::shared_ptr<Honeycomb::Geometry::Mesh> 
 				&mesh);
+
+		/// <summary>
+		/// Sets whether the switch between two levels of detail should be
+		/// cross-faded (using a dither pattern) instead of happening at once.
+		/// </summary>
+		/// <param name="fade">
+		/// True if the levels of detail should be cross-faded, false
+		/// otherwise.
+		/// </param>
+		void setDoLevelOfDetailCrossFade(const bool &fade);
+
+		/// <summary>
+		/// Sets whether this Mesh Renderer is an occluder. Only large, simple
+		/// meshes (walls, terrain, buildings) should be occluders, since each
+		/// of their triangles is rasterized on the CPU every frame.
+		/// </summary>
+		/// <param name="occluder">
+		/// True if this Mesh Renderer should be an occluder, false otherwise.
+		/// </param>
+		void setIsOccluder(const bool &occluder);
+
+		/// <summary>
+		/// Marks the materials of this Mesh Renderer, and of all of its future
+		/// clones, as shared. The shared materials are copied on write: each
+		/// Mesh Renderer copies a material the first time it is requested
+		/// through <see cref="getWritableMaterial"/> (or all of them through
+		/// the non constant <see cref="getMaterials"/>).
+		/// </summary>
+		void shareMaterials();
+
+		/// <summary>
+		/// Writes a snapshot of everything which is needed to render this
+		/// Mesh Renderer into the specified Render Frame object. The lists of
+		/// the object are assigned, so they keep their storage.
+		/// </summary>
+		/// <param name="object">
+		/// The object into which the snapshot is written.
+		/// </param>
+		void toRenderObject(Honeycomb::Render::RenderFrame::Object &object)
+				const;
 	private:
+		// Relative distance from a level of detail's screen size which must
+		// be crossed before the level changes, and the duration (in seconds)
+		// of the cross-fade between two levels.
+		static const float LEVEL_OF_DETAIL_HYSTERESIS;
+		static const float LEVEL_OF_DETAIL_FADE_DURATION;
+
 		// The list of meshes and materials of this Mesh Renderer.
 		std::vector<std::shared_ptr<Honeycomb::Geometry::Mesh>> meshes;
 		std::vector<std::shared_ptr<Honeycomb::Graphics::Material>> materials;
 
+		// The meshes and screen sizes of the coarser levels of detail (the
+		// finest level is the list of meshes above).
+		std::vector<std::vector<std::shared_ptr<Honeycomb::Geometry::Mesh>>>
+				lodMeshes;
+		std::vector<float> lodScreenSizes;
+
+		// The current level, the level which is being faded out (-1 if none)
+		// and the progress of the fade, in the [0, 1] range.
+		int lodLevel;
+		int lodFadeLevel;
+		float lodFadeProgress;
+		bool doLodCrossFade;
+
+		bool isOccluder; // Does this hide objects behind it from culling?
+
+		// Which materials are shared and copied on write (empty if none)
+		std::vector<bool> sharedMaterials;
+
 		// Reference to the transform of the mesh
 		Honeycomb::Component::Physics::Transform *transform;
 
+		/// <summary>
+		/// Computes the size of the bounds of this Mesh Renderer projected by
+		/// the active camera, as a fraction of the screen height.
+		/// </summary>
+		/// <returns>
+		/// The projected size, or zero if there is no active camera.
+		/// </returns>
+		float calcScreenSize() const;
+
+		/// <summary>
+		/// Renders the specified meshes using the specified materials (see
+		/// <see cref="onRender"/>).
+		/// </summary>
+		/// <param name="shader">
+		/// The Shader to be used when rendering the meshes.
+		/// </param>
+		/// <param name="meshes">
+		/// The meshes to be rendered.
+		/// </param>
+		/// <param name="materials">
+		/// The materials with which the meshes are rendered.
+		/// </param>
+		static void renderMeshes(Honeycomb::Shader::ShaderProgram &shader,
+				const std::vector<std::shared_ptr<Honeycomb::Geometry::Mesh>>
+				&meshes, const std::vector<std::shared_ptr<
+				Honeycomb::Graphics::Material>> &materials);
+
 		/// <summary>
 		/// Clones this Mesh Renderer component.
 		/// </summary>
@@ -160,6 +410,17 @@ namespace Honeycomb { namespace Component { namespace Render {
 		/// The new Mesh Renderer component.
 		/// </returns>
 		virtual MeshRenderer* cloneInternal() const override;
+
+		/// <summary>
+		/// Overrides the [UpdateAccess] property to return Own State, since
+		/// the update only reads the Transform & the active camera, and only
+		/// writes the level of detail of this Mesh Renderer.
+		/// </summary>
+		/// <returns>
+		/// Own State.
+		/// </returns>
+		virtual Honeycomb::Component::UpdateAccess getProperty_UpdateAccess()
+				const noexcept override;
 	};
 } } }
 
@@ -0,0 +1,320 @@
+#pragma once
+#ifndef GEOMETRY_ARENA_H
+#define GEOMETRY_ARENA_H
+
+#include <cstddef>
+#include <map>
+#include <unordered_map>
+
+#include "Vertex.h"
+#include "../base/GLItem.h"
+
+namespace Honeycomb { namespace Geometry {
+	/// <summary>
+	/// Class responsible for suballocating the vertex and index data of many
+	/// Meshes from one large vertex buffer and one large index buffer. Meshes
+	/// stored in the arena only differ by their base vertex and first index,
+	/// so they may be drawn without binding any buffers in between, and may
+	/// be batched into multi-draw calls.
+	///
+	/// The ranges are allocated first fit from a free list which coalesces
+	/// adjacent free ranges. When no free range is large enough, the buffer
+	/// grows and the old data is copied over on the GPU, so the offsets of
+	/// the existing allocations stay valid.
+	/// </summary>
+	class GeometryArena : public Honeycomb::Base::GLItem {
+	public:
+		/// <summary>
+		/// The initial capacities of the buffers of the arena, in vertices
+		/// and indices.
+		/// </summary>
+		const static std::size_t INITIAL_VERTEX_CAPACITY;
+		const static std::size_t INITIAL_INDEX_CAPACITY;
+
+		/// <summary>
+		/// Returns the Geometry Arena instance, initializing it if it has not
+		/// been initialized yet.
+		/// </summary>
+		/// <returns>
+		/// The pointer to the Geometry Arena.
+		/// </returns>
+		static GeometryArena* getGeometryArena();
+
+		/// <summary>
+		/// Returns whether the static Meshes should be stored in the arena.
+		/// </summary>
+		/// <returns>
+		/// True if the static Meshes are stored in the arena.
+		/// </returns>
+		static const bool& getIsEnabled();
+
+		/// <summary>
+		/// Sets whether the static Meshes should be stored in the arena. This
+		/// only affects the data which is set after the change.
+		/// </summary>
+		/// <param name="enabled">
+		/// True if the static Meshes should be stored in the arena.
+		/// </param>
+		static void setIsEnabled(const bool &enabled);
+
+		/// <summary>
+		/// Allocates a range of the specified number of indices.
+		/// </summary>
+		/// <param name="count">
+		/// The number of indices.
+		/// </param>
+		/// <returns>
+		/// The handle of the allocation.
+		/// </returns>
+		int allocateIndices(const std::size_t &count);
+
+		/// <summary>
+		/// Allocates a range of the specified number of vertices.
+		/// </summary>
+		/// <param name="count">
+		/// The number of vertices.
+		/// </param>
+		/// <returns>
+		/// The handle of the allocation.
+		/// </returns>
+		int allocateVertices(const std::size_t &count);
+
+		/// <summary>
+		/// Binds the vertex buffer of the arena to GL_ARRAY_BUFFER and the
+		/// index buffer of the arena to GL_ELEMENT_ARRAY_BUFFER, and enables
+		/// the attributes of the vertices, pointing them at the vertex buffer.
+		/// The attributes should be disabled again with
+		/// <see cref="unbindBuffers"/> once the arena has been drawn.
+		/// </summary>
+		void bindBuffers() const;
+
+		/// <summary>
+		/// Moves all of the allocations to the start of the buffers, so that
+		/// all of the free space forms a single range at the end. The data is
+		/// copied on the GPU. The handles stay valid, but their offsets
+		/// change, so the offsets must not be cached across this call.
+		/// </summary>
+		void defragment();
+
+		/// <summary>
+		/// Destroys the buffers of the arena. All of the allocations are lost.
+		/// </summary>
+		void destroy() override;
+
+		/// <summary>
+		/// Returns the position of the first index of the specified index
+		/// allocation within the index buffer.
+		/// </summary>
+		/// <param name="allocation">
+		/// The handle of the index allocation.
+		/// </param>
+		/// <returns>
+		/// The first index.
+		/// </returns>
+		const std::size_t& getFirstIndex(const int &allocation) const;
+
+		/// <summary>
+		/// Returns the position of the first vertex of the specified vertex
+		/// allocation within the vertex buffer, which is the base vertex to be
+		/// added to the indices of the allocation when drawing.
+		/// </summary>
+		/// <param name="allocation">
+		/// The handle of the vertex allocation.
+		/// </param>
+		/// <returns>
+		/// The base vertex.
+		/// </returns>
+		const std::size_t& getBaseVertex(const int &allocation) const;
+
+		/// <summary>
+		/// Returns the fraction of the free indices and vertices which are not
+		/// part of the largest free range of their buffer. Zero means that all
+		/// of the free space is contiguous.
+		/// </summary>
+		/// <returns>
+		/// The fragmentation, in the [0, 1] range.
+		/// </returns>
+		float getFragmentation() const;
+
+		/// <summary>
+		/// Returns the raw pointer of the index buffer object of the arena.
+		/// </summary>
+		/// <returns>
+		/// The index buffer object pointer.
+		/// </returns>
+		const int& getIndexBufferObject() const;
+
+		/// <summary>
+		/// Returns the raw pointer of the vertex buffer object of the arena.
+		/// </summary>
+		/// <returns>
+		/// The vertex buffer object pointer.
+		/// </returns>
+		const int& getVertexBufferObject() const;
+
+		/// <summary>
+		/// Frees the specified index allocation.
+		/// </summary>
+		/// <param name="allocation">
+		/// The handle of the index allocation.
+		/// </param>
+		void freeIndices(const int &allocation);
+
+		/// <summary>
+		/// Frees the specified vertex allocation.
+		/// </summary>
+		/// <param name="allocation">
+		/// The handle of the vertex allocation.
+		/// </param>
+		void freeVertices(const int &allocation);
+
+		/// <summary>
+		/// Initializes the arena by creating its buffers with the initial
+		/// capacities.
+		/// </summary>
+		void initialize() override;
+
+		/// <summary>
+		/// Disables the attributes of the vertices which were enabled by
+		/// <see cref="bindBuffers"/>.
+		/// </summary>
+		void unbindBuffers() const;
+
+		/// <summary>
+		/// Writes the specified indices into the specified index allocation.
+		/// The indices are relative to the base vertex of the Mesh.
+		/// </summary>
+		/// <param name="allocation">
+		/// The handle of the index allocation.
+		/// </param>
+		/// <param name="indices">
+		/// The pointer to the first index to be written.
+		/// </param>
+		/// <param name="count">
+		/// The number of indices to be written.
+		/// </param>
+		/// <param name="offset">
+		/// The position within the allocation of the first written index.
+		/// </param>
+		void writeIndices(const int &allocation, const unsigned int *indices,
+				const std::size_t &count, const std::size_t &offset);
+
+		/// <summary>
+		/// Writes the specified vertices into the specified vertex allocation.
+		/// </summary>
+		/// <param name="allocation">
+		/// The handle of the vertex allocation.
+		/// </param>
+		/// <param name="vertices">
+		/// The pointer to the first vertex to be written.
+		/// </param>
+		/// <param name="count">
+		/// The number of vertices to be written.
+		/// </param>
+		/// <param name="offset">
+		/// The position within the allocation of the first written vertex.
+		/// </param>
+		void writeVertices(const int &allocation, const Vertex *vertices,
+				const std::size_t &count, const std::size_t &offset);
+	private:
+		static bool isEnabled; // Are the static Meshes stored in the arena?
+
+		/// <summary>
+		/// A range of elements of a buffer.
+		/// </summary>
+		struct Range {
+			std::size_t offset;	// The first element
+			std::size_t count;	// The number of elements
+		};
+
+		/// <summary>
+		/// A buffer from which ranges are suballocated.
+		/// </summary>
+		struct Pool {
+			int bufferObject;			// The buffer "Pointer"
+			std::size_t stride;			// The size of an element, in bytes
+			std::size_t capacity;		// The number of elements
+
+			// The free ranges, by their offset, and the allocated ranges, by
+			// their handle.
+			std::map<std::size_t, std::size_t> freeRanges;
+			std::unordered_map<int, Range> allocations;
+		};
+
+		Pool vertices;          // The pool of the vertices
+		Pool indices;           // The pool of the indices
+		int nextAllocation;     // The handle of the next allocation
+
+		/// <summary>
+		/// Instantiates a new, uninitialized Geometry Arena.
+		/// </summary>
+		GeometryArena();
+
+		/// <summary>
+		/// Allocates a range of the specified pool, growing the pool if none
+		/// of its free ranges are large enough.
+		/// </summary>
+		/// <param name="pool">
+		/// The pool.
+		/// </param>
+		/// <param name="count">
+		/// The number of elements.
+		/// </param>
+		/// <returns>
+		/// The handle of the allocation.
+		/// </returns>
+		int allocate(Pool &pool, const std::size_t &count);
+
+		/// <summary>
+		/// Compacts the allocations of the specified pool to the start of a
+		/// new buffer of the same capacity.
+		/// </summary>
+		/// <param name="pool">
+		/// The pool.
+		/// </param>
+		void defragment(Pool &pool);
+
+		/// <summary>
+		/// Returns the free range of the specified pool back to its free list,
+		/// merging it with the adjacent free ranges.
+		/// </summary>
+		/// <param name="pool">
+		/// The pool.
+		/// </param>
+		/// <param name="range">
+		/// The range which is to be freed.
+		/// </param>
+		void free(Pool &pool, const Range &range);
+
+		/// <summary>
+		/// Grows the buffer of the specified pool so that it has a free range
+		/// of at least the specified number of elements at its end.
+		/// </summary>
+		/// <param name="pool">
+		/// The pool.
+		/// </param>
+		/// <param name="count">
+		/// The number of elements which must fit at the end of the pool.
+		/// </param>
+		void grow(Pool &pool, const std::size_t &count);
+
+		/// <summary>
+		/// Creates a new buffer of the specified size and copies the
+		/// specified ranges of the buffer of the pool into it, one after the
+		/// other, replacing the buffer of the pool.
+		/// </summary>
+		/// <param name="pool">
+		/// The pool.
+		/// </param>
+		/// <param name="capacity">
+		/// The capacity of the new buffer, in elements.
+		/// </param>
+		/// <param name="ranges">
+		/// The ranges to be copied, and the offsets to which they are copied.
+		/// </param>
+		void reallocate(Pool &pool, const std::size_t &capacity,
+				const std::map<std::size_t, Range> &ranges);
+	};
+} }
+
+#endif
@@ -9,8 +9,35 @@
 #include "../shader/ShaderProgram.h"
 
 namespace Honeycomb { namespace Geometry {
+	/// <summary>
+	/// The enumeration of how often the data of a Mesh is expected to change,
+	/// which decides how the vertex and index buffers of the Mesh are stored.
+	/// </summary>
+	enum MeshUsage {
+		// The data is set once and drawn many times. The data is stored in
+		// the Geometry Arena, if it is enabled, or else in buffers of the
+		// Mesh (GL_STATIC_DRAW).
+		USAGE_STATIC,
+
+		// The data is modified repeatedly, for example by sub-range updates
+		// of a CPU deformed mesh (GL_DYNAMIC_DRAW). The buffer storage is
+		// reused for as long as the data fits in it.
+		USAGE_DYNAMIC,
+
+		// The vertices are rewritten every frame. If GL_ARB_buffer_storage
+		// is supported, they are written straight into a persistently mapped
+		// ring buffer, whose regions are guarded by fences so that the CPU
+		// never writes a region which the GPU may still be reading.
+		// Otherwise, the buffer is orphaned on every update (GL_STREAM_DRAW).
+		USAGE_STREAM
+	};
+
 	/// <summary>
 	/// Class responsible for storing the vertex and index data of a Mesh.
+	/// Like any GL item, a Mesh may only be written on the thread which
+	/// renders. If the frames are pipelined, the frame which is being
+	/// rendered shares the meshes of the scene, so the meshes may then only
+	/// be written from BaseGame::render, while the frames are exchanged.
 	/// </summary>
 	class Mesh : public Honeycomb::Base::GLItem {
 	public:
@@ -22,21 +49,35 @@ namespace Honeycomb { namespace Geometry {
 		/// </returns>
 		static const int& getInitializedMeshCount();
 
+		/// <summary>
+		/// The number of regions of the persistently mapped ring buffer of a
+		/// streamed Mesh. Each region holds a full copy of the vertices.
+		/// </summary>
+		const static int STREAM_RING_SIZE;
+
 		/// <summary>
 		/// Creates a new, initialized Mesh.
 		/// </summary>
+		/// <param name="usage">
+		/// How often the data of the Mesh is expected to change.
+		/// </param>
 		/// <returns>
 		/// The shared pointer to the Mesh.
 		/// </returns>
-		static std::shared_ptr<Mesh> newMeshShared();
+		static std::shared_ptr<Mesh> newMeshShared(const MeshUsage &usage =
+				MeshUsage::USAGE_STATIC);
 
 		/// <summary>
 		/// Creates a new, initialized Mesh.
 		/// </summary>
+		/// <param name="usage">
+		/// How often the data of the Mesh is expected to change.
+		/// </param>
 		/// <returns>
 		/// The unique pointer to the Mesh.
 		/// </returns>
-		static std::unique_ptr<Mesh> newMeshUnique();
+		static std::unique_ptr<Mesh> newMeshUnique(const MeshUsage &usage =
+				MeshUsage::USAGE_STATIC);
 
 		/// <summary>
 		/// Deinitializes and destroys this Mesh.
@@ -107,8 +148,48 @@ namespace Honeycomb { namespace Geometry {
 		/// </exception>
 		void destroy();
 
+		/// <summary>
+		/// Returns the base vertex which is added to the indices of this Mesh
+		/// when it is drawn, which is the offset of its vertices within the
+		/// Geometry Arena (zero if the vertices are not in the arena).
+		/// </summary>
+		/// <returns>
+		/// The base vertex.
+		/// </returns>
+		std::size_t getBaseVertex() const;
+
+		/// <summary>
+		/// Returns the maximum corner of the axis aligned bounding box of the
+		/// vertices of this Mesh, in the local space of the Mesh.
+		/// </summary>
+		/// <returns>
+		/// The maximum corner of the bounding box.
+		/// </returns>
+		const Honeycomb::Math::Vector3f& getBoundsMax() const;
+
+		/// <summary>
+		/// Returns the minimum corner of the axis aligned bounding box of the
+		/// vertices of this Mesh, in the local space of the Mesh.
+		/// </summary>
+		/// <returns>
+		/// The minimum corner of the bounding box.
+		/// </returns>
+		const Honeycomb::Math::Vector3f& getBoundsMin() const;
+
+		/// <summary>
+		/// Returns the position of the first index of this Mesh within the
+		/// index buffer of the Geometry Arena (zero if the indices are not in
+		/// the arena).
+		/// </summary>
+		/// <returns>
+		/// The first index.
+		/// </returns>
+		std::size_t getFirstIndex() const;
+
 		/// <summary>
 		/// Returns the raw pointer of the index buffer object of this Mesh.
+		/// If the indices are stored in the Geometry Arena, this is the index
+		/// buffer of the arena.
 		/// 
 		/// If the mesh has not yet been initialized, this pointer will be
 		/// negative.
@@ -126,8 +207,28 @@ namespace Honeycomb { namespace Geometry {
 		/// </returns>
 		const std::vector<unsigned int>& getIndices() const;
 
+		/// <summary>
+		/// Returns whether both the vertices and the indices of this Mesh are
+		/// stored in the Geometry Arena, in which case the Mesh may be drawn
+		/// as part of a multi-draw call over the buffers of the arena.
+		/// </summary>
+		/// <returns>
+		/// True if the Mesh is stored in the Geometry Arena.
+		/// </returns>
+		bool getIsInGeometryArena() const;
+
+		/// <summary>
+		/// Returns how often the data of this Mesh is expected to change.
+		/// </summary>
+		/// <returns>
+		/// The usage of the Mesh.
+		/// </returns>
+		const MeshUsage& getUsage() const;
+
 		/// <summary>
 		/// Returns the raw pointer of the vertex buffer object of this Mesh.
+		/// If the vertices are stored in the Geometry Arena, this is the
+		/// vertex buffer of the arena.
 		/// </summary>
 		/// 
 		/// If the mesh has not yet been initialized, this pointer will be
@@ -198,6 +299,63 @@ namespace Honeycomb { namespace Geometry {
 		/// </exception>
 		void setVertexData(const std::vector<Vertex> &vertices);
 
+		/// <summary>
+		/// Sets how often the data of this Mesh is expected to change. The
+		/// buffers are reallocated using the new usage and the current data
+		/// of this Mesh is uploaded again.
+		/// 
+		/// If the Mesh has not yet been initialized, a GLItemNotInitialized 
+		/// exception will be thrown.
+		/// </summary>
+		/// <param name="usage">
+		/// The usage of the Mesh.
+		/// </param>
+		/// <exception cref="GLItemNotInitializedException">
+		/// Thrown if the Mesh has not yet been initialized.
+		/// </exception>
+		void setUsage(const MeshUsage &usage);
+
+		/// <summary>
+		/// Overwrites a range of the indices of this Mesh, without changing
+		/// the number of indices or reallocating the index buffer.
+		/// 
+		/// If the Mesh has not yet been initialized, a GLItemNotInitialized 
+		/// exception will be thrown.
+		/// </summary>
+		/// <param name="indices">
+		/// The new indices. The range must lie within the current indices.
+		/// </param>
+		/// <param name="offset">
+		/// The position of the first index to be overwritten.
+		/// </param>
+		/// <exception cref="GLItemNotInitializedException">
+		/// Thrown if the Mesh has not yet been initialized.
+		/// </exception>
+		void updateIndexData(const std::vector<unsigned int> &indices,
+				const std::size_t &offset);
+
+		/// <summary>
+		/// Overwrites a range of the vertices of this Mesh, without changing
+		/// the number of vertices or reallocating the vertex buffer. Only
+		/// the updated range is uploaded, unless the Mesh is streamed, in
+		/// which case all of the vertices are written to the next region of
+		/// the ring buffer.
+		/// 
+		/// If the Mesh has not yet been initialized, a GLItemNotInitialized 
+		/// exception will be thrown.
+		/// </summary>
+		/// <param name="vertices">
+		/// The new vertices. The range must lie within the current vertices.
+		/// </param>
+		/// <param name="offset">
+		/// The position of the first vertex to be overwritten.
+		/// </param>
+		/// <exception cref="GLItemNotInitializedException">
+		/// Thrown if the Mesh has not yet been initialized.
+		/// </exception>
+		void updateVertexData(const std::vector<Vertex> &vertices,
+				const std::size_t &offset);
+
 		/// <summary>
 		/// Checks if the specified Mesh is equal to this mesh.
 		/// </summary>
@@ -237,10 +395,83 @@ namespace Honeycomb { namespace Geometry {
 		std::vector<Vertex> vertices;                          // Vertices List
 		std::vector<unsigned int> indices;                     // Indices List
 
+		Honeycomb::Math::Vector3f boundsMin;                   // Bounding Box
+		Honeycomb::Math::Vector3f boundsMax;                   // Bounding Box
+
+		MeshUsage usage;                                       // Usage Hint
+		int arenaVertices;    // Vertex allocation in the arena (-1 if none)
+		int arenaIndices;     // Index allocation in the arena (-1 if none)
+		std::size_t vertexCapacity;         // Vertices which fit in the VBO
+		std::size_t indexCapacity;          // Indices which fit in the IBO
+
+		// The persistently mapped ring buffer of a streamed Mesh (null if the
+		// Mesh is not streamed, or if buffer storage is not supported), the
+		// region which is currently drawn, and the fence of each region
+		// (stored as void pointers to keep the GL types out of this header).
+		float *streamMapping;
+		int streamRegion;
+		std::vector<void*> streamFences;
+
 		/// <summary>
 		/// Creates a new, empty Mesh item.
 		/// </summary>
 		Mesh();
+
+		/// <summary>
+		/// Recalculates the bounding box of the vertices of this Mesh.
+		/// </summary>
+		void calcBounds();
+
+		/// <summary>
+		/// Frees the allocations of this Mesh in the Geometry Arena, if any.
+		/// </summary>
+		/// <param name="vertices">
+		/// Whether the vertex allocation should be freed.
+		/// </param>
+		/// <param name="indices">
+		/// Whether the index allocation should be freed.
+		/// </param>
+		void freeArena(const bool &vertices, const bool &indices);
+
+		/// <summary>
+		/// Releases the ring buffer of this Mesh, if it is streamed, deleting
+		/// the fences of its regions. Since the storage of the ring buffer is
+		/// immutable, the vertex buffer is replaced by a new, empty buffer.
+		/// </summary>
+		void destroyStream();
+
+		/// <summary>
+		/// Returns the OpenGL buffer usage hint for the usage of this Mesh.
+		/// </summary>
+		/// <returns>
+		/// The OpenGL usage hint.
+		/// </returns>
+		int getUsageGL() const;
+
+		/// <summary>
+		/// Writes all of the vertices of this Mesh into the next region of
+		/// its ring buffer, (re)allocating the ring buffer if the vertices do
+		/// not fit in it.
+		/// </summary>
+		void writeStream();
+
+		/// <summary>
+		/// Writes the specified range of the vertices of this Mesh into the
+		/// vertex buffer, by mapping the range of the buffer and writing the
+		/// vertex elements directly into the mapped memory.
+		/// </summary>
+		/// <param name="first">
+		/// The first vertex of the range.
+		/// </param>
+		/// <param name="count">
+		/// The number of vertices of the range.
+		/// </param>
+		/// <param name="invalidate">
+		/// Whether the whole buffer (instead of just the range) may be
+		/// discarded by the driver.
+		/// </param>
+		void writeVertices(const std::size_t &first, const std::size_t &count,
+				const bool &invalidate);
 	};
 } }
 
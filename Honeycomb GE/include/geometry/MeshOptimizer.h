@@ -0,0 +1,223 @@
+#pragma once
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include <cstddef>
+#include <vector>
+
+#include "Vertex.h"
+
+namespace Honeycomb { namespace Geometry {
+	/// <summary>
+	/// Structure storing the efficiency of a triangle list with respect to a
+	/// simulated post transform vertex cache.
+	/// </summary>
+	struct VertexCacheStatistics {
+	public:
+		std::size_t transformCount;    // Number of vertex shader invocations
+		std::size_t triangleCount;     // Number of triangles
+		std::size_t vertexCount;       // Number of referenced vertices
+
+		/// <summary>
+		/// Creates a new, empty statistics structure.
+		/// </summary>
+		VertexCacheStatistics();
+
+		/// <summary>
+		/// Returns the Average Cache Miss Ratio, which is the number of
+		/// vertices transformed per triangle. It ranges from 3 (no reuse) to
+		/// about 0.5 (ideal reuse on a regular grid).
+		/// </summary>
+		/// <returns>
+		/// The ACMR, or zero if there are no triangles.
+		/// </returns>
+		float getACMR() const;
+
+		/// <summary>
+		/// Returns the Average Transform to Vertex Ratio, which is the number
+		/// of times each vertex is transformed. It is 1 for an ideal order,
+		/// which is independent of the topology of the mesh.
+		/// </summary>
+		/// <returns>
+		/// The ATVR, or zero if there are no vertices.
+		/// </returns>
+		float getATVR() const;
+
+		/// <summary>
+		/// Adds the counts of the specified statistics to these statistics,
+		/// so that the statistics of multiple meshes may be combined.
+		/// </summary>
+		/// <param name="stats">
+		/// The statistics to be added.
+		/// </param>
+		/// <returns>
+		/// This instance.
+		/// </returns>
+		VertexCacheStatistics& operator+=(const VertexCacheStatistics &stats);
+	};
+
+	/// <summary>
+	/// Structure storing the vertex cache efficiency of a triangle list before
+	/// and after it was optimized.
+	/// </summary>
+	struct MeshOptimizationReport {
+	public:
+		VertexCacheStatistics before;  // The statistics of the input order
+		VertexCacheStatistics after;   // The statistics of the final order
+
+		/// <summary>
+		/// Adds the statistics of the specified report to this report.
+		/// </summary>
+		/// <param name="report">
+		/// The report to be added.
+		/// </param>
+		/// <returns>
+		/// This instance.
+		/// </returns>
+		MeshOptimizationReport& operator+=(
+				const MeshOptimizationReport &report);
+	};
+
+	/// <summary>
+	/// Class responsible for reordering the triangles and vertices of triangle
+	/// meshes, so that they make better use of the post transform vertex
+	/// cache, cause less overdraw and fetch their vertices more linearly.
+	/// </summary>
+	class MeshOptimizer {
+	public:
+		/// <summary>
+		/// The size of the FIFO vertex cache which is simulated when the
+		/// statistics of a triangle list are computed.
+		/// </summary>
+		const static int ANALYSIS_CACHE_SIZE;
+
+		/// <summary>
+		/// Simulates a FIFO post transform vertex cache for the specified
+		/// triangle list and returns its statistics.
+		/// </summary>
+		/// <param name="indices">
+		/// The indices of the triangle list.
+		/// </param>
+		/// <param name="vertexCount">
+		/// The number of vertices referenced by the indices.
+		/// </param>
+		/// <param name="cacheSize">
+		/// The number of entries of the simulated cache.
+		/// </param>
+		/// <returns>
+		/// The statistics of the triangle list.
+		/// </returns>
+		static VertexCacheStatistics analyzeVertexCache(
+				const std::vector<unsigned int> &indices,
+				const std::size_t &vertexCount,
+				const int &cacheSize = MeshOptimizer::ANALYSIS_CACHE_SIZE);
+
+		/// <summary>
+		/// Runs all of the optimizations on the specified triangle list, in
+		/// order: vertex cache, overdraw and then vertex fetch.
+		/// </summary>
+		/// <param name="vertices">
+		/// The vertices of the triangle list, which are reordered.
+		/// </param>
+		/// <param name="indices">
+		/// The indices of the triangle list, which are reordered.
+		/// </param>
+		/// <param name="overdrawThreshold">
+		/// The factor by which the overdraw optimization may increase the
+		/// ACMR of the vertex cache optimized order.
+		/// </param>
+		/// <returns>
+		/// The statistics of the triangle list before and after optimizing.
+		/// </returns>
+		static MeshOptimizationReport optimize(std::vector<Vertex> &vertices,
+				std::vector<unsigned int> &indices,
+				const float &overdrawThreshold = 1.05F);
+
+		/// <summary>
+		/// Reorders the triangles of the specified triangle list so that
+		/// consecutive triangles share as many vertices as possible, using
+		/// Tom Forsyth's linear speed vertex cache optimization. Triangles
+		/// are greedily emitted by the score of their vertices, which favors
+		/// the vertices which were recently used, as well as the vertices
+		/// with few remaining triangles (to avoid leaving isolated
+		/// triangles behind).
+		/// </summary>
+		/// <param name="indices">
+		/// The indices of the triangle list, which are reordered.
+		/// </param>
+		/// <param name="vertexCount">
+		/// The number of vertices referenced by the indices.
+		/// </param>
+		static void optimizeVertexCache(std::vector<unsigned int> &indices,
+				const std::size_t &vertexCount);
+
+		/// <summary>
+		/// Reorders the clusters of a vertex cache optimized triangle list so
+		/// that the clusters which face away from the center of the mesh (and
+		/// are therefore likely to occlude the other clusters) are drawn
+		/// first. The clusters are split where the cache would be entirely
+		/// flushed anyway, so the ACMR barely changes. If the ACMR grows by
+		/// more than the specified threshold, the order is left unchanged.
+		/// </summary>
+		/// <param name="indices">
+		/// The indices of the triangle list, which are reordered.
+		/// </param>
+		/// <param name="vertices">
+		/// The vertices of the triangle list.
+		/// </param>
+		/// <param name="threshold">
+		/// The factor by which the ACMR may be increased.
+		/// </param>
+		static void optimizeOverdraw(std::vector<unsigned int> &indices,
+				const std::vector<Vertex> &vertices, const float &threshold);
+
+		/// <summary>
+		/// Reorders the vertices of the specified triangle list in the order
+		/// in which they are first referenced by the indices, so that the
+		/// vertices are fetched from memory as linearly as possible. The
+		/// indices are remapped accordingly and the vertices which are not
+		/// referenced are moved to the end.
+		/// </summary>
+		/// <param name="vertices">
+		/// The vertices of the triangle list, which are reordered.
+		/// </param>
+		/// <param name="indices">
+		/// The indices of the triangle list, which are remapped.
+		/// </param>
+		static void optimizeVertexFetch(std::vector<Vertex> &vertices,
+				std::vector<unsigned int> &indices);
+	private:
+		// The size of the LRU cache which is modeled by the vertex cache
+		// optimization, and the parameters of its vertex scores.
+		const static int FORSYTH_CACHE_SIZE;
+		const static float FORSYTH_CACHE_DECAY;
+		const static float FORSYTH_LAST_TRIANGLE_SCORE;
+		const static float FORSYTH_VALENCE_SCALE;
+		const static float FORSYTH_VALENCE_POWER;
+
+		/// <summary>
+		/// Mesh Optimizer only contains static functions and should not be
+		/// instantiated.
+		/// </summary>
+		MeshOptimizer() = delete;
+
+		/// <summary>
+		/// Returns the Forsyth score of a vertex.
+		/// </summary>
+		/// <param name="cachePosition">
+		/// The position of the vertex in the LRU cache, or -1 if the vertex is
+		/// not in the cache.
+		/// </param>
+		/// <param name="remaining">
+		/// The number of triangles of the vertex which have yet to be
+		/// emitted.
+		/// </param>
+		/// <returns>
+		/// The score of the vertex.
+		/// </returns>
+		static float calcVertexScore(const int &cachePosition,
+				const unsigned int &remaining);
+	};
+} }
+
+#endif
@@ -0,0 +1,172 @@
+#pragma once
+#ifndef MESH_SIMPLIFIER_H
+#define MESH_SIMPLIFIER_H
+
+#include <memory>
+#include <vector>
+
+#include "Mesh.h"
+#include "Vertex.h"
+
+namespace Honeycomb { namespace Geometry {
+	/// <summary>
+	/// Class responsible for simplifying triangle meshes using quadric error
+	/// edge collapses, for generating the levels of detail of a Mesh.
+	/// </summary>
+	class MeshSimplifier {
+	public:
+		/// <summary>
+		/// Creates a new, initialized Mesh which is a simplified copy of the
+		/// specified Mesh. The vertices which are no longer referenced by the
+		/// simplified triangles are not copied.
+		/// </summary>
+		/// <param name="mesh">
+		/// The Mesh to be simplified. Its vertex and index data must form a
+		/// triangle list.
+		/// </param>
+		/// <param name="ratio">
+		/// The fraction of the triangles of the Mesh which should be kept,
+		/// in the [0, 1] range.
+		/// </param>
+		/// <param name="targetError">
+		/// The largest distance by which the simplified surface may deviate
+		/// from the original surface, relative to the size of the Mesh.
+		/// </param>
+		/// <returns>
+		/// The unique pointer to the simplified Mesh.
+		/// </returns>
+		static std::unique_ptr<Mesh> newSimplifiedMesh(const Mesh &mesh,
+				const float &ratio, const float &targetError = 0.05F);
+
+		/// <summary>
+		/// Simplifies the specified triangle list by repeatedly collapsing
+		/// the edge whose collapse introduces the smallest quadric error,
+		/// until the index count drops to the target or no edge can be
+		/// collapsed within the target error. Each edge collapses onto one
+		/// of its existing vertices, so that the vertex attributes need not
+		/// be interpolated. Vertices on open borders or on attribute seams
+		/// (vertices which share their position with another vertex) are
+		/// never moved, and collapses which would flip a triangle are
+		/// rejected.
+		/// </summary>
+		/// <param name="vertices">
+		/// The vertices of the triangle list.
+		/// </param>
+		/// <param name="indices">
+		/// The indices of the triangle list.
+		/// </param>
+		/// <param name="targetIndexCount">
+		/// The number of indices at which the simplification stops.
+		/// </param>
+		/// <param name="targetError">
+		/// The largest distance by which the simplified surface may deviate
+		/// from the original surface, relative to the size of the mesh.
+		/// </param>
+		/// <returns>
+		/// The indices of the simplified triangle list, which reference the
+		/// specified vertices.
+		/// </returns>
+		static std::vector<unsigned int> simplify(
+				const std::vector<Vertex> &vertices,
+				const std::vector<unsigned int> &indices,
+				const std::size_t &targetIndexCount, const float &targetError);
+	private:
+		/// <summary>
+		/// Symmetric 4x4 matrix storing the sum of the squared distances to a
+		/// set of planes, each weighted by the area of its triangle, along
+		/// with the sum of the weights. Only the upper triangle is stored
+		/// (row major).
+		/// </summary>
+		struct Quadric {
+			double m[10];
+			double weight;
+		};
+
+		/// <summary>
+		/// Candidate collapse of a vertex onto another vertex.
+		/// </summary>
+		struct Collapse {
+			unsigned int from;	// The vertex which is removed
+			unsigned int to;	// The vertex which remains
+			double error;		// The quadric error of the collapse
+		};
+
+		/// <summary>
+		/// Mesh Simplifier only contains static functions and should not be
+		/// instantiated.
+		/// </summary>
+		MeshSimplifier() = delete;
+
+		/// <summary>
+		/// Adds the specified quadric to the other quadric.
+		/// </summary>
+		/// <param name="q">
+		/// The quadric to which the other quadric is added.
+		/// </param>
+		/// <param name="add">
+		/// The quadric to be added.
+		/// </param>
+		static void addQuadric(Quadric &q, const Quadric &add);
+
+		/// <summary>
+		/// Returns the mean of the squared distances from the specified point
+		/// to the planes of the specified quadric, weighted by the areas of
+		/// the planes (the standard area weighted quadric error, normalized
+		/// by the total area).
+		/// </summary>
+		/// <param name="q">
+		/// The quadric.
+		/// </param>
+		/// <param name="p">
+		/// The point.
+		/// </param>
+		/// <returns>
+		/// The quadric error of the point.
+		/// </returns>
+		static double evaluateQuadric(const Quadric &q,
+				const Honeycomb::Math::Vector3f &p);
+
+		/// <summary>
+		/// Returns the quadric of the plane of the specified triangle, which
+		/// is weighted by the area of the triangle.
+		/// </summary>
+		/// <param name="p0">
+		/// The first vertex position of the triangle.
+		/// </param>
+		/// <param name="p1">
+		/// The second vertex position of the triangle.
+		/// </param>
+		/// <param name="p2">
+		/// The third vertex position of the triangle.
+		/// </param>
+		/// <returns>
+		/// The triangle quadric (all zeros for degenerate triangles).
+		/// </returns>
+		static Quadric newTriangleQuadric(const Honeycomb::Math::Vector3f &p0,
+				const Honeycomb::Math::Vector3f &p1,
+				const Honeycomb::Math::Vector3f &p2);
+
+		/// <summary>
+		/// Returns the normal of the specified triangle, whose length is
+		/// twice the area of the triangle.
+		/// </summary>
+		/// <param name="p0">
+		/// The first vertex position of the triangle.
+		/// </param>
+		/// <param name="p1">
+		/// The second vertex position of the triangle.
+		/// </param>
+		/// <param name="p2">
+		/// The third vertex position of the triangle.
+		/// </param>
+		/// <returns>
+		/// The non normalized normal of the triangle.
+		/// </returns>
+		static Honeycomb::Math::Vector3f triangleNormal(
+				const Honeycomb::Math::Vector3f &p0,
+				const Honeycomb::Math::Vector3f &p1,
+				const Honeycomb::Math::Vector3f &p2);
+	};
+} }
+
+#endif
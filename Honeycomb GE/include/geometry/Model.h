@@ -5,7 +5,9 @@
 #include <vector>
 
 #include "Mesh.h"
+#include "MeshOptimizer.h"
 #include "../object/GameObject.h"
+#include "../object/Prefab.h"
 #include "../component/render/MeshRenderer.h"
 #include "../graphics/Material.h"
 #include "../graphics/Texture2D.h"
@@ -42,6 +44,13 @@ namespace Honeycomb { namespace Geometry {
 		bool flipUVs;                  // Flip the UV coordinates along y-axis?
 		bool flipWindingOrder;         // Flip Face Winding Order to CW?
 
+		bool optimizeVertexOrder;      // Reorder for the vertex cache/fetch?
+		float overdrawThreshold;       // ACMR increase allowed for overdraw
+
+		int lodLevels;                 // Number of generated coarser LODs
+		float lodReduction;            // Fraction of triangles kept per LOD
+		float lodScreenSize;           // Screen size of the first LOD
+
 		/// <summary>
 		/// Creates a model settings structure with the following default
 		/// settings:
@@ -63,6 +72,20 @@ namespace Honeycomb { namespace Geometry {
 		/// optimizeGraph = false;
 		/// flipUVs = true;
 		/// flipWindingOrder = false;
+		/// optimizeVertexOrder = true;
+		/// overdrawThreshold = 1.05F;
+		/// lodLevels = 0;
+		/// lodReduction = 0.5F;
+		/// lodScreenSize = 0.25F;
+		/// 
+		/// If lodLevels is greater than zero, that many coarser levels of
+		/// detail are generated for each Mesh Renderer of the Model, where
+		/// level k keeps lodReduction^k of the triangles and is used below
+		/// a screen size of lodScreenSize / 2^(k - 1).
+		/// 
+		/// If optimizeVertexOrder is true, the triangles and vertices of each
+		/// Mesh are reordered by the Mesh Optimizer (vertex cache, overdraw
+		/// and vertex fetch), in addition to the ASSIMP post processing.
 		/// </summary>
 		ModelSettings();
 	private:
@@ -101,7 +124,10 @@ namespace Honeycomb { namespace Geometry {
 
 		/// <summary>
 		/// Returns a clone of the loaded in model Game Object. The clone will
-		/// be independent and not attached to any scene or parent.
+		/// be independent and not attached to any scene or parent. The clone
+		/// is instanced from the prefab of the model, so its meshes and
+		/// materials are shared with the other clones (the materials are
+		/// copied on write).
 		/// </summary>
 		/// <returns>
 		/// The unique pointer to the clone.
@@ -116,15 +142,26 @@ namespace Honeycomb { namespace Geometry {
 		/// The path string.
 		/// </returns>
 		const std::string& getPath() const;
+
+		/// <summary>
+		/// Gets the combined vertex cache statistics of all of the meshes of
+		/// this Model, before and after their vertex order was optimized. If
+		/// the vertex order was not optimized, both statistics are equal.
+		/// </summary>
+		/// <returns>
+		/// The optimization report.
+		/// </returns>
+		const MeshOptimizationReport& getOptimizationReport() const;
 	private:
 		std::string path;           // The system path to the model
 		ModelSettings settings;     // The settings used to import this model
+		MeshOptimizationReport optimizationReport; // Stats of all meshes
 
 		const aiScene* scene;       // Pointer to ASSIMP scene
 
-		// The constructed Game Object. All Game Object clones returned from
-		// this instance are clones of this Game Object.
-		std::unique_ptr<Honeycomb::Object::GameObject> gameObject;
+		// The prefab of the constructed Game Object. All Game Object clones
+		// returned from this instance are instances of this prefab.
+		std::unique_ptr<Honeycomb::Object::Prefab> prefab;
 
 		/// <summary>
 		/// Fetches the specified float material property from the given
@@ -12,6 +12,7 @@ namespace Honeycomb { namespace Geometry {
 	/// Class for storing any mesh data for a Vertex.
 	/// </summary>
 	class Vertex {
+		friend class GeometryArena;
 		friend class Mesh;
 	public:
 		/// <summary>
@@ -31,6 +32,24 @@ namespace Honeycomb { namespace Geometry {
 		static std::vector<float> toFloatBuffer(const std::vector<Vertex>
 				&verts);
 
+		/// <summary>
+		/// Writes the specified vertices into the specified float buffer, in
+		/// the same layout as <see cref="toFloatBuffer"/>. This allows the
+		/// vertices to be written directly into mapped buffer memory.
+		/// </summary>
+		/// <param name="verts">
+		/// The pointer to the first vertex to be written.
+		/// </param>
+		/// <param name="count">
+		/// The number of vertices to be written.
+		/// </param>
+		/// <param name="buffer">
+		/// The buffer to which the vertices are written. It must have room
+		/// for ELEMENTS_PER_VERTEX_COUNT floats per vertex.
+		/// </param>
+		static void writeFloatBuffer(const Vertex *verts,
+				const std::size_t &count, float *buffer);
+
 		/// <summary>
 		/// Creates a new vertex with the position, normals, tangents and
 		/// texture coordinates being set to their default Vector2f and
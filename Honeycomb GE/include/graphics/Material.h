@@ -25,6 +25,12 @@ namespace Honeycomb { namespace Graphics {
 		/// Returns the name of the material.
 		/// return : The material name.
 		const std::string& getName() const;
+
+		/// Returns whether this is a Standard Material, i.e. whether its
+		/// struct is the Material struct of the standard shaders (and it may
+		/// therefore be stored in a Material Table).
+		/// return : True if this is a Standard Material, false otherwise.
+		bool getIsStandard() const;
 	private:
 		// Variables outlining the file directory of the Shader file and name
 		// of the struct where the Default Standard Material is defined.
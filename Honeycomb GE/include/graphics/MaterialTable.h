@@ -0,0 +1,156 @@
+#pragma once
+#ifndef MATERIAL_TABLE_H
+#define MATERIAL_TABLE_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Material.h"
+#include "Texture2D.h"
+#include "../base/GLItem.h"
+#include "../shader/ShaderProgram.h"
+
+namespace Honeycomb { namespace Graphics {
+	/// Stores the values of many Standard Materials in a single buffer
+	/// texture, and their textures as layers of a few texture arrays (pages),
+	/// so that draws of different materials may be issued without binding any
+	/// textures or writing any uniforms in between (see stdMaterialTable.glsl).
+	///
+	/// Each page holds the textures of one size and internal format, which
+	/// are all sampled as textures are by default (repeated & trilinearly
+	/// filtered); materials with textures which are sampled otherwise are not
+	/// stored in the table. The textures are copied into their page on the
+	/// graphics card when they are first added, and again whenever their image
+	/// data is set. The layers of textures which were destroyed are reused
+	/// when the table is cleared.
+	class MaterialTable : public Honeycomb::Base::GLItem {
+	public:
+		// The maximum number of pages, and the number of RGBA32F texels which
+		// store each material in the table.
+		const static int PAGE_COUNT;
+		const static int ROWS_PER_MATERIAL;
+
+		/// Writes the texture units of a table and of its pages to the
+		/// specified shader, without binding anything to them.
+		/// ShaderProgram &shader : The shader.
+		/// const int &unit : The texture unit of the table (the pages take
+		///					  the PAGE_COUNT units which precede it, see
+		///					  Render::TextureUnit).
+		static void setTextureUnits(Honeycomb::Shader::ShaderProgram &shader,
+				const int &unit);
+
+		/// Instantiates a new, empty Material Table.
+		MaterialTable();
+
+		/// Deinstantiates this Material Table.
+		~MaterialTable();
+
+		/// Adds the specified material to this table, unless it was already
+		/// added since the table was last cleared. The values of the material
+		/// are copied as they are when it is added.
+		/// const Material &material : The material to be added.
+		/// return : The index of the material within the table, or -1 if the
+		///			 material is not a Standard Material, or if one of its
+		///			 textures can not be stored in a page (in which case the
+		///			 material must be written to the shader on its own).
+		int add(const Honeycomb::Graphics::Material &material);
+
+		/// Removes all of the materials from this table, and frees the layers
+		/// of the textures which were destroyed. The pages are kept, so that
+		/// the textures need not be copied again.
+		void clear();
+
+		/// Destroys the pages, buffer, buffer texture and framebuffer of this
+		/// table.
+		void destroy();
+
+		/// Returns the number of materials in this table.
+		/// return : The number of materials.
+		std::size_t getMaterialCount() const;
+
+		/// Initializes the buffer, buffer texture and framebuffer of this
+		/// table.
+		void initialize();
+
+		/// Writes this table to the specified shader, uploading the materials
+		/// if they changed. The table is bound to the specified texture unit,
+		/// and the pages to the PAGE_COUNT units which precede it.
+		/// ShaderProgram &shader : The shader to which the table is written.
+		/// const int &unit : The texture unit of the table.
+		void toShader(Honeycomb::Shader::ShaderProgram &shader,
+				const int &unit);
+	private:
+		// A texture array which stores the textures of one size & format
+		struct Page {
+			int width;
+			int height;
+			TextureDataInternalFormat format;
+
+			int texture;				 // The texture array
+			int layerCount;				 // Number of layers in use
+			int capacity;				 // Number of layers allocated
+			std::vector<int> freeLayers; // Layers of destroyed textures
+			bool isMipmapped;			 // Are the mipmaps up to date?
+		};
+
+		// The page & layer of a texture (or a page of -1 if the texture can
+		// not be stored in a page), the texture itself (to find out whether
+		// it was destroyed) and the revision of the texture which was copied.
+		struct Layer {
+			std::weak_ptr<const Texture2D> texture;
+			unsigned int revision;
+			int page;
+			int layer;
+		};
+
+		// The number of layers with which a page is first allocated
+		const static int INITIAL_PAGE_CAPACITY;
+
+		// The slots of the texture rows, in the order of stdMaterialTable
+		const static std::string TEXTURE_SLOTS[];
+
+		std::vector<Page> pages;
+		std::unordered_map<const Texture2D*, Layer> layers;
+
+		// The index of each material in the table and the texels of all of
+		// the materials.
+		std::unordered_map<const Material*, int> materialIndices;
+		std::vector<float> rows;
+		bool isUploaded; // Were the texels written to the buffer?
+
+		// The buffer & buffer texture of the texels, the number of materials
+		// which the buffer fits, and the framebuffer from which the textures
+		// are copied into the pages.
+		int tableBuffer;
+		int tableTexture;
+		std::size_t capacity;
+		int frameBuffer;
+
+		/// Returns whether textures of the specified format may be stored in a
+		/// page.
+		/// const TextureDataInternalFormat &format : The format.
+		/// return : True if the format is color renderable (so that it can
+		///			 be read from a framebuffer, which is still checked for
+		///			 completeness) and filterable, false otherwise.
+		static bool isPageable(const TextureDataInternalFormat &format);
+
+		/// Finds the page & layer of the specified texture, copying the
+		/// texture into a page if it is not stored in one yet, or if its
+		/// image data was set since it was copied.
+		/// const shared_ptr<const Texture2D> &texture : The texture.
+		/// return : The pointer to the layer of the texture, or null if the
+		///			 texture can not be stored in a page.
+		const Layer* findLayer(const std::shared_ptr<const Texture2D> &texture);
+
+		/// Reallocates the specified page with the specified number of layers,
+		/// copying over the layers which are in use.
+		/// Page &page : The page to be reallocated.
+		/// const int &capacity : The new number of layers.
+		void reallocate(Page &page, const int &capacity);
+	};
+} }
+
+#endif
@@ -149,6 +149,17 @@ namespace Honeycomb { namespace Graphics {
 		/// </exception>
 		void bind(const int &loc) const;
 
+		/// <summary>
+		/// Returns whether the texture is sampled as set by default when its
+		/// image data is set with mipmaps: repeated, trilinearly filtered and
+		/// without anisotropic filtering. Setting the wrap or the filtering
+		/// of the texture afterwards is assumed to change the sampling.
+		/// </summary>
+		/// <returns>
+		/// True if the texture is sampled as set by default.
+		/// </returns>
+		const bool& getHasDefaultSampling() const;
+
 		/// <summary>
 		/// Returns the height of the texture, in pixels.
 		/// </summary>
@@ -157,6 +168,25 @@ namespace Honeycomb { namespace Graphics {
 		/// </returns>
 		const int& getHeight() const;
 
+		/// <summary>
+		/// Returns the internal format with which the image data of the
+		/// texture is stored.
+		/// </summary>
+		/// <returns>
+		/// The internal format of the texture.
+		/// </returns>
+		const TextureDataInternalFormat& getInternalFormat() const;
+
+		/// <summary>
+		/// Returns the number of times the image data of the texture has been
+		/// set, so that copies of the texture may find out whether they are
+		/// out of date.
+		/// </summary>
+		/// <returns>
+		/// The revision of the image data.
+		/// </returns>
+		const unsigned int& getRevision() const;
+
 		/// <summary>
 		/// Returns the raw OpenGL pointer of the texture. If the texture has
 		/// not yet been initialized, the texture ID will be negative.
@@ -402,6 +432,12 @@ namespace Honeycomb { namespace Graphics {
 		int width;                     // The width of the texture
 		int height;                    // The height of the texture
 
+		// The format with which the image data is stored
+		TextureDataInternalFormat internalFormat;
+
+		unsigned int revision;         // Number of times the image was set
+		bool hasDefaultSampling;       // Is the wrap & filtering the default?
+
 		/// <summary>
 		/// Creates an empty, uninitialized texture instance.
 		/// </summary>
@@ -0,0 +1,208 @@
+#pragma once
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Honeycomb { namespace Job {
+	/// <summary>
+	/// Counts the jobs of a group which have not finished yet. Each job which
+	/// is run with a counter increments it, and decrements it once it is done,
+	/// so that the parent of the jobs may wait on all of its children (which
+	/// may in turn run and wait on children of their own).
+	/// </summary>
+	class JobCounter {
+		friend class JobSystem;
+	public:
+		/// <summary>
+		/// Instantiates a new Job Counter, with no unfinished jobs.
+		/// </summary>
+		JobCounter();
+
+		/// <summary>
+		/// Returns whether all of the jobs of this counter have finished.
+		/// </summary>
+		/// <returns>
+		/// True if no job of this counter is queued or running.
+		/// </returns>
+		bool getIsDone() const;
+	private:
+		std::atomic<int> count; // The number of unfinished jobs
+
+		JobCounter(const JobCounter &) = delete;
+		JobCounter& operator=(const JobCounter &) = delete;
+	};
+
+	/// <summary>
+	/// Runs jobs on a pool of worker threads (one per hardware thread, the
+	/// thread which initialized the system being the first). Each worker
+	/// queues the jobs it runs in its own deque and takes the newest of them
+	/// first, while a worker whose deque is empty steals the oldest job of
+	/// another worker. A thread which waits on a counter runs the queued jobs
+	/// of that counter in the meantime, rather than blocking, so jobs may
+	/// freely wait on the jobs which they spawn. It never runs the jobs of
+	/// other counters while it waits, so a thread (such as the one which
+	/// renders) only ever runs the jobs which it is waiting on itself.
+	///
+	/// Before the system is initialized (or after it is destroyed), all jobs
+	/// are run immediately on the calling thread.
+	/// </summary>
+	class JobSystem {
+	public:
+		/// <summary>
+		/// Destroys the worker threads of this system. The jobs which are
+		/// still queued are discarded.
+		/// </summary>
+		void destroy();
+
+		/// <summary>
+		/// Returns the Job System instance of this Singleton.
+		/// </summary>
+		/// <returns>
+		/// The Job System instance.
+		/// </returns>
+		static JobSystem* getJobSystem();
+
+		/// <summary>
+		/// Returns the number of threads which run jobs, including the thread
+		/// which initialized this system.
+		/// </summary>
+		/// <returns>
+		/// The number of workers, or one if the system is not initialized.
+		/// </returns>
+		int getWorkerCount() const;
+
+		/// <summary>
+		/// Starts the worker threads of this system. The calling thread
+		/// becomes the first worker, and only runs jobs while it waits.
+		/// </summary>
+		/// <param name="threadCount">
+		/// The number of workers, or zero for one per hardware thread.
+		/// </param>
+		void initialize(const int &threadCount = 0);
+
+		/// <summary>
+		/// Splits the range [0, count) into chunks, runs the specified body
+		/// for each chunk as a job, and waits for all of them to finish. The
+		/// first chunk is run on the calling thread.
+		/// </summary>
+		/// <param name="count">
+		/// The number of elements in the range.
+		/// </param>
+		/// <param name="grain">
+		/// The number of elements in each chunk, or zero to split the range
+		/// into a few chunks per worker.
+		/// </param>
+		/// <param name="body">
+		/// The function which processes the elements [begin, end) of a chunk.
+		/// It is called concurrently for different chunks.
+		/// </param>
+		void parallelFor(const int &count, const int &grain,
+				const std::function<void(int, int)> &body);
+
+		/// <summary>
+		/// Queues the specified job on the deque of the calling thread, from
+		/// which it is run by the calling thread or stolen by another worker.
+		/// </summary>
+		/// <param name="job">
+		/// The function of the job. It must not throw.
+		/// </param>
+		/// <param name="counter">
+		/// The counter which is incremented until the job is done.
+		/// </param>
+		void run(const std::function<void()> &job, JobCounter &counter);
+
+		/// <summary>
+		/// Waits until all of the jobs of the specified counter are done,
+		/// running the queued jobs of the counter in the meantime.
+		/// </summary>
+		/// <param name="counter">
+		/// The counter on which to wait.
+		/// </param>
+		void wait(const JobCounter &counter);
+	private:
+		// A queued job, along with the counter of its group
+		struct Job {
+			std::function<void()> function;
+			JobCounter *counter;
+		};
+
+		// A worker thread, along with its deque of jobs (the newest of which
+		// are at the back).
+		struct Worker {
+			std::thread thread;
+			std::deque<Job> jobs;
+			std::mutex mutex;
+		};
+
+		// The number of chunks per worker into which parallelFor splits a
+		// range, if no grain is given.
+		const static int CHUNKS_PER_WORKER;
+
+		// The index of the worker of the calling thread (or -1 if the calling
+		// thread is not a worker).
+		static thread_local int workerIndex;
+
+		std::vector<std::unique_ptr<Worker>> workers;
+
+		std::atomic<int> pendingJobs; // Number of queued jobs
+		std::atomic<int> nextWorker;  // Deque for jobs of other threads
+		bool isRunning;               // Should the workers keep running?
+
+		// The workers sleep on the condition while there are no jobs
+		std::mutex sleepMutex;
+		std::condition_variable sleepCondition;
+
+		/// <summary>
+		/// Instantiates the Job System, without any worker threads.
+		/// </summary>
+		JobSystem();
+
+		/// <summary>
+		/// Runs the specified job and marks it as done.
+		/// </summary>
+		/// <param name="job">
+		/// The job.
+		/// </param>
+		void execute(Job &job);
+
+		/// <summary>
+		/// Takes a job from the back of the deque of the specified worker, or
+		/// steals one from the front of the deque of another worker if it is
+		/// empty. If a counter is given, only the jobs of that counter are
+		/// taken, the newest of the own deque and the oldest of the others.
+		/// </summary>
+		/// <param name="index">
+		/// The index of the worker (or -1 to only steal).
+		/// </param>
+		/// <param name="job">
+		/// The job which was taken.
+		/// </param>
+		/// <param name="counter">
+		/// The counter whose jobs may be taken, or null for any job.
+		/// </param>
+		/// <returns>
+		/// True if a job was taken, false if the deques have no such job.
+		/// </returns>
+		bool take(const int &index, Job &job,
+				const JobCounter *counter = nullptr);
+
+		/// <summary>
+		/// The loop of a worker thread, which runs jobs until the system is
+		/// destroyed, and sleeps while there are none.
+		/// </summary>
+		/// <param name="index">
+		/// The index of the worker.
+		/// </param>
+		void work(const int &index);
+	};
+} }
+
+#endif
@@ -0,0 +1,109 @@
+#pragma once
+#ifndef POOL_ALLOCATOR_H
+#define POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Honeycomb { namespace Memory {
+	/// <summary>
+	/// The allocation statistics of a Pool Allocator.
+	/// </summary>
+	struct PoolStatistics {
+		std::size_t allocations;         // Number of blocks allocated
+		std::size_t deallocations;       // Number of blocks freed
+		std::size_t liveBlocks;          // Pooled blocks which are in use
+		std::size_t slabs;               // Number of slabs reserved
+		std::size_t reservedBytes;       // Total size of all of the slabs
+		std::size_t fallbackAllocations; // Blocks too large to be pooled
+	};
+
+	/// <summary>
+	/// Allocates small blocks of memory from slabs, rather than from the heap
+	/// one by one. The blocks are split into size classes, each of which has
+	/// a free list of blocks carved out of its own slabs, so that allocating
+	/// or freeing a block only takes a block from, or returns it to, the free
+	/// list of its size class. Since the objects of a type are all of the same
+	/// size, each type is effectively pooled on its own.
+	///
+	/// The slabs are never returned to the heap, so the memory of the objects
+	/// which were freed is reused for the next objects of the same size.
+	/// Blocks which are larger than the largest size class are allocated from
+	/// the heap directly.
+	/// </summary>
+	class PoolAllocator {
+	public:
+		/// <summary>
+		/// Returns the Pool Allocator instance of this Singleton.
+		/// </summary>
+		/// <returns>
+		/// The Pool Allocator instance.
+		/// </returns>
+		static PoolAllocator* getPoolAllocator();
+
+		/// <summary>
+		/// Allocates a block of the specified size, which is aligned for any
+		/// type. This may be called concurrently.
+		/// </summary>
+		/// <param name="size">
+		/// The size of the block, in bytes.
+		/// </param>
+		/// <returns>
+		/// The pointer to the block.
+		/// </returns>
+		void* allocate(const std::size_t &size);
+
+		/// <summary>
+		/// Frees the specified block, which must have been allocated by this
+		/// allocator with the same size. This may be called concurrently.
+		/// </summary>
+		/// <param name="block">
+		/// The pointer to the block, or a nullptr.
+		/// </param>
+		/// <param name="size">
+		/// The size of the block, in bytes.
+		/// </param>
+		void deallocate(void *block, const std::size_t &size);
+
+		/// <summary>
+		/// Returns the allocation statistics of this allocator.
+		/// </summary>
+		/// <returns>
+		/// The copy of the statistics.
+		/// </returns>
+		PoolStatistics getStatistics() const;
+	private:
+		// A free block, which links to the next free block of its size class
+		struct Block {
+			Block *next;
+		};
+
+		const static std::size_t BLOCK_ALIGNMENT; // Step between size classes
+		const static std::size_t MAX_BLOCK_SIZE;  // Largest pooled block size
+		const static std::size_t SLAB_SIZE;       // Minimum size of a slab
+
+		std::vector<Block*> freeLists;              // Free list of each class
+		std::vector<std::unique_ptr<char[]>> slabs; // All of the slabs
+		PoolStatistics statistics;
+
+		mutable std::mutex mutex; // Guards the free lists & statistics
+
+		/// <summary>
+		/// Instantiates the Pool Allocator, without any slabs.
+		/// </summary>
+		PoolAllocator();
+
+		/// <summary>
+		/// Reserves a new slab for the specified size class and adds all of
+		/// its blocks to the free list of the class.
+		/// </summary>
+		/// <param name="sizeClass">
+		/// The index of the size class.
+		/// </param>
+		void reserveSlab(const std::size_t &sizeClass);
+	};
+} }
+
+#endif
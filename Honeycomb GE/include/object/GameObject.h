@@ -12,6 +12,7 @@
 #include "../debug/Logger.h"
 
 namespace Honeycomb { namespace Component { class GameComponent; } }
+namespace Honeycomb { namespace Scene { class GameObjectQuery; } }
 namespace Honeycomb { namespace Scene { class GameScene; } }
 namespace Honeycomb { namespace Component { namespace Light { 
 	class BaseLight; } } }
@@ -52,7 +53,11 @@ namespace Honeycomb { namespace Object {
 		std::string entityName;         // Name of entity which D.N.E.
 	};
 
+	class Prefab;
+
 	class GameObject {
+		friend class Prefab;
+		friend class Honeycomb::Scene::GameObjectQuery;
 		friend class Honeycomb::Scene::GameScene;
 	public:
 		/// <summary>
@@ -306,10 +311,12 @@ namespace Honeycomb { namespace Object {
 		const T& getComponent() const {
 			Honeycomb::Component::GameComponent::assertIsBaseOf<T>();
 
+			// All of the components with the Component ID of type T are of
+			// type T, so no RTTI is needed to downcast them.
 			auto &componentsOfType = this->getComponentsInternal<T>();
 
 			for (auto &comp : componentsOfType)
-				return dynamic_cast<const T&>(*comp.get());
+				return static_cast<const T&>(*comp.get());
 
 			throw GameEntityNotAttachedException(this, typeid(T).name());
 		}
@@ -334,7 +341,7 @@ namespace Honeycomb { namespace Object {
 			std::vector<std::reference_wrapper<T>> components;
 
 			for (auto &raw : rawComponents) {
-				auto &downcast = dynamic_cast<T&>(*raw.get());
+				auto &downcast = static_cast<T&>(*raw.get());
 				auto refWrapped = std::ref(downcast);
 
 				components.push_back(refWrapped);
@@ -375,7 +382,7 @@ namespace Honeycomb { namespace Object {
 				// For each component, downcast to type T, convert to reference
 				// and store into components vector.
 				for (const auto &raw : currentComponents) {
-					auto &downcast = dynamic_cast<T&>(*raw.get());
+					auto &downcast = static_cast<T&>(*raw.get());
 					auto refWrapped = std::ref(downcast);
 
 					ancestorComponents.push_back(refWrapped);
@@ -427,7 +434,7 @@ namespace Honeycomb { namespace Object {
 				auto &currentComponents = 
 					current.get().getComponentsInternal<T>();
 				for (auto &comp : currentComponents) {
-					auto &downcast = dynamic_cast<T&>(*comp.get());
+					auto &downcast = static_cast<T&>(*comp.get());
 					auto refWrapped = std::ref(downcast);
 
 					descendantComponents.push_back(refWrapped);
@@ -461,15 +468,16 @@ namespace Honeycomb { namespace Object {
 				// If no components of this type exist, continue to next set
 				if (componentsOfType.empty()) continue;
 
-				// If any component in the set does not downcast to type T,
-				// continue to next set.
+				// If the components of this type are not of type T (which is
+				// only checked once per type), continue to next set.
 				auto first = componentsOfType[0].get();
-				if (dynamic_cast<T*>(first) == nullptr) continue;
+				if (!Honeycomb::Component::GameComponent::
+						getIsOfType<T>(*first)) continue;
 
 				// Else, downcast each component to type T and store in
 				// the reference vector.
 				for (auto &component : componentsOfType) {
-					auto &downcast = dynamic_cast<T&>(*component.get());
+					auto &downcast = static_cast<T&>(*component.get());
 					auto refWrapped = std::ref(downcast);
 
 					refComponents.push_back(refWrapped);
@@ -572,12 +580,14 @@ namespace Honeycomb { namespace Object {
 		/// <summary>
 		/// Gets a boolean representing whether or not the Game Object is
 		/// enabled. This is true only if this is self active and its parent
-		/// is active.
+		/// is active. The activeness is cached, and only recalculated when
+		/// this Game Object or one of its ancestors is enabled, disabled or
+		/// reparented, so this does not walk up the hierarchy.
 		/// </summary>
 		/// <returns>
 		/// True if the object is active, false otherwise.
 		/// </returns>
-		virtual bool getIsActive() const;
+		bool getIsActive() const;
 
 		/// <summary>
 		/// Gets a boolean representing whether or not the Game Object is self
@@ -726,7 +736,8 @@ namespace Honeycomb { namespace Object {
 		bool hasComponent() const {
 			Honeycomb::Component::GameComponent::assertIsBaseOf<T>();
 
-			return this->getNumberOfComponents<T>() > 0;
+			return this->hasComponent(Honeycomb::Component::GameComponent::
+				getGameComponentTypeID<T>());
 		}
 
 		/// <summary>
@@ -847,12 +858,38 @@ namespace Honeycomb { namespace Object {
 		/// </param>
 		void setName(const std::string &name);
 
+		/// <summary>
+		/// Allocates the memory of a new Game Object from the Pool
+		/// Allocator, so that the Game Objects of a type share slabs, rather
+		/// than each being a separate heap allocation.
+		/// </summary>
+		/// <param name="size">
+		/// The size of the Game Object, in bytes.
+		/// </param>
+		/// <returns>
+		/// The pointer to the memory.
+		/// </returns>
+		static void* operator new(std::size_t size);
+
+		/// <summary>
+		/// Returns the memory of a destroyed Game Object to the Pool
+		/// Allocator.
+		/// </summary>
+		/// <param name="block">
+		/// The pointer to the memory.
+		/// </param>
+		/// <param name="size">
+		/// The size of the Game Object, in bytes.
+		/// </param>
+		static void operator delete(void *block, std::size_t size);
+
 		/// <summary>
 		/// No assignment operator exists for the Game Object class.
 		/// </summary>
 		GameObject& operator=(const GameObject &object) = delete;
 	protected:
 		bool isSelfActive;                  // Is this object self active?
+		bool isActive;                      // Are this & its ancestors on?
 		std::string name;                   // Name of this Game Object
 		
 		GameObject *parent;                 // The parent of this Game Object
@@ -864,11 +901,18 @@ namespace Honeycomb { namespace Object {
 		// The 2D array of all of the components of the Game Object. For each
 		// Game Component, there exists an array, at the index of the Game
 		// Component ID, which contains all of the Game Components of that
-		// type which are attached to this Game Object.
-		mutable std::vector<std::vector<std::unique_ptr<
+		// type which are attached to this Game Object. The array only grows
+		// when a component is added, so it may be shorter than the number of
+		// component types.
+		std::vector<std::vector<std::unique_ptr<
 				Honeycomb::Component::GameComponent>>> components;
 		unsigned int numComponents;
 
+		// The mask of the component types of this Game Object, in which the
+		// bit at the index of a Game Component ID is set if this Game Object
+		// has at least one component of that type.
+		std::vector<bool> componentMask;
+
 		/// <summary>
 		/// Initializes a new Game Object with the specified name, and no
 		/// parent or scene. The Game Object is not active by default. The
@@ -883,12 +927,31 @@ namespace Honeycomb { namespace Object {
 		/// </param>
 		GameObject(const std::string &name, const bool &attachTransform);
 
+		/// <summary>
+		/// Adds the specified component to the component pool of its type in
+		/// the scene of this Game Object (and to the lights of the scene, if
+		/// it is a light). This has no effect if this Game Object is not in a
+		/// scene.
+		/// </summary>
+		/// <param name="component">
+		/// The component, which must be attached to this Game Object.
+		/// </param>
+		void addToScenePool(Honeycomb::Component::GameComponent &component);
+
+		/// <summary>
+		/// Calculates whether this Game Object is active from its own
+		/// self-activeness and the cached activeness of its parent.
+		/// </summary>
+		/// <returns>
+		/// True if this Game Object should be active, false otherwise.
+		/// </returns>
+		virtual bool calcIsActive() const;
+
 		/// <summary>
 		/// Returns the list of components attached to this Game Object which
 		/// share the same Component ID as the specified parameter. This
 		/// function also automatically resizes the components vector if new
-		/// component types were added since it (or its overrides) was last 
-		/// called.
+		/// component types were added since it was last called.
 		/// </summary>
 		/// <param name="id">
 		/// The Component ID.
@@ -902,10 +965,8 @@ namespace Honeycomb { namespace Object {
 
 		/// <summary>
 		/// Returns the list of components attached to this Game Object which
-		/// share the same Component ID as the specified parameter. This
-		/// function also automatically resizes the components vector if new
-		/// component types were added since it (or its overrides) was last 
-		/// called.
+		/// share the same Component ID as the specified parameter. The list
+		/// is empty if this Game Object never had a component of that type.
 		/// </summary>
 		/// <param name="id">
 		/// The Component ID.
@@ -920,35 +981,8 @@ namespace Honeycomb { namespace Object {
 
 		/// <summary>
 		/// Returns the list of components of the specified type which are
-		/// attached to this Game Object. This function also automatically 
-		/// resizes the components vector if new component types were added 
-		/// since it (or its overrides) was last called.
-		/// </summary>
-		/// <typeparam name="T">
-		/// The type of the component.
-		/// </typeparam>
-		/// <returns>
-		/// The list of components of type T attached to this Game Object, by
-		/// means of a reference.
-		/// </returns>
-		template<typename T>
-		std::vector<std::unique_ptr<Honeycomb::Component::GameComponent>>&
-				getComponentsInternal() {
-			Honeycomb::Component::GameComponent::assertIsBaseOf<T>();
-			this->resizeComponents();
-
-			// Get the list of components of the specified type and return it
-			unsigned int id = Honeycomb::Component::GameComponent::
-				getGameComponentTypeID<T>();
-
-			return this->components.at(id);
-		}
-
-		/// <summary>
-		/// Returns the list of components of the specified type which are
-		/// attached to this Game Object. This function also automatically 
-		/// resizes the components vector if new component types were added 
-		/// since it (or its overrides) was last called.
+		/// attached to this Game Object. The list is empty if this Game
+		/// Object never had a component of that type.
 		/// </summary>
 		/// <typeparam name="T">
 		/// The type of the component.
@@ -962,13 +996,10 @@ namespace Honeycomb { namespace Object {
 				Honeycomb::Component::GameComponent>>& 
 				getComponentsInternal() const {
 			Honeycomb::Component::GameComponent::assertIsBaseOf<T>();
-			this->resizeComponents();
 
 			// Get the list of components of the specified type and return it
-			unsigned int id = Honeycomb::Component::GameComponent::
-				getGameComponentTypeID<T>();
-
-			return this->components.at(id);
+			return this->getComponentsInternal(Honeycomb::Component::
+				GameComponent::getGameComponentTypeID<T>());
 		}
 
 		/// <summary>
@@ -1014,11 +1045,44 @@ namespace Honeycomb { namespace Object {
 		virtual void onDetach(Honeycomb::Scene::GameScene *scene);
 
 		/// <summary>
-		/// Resizes the components vector of this Game Object to be roughly
-		/// twice the size of the number of component types if the number of
-		/// component types exceeds the components vector size.
+		/// Removes the specified component from the component pool of its
+		/// type in the scene of this Game Object (and from the lights of the
+		/// scene, if it is a light). This has no effect if this Game Object is
+		/// not in a scene.
+		/// </summary>
+		/// <param name="component">
+		/// The component, which must be attached to this Game Object.
+		/// </param>
+		void removeFromScenePool(
+				Honeycomb::Component::GameComponent &component);
+
+		/// <summary>
+		/// Resizes the components vector and the component mask of this Game
+		/// Object to the number of component types, if the number of component
+		/// types exceeds the components vector size.
 		/// </summary>
-		void resizeComponents() const;
+		void resizeComponents();
+
+		/// <summary>
+		/// Recalculates the cached activeness of this Game Object. If it
+		/// changed, the activeness of the components and of the children of
+		/// this Game Object is recalculated as well, recursively, so that
+		/// each change is propagated down the hierarchy only once.
+		/// </summary>
+		void updateIsActive();
+
+		/// <summary>
+		/// Updates the active components of this Game Object which may access
+		/// anything, and collects the active components which may be updated
+		/// in parallel instead of updating them. This function is recursively
+		/// called for each active child.
+		/// </summary>
+		/// <param name="parallel">
+		/// The lists of the components to be updated in parallel, at the index
+		/// of their Game Component ID, to which the components are appended.
+		/// </param>
+		void updateSequential(std::vector<std::vector<
+				Honeycomb::Component::GameComponent*>> &parallel);
 	};
 } }
 
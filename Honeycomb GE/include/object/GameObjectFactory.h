@@ -148,7 +148,8 @@ namespace Honeycomb { namespace Object {
 		/// Helper method for loading in default models. This creates an object
 		/// clone from the specified model and then fetches the child of the
 		/// specified name and deparents it from the RootNode. The independent
-		/// child is then returned.
+		/// child is then returned. Each default shape keeps a prefab of this
+		/// child, so this is only done once per shape.
 		/// </summary>
 		/// <param name="model">
 		/// The model from which the Game Object is to be cloned.
@@ -0,0 +1,107 @@
+#pragma once
+#ifndef PREFAB_H
+#define PREFAB_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GameObject.h"
+#include "../component/GameComponent.h"
+
+namespace Honeycomb { namespace Object {
+	/// <summary>
+	/// An immutable template of a Game Object hierarchy, from which any number
+	/// of instances may be created. The template is a copy of the hierarchy,
+	/// stored as a list of nodes (each parent before its children) along with
+	/// a prototype of each component, so it is independent of the Game Object
+	/// from which it was made.
+	///
+	/// Unlike cloning a Game Object, instantiating a Prefab builds the whole
+	/// hierarchy in bulk: the storage of the children of each node is
+	/// reserved up front, the components are put straight into their Game
+	/// Objects without the checks of addComponent, and the Transforms are
+	/// linked to their parents without firing their changed events. The
+	/// global transformation of each node (relative to the root) is computed
+	/// once when the Prefab is made, rather than for every instance. The
+	/// materials of the Mesh Renderers are shared by all of the instances and
+	/// copied on write, so that an instance only gets its own copy of a
+	/// material once it writes to it (see MeshRenderer::getWritableMaterial).
+	/// </summary>
+	class Prefab {
+	public:
+		/// <summary>
+		/// Initializes a new Prefab from the specified Game Object and its
+		/// descendants. The Prefab is independent of the Game Object, which
+		/// may be changed or destroyed afterwards.
+		/// </summary>
+		/// <param name="object">
+		/// The Game Object to be used as the template.
+		/// </param>
+		Prefab(const GameObject &object);
+
+		/// <summary>
+		/// No copy constructor exists for the Prefab class.
+		/// </summary>
+		Prefab(const Prefab &prefab) = delete;
+
+		/// <summary>
+		/// Returns the number of Game Objects of each instance of this Prefab.
+		/// </summary>
+		/// <returns>
+		/// The number of nodes of this Prefab.
+		/// </returns>
+		std::size_t getNodeCount() const;
+
+		/// <summary>
+		/// Creates a new instance of this Prefab. The instance will not be
+		/// parented to any Scene or Game Object, nor will it be active by
+		/// default, just like a clone of the template would.
+		/// </summary>
+		/// <returns>
+		/// The unique pointer to the root of the instance.
+		/// </returns>
+		std::unique_ptr<GameObject> instantiate() const;
+
+		/// <summary>
+		/// No assignment operator exists for the Prefab class.
+		/// </summary>
+		Prefab& operator=(const Prefab &prefab) = delete;
+	private:
+		// A Game Object of the template
+		struct Node {
+			std::string name;           // Name of the Game Object
+			int parent;                 // Index of the parent (-1 if root)
+			std::size_t firstComponent; // Index of the first prototype
+			std::size_t componentCount; // Number of prototypes
+			std::size_t childCount;     // Number of children
+			int transform;              // Index of the Transform prototype
+		};
+
+		std::vector<Node> nodes;
+		std::vector<std::unique_ptr<Honeycomb::Component::GameComponent>>
+				prototypes;
+
+		/// <summary>
+		/// Appends the specified Game Object and its descendants to the nodes
+		/// of this Prefab, each parent before its children.
+		/// </summary>
+		/// <param name="object">
+		/// The Game Object.
+		/// </param>
+		/// <param name="parent">
+		/// The index of the node of the parent, or -1 for the root.
+		/// </param>
+		void flatten(const GameObject &object, const int &parent);
+
+		/// <summary>
+		/// Computes the global transformation of the Transform prototype of
+		/// each node from the local transformations of its ancestors, as if
+		/// the root had no parent. The instances copy these, so that their
+		/// Transforms need not be recomputed when they are linked.
+		/// </summary>
+		void precomputeTransforms();
+	};
+} }
+
+#endif
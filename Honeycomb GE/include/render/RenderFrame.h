@@ -0,0 +1,150 @@
+#pragma once
+#ifndef RENDER_FRAME_H
+#define RENDER_FRAME_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../component/light/BaseLight.h"
+#include "../geometry/Mesh.h"
+#include "../graphics/Material.h"
+#include "../math/Matrix4f.h"
+#include "../math/Vector3f.h"
+#include "../shader/GenericStruct.h"
+#include "../shader/ShaderProgram.h"
+
+namespace Honeycomb { namespace Scene {
+	class GameScene;
+} }
+
+namespace Honeycomb { namespace Render {
+	/// A snapshot of everything which the renderers read from a Game Scene:
+	/// the active Mesh Renderers, the active lights and the active camera.
+	/// A frame is extracted once the scene was updated and is not changed
+	/// afterwards, so the scene may be updated again while the frame is
+	/// being rendered (even on another thread). The materials are copied
+	/// into the frame, so the game may change them while the frame is
+	/// rendered. The meshes are shared with the scene rather than copied, so
+	/// that extracting a frame stays cheap; since they may only be written
+	/// on the thread which renders (i.e. from BaseGame::render, while the
+	/// frames are exchanged), they never change while the frame is rendered.
+	class RenderFrame {
+	public:
+		// The state of a Mesh Renderer which is needed to render it
+		struct Object {
+			Honeycomb::Math::Matrix4f transform; // Global transformation
+			Honeycomb::Math::Vector3f boundsMin; // World space bounding box
+			Honeycomb::Math::Vector3f boundsMax;
+			Honeycomb::Math::Vector3f position;  // Global translation
+			bool isOddNegativelyScaled;          // Is the winding flipped?
+			bool isBatchable;                    // May it be multi drawn?
+			bool isOccluder;                     // Does it hide others?
+
+			// The meshes of the current level of detail, and the meshes of
+			// the level which is being faded out (empty if none) along with
+			// the progress of the fade.
+			std::vector<std::shared_ptr<Honeycomb::Geometry::Mesh>> meshes;
+			std::vector<std::shared_ptr<Honeycomb::Geometry::Mesh>> fading;
+			float fadeProgress;
+
+			// The meshes which are rasterized into the occlusion buffer (the
+			// finest level of detail, and only if this is an occluder).
+			std::vector<std::shared_ptr<Honeycomb::Geometry::Mesh>>
+					occluderMeshes;
+
+			// Copies of the materials, which are shared by all of the objects
+			// of this frame which use the same material.
+			std::vector<std::shared_ptr<Honeycomb::Graphics::Material>>
+					materials;
+		};
+
+		// The state of a light which is needed to render it
+		struct Light {
+			Honeycomb::Component::Light::LightType type;
+
+			// The uniforms of the light, and of its attenuation & shadow (null
+			// if the light has none).
+			Honeycomb::Shader::GenericStruct uniforms;
+			std::unique_ptr<Honeycomb::Component::Light::Attenuation>
+					attenuation;
+			std::unique_ptr<Honeycomb::Component::Light::Shadow> shadow;
+
+			Honeycomb::Math::Matrix4f transform; // Global transformation
+			Honeycomb::Math::Vector3f position;  // Global translation
+			Honeycomb::Math::Vector3f direction; // Direction of the light
+			Honeycomb::Math::Vector3f color;
+			float intensity;
+			float range;                         // Zero if unbounded
+			float angle;                         // Zero unless a spot light
+
+			/// Takes a snapshot of the specified light.
+			/// const BaseLight &light : The light.
+			Light(const Honeycomb::Component::Light::BaseLight &light);
+
+			/// Writes this light to the specified shader, exactly like the
+			/// light from which it was taken would.
+			/// ShaderProgram &shader : The shader.
+			/// const string &uni : The name of the uniform of the light.
+			void toShader(Honeycomb::Shader::ShaderProgram &shader,
+					const std::string &uni) const;
+		};
+
+		/// Instantiates a new, empty Render Frame, which has no camera.
+		RenderFrame();
+
+		/// Deinstantiates this Render Frame.
+		~RenderFrame();
+
+		/// Empties this frame, so that it has no objects, lights or camera.
+		void clear();
+
+		/// Replaces the contents of this frame with a snapshot of the active
+		/// Mesh Renderers, lights and camera of the specified scene.
+		/// GameScene &scene : The scene, which must be done updating.
+		void extract(Honeycomb::Scene::GameScene &scene);
+
+		/// Returns the uniforms of the camera of this frame. Only valid if
+		/// the frame has a camera.
+		/// return : The constant reference to the camera uniforms.
+		const Honeycomb::Shader::GenericStruct& getCamera() const;
+
+		/// Returns the projection of the camera of this frame. Only valid if
+		/// the frame has a camera.
+		/// return : The constant reference to the camera projection.
+		const Honeycomb::Math::Matrix4f& getCameraProjection() const;
+
+		/// Returns whether a camera was active when this frame was extracted.
+		/// Nothing can be rendered without one.
+		/// return : True if this frame has a camera.
+		bool getHasCamera() const;
+
+		/// Returns the lights of this frame, in the order of the scene.
+		/// return : The constant reference to the list of lights.
+		const std::vector<Light>& getLights() const;
+
+		/// Returns the objects of this frame, in no particular order.
+		/// return : The constant reference to the list of objects.
+		const std::vector<Object>& getObjects() const;
+
+		/// Renders all of the objects of this frame with the specified
+		/// shader, like GameScene::onRender renders the Mesh Renderers.
+		/// ShaderProgram &shader : The shader.
+		void renderObjects(Honeycomb::Shader::ShaderProgram &shader) const;
+	private:
+		std::vector<Object> objects;
+		std::vector<Light> lights;
+
+		// The copy of each material of the scene which the objects use. The
+		// copies are reassigned from frame to frame, rather than reallocated.
+		std::unordered_map<const Honeycomb::Graphics::Material*,
+				std::shared_ptr<Honeycomb::Graphics::Material>> materials;
+
+		// The uniforms & projection of the camera (null if there was none)
+		std::unique_ptr<Honeycomb::Shader::GenericStruct> camera;
+		Honeycomb::Math::Matrix4f cameraProjection;
+	};
+} }
+
+#endif
@@ -5,7 +5,7 @@
 #include "../geometry/Mesh.h"
 #include "../graphics/Cubemap.h"
 #include "../math/Vector4f.h"
-#include "../scene/GameScene.h"
+#include "RenderFrame.h"
 #include "../shader/ShaderProgram.h"
 
 namespace Honeycomb { namespace Component { namespace Render { 
@@ -13,8 +13,11 @@ namespace Honeycomb { namespace Component { namespace Render {
 } } };
 
 namespace Honeycomb { namespace Render {
+	class RenderingEngine;
+
 	class Renderer {
 		friend class Honeycomb::Component::Render::MeshRenderer;
+		friend class Honeycomb::Render::RenderingEngine;
 	public:
 		/// Represents the different types of Antialiasing supported by the
 		/// engine.
@@ -23,6 +26,16 @@ namespace Honeycomb { namespace Render {
 			NONE				= 1
 		};
 
+		/// Represents the per-pixel post processing effects supported by the
+		/// engine. These are applied all at once by the pass which writes the
+		/// final image to the window, in the order in which they are
+		/// declared, rather than each in a full screen pass of its own.
+		enum PostEffect {
+			TONEMAP				= 1,		// Reinhard HDR Tone Mapping
+			GRAYSCALE			= 2,		// Luminance of the Color
+			INVERSION			= 4			// One Minus the Color
+		};
+
 		/// Represents the modes used for the background of the scene
 		enum BackgroundMode {
 			SOLID_COLOR			= 0,
@@ -89,9 +102,10 @@ namespace Honeycomb { namespace Render {
 		const int& getShadowMapWidth() const;
 
 		/// Virtual method which should be overriden to render the specified
-		/// scene.
-		/// GameScene &scene : The game scene to be rendered.
-		virtual void render(Honeycomb::Scene::GameScene &scene);
+		/// frame.
+		/// const RenderFrame &frame : The snapshot of the game scene to be
+		///							   rendered.
+		virtual void render(const Honeycomb::Render::RenderFrame &frame);
 
 		/// Sets the Anti-Aliasing to the specified algorithm, or none.
 		/// const AntiAliasing &aa : The Anti-Aliasing to be used when 
@@ -127,11 +141,21 @@ namespace Honeycomb { namespace Render {
 		void setDoDepthTest(const bool &b);
 
 		/// Should the renderer post process the image according to the post
-		/// processing shaders?
+		/// processing shaders and the post effects?
 		/// const bool &b : True if the renderer should perform post processing
 		///					and false otherwise.
 		void setDoPostProcess(const bool &b);
 
+		/// Should the renderer apply the specified per-pixel effect to the
+		/// final image? Unlike the post processing shaders, the effects do
+		/// not cost a full screen pass each. The post processing shaders
+		/// should therefore be left to effects which read the neighbors of
+		/// each pixel (such as blurring or sharpening).
+		/// const PostEffect &e : The effect.
+		/// const bool &b : True if the effect should be applied, false
+		///					otherwise.
+		void setDoPostEffect(const PostEffect &e, const bool &b);
+
 		/// Sets the winding order of the Front Face of a polygon.
 		/// const WindingOrder &w : The winding order (either clockwise or
 		///							counterclockwise).
@@ -157,13 +181,21 @@ namespace Honeycomb { namespace Render {
 	protected:
 		static Renderer *renderer; // Singleton Instance
 
+		// The frame which is being rendered (only valid within render)
+		const Honeycomb::Render::RenderFrame *frame;
+
 		// Antialiasing Variables
 		AntiAliasing antiAliasing;
 		Honeycomb::Shader::ShaderProgram fxaaShader;
 
-		// Color Space Variables
+		// Color Space Variables, and the shader which writes the final image
+		// to the window with the gamma correction and the post effects.
 		ColorSpace colorSpace;
-		Honeycomb::Shader::ShaderProgram gammaShader;
+		Honeycomb::Shader::ShaderProgram finalShader;
+
+		// Full screen quad which is rendered with a texture when post
+		// processing and when rendering the final image to the screen
+		std::unique_ptr<Honeycomb::Geometry::Mesh> quad;
 
 		// Properties for a Background Color & Skybox
 		BackgroundMode backgroundMode;
@@ -192,6 +224,7 @@ namespace Honeycomb { namespace Render {
 		// Shaders for post processing the Final Image
 		std::vector<Honeycomb::Shader::ShaderProgram> postShaders;
 		bool doPostProcess;
+		int postEffects; // Bitmask of the enabled PostEffect values
 
 		// Face culling variables
 		PolygonFace cullingFace;
@@ -216,14 +249,17 @@ namespace Honeycomb { namespace Render {
 		/// Initializes the dependencies of the Cubemap (Mesh and Shaders).
 		void initializeCubemapDependencies();
 
-		/// Initializes the Shader used by the Gamma Correction Post Processing
-		/// color spacec algorithm.
-		void initializeGammaShader();
+		/// Initializes the Shader which writes the final image to the window,
+		/// applying the Gamma Correction and the post effects.
+		void initializeFinalShader();
 
 		/// Initializes the Shader used by the Fast Approximate Anti Aliasing
 		/// (FXAA).
 		void initializeFXAAShader();
 
+		/// Initializes the full screen Quad Mesh.
+		void initializeQuad();
+
 		/// Initializes the dependencies of the Shadow Map.
 		void initializeShadowMapDependencies();
 
@@ -238,6 +274,13 @@ namespace Honeycomb { namespace Render {
 		/// Sets the value of the gamma to be used for non-linear color space.
 		/// const float &g : The gamma value.
 		virtual void setGamma(const float &g);
+
+		/// Writes the post effects which are to be applied to the final image
+		/// to the specified shader (which includes postEffects.glsl). No
+		/// effects are applied if post processing is disabled.
+		/// ShaderProgram &shader : The shader.
+		void writePostEffectsToShader(Honeycomb::Shader::ShaderProgram
+				&shader);
 	};
 } }
 
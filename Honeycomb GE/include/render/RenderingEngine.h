@@ -2,12 +2,19 @@
 #ifndef RENDERING_ENGINE
 #define RENDERING_ENGINE
 
+#include "RenderFrame.h"
 #include "Renderer.h"
 #include "../scene/GameScene.h"
 
 namespace Honeycomb { namespace Render {
 	enum RenderingType {
-		TYPE_DEFERRED_RENDERER
+		TYPE_DEFERRED_RENDERER,
+
+		// The Forward+ renderer only renders the shadow of the first
+		// directional or spot light which casts one; the other lights of the
+		// frame are shaded without their shadows. Neither renderer supports
+		// transparency.
+		TYPE_FORWARD_PLUS_RENDERER
 	};
 
 	class RenderingEngine {
@@ -18,19 +25,27 @@ namespace Honeycomb { namespace Render {
 		/// return : A pointer to the Rendering Engine singleton.
 		static RenderingEngine* getRenderingEngine();
 
-		/// Renders the specified scene using the render stored in this
+		/// Renders the specified frame using the renderer stored in this
 		/// Rendering Engine.
+		/// const RenderFrame &frame : The snapshot of the game scene to be
+		///							   rendered.
+		void render(const Honeycomb::Render::RenderFrame &frame);
+
+		/// Extracts a frame from the specified scene and renders it using the
+		/// renderer stored in this Rendering Engine.
 		/// GameScene &scene : The game scene to be rendered.
 		void render(Honeycomb::Scene::GameScene &scene);
 
 		/// Sets the rendering type which this rendering engine should use when
-		/// rendering.
+		/// rendering (see RenderingType for what each renderer supports).
 		/// const RenderingType &type : The type of rendering to be used.
 		void setRenderingType(const RenderingType &type);
 	private:
 		static RenderingEngine *renderingEngine; // Singleton Instance
 
 		Honeycomb::Render::Renderer *renderer; // Renderer to be used
+		RenderingType type;                    // Type of the renderer
+		Honeycomb::Render::RenderFrame frame;  // Frame extracted by render
 
 		/// Initializes a new instance of the Rendering Engine. The default
 		/// rendering type will be set to LEGACY_FORWARD_RENDERER.
@@ -0,0 +1,40 @@
+#pragma once
+#ifndef TEXTURE_UNIT_H
+#define TEXTURE_UNIT_H
+
+namespace Honeycomb { namespace Render {
+	/// The texture units which are reserved by the renderers, the batches
+	/// and the Material Table. The units below TEXTURE_UNIT_RESERVED are
+	/// left to the materials (which bind their samplers from unit zero), the
+	/// G Buffer textures and the shadow map of the light passes. Samplers of
+	/// different types may not share a unit within a shader, so every
+	/// reserved sampler has a unit of its own.
+	enum TextureUnit {
+		// The first of the reserved units
+		TEXTURE_UNIT_RESERVED				= 16,
+
+		// The shadow map sampled by the Forward+ shader
+		TEXTURE_UNIT_FORWARD_SHADOW_MAP		= 16,
+
+		// The light data, light grid & light indices of the Forward+
+		// Renderer
+		TEXTURE_UNIT_LIGHT_DATA				= 17,
+		TEXTURE_UNIT_LIGHT_GRID				= 18,
+		TEXTURE_UNIT_LIGHT_INDICES			= 19,
+
+		// The pages of the Material Table (MaterialTable::PAGE_COUNT units,
+		// which directly precede the unit of the table itself)
+		TEXTURE_UNIT_MATERIAL_PAGES			= 20,
+		TEXTURE_UNIT_MATERIAL_TABLE			= 28,
+
+		// The depth pyramid read by the culling compute shader, and the
+		// transforms of the Multi-Draw Batch
+		TEXTURE_UNIT_HI_Z					= 29,
+		TEXTURE_UNIT_TRANSFORMS				= 30,
+
+		// The skybox cubemap reflected by the surfaces
+		TEXTURE_UNIT_SKYBOX					= 31
+	};
+} }
+
+#endif
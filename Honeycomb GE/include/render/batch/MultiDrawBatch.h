@@ -0,0 +1,193 @@
+#pragma once
+#ifndef MULTI_DRAW_BATCH_H
+#define MULTI_DRAW_BATCH_H
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "../TextureUnit.h"
+#include "../culling/HiZBuffer.h"
+#include "../../base/GLItem.h"
+#include "../../graphics/Material.h"
+#include "../../graphics/MaterialTable.h"
+#include "../../math/Matrix4f.h"
+#include "../../render/RenderFrame.h"
+#include "../../shader/ShaderProgram.h"
+
+namespace Honeycomb { namespace Render { namespace Batch {
+	class MultiDrawBatch : public Honeycomb::Base::GLItem {
+	public:
+		/// Returns whether the graphics card supports the indirect multi-draw
+		/// calls (with a base instance) on which the batch relies.
+		/// return : True if batches may be rendered, false otherwise.
+		static bool isSupported();
+
+		/// Returns whether the graphics card supports the compute shaders and
+		/// shader storage buffers with which the batch is culled.
+		/// return : True if batches may be culled, false otherwise.
+		static bool isCullingSupported();
+
+		/// Writes the texture units of the transforms and of the Material
+		/// Table to the specified shader. Samplers of different types may not
+		/// share a unit, so this must be done once for every shader which
+		/// includes stdTransformVS.glsl or stdMaterialTable.glsl, before it
+		/// renders anything (including the objects which are not batched).
+		/// ShaderProgram &shader : The shader.
+		static void setTextureUnits(Honeycomb::Shader::ShaderProgram &shader);
+
+		/// Instantiates a new, empty Multi-Draw Batch.
+		MultiDrawBatch();
+
+		/// Deinstantiates this Multi-Draw Batch.
+		~MultiDrawBatch();
+
+		/// Adds the meshes of the current level of detail of the specified
+		/// object to this batch, if the object may be batched. The draws
+		/// whose materials can be stored in the Material Table are grouped
+		/// together, and the others are grouped by material, in the order in
+		/// which they were added. The batch must be rendered before the
+		/// meshes or the materials of the object change.
+		/// const RenderFrame::Object &object : The object to be batched.
+		/// return : True if the object was batched, false if it must be
+		///			 rendered on its own.
+		bool add(const Honeycomb::Render::RenderFrame::Object &object);
+
+		/// Removes all of the draws from this batch. The storage of the batch
+		/// is kept so that it may be refilled without any allocations.
+		void clear();
+
+		/// Culls the draws of this batch on the graphics card, without any
+		/// read back. A compute shader tests the bounds of each draw against
+		/// the view frustum and, if a Hierarchical Depth Buffer is specified,
+		/// against its depth pyramid. The visible commands are compacted per
+		/// material if the graphics card supports indirect draw counts, and
+		/// are otherwise kept in place with zero instances. The following
+		/// renders of the batch only draw the visible draws, until the batch
+		/// is culled again or cleared, so a batch which is drawn from several
+		/// views (e.g. the camera and then each shadow casting light) must be
+		/// culled before the passes of each view. This does nothing if
+		/// culling is not supported.
+		/// const Matrix4f &proj : The projection of the camera.
+		/// const HiZBuffer *hiZ : The buffer whose depth pyramid occludes
+		///						   the draws, or null if the draws are only
+		///						   to be culled against the frustum.
+		void cull(const Honeycomb::Math::Matrix4f &proj,
+				const Honeycomb::Render::Culling::HiZBuffer *hiZ = nullptr);
+
+		/// Destroys the buffers, the textures, the Material Table and the
+		/// shader of this batch.
+		void destroy();
+
+		/// Returns the number of meshes which are drawn by this batch.
+		/// return : The number of draws.
+		const std::size_t& getDrawCount() const;
+
+		/// Initializes the buffers, the textures, the Material Table and the
+		/// shader of this batch.
+		void initialize();
+
+		/// Renders all of the draws of this batch from the buffers of the
+		/// Geometry Arena, with one indirect multi-draw call for all of the
+		/// draws whose materials are in the Material Table, and one call per
+		/// material for the other draws. The transform & material of each
+		/// draw are fetched by the shaders from buffer textures, using the
+		/// draw data which is indexed by the base instance of its command
+		/// (see stdTransformVS.glsl and stdMaterialTable.glsl). The draws and
+		/// transforms are uploaded on the first render after they change.
+		/// ShaderProgram &shader : The shader with which the batch is to be
+		///							rendered.
+		/// const bool &doMaterials : Should the materials be written to the
+		///							  shader? If not (e.g. for depth only
+		///							  passes), all of the draws are issued
+		///							  with a single call, unless the culled
+		///							  commands were compacted.
+		void render(Honeycomb::Shader::ShaderProgram &shader,
+				const bool &doMaterials = true);
+	private:
+		// The layout of a command of glMultiDrawElementsIndirect
+		struct DrawCommand {
+			unsigned int count;			// Number of indices
+			unsigned int instanceCount;	// Number of instances (0 if culled)
+			unsigned int firstIndex;	// First index within the arena
+			int baseVertex;				// Base vertex within the arena
+			unsigned int baseInstance;	// Index of the draw data
+		};
+
+		// The data of a command which is read by the shaders
+		struct DrawData {
+			int transform;				// Index of the transform
+			int material;				// Index in the Material Table (or -1)
+		};
+
+		// The data with which a command is culled (see cullDrawsCS.glsl)
+		struct DrawCullData {
+			float boundsMin[3];			// Local bounds of the mesh
+			unsigned int bucket;		// Index of the bucket of the draw
+			float boundsMax[3];
+			unsigned int bucketOffset;	// First command of the bucket
+		};
+
+		// The draws which share a material, or whose materials are all in the
+		// Material Table (in which case the material is null), with the data
+		// with which each draw is culled & shaded, and the position of their
+		// first command within the command buffer.
+		struct Bucket {
+			const Honeycomb::Graphics::Material *material;
+			std::vector<DrawCommand> commands;
+			std::vector<DrawCullData> cullData;
+			std::vector<DrawData> draws;
+			std::size_t offset;
+		};
+
+		// The number of draws culled by each compute shader work group
+		const static int CULL_GROUP_SIZE;
+
+		// The buckets of the draws (only the first bucketCount are in use)
+		// and the index of the bucket of each material.
+		std::vector<Bucket> buckets;
+		std::size_t bucketCount;
+		std::unordered_map<const Honeycomb::Graphics::Material*, std::size_t>
+				bucketIndices;
+
+		// The rows of the transform of each draw, the flattened commands,
+		// cull data & draw data, the number of draws and the materials of
+		// the draws.
+		std::vector<float> transforms;
+		std::vector<DrawCommand> commands;
+		std::vector<DrawCullData> cullData;
+		std::vector<DrawData> drawData;
+		std::size_t drawCount;
+		Honeycomb::Graphics::MaterialTable materialTable;
+		bool isUploaded; // Were the draws written to the buffers?
+
+		// Were the draws culled since they were last changed, and were the
+		// visible commands compacted (rather than kept in place)?
+		bool isCulled;
+		bool isCompacted;
+
+		// The buffer of the commands, the buffer holding the data of each
+		// command (an instanced attribute), and the buffer & buffer texture
+		// of the transforms, along with the number of draws which they fit.
+		int commandBuffer;
+		int drawDataBuffer;
+		int transformBuffer;
+		int transformTexture;
+		std::size_t capacity;
+
+		// The buffer of the cull data, the buffer into which the culled
+		// commands are written, the buffer of the number of visible commands
+		// of each bucket and the shader which culls the commands.
+		int cullDataBuffer;
+		int culledCommandBuffer;
+		int drawCountBuffer;
+		Honeycomb::Shader::ShaderProgram cullShader;
+
+		/// Writes the commands, transforms, cull data and draw data of the
+		/// draws to the buffers, growing the buffers if the draws do not
+		/// fit.
+		void upload();
+	};
+} } }
+
+#endif
@@ -0,0 +1,138 @@
+#pragma once
+#ifndef HI_Z_BUFFER_H
+#define HI_Z_BUFFER_H
+
+#include <vector>
+
+#include "../../base/GLItem.h"
+#include "../../geometry/Mesh.h"
+#include "../../graphics/Texture2D.h"
+#include "../../math/Matrix4f.h"
+#include "../../math/Vector3f.h"
+#include "../../shader/ShaderProgram.h"
+
+namespace Honeycomb { namespace Render { namespace Culling {
+	class HiZBuffer : public Honeycomb::Base::GLItem {
+	public:
+		/// Instantiates a blank Hierarchical Depth Buffer.
+		HiZBuffer();
+
+		/// Deinstantiates this Hierarchical Depth Buffer.
+		~HiZBuffer();
+
+		/// Destroys the pyramid texture, the frame buffer, the read back
+		/// buffers and the shader of this Hierarchical Depth Buffer.
+		void destroy();
+
+		/// Returns whether the depth pyramid has been built since the buffer
+		/// was (re)sized, i.e. whether its levels hold any depths.
+		/// return : True if the depth pyramid may be sampled.
+		const bool& getHasPyramid() const;
+
+		/// Returns the camera projection with which the depths of the depth
+		/// pyramid were rendered.
+		/// return : The projection of the depth pyramid.
+		const Honeycomb::Math::Matrix4f& getPyramidProjection() const;
+
+		/// Returns the raw pointer of the depth pyramid texture, whose levels
+		/// store the farthest depth of the 2x2 texel blocks of the previous
+		/// level. The depths are never more than a frame old, so they may be
+		/// sampled on the graphics card to cull the next frame.
+		/// return : The depth pyramid texture pointer.
+		const int& getPyramidTexture() const;
+
+		/// Initializes this Hierarchical Depth Buffer. The depth pyramid
+		/// must be sized with resize() before it is first built.
+		void initialize();
+
+		/// Returns whether an axis aligned bounding box may be visible, by
+		/// testing its nearest depth against the farthest depths stored by
+		/// the depth pyramid which was last read back from the graphics card.
+		/// Since the depths are read back asynchronously, they are typically
+		/// one or two frames old, and the box is projected using the camera
+		/// projection with which the depths were rendered. The test is
+		/// conservative: if no depths are available or the box is (partially)
+		/// behind the old camera or outside of its screen, the box is always
+		/// visible.
+		/// const Vector3f &min : The minimum corner of the box, in world
+		///						  space.
+		/// const Vector3f &max : The maximum corner of the box, in world
+		///						  space.
+		/// return : True if the box may be visible, false if it is
+		///			 certainly occluded.
+		bool isVisible(const Honeycomb::Math::Vector3f &min,
+				const Honeycomb::Math::Vector3f &max) const;
+
+		/// Allocates the depth pyramid texture and the read back buffers for
+		/// a depth texture of the specified size, so that the finest level
+		/// is half of its size. Any previously read back depths are
+		/// discarded, unless the size has not changed, in which case nothing
+		/// is done.
+		/// const int &width : The width of the depth texture, in texels.
+		/// const int &height : The height of the depth texture, in texels.
+		void resize(const int &width, const int &height);
+
+		/// Builds the depth pyramid from the specified depth texture, whose
+		/// size must be the size with which this buffer was last resized, and
+		/// starts reading back its coarsest levels from the graphics card.
+		/// The depths which were read back in the previous frames are made
+		/// available to the visibility test, if they are ready. This changes
+		/// the bound frame buffer and the viewport.
+		/// const Texture2D &depth : The depth texture from which the pyramid
+		///							 is to be built.
+		/// const Matrix4f &proj : The camera projection with which the depth
+		///						   texture was rendered.
+		/// const Mesh &quad : The full screen quad used to draw each level.
+		void update(const Honeycomb::Graphics::Texture2D &depth,
+				const Honeycomb::Math::Matrix4f &proj,
+				const Honeycomb::Geometry::Mesh &quad);
+	private:
+		// Maximum width of the level which is read back to the CPU
+		const static int READ_BACK_MAX_WIDTH;
+
+		// Number of read back buffers (the buffer written to in one frame is
+		// read from in the next frame).
+		const static int READ_BACK_BUFFERS = 2;
+
+		// Depth pyramid texture and the frame buffer used to draw its levels,
+		// along with the size of the depth texture from which it is built.
+		int pyramidTexture;
+		int frameBuffer;
+		int sourceWidth;
+		int sourceHeight;
+		std::vector<int> levelWidths;
+		std::vector<int> levelHeights;
+		Honeycomb::Math::Matrix4f pyramidProjection;
+		bool hasPyramid;
+
+		// Shader which writes the farthest depth of each 2x2 texel block
+		Honeycomb::Shader::ShaderProgram downsampleShader;
+
+		// Pixel buffers into which the read back level is copied, the fences
+		// which are signaled once the copies have completed and the
+		// projections with which the copied depths were rendered.
+		int readBackBuffers[READ_BACK_BUFFERS];
+		void *readBackFences[READ_BACK_BUFFERS];
+		Honeycomb::Math::Matrix4f readBackProjections[READ_BACK_BUFFERS];
+		int readBackLevel;
+		int readBackIndex;
+
+		// The depth levels read back from the graphics card, from the finest
+		// (the read back level) to the coarsest (1x1), along with their
+		// sizes and the projection with which they were rendered.
+		std::vector<std::vector<float>> cpuLevels;
+		std::vector<int> cpuWidths;
+		std::vector<int> cpuHeights;
+		Honeycomb::Math::Matrix4f cpuProjection;
+		bool hasCpuLevels;
+
+		/// Builds the coarser CPU depth levels from the finest CPU level.
+		void buildCpuLevels();
+
+		/// Copies the read back level, if its copy has completed, from the
+		/// oldest read back buffer into the CPU depth levels.
+		void collectReadBack();
+	};
+} } }
+
+#endif
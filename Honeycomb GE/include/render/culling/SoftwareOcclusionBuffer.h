@@ -0,0 +1,118 @@
+#pragma once
+#ifndef SOFTWARE_OCCLUSION_BUFFER_H
+#define SOFTWARE_OCCLUSION_BUFFER_H
+
+#include <vector>
+
+#include "../../geometry/Mesh.h"
+#include "../../math/Matrix4f.h"
+#include "../../math/Vector3f.h"
+
+namespace Honeycomb { namespace Render { namespace Culling {
+	class SoftwareOcclusionBuffer {
+	public:
+		/// Instantiates a new, empty Software Occlusion Buffer.
+		SoftwareOcclusionBuffer();
+
+		/// Transforms the triangles of the specified occluder mesh into the
+		/// screen space of this buffer and bins them into the screen tiles
+		/// which they overlap. The triangles are not rasterized until
+		/// rasterize() is called. Triangles which cross the near plane are
+		/// skipped, since skipping an occluder is always conservative. The
+		/// rasterization is conservative as well: a triangle only writes the
+		/// pixels which it covers entirely, with its farthest depth within
+		/// each pixel. The pixels along the edges shared by two triangles are
+		/// therefore left uncovered, which culls less, but never wrongly.
+		/// const Mesh &mesh : The occluder mesh, whose vertices and indices
+		///					   are read from its CPU copy.
+		/// const Matrix4f &transform : The transformation of the mesh.
+		void addOccluder(const Honeycomb::Geometry::Mesh &mesh,
+				const Honeycomb::Math::Matrix4f &transform);
+
+		/// Clears the depths and the occluders of this buffer and sets the
+		/// projection and the resolution with which the next occluders are
+		/// rasterized. The depth storage is only reallocated if the
+		/// resolution changes.
+		/// const Matrix4f &proj : The camera projection.
+		/// const int &width : The width of the buffer, in pixels.
+		/// const int &height : The height of the buffer, in pixels.
+		void clear(const Honeycomb::Math::Matrix4f &proj, const int &width,
+				const int &height);
+
+		/// Returns the depth stored at the specified pixel of this buffer.
+		/// The depth is in the [0, 1] range, with 1 being the far plane.
+		/// const int &x : The column of the pixel.
+		/// const int &y : The row of the pixel, starting at the bottom.
+		/// return : The depth of the pixel.
+		float getDepth(const int &x, const int &y) const;
+
+		/// Returns the height of this buffer.
+		/// return : The height, in pixels.
+		const int& getHeight() const;
+
+		/// Returns the width of this buffer.
+		/// return : The width, in pixels.
+		const int& getWidth() const;
+
+		/// Returns whether an axis aligned bounding box may be visible, by
+		/// testing its nearest depth against the rasterized occluder depths
+		/// of all of the pixels which its screen rectangle touches. Boxes
+		/// outside of the screen are not visible, and boxes which cross the
+		/// near plane always are.
+		/// const Vector3f &min : The minimum corner of the box, in world
+		///						  space.
+		/// const Vector3f &max : The maximum corner of the box, in world
+		///						  space.
+		/// return : True if the box may be visible, false if it is
+		///			 certainly hidden.
+		bool isVisible(const Honeycomb::Math::Vector3f &min,
+				const Honeycomb::Math::Vector3f &max) const;
+
+		/// Rasterizes the binned occluder triangles into the depth buffer.
+		/// Each screen tile is rasterized by a job of the Job System, so
+		/// each tile is written by a single thread.
+		void rasterize();
+	private:
+		// Width & Height of a screen tile, in pixels. The width must be a
+		// multiple of four, since four pixels are rasterized at once.
+		const static int TILE_WIDTH;
+		const static int TILE_HEIGHT;
+
+		// A screen space triangle, stored as its three edge functions, its
+		// depth plane and its clamped pixel bounds. The edges are moved in
+		// and the depth plane back by half a pixel, so that evaluating them
+		// at a pixel center gives the inner coverage & farthest depth.
+		struct Triangle {
+			float edgeA[3];	// Edge function: A * x + B * y + C >= 0 inside
+			float edgeB[3];
+			float edgeC[3];
+
+			float depth;	// Depth at the origin of the screen
+			float depthDx;	// Change in depth per pixel in x
+			float depthDy;	// Change in depth per pixel in y
+
+			int minX, maxX;	// The inclusive pixel bounds
+			int minY, maxY;
+		};
+
+		Honeycomb::Math::Matrix4f projection; // The camera projection
+
+		// Size of the buffer and of its padded rows (a whole number of tiles)
+		int width;
+		int height;
+		int stride;
+		int tilesX;
+		int tilesY;
+
+		std::vector<float> depths; // Depth of each pixel (row major)
+		std::vector<Triangle> triangles; // Triangles of all of the occluders
+		std::vector<std::vector<int>> tileBins; // Triangle indices per tile
+		std::vector<float> screenVerts; // Scratch screen space vertices
+
+		/// Rasterizes all of the triangles binned into the specified tile.
+		/// const int &tile : The index of the tile.
+		void rasterizeTile(const int &tile);
+	};
+} } }
+
+#endif
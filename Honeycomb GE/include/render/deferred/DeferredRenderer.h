@@ -2,9 +2,17 @@
 #ifndef DEFERRED_RENDERER_H
 #define DEFERRED_RENDERER_H
 
+#include <utility>
+#include <vector>
+
 #include "GBuffer.h"
 #include "../Renderer.h"
+#include "../culling/HiZBuffer.h"
+#include "../culling/SoftwareOcclusionBuffer.h"
+#include "../graph/FrameGraph.h"
 
+#include "../batch/MultiDrawBatch.h"
+#include "../../conjuncture/EventHandler.h"
 #include "../../geometry/Mesh.h"
 
 namespace Honeycomb { namespace Render { namespace Deferred {
@@ -16,6 +24,8 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 			NORMAL					= GBufferTextureType::NORMAL,
 
 			MATERIAL				= GBufferTextureType::MATERIAL,
+			MATERIAL_AMBIENT		= GBufferTextureType::MATERIAL_AMBIENT,
+			MATERIAL_SPECULAR		= GBufferTextureType::MATERIAL_SPECULAR,
 
 			DEPTH					= GBufferTextureType::DEPTH,
 
@@ -25,14 +35,85 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 			VARIANCE_SHADOW_MAP
 		};
 
+		// Enum representing how the occluded objects are culled.
+		enum OcclusionCulling {
+			OCCLUSION_CULLING_NONE,		// Render all objects
+			OCCLUSION_CULLING_HI_Z,		// Test against the previous frames'
+										// GPU depth (no setup required)
+			OCCLUSION_CULLING_SOFTWARE	// Test against the occluder meshes
+										// rasterized on the CPU this frame
+		};
+
+		// Event Handler for the Window Resize Event
+		Honeycomb::Conjuncture::EventHandler windowResizeHandler;
+
 		/// Returns the Deferred Renderer singleton instance.
 		/// return : A pointer to the singleton instance of the Deferred
 		///			 Renderer structure.
 		static DeferredRenderer* getDeferredRenderer();
 
-		/// Renders the specified Game Scene using this Deferred Renderer.
-		/// GameScene &scene : The scene which is to be rendered.
-		void render(Honeycomb::Scene::GameScene &scene);
+		/// Returns the layout of the textures of the G Buffer used by this
+		/// Deferred Renderer.
+		/// return : The G Buffer layout.
+		const GBufferLayout& getGBufferLayout() const;
+
+		/// Returns the fraction of the window size at which the geometry and
+		/// the lights are currently rendered.
+		/// return : The render scale, in (0, 1].
+		const float& getRenderScale() const;
+
+		/// Renders the specified frame using this Deferred Renderer.
+		/// const RenderFrame &frame : The snapshot of the scene which is to
+		///							   be rendered.
+		void render(const Honeycomb::Render::RenderFrame &frame);
+
+		/// Should the renderer write the depth of the geometry in a separate
+		/// pass before the geometry pass? The prepass draws the geometry
+		/// front to back with a minimal shader, after which the geometry pass
+		/// only shades the visible fragment of each pixel (GL_EQUAL depth
+		/// test). This is worth it for scenes with a lot of overdraw.
+		/// const bool &b : True if the depth prepass should be performed,
+		///					false otherwise.
+		void setDoDepthPrepass(const bool &b);
+
+		/// Should the renderer adjust the render scale by itself to hold the
+		/// target frame rate? The time which the graphics card spends on
+		/// each frame is measured with timer queries (read back a few frames
+		/// later, so that the renderer never waits for them), and the scale
+		/// is lowered as soon as the frames are too slow, and raised back
+		/// one step at a time once they are comfortably fast. The scale is
+		/// only changed in steps, and only after the previous change shows
+		/// in the measurements, so that the G Buffer is rarely reallocated.
+		/// const bool &b : True if the render scale should be dynamic, false
+		///					if it should stay as it is.
+		void setDoDynamicResolution(const bool &b);
+
+		/// Should the renderer cull the multi-drawn mesh renderers on the
+		/// graphics card? A compute shader tests each batched draw against
+		/// the view frustum (and the depth pyramid, if the occlusion culling
+		/// mode is HI_Z) and writes the visible draws into the indirect draw
+		/// buffer, so the CPU never tests those mesh renderers itself. The
+		/// batch is culled again against each light which renders a shadow
+		/// map. The mesh renderers which are not batched are still culled on
+		/// the CPU, and the batched mesh renderers are no longer sorted front
+		/// to back for the depth prepass.
+		/// This has no effect if multi-draw is disabled or if the graphics
+		/// card does not support compute shaders, in which case all of the
+		/// mesh renderers are culled on the CPU.
+		/// const bool &b : True if the batch should be culled on the GPU,
+		///					false otherwise.
+		void setDoGpuCulling(const bool &b);
+
+		/// Should the renderer draw the geometry of the mesh renderers whose
+		/// meshes are stored in the Geometry Arena with indirect multi-draw
+		/// calls? The draws are grouped by material, so the geometry pass
+		/// only issues one draw call per material, rather than one per mesh.
+		/// The other mesh renderers are still drawn one by one. This has no
+		/// effect if the graphics card does not support indirect multi-draw
+		/// calls.
+		/// const bool &b : True if the geometry should be batched, false
+		///					otherwise.
+		void setDoMultiDrawIndirect(const bool &b);
 
 		/// Sets the final texture which will be rendered to the screen after
 		/// the entire Deferred Renderer pipeline. Do note that the lights will
@@ -40,25 +121,131 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		/// mode is IGNORED for the DEPTH Texture.
 		/// const FinalTexture &fin : The final texture to be rendered.
 		void setFinalTexture(const FinalTexture &fin);
+
+		/// Sets the layout of the textures of the G Buffer used by this
+		/// Deferred Renderer. The compact layout reconstructs the position
+		/// from the depth buffer and stores the normals and material in 
+		/// smaller textures, which roughly halves the G Buffer bandwidth.
+		/// const GBufferLayout &layout : The G Buffer layout to be used.
+		void setGBufferLayout(const GBufferLayout &layout);
+
+		/// Sets how the renderer skips the objects which are hidden behind
+		/// other objects. The bounding box of each object is tested against
+		/// a depth buffer before anything is submitted to the graphics card.
+		/// 
+		/// HI_Z: The depth of each frame is downsampled into a Hierarchical
+		/// Depth Buffer and read back asynchronously. Since the depths are a
+		/// frame or two old, objects which are disoccluded by fast camera or
+		/// object motion may appear a frame late.
+		/// 
+		/// SOFTWARE: The meshes of the mesh renderers marked as occluders are
+		/// rasterized into a small depth buffer on the CPU, every frame. This
+		/// has no latency, but only the occluders can hide other objects.
+		/// const OcclusionCulling &mode : The occlusion culling mode.
+		void setOcclusionCulling(const OcclusionCulling &mode);
+
+		/// Sets the fraction of the window size at which the geometry and
+		/// the lights are rendered. The post processing is also done at this
+		/// size, after which the final image is upscaled to the window with
+		/// a bicubic filter. If the resolution is dynamic, this is only the
+		/// scale from which the renderer starts adjusting.
+		/// const float &scale : The render scale, which is clamped to
+		///						 [MIN_RENDER_SCALE, 1].
+		void setRenderScale(const float &scale);
+
+		/// Sets the frame rate which the dynamic resolution tries to hold.
+		/// Only the time which the graphics card spends rendering the scene
+		/// is measured, so some headroom should be left for the rest of the
+		/// frame.
+		/// const float &fps : The target frame rate, in frames per second.
+		void setTargetFrameRate(const float &fps);
 	private:
 		static DeferredRenderer *deferredRenderer; // Singleton instance
 
 		const static int SHADOW_MAP_INDEX; // Index of Shadow Map Sampler2D
 
+		// Width of the Software Occlusion Buffer (the height is derived from
+		// the aspect ratio of the window).
+		const static int SOFTWARE_OCCLUSION_WIDTH;
+
+		// The lowest render scale and the steps in which the dynamic
+		// resolution changes the scale.
+		const static float MIN_RENDER_SCALE;
+		const static float RENDER_SCALE_STEP;
+
+		// The number of timer queries used in turn to measure the frame time,
+		// the weight of each new measurement in the smoothed frame time, and
+		// the fraction of the target frame time under which the scale is
+		// raised.
+		const static int FRAME_QUERY_COUNT;
+		const static float FRAME_TIME_SMOOTHING;
+		const static float FRAME_TIME_RAISE_THRESHOLD;
+
 		// The directories of the Point and Spot Lights Volume models
 		const static std::string POINT_LIGHT_VOLUME_MODEL;
 		const static std::string SPOT_LIGHT_VOLUME_MODEL;
 
-		// Full screen quad which is rendered with a GBuffer's texture
-		std::unique_ptr<Honeycomb::Geometry::Mesh> quad;
-
 		GBuffer gBuffer; // The G Buffer of the Renderer
+
+		// The passes of the frame, which owns the transient post processing
+		// textures.
+		Honeycomb::Render::Graph::FrameGraph frameGraph;
 		FinalTexture final; // The texture which will be rendered to screen
 
-		// Geometry, Full Screen Quad and Stencil Shaders
+		// Should the depth prepass be rendered and how are the occluded mesh
+		// renderers culled?
+		bool doDepthPrepass;
+		OcclusionCulling occlusionCulling;
+		bool doMultiDrawIndirect; // Are the mesh renderers batched?
+		bool doGpuCulling; // Is the batch culled on the graphics card?
+
+		// Is the render scale adjusted to hold the target frame time? (both
+		// frame times are in milliseconds, and the smoothed one is negative
+		// until the first measurement is read)
+		bool doDynamicResolution;
+		float targetFrameTime;
+		float frameTime;
+
+		// The timer queries of the last frames, the index of the query of
+		// the next frame, the number of queries which were issued (up to
+		// FRAME_QUERY_COUNT) and the number of frames since the render scale
+		// was last changed.
+		std::vector<int> frameQueries;
+		int frameQueryIndex;
+		int frameQueryCount;
+		int framesSinceRescale;
+
+		// The Hierarchical Depth Buffer and the Software Occlusion Buffer
+		// against which objects are culled.
+		Honeycomb::Render::Culling::HiZBuffer hiZBuffer;
+		Honeycomb::Render::Culling::SoftwareOcclusionBuffer softwareBuffer;
+
+		// The objects which are to be rendered this frame, along with their
+		// depths (used for sorting them when the depth prepass is on). The
+		// list is rebuilt each frame but its storage is reused.
+		std::vector<std::pair<float, const Honeycomb::Render::RenderFrame::
+				Object*>> renderQueue;
+
+		// The batch of the queued objects which may be multi-drawn, and the
+		// queued objects which must be rendered on their own.
+		Honeycomb::Render::Batch::MultiDrawBatch multiDrawBatch;
+		std::vector<const Honeycomb::Render::RenderFrame::Object*>
+				unbatchedQueue;
+
+		// Does the batch hold every batchable object of the frame (rather
+		// than only the visible ones), so that it may be culled on the
+		// graphics card for each shadow map? The objects of the frame which
+		// are not in the batch are culled on the CPU for each shadow map.
+		bool isBatchHoldingFrame;
+		std::vector<const Honeycomb::Render::RenderFrame::Object*>
+				shadowQueue;
+
+		// Depth, Geometry, Full Screen Quad and Stencil Shaders
+		Honeycomb::Shader::ShaderProgram depthShader;
 		Honeycomb::Shader::ShaderProgram geometryShader;
 		Honeycomb::Shader::ShaderProgram quadShader;
 		Honeycomb::Shader::ShaderProgram stencilShader;
+		Honeycomb::Shader::ShaderProgram upscaleShader;
 		
 		// Shaders used by all of the lights
 		Honeycomb::Shader::ShaderProgram ambientShader;
@@ -66,6 +253,13 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		Honeycomb::Shader::ShaderProgram directionalLightShader;
 		Honeycomb::Shader::ShaderProgram spotLightShader;
 
+		// Geometry and light shaders used by the compact G Buffer layout
+		Honeycomb::Shader::ShaderProgram geometryCompactShader;
+		Honeycomb::Shader::ShaderProgram ambientCompactShader;
+		Honeycomb::Shader::ShaderProgram pointLightCompactShader;
+		Honeycomb::Shader::ShaderProgram directionalLightCompactShader;
+		Honeycomb::Shader::ShaderProgram spotLightCompactShader;
+
 		// Meshes of the Light Volumes
 		std::shared_ptr<Honeycomb::Geometry::Mesh> lightVolumePoint;
 		std::shared_ptr<Honeycomb::Geometry::Mesh> lightVolumeSpot;
@@ -76,95 +270,146 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		/// Destroys this Deferred Renderer.
 		~DeferredRenderer();
 
+		/// Starts measuring the time which the graphics card spends on this
+		/// frame, if the resolution is dynamic. The measurement of an earlier
+		/// frame is read first, if it is available, and the render scale is
+		/// adjusted accordingly.
+		void beginFrameTimer();
+
+		/// Declares the passes of this frame and the resources which they
+		/// read and write to the frame graph: the geometry, the lights, the
+		/// background, the copy of the final texture target (if it is not
+		/// the FINAL texture), the post processing shaders & FXAA, and the
+		/// final render to the window.
+		void buildFrameGraph();
+
+		/// Builds the render queue out of the objects of the frame which is
+		/// being rendered, skipping the ones which are outside of the view
+		/// frustum or occluded. If the depth prepass is enabled, the queue is
+		/// sorted front to back by the view depth of each object. If multi-draw
+		/// is enabled, the queue is then split into the multi-draw batch and
+		/// the unbatched queue. If the batch is culled on the graphics card,
+		/// every batchable object is put straight into the batch (in the
+		/// order of the frame) and is never tested on the CPU, and only the
+		/// other objects go through the queue.
+		void buildRenderQueue();
+
+		/// Stops measuring the time which the graphics card spends on this
+		/// frame, if it is being measured.
+		void endFrameTimer();
+
+		/// Returns the geometry shader which matches the current G Buffer
+		/// layout.
+		/// return : The geometry shader.
+		Honeycomb::Shader::ShaderProgram& getGeometryShader();
+
+		/// Returns the light shader of the specified light type which matches
+		/// the current G Buffer layout.
+		/// const LightType &type : The type of the light.
+		/// return : The light shader.
+		Honeycomb::Shader::ShaderProgram& getLightShader(const 
+				Honeycomb::Component::Light::LightType &type);
+
+		/// Returns whether an axis aligned bounding box intersects the view
+		/// frustum of the specified projection. The box is outside if all of
+		/// its corners are outside of the same clip plane.
+		/// const Matrix4f &proj : The projection of the camera.
+		/// const Vector3f &min : The minimum corner of the box, in world
+		///						  space.
+		/// const Vector3f &max : The maximum corner of the box, in world
+		///						  space.
+		/// return : False if the box is certainly outside of the frustum.
+		static bool isInFrustum(const Honeycomb::Math::Matrix4f &proj,
+				const Honeycomb::Math::Vector3f &min,
+				const Honeycomb::Math::Vector3f &max);
+
 		/// Initializes the Light Volumes used by the Spot and Point Light
 		/// structures.
 		void initializeLightVolumes();
 
-		/// Initializes the Geometry Shader, Quad Shader, Stencil Shader, and
-		/// the light component shaders.
+		/// Initializes the Depth Shader, Geometry Shader, Quad Shader, Stencil
+		/// Shader, and the light component shaders.
 		void initializeShaders();
 
-		/// Initializes the Quad Mesh.
-		void initializeQuad();
-
 		/// Renders the background (solid color or skybox, depending on the
 		/// settings of the Renderer) of the scene. The background is only
 		/// rendered if the final texture target is NOT a depth or shadow map.
 		void renderBackground();
 		
 		/// Renders the specified Ambient Light using Deferred Rendering.
-		/// const AmbientLight &aL : The ambient light to be rendered.
-		void renderLightAmbient(const Honeycomb::Component::Light::AmbientLight
+		/// const Light &aL : The ambient light to be rendered.
+		void renderLightAmbient(const Honeycomb::Render::RenderFrame::Light
 			&aL);
 
 		/// Renders the specified Directional Light using Deferred Rendering.
-		/// const DirectionalLight &dL : The directional light to be rendered.
-		/// const GameScene &scene : The scene to be rendered.
-		void renderLightDirectional(const Honeycomb::Component::Light::
-				DirectionalLight &dL, Honeycomb::Scene::GameScene &scene);
+		/// const Light &dL : The directional light to be rendered.
+		void renderLightDirectional(const Honeycomb::Render::RenderFrame::
+				Light &dL);
 
 		/// Renders the specified Point Light using Deferred Rendering.
-		/// const PointLight &pL : The point light to be rendered.
-		void renderLightPoint(const Honeycomb::Component::Light::PointLight
+		/// const Light &pL : The point light to be rendered.
+		void renderLightPoint(const Honeycomb::Render::RenderFrame::Light
 			&pL);
 
 		/// Renders the specified Spot Light using Deferred Rendering.
-		/// const SpotLight &pL : The spot light to be rendered.
-		/// const GameScene &scene : The scene to be rendered.
-		void renderLightSpot(const Honeycomb::Component::Light::SpotLight &sL,
-				Honeycomb::Scene::GameScene &scene);
+		/// const Light &sL : The spot light to be rendered.
+		void renderLightSpot(const Honeycomb::Render::RenderFrame::Light &sL);
 
-		/// Renders the specified Base Light using a full screen quad.
-		/// const BaseLight &bL : The base light to be rendered.
+		/// Renders the specified light using a full screen quad.
+		/// const Light &bL : The light to be rendered.
 		/// const ShaderProgram &shader : The shader program to be used when
 		///								  rendering the light quad.
 		/// const string &name : The name of the light uniform in the Shader.
-		void renderLightQuad(const Honeycomb::Component::Light::BaseLight &bL,
+		void renderLightQuad(const Honeycomb::Render::RenderFrame::Light &bL,
 			Honeycomb::Shader::ShaderProgram &shader, const std::string
 			&name);
 
-		/// Renders the specified Base Light using a full screen quad.
-		/// const BaseLight &bL : The base light to be rendered.
+		/// Renders the specified light using its light volume.
+		/// const Light &bL : The light to be rendered.
 		/// Mesh &volume : The game object representing the volume of the light
 		///				   to be rendered.
 		/// const ShaderProgram &shader : The shader program to be used when
 		///								  rendering the light quad.
 		/// const string &name : The name of the light uniform in the Shader.
-		void renderLightVolume(const Honeycomb::Component::Light::BaseLight
+		void renderLightVolume(const Honeycomb::Render::RenderFrame::Light
 			&bL, Honeycomb::Geometry::Mesh &volume,
 			Honeycomb::Shader::ShaderProgram &shader, const std::string
 			&name);
 
-		/// Renders the geometry of the specified scene. Geometry is not
-		/// rendered if the final target is a shadow map.
-		/// GameScene &scene : The scene whose geometry is to be rendered.
-		void renderPassGeometry(Honeycomb::Scene::GameScene &scene);
-
-		/// Renders the lights of the specified scene, if the final target of
-		/// this Renderer is set to FINAL. If the final target is set to
-		/// shadow map, only the shadow map is rendered from the perspective of
-		/// the light.
-		/// GameScene &scene : The scene whose lights are to be rendered.
-		void renderPassLight(Honeycomb::Scene::GameScene &scene);
-
-		/// Writes the final texture target data to the GBuffer::FINAL_2 and
-		/// performs post processing on the FINAL_2 buffer. At the end, the
-		/// texture containing the final post processed image is returned.
-		/// return : The texture containing the post processed final image.
-		Honeycomb::Graphics::Texture2D& renderPassPostProcess();
-
-		/// Reads in a texture from the read buffer, post processes it with the
-		/// specified shader, and writes it to the write buffer. The read and
-		/// write are then swapped so that the read equals the old write, and
-		/// vice versa.
+		/// Renders the depth of the geometry of the render queue into the
+		/// G Buffer. No color is written.
+		void renderPassDepth();
+
+		/// Builds the render queue and renders the geometry of the frame.
+		/// Geometry is not rendered if the final target is a shadow map. If
+		/// the depth prepass is enabled, only the fragments which are visible
+		/// are shaded.
+		void renderPassGeometry();
+
+		/// Renders the lights of the frame, if the final target of this
+		/// Renderer is set to FINAL. If the final target is set to shadow
+		/// map, only the shadow map is rendered from the perspective of the
+		/// light.
+		void renderPassLight();
+
+		/// Copies the final texture target (if it is not the FINAL texture)
+		/// into the specified transient texture of the frame graph, so that
+		/// it may be post processed.
+		/// const int &write : The frame graph resource of the texture into
+		///					   which the final texture target is copied.
+		void renderPassCopy(const int &write);
+
+		/// Reads in a texture from the read resource of the frame graph, post
+		/// processes it with the specified shader, and writes it to the write
+		/// resource.
 		/// ShaderProgram &shader : The shader program to be used to post
 		///							process the texture.
-		/// int &read : The GBuffer texture index containing the image to be
-		///				post processed.
-		/// int &write : The color attachment index into which the post 
-		///				 processed image is to be drawn into.
+		/// const int &read : The frame graph resource containing the image to
+		///					  be post processed.
+		/// const int &write : The frame graph resource (a transient texture)
+		///					   into which the post processed image is drawn.
 		void renderPostProcessShader(Honeycomb::Shader::ShaderProgram &shader,
-				int &read, int &write);
+				const int &read, const int &write);
 
 		/// Reads in a texture from the read texture, post processes it with 
 		/// the specified shader, and writes it to the write buffer. The read
@@ -184,8 +429,6 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		///                      for spot lights, No for directional lights).
 		/// const Shadow &shadow : The shadow information to be used when
 		///                        rendering the light.
-		/// GameScene &scene : The scene for which the shadow map is to be
-		///					   rendered.
 		/// const Vector3f &pos : Optional parameter specifying the position of
 		///                       the light in world space. This should only be
 		///                       used for linear lights.
@@ -195,16 +438,30 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		void renderTextureShadowMap(
 				const bool &linear,
 				const Honeycomb::Component::Light::Shadow &shadow,
-				Honeycomb::Scene::GameScene &scene,
 				const Honeycomb::Math::Vector3f &pos = 
 					Honeycomb::Math::Vector3f(),
 				const float &zFar = 0.0F);
 
-		/// Renders the specified texture to the screen.
+		/// Renders the objects of the frame which may cast a shadow into the
+		/// bound shadow map. If the batch holds every batchable object of the
+		/// frame, it is culled against the light on the graphics card, and
+		/// only the other objects are tested against the light on the CPU.
+		/// ShaderProgram &shader : The shadow map shader.
+		/// const Matrix4f &lP : The projection of the light.
+		void renderShadowCasters(Honeycomb::Shader::ShaderProgram &shader,
+				const Honeycomb::Math::Matrix4f &lP);
+
+		/// Renders the specified texture to the screen, upscaling it to the
+		/// window size if the render scale is below one, and applying the
+		/// post effects and the gamma correction.
 		/// const Texture2D &tex : The texture which is to be rendered as a 
 		///						   full screen quad.
 		void renderTexture(const Honeycomb::Graphics::Texture2D &tex);
 
+		/// Resizes the Hierarchical Depth Buffer to the render size of the
+		/// G Buffer, from whose depth texture the depth pyramid is built.
+		void resizeHiZBuffer();
+
 		/// Sets the value of the gamma to be used for non-linear color space.
 		/// const float &g : The gamma value.
 		void setGamma(const float &g);
@@ -215,19 +472,33 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		///				   light.
 		void stencilLightVolume(Honeycomb::Geometry::Mesh &volume);
 
+		/// Adjusts the render scale according to the specified measurement of
+		/// the frame time.
+		/// const float &time : The time which the graphics card spent on a
+		///						recent frame, in milliseconds.
+		void updateRenderScale(const float &time);
+
+		/// Writes the camera of the frame to the specified shader, with the
+		/// size of the G Buffer as the size of the camera, so that the
+		/// shaders which find their screen coordinates from the size of the
+		/// camera read the G Buffer correctly at any render scale.
+		/// ShaderProgram &shader : The shader to which the camera is to be
+		///							written.
+		void writeCameraToShader(Honeycomb::Shader::ShaderProgram &shader);
+
 		/// Writes the transform of the point light to the stencil and point
 		/// light shader.
-		/// const PointLight &pL : The Point Light for which the light volume
-		///					       is to be transformed.
-		void writePointLightTransform(const Honeycomb::Component::Light::
-				PointLight &pL);
+		/// const Light &pL : The Point Light for which the light volume is to
+		///					  be transformed.
+		void writePointLightTransform(const Honeycomb::Render::RenderFrame::
+				Light &pL);
 
 		/// Writes the transform of the point light to the stencil and spot
 		/// light shader.
-		/// const SpotLight &sL : The Spot Light for which the light volume is
-		///						  to be transformed.
-		void writeSpotLightTransform(const Honeycomb::Component::Light::
-				SpotLight &sL);
+		/// const Light &sL : The Spot Light for which the light volume is to
+		///					  be transformed.
+		void writeSpotLightTransform(const Honeycomb::Render::RenderFrame::
+				Light &sL);
 
 		/// Binds the shadow map of the specified shadow type to the specified
 		/// shader.
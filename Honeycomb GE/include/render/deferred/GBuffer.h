@@ -9,27 +9,46 @@
 
 namespace Honeycomb { namespace Render { namespace Deferred {
 	enum GBufferTextureType {
-		// Uses GL_RGB16F
+		// Uses GL_RGB16F (STANDARD), Unused (COMPACT)
 		POSITION,		// Position
+		
+		// Uses GL_RGB16F (STANDARD), GL_RG16 (COMPACT)
 		NORMAL,			// Normals
 
-		// Uses GL_RGBA32UI
-		MATERIAL,		// Albedo (x.rgb), Ambient (y.rgb), Diffuse (z.rgb), 
-						// Specular (w.rgb) & Shininess (w.w)
+		// Uses GL_RGBA32UI (STANDARD), GL_RGBA8 (COMPACT)
+		MATERIAL,		// STANDARD: Albedo (x.rgb), Ambient (y.rgb), Diffuse
+						// (z.rgb), Specular (w.rgb) & Shininess (w.w).
+						// COMPACT: Diffuse (rgb) & Shininess (a).
+
+		// Uses GL_RGBA8 (COMPACT), Unused (STANDARD)
+		MATERIAL_AMBIENT,	// Ambient (rgb)
+		MATERIAL_SPECULAR,	// Specular (rgb)
 		
-		// Uses GL_DEPTH32F_STENCIL8
+		// Uses GL_DEPTH32F_STENCIL8 (STANDARD), GL_DEPTH24_STENCIL8 (COMPACT)
 		DEPTH,			// Depth Buffer (== to # of color buffers)
 		
-		// When post processing, we cannot read from and write to the same
-		// buffer, so we must read from one and write to the other, so we
-		// require two final buffers.
-		// Uses GL_RGB
-		FINAL_1,		// Final Buffer 1
-		FINAL_2,		// Final Buffer 2
+		// The lights are accumulated into the final buffer. The targets of
+		// the post processing passes are transient textures of the Frame
+		// Graph of the Deferred Renderer, rather than part of the G Buffer.
+		// Uses GL_RGB16F (STANDARD), GL_R11F_G11F_B10F (COMPACT)
+		FINAL_1,		// Final Buffer
 
 		COUNT			// The total number of buffers
 	};
 
+	enum GBufferLayout {
+		// The standard layout stores the world position and the normals in
+		// floating point textures and packs the material into a 128 bit
+		// integer texture.
+		LAYOUT_STANDARD,
+
+		// The compact layout reconstructs the position from the depth buffer,
+		// octahedral encodes the normals into two 16 bit channels and stores
+		// the material in 8 bit per channel textures. This roughly halves the
+		// number of bytes written per pixel in the geometry pass.
+		LAYOUT_COMPACT
+	};
+
 	class GBuffer : public Honeycomb::Base::GLItem {
 		friend class DeferredRenderer;
 	public:
@@ -103,6 +122,13 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		///							are to be binded.
 		void bindColorTextures(Honeycomb::Shader::ShaderProgram &shader);
 
+		/// Copies the depth texture of this G Buffer into the texture which
+		/// the light passes sample to reconstruct the position (compact
+		/// layout only). The light passes keep the depth texture attached for
+		/// the stencil test, so sampling it directly would be a feedback
+		/// loop. This must be called once the geometry has been rendered.
+		void copyDepth();
+
 		/// Destroys this G Buffer structure, and its position, diffuse, normal
 		/// and texture coordinate buffers.
 		void destroy();
@@ -114,11 +140,43 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		/// return : The FBO index.
 		const int& getFrameBuffer() const;
 
+		/// Returns the layout of the textures of this G Buffer.
+		/// return : The layout.
+		const GBufferLayout& getLayout() const;
+
+		/// Returns the height of the buffer textures of this G Buffer, which
+		/// is the height of the window scaled by the render scale.
+		/// return : The height, in pixels.
+		const int& getRenderHeight() const;
+
+		/// Returns the fraction of the window size at which the buffer
+		/// textures of this G Buffer are allocated.
+		/// return : The render scale, in (0, 1].
+		const float& getRenderScale() const;
+
+		/// Returns the width of the buffer textures of this G Buffer, which
+		/// is the width of the window scaled by the render scale.
+		/// return : The width, in pixels.
+		const int& getRenderWidth() const;
+
 		/// Initializes this G Buffer structure with the position, diffuse,
 		/// normal and texture coordinate buffers. The Buffer texture size will
 		/// be set to the Game Window's size.
 		void initialize();
 
+		/// Sets the layout of the textures of this G Buffer. If this G Buffer
+		/// has been initialized, all of its textures are reallocated to match
+		/// the new layout.
+		/// const GBufferLayout &layout : The new layout.
+		void setLayout(const GBufferLayout &layout);
+
+		/// Sets the fraction of the window size at which the buffer textures
+		/// of this G Buffer are allocated. If this G Buffer has been
+		/// initialized and the size of the textures changes, all of its
+		/// textures are reallocated.
+		/// const float &scale : The render scale, in (0, 1].
+		void setRenderScale(const float &scale);
+
 		/// Binds the default frame buffer object (0) for both drawing and
 		/// reading.
 		static void unbind();
@@ -130,22 +188,55 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		static void unbindRead();
 	private:
 		int frameBufferObj; // The frame buffer object for this G Buffer
+		GBufferLayout layout; // The layout of the buffer textures
 		
+		// The buffer textures (null if the texture is unused by the layout)
 		std::unique_ptr<Honeycomb::Graphics::Texture2D> bufferTextures
 			[GBufferTextureType::COUNT];
 
+		// The copy of the depth texture which is sampled by the light passes,
+		// and the frame buffer object into which it is blitted (the texture
+		// is null unless the layout is compact).
+		int depthCopyFrameBufferObj;
+		std::unique_ptr<Honeycomb::Graphics::Texture2D> depthCopyTexture;
+
 		// Stores the Shader Uniform names of all of the GBuffer Textures of a
 		// GBuffer.
 		static const std::string 
 			TEXTURE_SHADER_NAMES[GBufferTextureType::COUNT];
 
 		// The width and height of the buffer textures, from the GameWindow
+		// size scaled by the render scale.
 		int textureHeight;
 		int textureWidth;
+		float renderScale;
+
+		/// Allocates the texture of the specified type according to the
+		/// layout and the size of this GBuffer, and attaches it to the frame
+		/// buffer object. If the texture is not used by the layout, it is
+		/// destroyed and detached instead. The frame buffer object must be
+		/// bound before this is called.
+		/// const GBufferTextureType &type : The type of the texture.
+		void allocateTexture(const GBufferTextureType &type);
+
+		/// Allocates the copy of the depth texture at the size and format of
+		/// the depth texture if the layout is compact, or destroys it
+		/// otherwise.
+		void allocateDepthCopy();
+
+		/// Allocates all of the buffer textures of this GBuffer according to
+		/// its layout and size, and verifies that the frame buffer object is
+		/// complete.
+		void allocateTextures();
 
 		/// Resizes all of the buffer textures of this GBuffer to match the
-		/// current window screen size.
+		/// current window screen size, scaled by the render scale.
 		void resizeTextures();
+
+		/// Computes the size of the buffer textures of this GBuffer from the
+		/// current window screen size and the render scale, without
+		/// reallocating the textures.
+		void updateTextureSize();
 	};
 } } }
 
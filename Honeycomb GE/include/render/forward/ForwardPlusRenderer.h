@@ -0,0 +1,179 @@
+#pragma once
+#ifndef FORWARD_PLUS_RENDERER_H
+#define FORWARD_PLUS_RENDERER_H
+
+#include <memory>
+#include <vector>
+
+#include "../Renderer.h"
+
+#include "../../conjuncture/EventHandler.h"
+#include "../../geometry/Mesh.h"
+#include "../../graphics/Texture2D.h"
+#include "../../math/Matrix4f.h"
+#include "../../math/Vector3f.h"
+
+namespace Honeycomb { namespace Render { namespace Forward {
+	class ForwardPlusRenderer : public Honeycomb::Render::Renderer {
+	public:
+		// Event Handler for the Window Resize Event
+		Honeycomb::Conjuncture::EventHandler windowResizeHandler;
+
+		/// Returns the Forward+ Renderer singleton instance.
+		/// return : A pointer to the singleton instance of the Forward+
+		///			 Renderer structure.
+		static ForwardPlusRenderer* getForwardPlusRenderer();
+
+		/// Returns the number of samples per pixel used by the multisampled
+		/// render target of this Forward+ Renderer.
+		/// return : The number of samples.
+		const int& getSampleCount() const;
+
+		/// Renders the specified frame using this Forward+ Renderer.
+		/// const RenderFrame &frame : The snapshot of the scene which is to
+		///							   be rendered.
+		void render(const Honeycomb::Render::RenderFrame &frame);
+
+		/// Sets the number of samples per pixel used by the multisampled
+		/// render target of this Forward+ Renderer. The value is clamped to
+		/// the maximum supported by the graphics card. A value of one disables
+		/// the multisampling.
+		/// const int &samples : The number of samples.
+		void setSampleCount(const int &samples);
+	private:
+		static ForwardPlusRenderer *forwardPlusRenderer; // Singleton instance
+
+		// Width & Height of a light culling tile, in pixels
+		const static int TILE_SIZE;
+
+		// Multisampled Frame Buffer, into which the scene is rendered
+		int msaaBuffer;
+		int msaaColorBuffer;
+		int msaaDepthBuffer;
+		int sampleCount;
+
+		// Frame Buffer into which the multisampled image is resolved. The two
+		// textures are used for reading from & writing to when post
+		// processing.
+		int resolveBuffer;
+		std::unique_ptr<Honeycomb::Graphics::Texture2D> resolveTextures[2];
+
+		// Width & Height of the Frame Buffers
+		int bufferWidth;
+		int bufferHeight;
+
+		// Light Data, Tile Grid and Tile Light Index buffers (and the buffer
+		// textures through which they are read by the shading pass).
+		int lightDataBuffer;
+		int lightDataTexture;
+		int lightGridBuffer;
+		int lightGridTexture;
+		int lightIndicesBuffer;
+		int lightIndicesTexture;
+
+		// CPU side copies of the light buffers, which are reused every frame
+		std::vector<float> lightData;
+		std::vector<unsigned int> lightGrid;
+		std::vector<unsigned int> lightIndices;
+		std::vector<int> lightTiles;
+
+		// The directional or spot light whose shadow map is rendered this
+		// frame (null if no light casts a shadow), and was it already logged
+		// that the shadows of the other lights of a frame are dropped?
+		const Honeycomb::Render::RenderFrame::Light *shadowLight;
+		bool isShadowLimitLogged;
+
+		// Depth Prepass and Forward+ Shading Shaders
+		Honeycomb::Shader::ShaderProgram depthShader;
+		Honeycomb::Shader::ShaderProgram forwardShader;
+
+		/// Initializes a new Forward+ Renderer.
+		ForwardPlusRenderer();
+
+		/// Destroys this Forward+ Renderer.
+		~ForwardPlusRenderer();
+
+		/// Culls the point and spot lights of the frame against the screen
+		/// tiles and writes the light data, the per tile offsets and counts
+		/// and the per tile light indices to the light buffers. The ambient
+		/// and directional lights are written to the shading shader. The
+		/// first directional or spot light which casts a shadow is kept out
+		/// of the light buffers and is written to the shading shader on its
+		/// own, along with its shadow. The shadows of any other lights are
+		/// not rendered.
+		void cullLights();
+
+		/// Computes the screen tiles which are covered by a light sphere with
+		/// the specified center and radius, and appends them to the list of
+		/// light tiles as the minimum and maximum tile coordinates.
+		/// const Matrix4f &proj : The projection of the camera.
+		/// const Vector3f &center : The world position of the light sphere.
+		/// const float &radius : The radius of the light sphere.
+		/// return : True if the light covers at least one tile, false if it
+		///			 is outside of the screen.
+		bool cullLightSphere(const Honeycomb::Math::Matrix4f &proj,
+				const Honeycomb::Math::Vector3f &center, const float &radius);
+
+		/// Initializes the multisampled and the resolve Frame Buffers.
+		void initializeBuffers();
+
+		/// Initializes the light data, tile grid and tile light index buffers.
+		void initializeLightBuffers();
+
+		/// Initializes the Depth, Forward+ and Quad Shaders.
+		void initializeShaders();
+
+		/// Renders the background (solid color or skybox, depending on the
+		/// settings of the Renderer) of the scene into the multisampled
+		/// Frame Buffer.
+		void renderBackground();
+
+		/// Renders the shadow map of the light which casts a shadow this
+		/// frame (if there is one) from the perspective of the light.
+		void renderPassShadow();
+
+		/// Renders the depth of the frame into the multisampled Frame Buffer,
+		/// without writing any color.
+		void renderPassDepth();
+
+		/// Shades the geometry of the frame with all of its lights into the
+		/// multisampled Frame Buffer. Only the fragments which passed the
+		/// depth prepass are shaded.
+		void renderPassShading();
+
+		/// Resolves the multisampled Frame Buffer and performs post processing
+		/// on the resolved image. At the end, the texture containing the final
+		/// post processed image is returned.
+		/// return : The texture containing the post processed final image.
+		Honeycomb::Graphics::Texture2D& renderPassPostProcess();
+
+		/// Reads in a texture from the read texture, post processes it with
+		/// the specified shader, and writes it to the write texture. The read
+		/// and write are then swapped so that the read equals the old write,
+		/// and vice versa.
+		/// ShaderProgram &shader : The shader program to be used to post
+		///							process the texture.
+		/// int &read : The resolve texture index containing the image to be
+		///				post processed.
+		/// int &write : The resolve texture index into which the post
+		///				 processed image is to be drawn into.
+		void renderPostProcessShader(Honeycomb::Shader::ShaderProgram &shader,
+				int &read, int &write);
+
+		/// Renders the specified texture to the screen, applying the post
+		/// effects and the gamma correction.
+		/// const Texture2D &tex : The texture which is to be rendered as a
+		///						   full screen quad.
+		void renderTexture(const Honeycomb::Graphics::Texture2D &tex);
+
+		/// Resizes the multisampled and the resolve Frame Buffers to the size
+		/// of the game window.
+		void resizeBuffers();
+
+		/// Sets the value of the gamma to be used for non-linear color space.
+		/// const float &g : The gamma value.
+		void setGamma(const float &g);
+	};
+} } }
+
+#endif
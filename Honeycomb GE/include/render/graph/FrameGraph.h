@@ -0,0 +1,194 @@
+#pragma once
+#ifndef FRAME_GRAPH_H
+#define FRAME_GRAPH_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../../base/GLItem.h"
+#include "../../graphics/Texture2D.h"
+
+namespace Honeycomb { namespace Render { namespace Graph {
+	class FrameGraph : public Honeycomb::Base::GLItem {
+	public:
+		// The size and format of a transient texture. Transient textures may
+		// only share storage if their descriptions are equal.
+		struct TextureDescription {
+			int width;
+			int height;
+			Honeycomb::Graphics::TextureDataType type;
+			Honeycomb::Graphics::TextureDataInternalFormat internalFormat;
+			Honeycomb::Graphics::TextureDataFormat format;
+
+			/// Compares this description to the specified description for
+			/// equality.
+			/// const TextureDescription &rhs : The other description.
+			/// return : True if the descriptions are equal.
+			bool operator==(const TextureDescription &rhs) const;
+		};
+
+		/// Instantiates a new, empty Frame Graph.
+		FrameGraph();
+
+		/// Deinstantiates this Frame Graph.
+		~FrameGraph();
+
+		/// Adds a pass to this graph. The passes are executed in the order in
+		/// which they are added, unless they are culled.
+		/// const string &name : The name of the pass.
+		/// const function<void()> &execute : The function which renders the
+		///									  pass.
+		/// const bool &hasSideEffects : Does the pass do anything besides
+		///								 writing its resources (e.g. render to
+		///								 the window)? Such passes are never
+		///								 culled.
+		/// return : The index of the pass.
+		int addPass(const std::string &name, const std::function<void()>
+				&execute, const bool &hasSideEffects = false);
+
+		/// Declares that the specified pass reads the specified resource.
+		/// const int &pass : The index of the pass.
+		/// const int &resource : The index of the resource.
+		void addRead(const int &pass, const int &resource);
+
+		/// Declares a resource which is owned outside of this graph (such as
+		/// the G Buffer). Imported resources are never aliased.
+		/// const string &name : The name of the resource.
+		/// const Texture2D *texture : The texture of the resource, or null if
+		///							   the resource only orders the passes
+		///							   which read and write it.
+		/// return : The index of the resource.
+		int addImport(const std::string &name,
+				const Honeycomb::Graphics::Texture2D *texture = nullptr);
+
+		/// Declares a transient texture, which only lives from the first to
+		/// the last pass which uses it. Its storage is taken from the pool of
+		/// this graph when the graph is compiled, and may be shared with the
+		/// transient textures which are not alive at the same time.
+		/// const string &name : The name of the resource.
+		/// const TextureDescription &description : The size and format of
+		///											the texture.
+		/// return : The index of the resource.
+		int addTexture(const std::string &name,
+				const TextureDescription &description);
+
+		/// Declares that the specified pass writes the specified resource.
+		/// const int &pass : The index of the pass.
+		/// const int &resource : The index of the resource.
+		void addWrite(const int &pass, const int &resource);
+
+		/// Binds the specified transient texture for drawing. The transient
+		/// textures of one size are attached to the same framebuffer, so that
+		/// a chain of passes only selects another draw buffer, and the
+		/// framebuffer is only bound if it is not bound already.
+		/// const int &resource : The index of the transient texture.
+		void bindRenderTarget(const int &resource);
+
+		/// Removes all of the passes and resources from this graph. The pool
+		/// of transient textures is kept, so that it may be reused by the
+		/// passes of the next frame.
+		void clear();
+
+		/// Culls the passes whose results are never used, and assigns the
+		/// storage of the transient textures used by the remaining passes.
+		/// The textures of the pool which were not used for several compiles
+		/// are destroyed.
+		void compile();
+
+		/// Destroys the pool of transient textures and its framebuffers.
+		void destroy();
+
+		/// Executes all of the passes which were not culled, in order.
+		void execute();
+
+		/// Returns whether the specified pass was culled by the last compile.
+		/// const int &pass : The index of the pass.
+		/// return : True if the pass will not be executed.
+		bool getIsPassCulled(const int &pass) const;
+
+		/// Returns the texture of the specified resource. The texture of a
+		/// transient resource may only be used by the passes which declared
+		/// it, after the graph was compiled.
+		/// const int &resource : The index of the resource.
+		/// return : The texture.
+		const Honeycomb::Graphics::Texture2D& getTexture(const int &resource)
+				const;
+
+		/// Initializes this Frame Graph.
+		void initialize();
+	private:
+		// A pass, along with the resources which it reads and writes, and the
+		// number of its writes which are used (it is culled if none are).
+		struct Pass {
+			std::string name;
+			std::function<void()> execute;
+			bool hasSideEffects;
+
+			std::vector<int> reads;
+			std::vector<int> writes;
+			int refCount;
+			bool isCulled;
+		};
+
+		// A resource, along with the passes which write it, the number of
+		// passes which read it, and the first & last live pass which use it.
+		// The pooled texture is -1 until a transient resource is assigned a
+		// texture of the pool, and always for imported resources.
+		struct Resource {
+			std::string name;
+			bool isTransient;
+			const Honeycomb::Graphics::Texture2D *imported;
+			TextureDescription description;
+			int pooled;
+
+			std::vector<int> writers;
+			int refCount;
+			int firstUse;
+			int lastUse;
+		};
+
+		// A texture of the pool, along with the color attachment of the
+		// framebuffer (shared by the pooled textures of the same size) to
+		// which it is attached.
+		struct PooledTexture {
+			TextureDescription description;
+			std::unique_ptr<Honeycomb::Graphics::Texture2D> texture;
+			int frameBuffer;
+			int attachment;
+
+			bool isInUse;		// Is it used by a live resource right now?
+			int compilesUnused;	// Number of compiles since it was last used
+		};
+
+		// The number of compiles for which a pooled texture may remain unused
+		// before it is destroyed, and the number of textures attached to each
+		// framebuffer.
+		const static int POOL_RELEASE_COMPILES;
+		const static int ATTACHMENTS_PER_FRAMEBUFFER;
+
+		std::vector<Pass> passes;
+		std::vector<Resource> resources;
+		std::vector<PooledTexture> pool;
+
+		/// Takes a texture with the specified description from the pool,
+		/// creating it if no such texture is free.
+		/// const TextureDescription &description : The description.
+		/// return : The index of the pooled texture.
+		int acquire(const TextureDescription &description);
+
+		/// Attaches the specified pooled texture to a framebuffer of the
+		/// textures of its size, creating the framebuffer if all of their
+		/// framebuffers are full.
+		/// PooledTexture &pooled : The pooled texture.
+		void attach(PooledTexture &pooled);
+
+		/// Detaches the specified pooled texture from its framebuffer and
+		/// destroys it, destroying the framebuffer if it is now empty.
+		/// const int &index : The index of the pooled texture.
+		void release(const int &index);
+	};
+} } }
+
+#endif
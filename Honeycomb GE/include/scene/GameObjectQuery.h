@@ -0,0 +1,133 @@
+#pragma once
+#ifndef GAME_OBJECT_QUERY_H
+#define GAME_OBJECT_QUERY_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "../component/GameComponent.h"
+#include "../object/GameObject.h"
+
+namespace Honeycomb { namespace Scene { class GameScene; } }
+
+namespace Honeycomb { namespace Scene {
+	/// <summary>
+	/// The set of the Game Objects of a scene which have at least one
+	/// component of each of a set of types (active or not). The set is cached
+	/// by the scene and kept up to date as objects join and leave the scene
+	/// and as components are added and removed, so that reading it is only a
+	/// walk over a packed array. The order of the objects is unspecified.
+	/// </summary>
+	class GameObjectQuery {
+		friend class GameScene;
+	public:
+		/// <summary>
+		/// Calls the specified function for each Game Object of this query,
+		/// with the object and the first component of each of the specified
+		/// types. Each of the types must be one of the types of this query.
+		/// </summary>
+		/// <typeparam name="...T">
+		/// The types of the components to be passed to the function.
+		/// </typeparam>
+		/// <typeparam name="F">
+		/// The type of the function.
+		/// </typeparam>
+		/// <param name="function">
+		/// The function, which takes a reference to the Game Object and a
+		/// reference to a component of each type.
+		/// </param>
+		template<typename ...T, typename F>
+		void forEach(F function) const {
+			for (Honeycomb::Object::GameObject *object : this->objects)
+				function(*object, GameObjectQuery::getFirst<T>(*object)...);
+		}
+
+		/// <summary>
+		/// Returns the sorted Game Component IDs of the types of this query.
+		/// </summary>
+		/// <returns>
+		/// The constant reference to the list of Game Component IDs.
+		/// </returns>
+		const std::vector<Honeycomb::Component::GameComponentID>&
+				getComponentIDs() const;
+
+		/// <summary>
+		/// Returns the Game Objects of this query.
+		/// </summary>
+		/// <returns>
+		/// The constant reference to the list of Game Objects.
+		/// </returns>
+		const std::vector<Honeycomb::Object::GameObject*>& getObjects() const;
+
+		/// <summary>
+		/// Checks if the specified Game Object has at least one component of
+		/// each of the types of this query.
+		/// </summary>
+		/// <param name="object">
+		/// The Game Object.
+		/// </param>
+		/// <returns>
+		/// True if the object matches this query, false otherwise.
+		/// </returns>
+		bool matches(const Honeycomb::Object::GameObject &object) const;
+	private:
+		// The sorted Game Component IDs of the types of this query
+		std::vector<Honeycomb::Component::GameComponentID> componentIDs;
+
+		// The matching objects, and the index of each of them in the list
+		std::vector<Honeycomb::Object::GameObject*> objects;
+		std::unordered_map<const Honeycomb::Object::GameObject*, std::size_t>
+				indices;
+
+		/// <summary>
+		/// Returns the first component of the specified type of the specified
+		/// Game Object, which must have one. The component is cast without
+		/// RTTI, since all of the components with the Game Component ID of a
+		/// type are of that type.
+		/// </summary>
+		/// <typeparam name="T">
+		/// The type of the component.
+		/// </typeparam>
+		/// <param name="object">
+		/// The Game Object.
+		/// </param>
+		/// <returns>
+		/// The reference to the component.
+		/// </returns>
+		template<typename T>
+		static T& getFirst(const Honeycomb::Object::GameObject &object) {
+			return static_cast<T&>(*object.getComponentsInternal(
+				Honeycomb::Component::GameComponent::
+				getGameComponentTypeID<T>()).front());
+		}
+
+		/// <summary>
+		/// Initializes a new, empty query for the specified types.
+		/// </summary>
+		/// <param name="ids">
+		/// The sorted Game Component IDs of the types, without duplicates.
+		/// </param>
+		GameObjectQuery(const std::vector<
+				Honeycomb::Component::GameComponentID> &ids);
+
+		/// <summary>
+		/// Removes the specified Game Object from this query. This has no
+		/// effect if the object is not part of this query.
+		/// </summary>
+		/// <param name="object">
+		/// The Game Object.
+		/// </param>
+		void remove(const Honeycomb::Object::GameObject &object);
+
+		/// <summary>
+		/// Adds the specified Game Object to this query if it matches the
+		/// query, and removes it otherwise.
+		/// </summary>
+		/// <param name="object">
+		/// The Game Object, whose components may have changed.
+		/// </param>
+		void update(Honeycomb::Object::GameObject &object);
+	};
+} }
+
+#endif
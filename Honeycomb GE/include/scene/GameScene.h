@@ -2,20 +2,23 @@
 #ifndef GAME_SCENE_H
 #define GAME_SCENE_H
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "../component/GameComponent.h"
+#include "../component/GameComponentPool.h"
 #include "../component/light/AmbientLight.h"
 #include "../component/light/BaseLight.h"
 #include "../component/light/DirectionalLight.h"
 #include "../component/light/PointLight.h"
 #include "../component/light/SpotLight.h"
 #include "../object/GameObject.h"
+#include "GameObjectQuery.h"
 
 namespace Honeycomb { namespace Scene {
 	class GameScene : public Honeycomb::Object::GameObject {
-		friend class Honeycomb::Component::Light::BaseLight;
+		friend class Honeycomb::Object::GameObject;
 	public:
 		/// <summary>
 		/// Returns the pointer to the active Game Scene. If no Game Scene is
@@ -39,27 +42,6 @@ namespace Honeycomb { namespace Scene {
 		/// </param>
 		GameScene(const std::string &name);
 
-		/// <summary>
-		/// Adds the specified Game Object as a child of this Game Scene. If 
-		/// the specified Game Object is already a child of this Game Scene,
-		/// no further action is taken and the reference to the child is 
-		/// returned. If the specified Game Object is already a child of some 
-		/// other Game Object, the child is detached from its current parent 
-		/// and reattached to this Game Scene. Since the child is passed as a 
-		/// unique pointer, this Game Scene instance will take ownership of 
-		/// the pointer. This function automatically fetches any lights of the
-		/// object and adds them to the scene's lights list.
-		/// </summary>
-		/// <param name="object">
-		/// The object to be parented to this Game Scene. This should be moved
-		/// to the Game Object using the <see cref="std::move"/> function.
-		/// </param>
-		/// <returns>
-		/// The reference to the new child Game Object.
-		/// </returns>
-		Honeycomb::Object::GameObject& addChild(
-			std::unique_ptr<Honeycomb::Object::GameObject> object) override;
-
 		/// <summary>
 		/// Clones this Game Scene into a new, independent Game Scene. The
 		/// Game Scene will have all of the same properties, components and
@@ -74,16 +56,43 @@ namespace Honeycomb { namespace Scene {
 		std::unique_ptr<GameScene> clone() const;
 
 		/// <summary>
-		/// Checks if this Game Scene is active.
+		/// Returns the pool of all of the components of the specified type
+		/// which are attached to the Game Objects of this scene (including the
+		/// scene itself), active or not. A system may iterate over the pool
+		/// to process all of the components of a type linearly, instead of
+		/// walking the hierarchy.
 		/// </summary>
+		/// <param name="id">
+		/// The Game Component ID of the type.
+		/// </param>
 		/// <returns>
-		/// True if this is the active Game Scene, false otherwise.
+		/// The reference to the component pool.
+		/// </returns>
+		Honeycomb::Component::GameComponentPool& getComponentPool(
+				const Honeycomb::Component::GameComponentID &id);
+
+		/// <summary>
+		/// Returns the pool of all of the components of the specified type
+		/// which are attached to the Game Objects of this scene (including the
+		/// scene itself), active or not. The components of the pool may be
+		/// cast to the type with a static_cast.
+		/// </summary>
+		/// <typeparam name="T">
+		/// The type of the Game Component.
+		/// </typeparam>
+		/// <returns>
+		/// The reference to the component pool.
 		/// </returns>
-		bool getIsActive() const;
+		template<typename T>
+		Honeycomb::Component::GameComponentPool& getComponentPool() {
+			return this->getComponentPool(Honeycomb::Component::
+				GameComponent::getGameComponentTypeID<T>());
+		}
 
 		/// <summary>
 		/// Returns a list of references to all of the lights of this Game
-		/// Scene.
+		/// Scene. The list is kept up to date as lights join and leave the
+		/// scene.
 		/// </summary>
 		/// <returns>
 		/// The list of references to the lights.
@@ -105,30 +114,124 @@ namespace Honeycomb { namespace Scene {
 		void onEnable() override;
 
 		/// <summary>
-		/// Removes the specified child from this Game Scene and returns a
-		/// unique pointer to it. If the specified Game Object is not attached
-		/// to this Game Scene, a GameEntityNotAttached exception will be
-		/// thrown 
+		/// Updates all of the active components of this Game Scene. First,
+		/// the components which may access anything are updated in the order
+		/// of the hierarchy. Then, the components which only write their own
+		/// state are updated in parallel chunks on the Job System (one type
+		/// of component after another), and finally their updates are
+		/// committed sequentially, in a deterministic order.
 		/// </summary>
-		/// <param name="object">
-		/// The pointer to the child which is to be removed.
+		void onUpdate() override;
+
+		/// <summary>
+		/// Returns the query of the Game Objects of this scene which have at
+		/// least one component of each of the specified types. The query is
+		/// created the first time it is requested, and is cached and kept up
+		/// to date by this scene from then on, so the same query may be
+		/// requested every frame without searching the hierarchy.
+		/// </summary>
+		/// <typeparam name="...T">
+		/// The types of the Game Components.
+		/// </typeparam>
+		/// <returns>
+		/// The constant reference to the query.
+		/// </returns>
+		template<typename ...T>
+		const GameObjectQuery& query() {
+			return this->query({ Honeycomb::Component::GameComponent::
+				getGameComponentTypeID<T>()... });
+		}
+
+		/// <summary>
+		/// Returns the query of the Game Objects of this scene which have at
+		/// least one component of each of the specified Game Component IDs.
+		/// The query is created the first time it is requested, and is cached
+		/// and kept up to date by this scene from then on.
+		/// </summary>
+		/// <param name="ids">
+		/// The Game Component IDs of the types, in any order.
 		/// </param>
 		/// <returns>
-		/// The unique pointer to the child after it has been removed from this
-		/// Game Scene.
+		/// The constant reference to the query.
 		/// </returns>
-		/// <exception cref="GameEntityNotAttachedException">
-		/// Thrown if the Game Object specified is not attached to this.
-		/// </exception>
-		std::unique_ptr<Honeycomb::Object::GameObject> removeChild(
-				Honeycomb::Object::GameObject *object) override;
+		const GameObjectQuery& query(
+				std::vector<Honeycomb::Component::GameComponentID> ids);
 	private:
 		static GameScene *activeScene; // The active game scene
 
+		// The pools of the components of the scene, at the index of their
+		// Game Component ID.
+		std::vector<Honeycomb::Component::GameComponentPool> componentPools;
+
+		// The cached queries of the scene
+		std::vector<std::unique_ptr<GameObjectQuery>> queries;
+
 		// List of all of the lights of this scene
 		std::vector<
 			std::reference_wrapper<Honeycomb::Component::Light::BaseLight>> 
 			sceneLights;
+
+		// The components to be updated in parallel during the current update,
+		// at the index of their Game Component ID.
+		std::vector<std::vector<Honeycomb::Component::GameComponent*>>
+			parallelUpdates;
+
+		/// <summary>
+		/// Adds the specified component to the lights of this scene, if it is
+		/// a light.
+		/// </summary>
+		/// <param name="component">
+		/// The component, which has joined this scene.
+		/// </param>
+		void addSceneLight(Honeycomb::Component::GameComponent &component);
+
+		/// <summary>
+		/// Calculates whether this Game Scene is active. A Game Scene has no
+		/// parent, so it is active if it is the active Game Scene.
+		/// </summary>
+		/// <returns>
+		/// True if this is the active Game Scene, false otherwise.
+		/// </returns>
+		bool calcIsActive() const override;
+
+		/// <summary>
+		/// Checks if the specified Game Component ID is the ID of one of the
+		/// types of light.
+		/// </summary>
+		/// <param name="id">
+		/// The Game Component ID.
+		/// </param>
+		/// <returns>
+		/// True if the components of the ID are lights, false otherwise.
+		/// </returns>
+		static bool isLight(const Honeycomb::Component::GameComponentID &id);
+
+		/// <summary>
+		/// Removes the specified Game Object from all of the cached queries.
+		/// </summary>
+		/// <param name="object">
+		/// The Game Object, which is leaving this scene.
+		/// </param>
+		void removeFromQueries(const Honeycomb::Object::GameObject &object);
+
+		/// <summary>
+		/// Removes the specified component from the lights of this scene, if
+		/// it is a light.
+		/// </summary>
+		/// <param name="component">
+		/// The component, which is leaving this scene.
+		/// </param>
+		void removeSceneLight(Honeycomb::Component::GameComponent &component);
+
+		/// <summary>
+		/// Adds the specified Game Object to the cached queries which it
+		/// matches, and removes it from those which it no longer matches.
+		/// </summary>
+		/// <param name="object">
+		/// The Game Object, which has joined this scene or whose components
+		/// have changed.
+		/// </param>
+		void updateQueries(Honeycomb::Object::GameObject &object);
 	};
 } }
 
@@ -15,6 +15,7 @@
 
 namespace Honeycomb { namespace Shader {
 	enum ShaderType {
+		COMPUTE_SHADER				= 0x91B9,	// from GL_COMPUTE_SHADER
 		FRAGMENT_SHADER				= 0x8B30,	// from GL_FRAGMENT_SHADER
 		GEOMETRY_SHADER				= 0x8DD9,	// from GL_GEOMETRY_SHADER
 		VERTEX_SHADER				= 0x8B31,	// from GL_VERTEX_SHADER
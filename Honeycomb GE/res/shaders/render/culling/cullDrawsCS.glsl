@@ -0,0 +1,178 @@
+///
+/// This Compute Shader culls the draws of a multi-draw batch on the graphics
+/// card. Each invocation tests the bounding box of one draw against the view
+/// frustum and, optionally, against the Hierarchical Depth Buffer, and then
+/// writes the command of the draw for the indirect multi-draw calls.
+///
+/// If the commands are compacted, the visible commands of each bucket (the
+/// draws which share a material, or whose materials are all read from the
+/// Material Table) are packed at the start of the range of the bucket, and
+/// their number is written to the draw count of the bucket. Otherwise, every
+/// command is written in place, with zero instances if it is not visible.
+///
+
+#version 430 core
+
+layout (local_size_x = 64) in;
+
+// The layout of a command of glMultiDrawElementsIndirect
+struct DrawCommand {
+	uint count;
+	uint instanceCount;
+	uint firstIndex;
+	int baseVertex;
+	uint baseInstance;
+};
+
+// The local bounds of the mesh of a draw, the index of the bucket of the
+// draw and the position of the first command of that bucket.
+struct DrawCullData {
+	vec3 boundsMin;
+	uint bucket;
+	vec3 boundsMax;
+	uint bucketOffset;
+};
+
+layout (std430, binding = 0) readonly buffer InCommands {
+	DrawCommand inCommands[];
+};
+
+layout (std430, binding = 1) writeonly buffer OutCommands {
+	DrawCommand outCommands[];
+};
+
+layout (std430, binding = 2) readonly buffer CullData {
+	DrawCullData cullData[];
+};
+
+layout (std430, binding = 3) readonly buffer Transforms {
+	vec4 transformRows[]; // The transforms of the batch, row by row
+};
+
+layout (std430, binding = 4) buffer DrawCounts {
+	uint drawCounts[]; // The number of visible commands of each bucket
+};
+
+layout (std430, binding = 5) readonly buffer DrawData {
+	ivec2 drawData[]; // The transform & material index of each command
+};
+
+uniform int commandCount;			// Number of commands of the batch
+uniform bool doCompact;				// Should the commands be compacted?
+uniform mat4 cullProjection;		// Projection of the camera
+
+uniform bool doOcclusion;			// Test against the depth pyramid?
+uniform mat4 hiZProjection;			// Projection of the depth pyramid
+uniform sampler2D hiZPyramid;		// Farthest depths of the depth pyramid
+
+/// Returns whether the specified world space box may be visible, by testing
+/// its nearest depth against the farthest depths of the depth pyramid (see
+/// HiZBuffer::isVisible, which performs the same test on the CPU).
+/// vec3 bMin : The minimum corner of the box.
+/// vec3 bMax : The maximum corner of the box.
+/// return : False if the box is certainly occluded.
+bool isVisibleHiZ(vec3 bMin, vec3 bMax) {
+	vec3 ndcMin = vec3(1.0e30F);
+	vec3 ndcMax = vec3(-1.0e30F);
+	for (int i = 0; i < 8; ++i) {
+		vec4 corner = hiZProjection * vec4(
+			(i & 1) != 0 ? bMax.x : bMin.x,
+			(i & 2) != 0 ? bMax.y : bMin.y,
+			(i & 4) != 0 ? bMax.z : bMin.z, 1.0F);
+		if (corner.w <= 0.0F) return true;
+
+		vec3 ndc = corner.xyz / corner.w;
+		ndcMin = min(ndcMin, ndc);
+		ndcMax = max(ndcMax, ndc);
+	}
+
+	// A box which is not entirely on the old screen may have come into view
+	// where there are no depths to test it against, so it is kept.
+	if (ndcMin.x < -1.0F || ndcMax.x > 1.0F ||
+		ndcMin.y < -1.0F || ndcMax.y > 1.0F) return true;
+
+	// Find the level in which the box covers at most 2x2 texels. If even the
+	// coarsest level is too fine, the box is large enough to be kept.
+	ivec2 size = textureSize(hiZPyramid, 0);
+	vec2 uvMin = ndcMin.xy * 0.5F + 0.5F;
+	vec2 uvMax = ndcMax.xy * 0.5F + 0.5F;
+	ivec2 t0 = min(ivec2(uvMin * vec2(size)), size - 1);
+	ivec2 t1 = min(ivec2(uvMax * vec2(size)), size - 1);
+
+	int level = 0;
+	int levels = textureQueryLevels(hiZPyramid);
+	while ((t1.x - t0.x > 1 || t1.y - t0.y > 1) && level + 1 < levels) {
+		++level;
+		ivec2 last = textureSize(hiZPyramid, level) - 1;
+		t0 = min(t0 / 2, last);
+		t1 = min(t1 / 2, last);
+	}
+	if (t1.x - t0.x > 1 || t1.y - t0.y > 1) return true;
+
+	float farthest = max(
+		max(texelFetch(hiZPyramid, t0, level).r,
+			texelFetch(hiZPyramid, ivec2(t1.x, t0.y), level).r),
+		max(texelFetch(hiZPyramid, ivec2(t0.x, t1.y), level).r,
+			texelFetch(hiZPyramid, t1, level).r));
+
+	return ndcMin.z * 0.5F + 0.5F <= farthest;
+}
+
+/// Returns whether the specified world space box intersects the frustum of
+/// the camera. The box is outside if all of its corners are outside of the
+/// same clip plane.
+/// vec3 bMin : The minimum corner of the box.
+/// vec3 bMax : The maximum corner of the box.
+/// return : False if the box is certainly outside of the frustum.
+bool isVisibleFrustum(vec3 bMin, vec3 bMax) {
+	// The number of corners below and above each pair of clip planes
+	ivec3 below = ivec3(0);
+	ivec3 above = ivec3(0);
+	for (int i = 0; i < 8; ++i) {
+		vec4 corner = cullProjection * vec4(
+			(i & 1) != 0 ? bMax.x : bMin.x,
+			(i & 2) != 0 ? bMax.y : bMin.y,
+			(i & 4) != 0 ? bMax.z : bMin.z, 1.0F);
+
+		below += ivec3(lessThan(corner.xyz, vec3(-corner.w)));
+		above += ivec3(greaterThan(corner.xyz, vec3(corner.w)));
+	}
+
+	return all(lessThan(below, ivec3(8))) && all(lessThan(above, ivec3(8)));
+}
+
+void main() {
+	int i = int(gl_GlobalInvocationID.x);
+	if (i >= commandCount) return;
+
+	DrawCommand command = inCommands[i];
+	DrawCullData data = cullData[i];
+
+	// Transform the center of the local box and project its half extents
+	// onto the world axes (see MeshRenderer::getBounds).
+	int row = drawData[i].x * 4;
+	mat4 transform = transpose(mat4(
+		transformRows[row + 0], transformRows[row + 1],
+		transformRows[row + 2], transformRows[row + 3]));
+	mat3 linear = mat3(transform);
+	vec3 center = (transform * vec4((data.boundsMin + data.boundsMax) *
+		0.5F, 1.0F)).xyz;
+	vec3 halfExtent = (data.boundsMax - data.boundsMin) * 0.5F;
+	vec3 extent = abs(linear[0]) * halfExtent.x +
+		abs(linear[1]) * halfExtent.y + abs(linear[2]) * halfExtent.z;
+
+	vec3 bMin = center - extent;
+	vec3 bMax = center + extent;
+	bool isVisible = isVisibleFrustum(bMin, bMax) &&
+		(!doOcclusion || isVisibleHiZ(bMin, bMax));
+
+	if (doCompact) {
+		if (isVisible) {
+			uint slot = atomicAdd(drawCounts[data.bucket], 1U);
+			outCommands[data.bucketOffset + slot] = command;
+		}
+	} else {
+		command.instanceCount = isVisible ? 1U : 0U;
+		outCommands[i] = command;
+	}
+}
@@ -0,0 +1,38 @@
+///
+/// This Fragment Shader is used for rendering the normals and materials of
+/// the geometry into the compact G-Buffer layout. The position is not written
+/// since it is reconstructed from the depth buffer by the light shaders, the
+/// normal is octahedral encoded and the material is split into RGBA8 targets.
+///
+
+#version 410 core
+
+#include <../../../util/packing.glsl>
+#include <../../../util/dither.glsl>
+#include <geometryMaterial.glsl>
+
+// Outputs correlating to the texture ID in the G-Buffer (location 0, the
+// position, is not used by the compact layout).
+layout (location = 1) out vec2 out_fs_normal;
+layout (location = 2) out vec4 out_fs_material;
+layout (location = 3) out vec4 out_fs_materialAmbient;
+layout (location = 4) out vec4 out_fs_materialSpecular;
+
+void main() {
+	ditherFade();
+
+	// Calculate Parallax Displaced Texture Coordinates once
+	calculateDisplacedTexCoords();
+
+	out_fs_normal = packNormalOctahedron(normalize(calculateNormal()));
+
+	vec3 reflectionVec = calculateReflection();
+	vec3 albedoVec = calculateAlbedo() * reflectionVec;
+	vec4 specularVec = calculateSpecular();
+
+	// Diffuse & Shininess, Ambient, and Specular (the RGBA8 textures will
+	// clamp each of the values to [0, 1] automatically).
+	out_fs_material = vec4(calculateDiffuse() * albedoVec, specularVec.a);
+	out_fs_materialAmbient = vec4(calculateAmbient() * albedoVec, 1.0F);
+	out_fs_materialSpecular = vec4(specularVec.rgb, 1.0F);
+}
@@ -0,0 +1,185 @@
+#ifndef GEOMETRY_MATERIAL_GLSL
+#define GEOMETRY_MATERIAL_GLSL
+
+///
+/// Shared material sampling functions for the geometry pass. These are used
+/// by both the standard and the compact G-Buffer geometry fragment shaders.
+/// The material is read from the Material Table if the object was drawn as
+/// part of a batch whose materials are in the table, and from the material
+/// uniform otherwise.
+///
+
+#include <../../../standard/structs/stdCamera.glsl>
+#include <../../../standard/structs/stdMaterial.glsl>
+#include <../../../standard/structs/stdMaterialTable.glsl>
+#include <../../../standard/vertex/stdVertexFS.glsl>
+
+uniform Material material;  // Standard Material of the Object
+uniform Camera camera;      // Scene Camera
+uniform samplerCube skybox; // Skybox for Reflection
+uniform float gamma;		// Gamma value for reading in textures
+
+vec2 displacedTexCoords;	// Parallax Displaced Tex Coords for this Fragment
+
+/// Returns the specified color of the material of this object.
+/// int row : The row of the color in the Material Table.
+/// vec3 color : The color in the material uniform.
+/// return : The color of the material.
+vec3 getMaterialColor(int row, vec3 color) {
+	return isMaterialTabled() ? readMaterialTable(row).rgb : color;
+}
+
+/// Returns the shininess, refractive index and reflection strength of the
+/// material of this object.
+/// return : The scalars of the material.
+vec3 getMaterialScalars() {
+	return isMaterialTabled() ? readMaterialTable(MATERIAL_ROW_SCALARS).xyz :
+		vec3(material.shininess, material.refractiveIndex,
+			material.reflectionStrength);
+}
+
+/// Samples the specified texture of the material of this object.
+/// int row : The row of the texture in the Material Table.
+/// sampler2D sampler : The texture in the material uniform.
+/// vec2 coord : The texture coordinates.
+/// float gamma : The gamma to be used when sampling (1.0F for linear space).
+/// return : The gamma corrected texture color.
+vec4 sampleMaterial(int row, sampler2D sampler, vec2 coord, float gamma) {
+	return isMaterialTabled() ?
+		applyGammaSRGB(sampleMaterialTable(row, coord), gamma) :
+		texture2DSRGB(sampler, coord, gamma);
+}
+
+/// Calculates the Reflection color of this object's fragment.
+/// return : The reflection color.
+vec3 calculateReflection() {
+	// Calculate the Reflection Color. To avoid an if statement, calculate the
+	// reflection strength as one minus the material's reflection strength.
+	// This strength will be one if the material reflection is zero, or zero
+	// if the material reflection is one. Then, add the reflected vector to the
+	// strength, so that if the strength is one, it remains one (after being
+	// clamped) or if the strength is zero, it becomes equal to the reflected
+	// vector. (
+	// Note on Normals: out_fs_normal should be computed prior to this!)
+	vec3 viewVec = normalize(vertexIn.position - camera.translation);
+	vec3 scalars = getMaterialScalars();
+	float matRefStr = clamp(scalars.z, 0.0F, 1.0F);
+	vec3 refVec = refract(viewVec, -normalize(vertexIn.normal), 
+		1.0F / scalars.y);
+	vec3 refStr = vec3(1.0F) - vec3(matRefStr);
+	vec3 refTexture = textureCubeSRGB(skybox, refVec, gamma).rgb;
+	vec3 reflection = clamp(refStr + refTexture, 0.0F, 1.0F);
+
+	return reflection;
+}
+
+/// Calculates the Ambient Color of this object's fragment.
+/// return : The ambient color.
+vec3 calculateAmbient() {
+	// Fetch material texture & ambient
+	vec3 tex = sampleMaterial(MATERIAL_ROW_AMBIENT_TEXTURE,
+		material.ambientTexture.sampler, displacedTexCoords, gamma).rgb;
+	vec3 ambient = getMaterialColor(MATERIAL_ROW_AMBIENT_COLOR,
+		material.ambientColor);
+
+	// Return Texture + Ambient
+	return tex * ambient;
+}
+
+/// Calculates the Albedo Color of this object's fragment.
+/// return : The albedo color.
+vec3 calculateAlbedo() {
+	// Fetch material texture & albedo
+	vec3 tex = sampleMaterial(MATERIAL_ROW_ALBEDO_TEXTURE,
+		material.albedoTexture.sampler, displacedTexCoords, gamma).rgb;
+	vec3 albedo = getMaterialColor(MATERIAL_ROW_ALBEDO_COLOR,
+		material.albedoColor);
+
+	// Return Texture + Albedo
+	return tex * albedo;
+}
+
+/// Calculates the Diffuse Color of this object's fragment.
+/// return : The diffuse color.
+vec3 calculateDiffuse() {
+	// Fetch material texture & diffuse
+	vec3 tex = sampleMaterial(MATERIAL_ROW_DIFFUSE_TEXTURE,
+		material.diffuseTexture.sampler, displacedTexCoords, gamma).rgb;
+	vec3 diffuse = getMaterialColor(MATERIAL_ROW_DIFFUSE_COLOR,
+		material.diffuseColor);
+
+	// Return Texture + Diffuse
+	return tex * diffuse;
+}
+
+/// Calculates the Normal/Bump map vector of this object's fragment.
+/// return : The normal vector.
+vec3 calculateNormal() {
+	// Fetch the standard interpolated vertex shader normal
+	vec3 vsNorm = normalize(vertexIn.normal);
+
+	// Fetch texture value from the Normal Map of the Material
+	vec3 tex = sampleMaterial(MATERIAL_ROW_NORMALS_TEXTURE,
+		material.normalsTexture.sampler, displacedTexCoords, 1.0F).rgb;
+	vec3 texNorm = tex;
+
+	// Convert the Normal Map texture from the range of [0, 1] to [-1, 1] since
+	// a normal can be negative or positive.
+	texNorm = normalize((tex * 2.0F) - vec3(1.0F));
+
+	// Orient the normal map according to the Tangent-Bitangent-Normal Matrix
+	texNorm = normalize(vertexIn.tbnMatrix * texNorm);
+
+	// Multiply by the ceiling of the original texture value. If this object
+	// has a texture map, the ceiling of the texture will be a { 1, 1, 1 }
+	// white vector, and will therefore not modify the texture map. If this
+	// object does not have a texture map, the ceiling of the texture will be
+	// { 0, 0, 0 } and will therefore nullify the texture map.
+	texNorm = ceil(tex) * texNorm;
+
+	// Now do the opposite of the above to the interpolated normal. If this
+	// object has a texture map, one minus the ceiling will be { 0, 0, 0 } and
+	// therefore the interpolated normal will be zero. If this object has no
+	// texture map, one minus the ceiling will be { 1, 1, 1 } and therefore the
+	// interpolated normal is not modified.
+	vsNorm = (vec3(1.0F) - ceil(tex)) * vsNorm;
+
+	// Since either vsNorm is zero or texNorm is zero, but not both, sum them
+	// up and the result will be equal to the non zero value, which is the one
+	// we want.
+	return texNorm + vsNorm;
+}
+
+/// Calculates the Specular Color and shininess of this object's fragment.
+/// return : The specular color and shininess.
+vec4 calculateSpecular() {
+	// Fetch Specular properties from the Materials
+	vec3 color = getMaterialColor(MATERIAL_ROW_SPECULAR_COLOR,
+		material.specularColor);
+	vec3 tex = sampleMaterial(MATERIAL_ROW_SPECULAR_TEXTURE,
+		material.specularTexture.sampler, vertexIn.texCoords0, 1.0F).rgb;
+	float shine = clamp(getMaterialScalars().x / 255.0F, 0.0F, 1.0F);
+
+	// Return Color + Texture, Shininess
+	return vec4(tex * color, shine);
+}
+
+/// Calculates the parallax displaced texture coordinates of this fragment
+/// and stores them so that they may be used by the calculate functions.
+void calculateDisplacedTexCoords() {
+	vec3 viewVec = normalize(vertexIn.position - camera.translation);
+	if (isMaterialTabled()) {
+		vec4 tilingOffset = readMaterialTable(MATERIAL_ROW_TILING_OFFSET);
+		displacedTexCoords = vertexIn.texCoords0 * tilingOffset.xy +
+			tilingOffset.zw;
+		displacedTexCoords = parallaxTransformTable(displacedTexCoords,
+			viewVec, vertexIn.tbnMatrix);
+	} else {
+		displacedTexCoords = getTextureCoordinates(material,
+			vertexIn.texCoords0);
+		displacedTexCoords = parallaxTransform(material.displacementTexture,
+			displacedTexCoords, viewVec, vertexIn.tbnMatrix);
+	}
+}
+
+#endif
\ No newline at end of file
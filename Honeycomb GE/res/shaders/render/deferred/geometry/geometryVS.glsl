@@ -10,11 +10,17 @@
 
 #include <../../../standard/structs/stdCamera.glsl>
 #include <../../../standard/vertex/stdVertexVS.glsl>
+#include <../../../standard/vertex/stdTransformVS.glsl>
+
+// Must match the depth prepass vertex shader, see depth/depthVS.glsl
+invariant gl_Position;
 
-uniform mat4 objTransform;		// Transform Matrix (pos, rot, scl)
 uniform Camera camera;			// Camera Structure
 
 void main() {
+	mat4 objTransform = getObjTransform();
+	objMaterialIndex = getObjMaterialIndex();
+
 	// Fetch position and texture coordinates
     vertexOut.position = (objTransform * vertexIn.position).xyz;
 	vertexOut.texCoords0 = vertexIn.texCoords0;
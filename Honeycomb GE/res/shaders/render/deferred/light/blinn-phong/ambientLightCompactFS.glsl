@@ -0,0 +1,18 @@
+#version 330 core
+
+#include <../../../../standard/light/blinn-phong/blinnPhongAmbient.glsl>
+#include <../gBufferCompact.glsl>
+
+uniform sampler2D gBufferMaterialAmbient;
+
+uniform AmbientLight ambientLight; // The Ambient Light
+uniform Camera camera;
+
+out vec4 fragColor;
+
+void main() {
+	vec2 screenCoord = getScreenCoordinates(camera);
+	vec3 ambient = texture2D(gBufferMaterialAmbient, screenCoord).rgb;
+
+    fragColor = vec4(calculateAmbientLight(ambientLight) * ambient, 1.0F);
+}
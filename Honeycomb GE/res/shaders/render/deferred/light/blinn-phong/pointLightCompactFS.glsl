@@ -0,0 +1,26 @@
+#version 330 core
+
+#include <../../../../standard/light/blinn-phong/blinnPhongPoint.glsl>
+#include <../gBufferCompact.glsl>
+
+uniform PointLight pointLight; // The point light
+uniform Camera camera;
+
+uniform sampler2D gBufferMaterialSpecular;
+
+out vec4 fragColor;
+
+void main() {
+    vec2 screenCoord = getScreenCoordinates(camera);
+    
+    vec3 pos = readGBufferPosition(camera, screenCoord);
+    vec3 norm = readGBufferNormal(screenCoord);
+	
+	vec4 mat = texture2D(gBufferMaterial, screenCoord);
+	vec3 diffuse = mat.rgb;
+	vec3 spec = texture2D(gBufferMaterialSpecular, screenCoord).rgb;
+	float shine = mat.a * 255.0F;
+
+	fragColor = vec4(calculatePointLight(pointLight, camera, pos, norm, shine,
+        spec, diffuse), 1.0F);
+}
@@ -0,0 +1,30 @@
+#version 330 core
+
+#include <../../../../standard/light/blinn-phong/blinnPhongSpot.glsl>
+#include <../gBufferCompact.glsl>
+
+uniform SpotLight spotLight; // The spot light
+uniform Camera camera;
+
+uniform sampler2D gBufferMaterialSpecular;
+
+uniform sampler2D shadowMap;
+
+out vec4 fragColor;
+
+void main() {
+    vec2 screenCoord = getScreenCoordinates(camera);
+    
+    vec3 pos = readGBufferPosition(camera, screenCoord);
+    vec3 norm = readGBufferNormal(screenCoord);
+	
+	vec4 mat = texture2D(gBufferMaterial, screenCoord);
+	vec3 diffuse = mat.rgb;
+	vec3 spec = texture2D(gBufferMaterialSpecular, screenCoord).rgb;
+	float shine = mat.a * 255.0F;
+
+	vec4 shadowCoords = spotLight.shadow.projection * vec4(pos, 1.0F);
+
+	fragColor = vec4(calculateSpotLight(spotLight, camera, pos, norm, shine, 
+		spec, diffuse, shadowMap, shadowCoords), 1.0F);
+}
@@ -0,0 +1,39 @@
+#ifndef G_BUFFER_COMPACT_GLSL
+#define G_BUFFER_COMPACT_GLSL
+
+///
+/// Functions for reading the compact G-Buffer layout from the light shaders.
+///
+
+#include <../../../util/packing.glsl>
+#include <../../../standard/structs/stdCamera.glsl>
+
+uniform sampler2D gBufferNormal;
+uniform sampler2D gBufferMaterial;
+uniform sampler2D gBufferDepth;
+
+/// Fetches the screen coordinates of this fragment.
+/// Camera cam : The camera with which the scene is rendered.
+/// return : The screen coordinates, in [0, 1].
+vec2 getScreenCoordinates(Camera cam) {
+	return vec2(gl_FragCoord.x / cam.width, gl_FragCoord.y / cam.height);
+}
+
+/// Reads the world position of the fragment at the specified screen
+/// coordinates by reconstructing it from the depth buffer.
+/// Camera cam : The camera with which the scene is rendered.
+/// vec2 screenCoord : The screen coordinates of the fragment.
+/// return : The world position of the fragment.
+vec3 readGBufferPosition(Camera cam, vec2 screenCoord) {
+	float depth = texture2D(gBufferDepth, screenCoord).r;
+	return reconstructWorldPosition(cam, screenCoord, depth);
+}
+
+/// Reads the normal of the fragment at the specified screen coordinates.
+/// vec2 screenCoord : The screen coordinates of the fragment.
+/// return : The unit normal of the fragment.
+vec3 readGBufferNormal(vec2 screenCoord) {
+	return unpackNormalOctahedron(texture2D(gBufferNormal, screenCoord).rg);
+}
+
+#endif
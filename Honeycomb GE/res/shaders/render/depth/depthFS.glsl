@@ -0,0 +1,12 @@
+///
+/// This Fragment Shader is used for the depth prepass of the renderers. No
+/// color is written; the depth is written automatically.
+///
+
+#version 410 core
+
+#include <../../util/dither.glsl>
+
+void main() {
+	ditherFade();
+}
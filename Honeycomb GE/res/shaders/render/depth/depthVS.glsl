@@ -0,0 +1,27 @@
+///
+/// This Vertex Shader is used for the depth prepass of the renderers. Only
+/// the depth of the geometry is written, so that the following pass may skip
+/// any fragment which is hidden behind some other surface.
+///
+
+#version 410 core
+
+#include <../../standard/structs/stdCamera.glsl>
+#include <../../standard/structs/stdMaterial.glsl>
+#include <../../standard/vertex/stdVertexVS.glsl>
+#include <../../standard/vertex/stdTransformVS.glsl>
+
+// The position must be computed exactly as in the geometry vertex shader, so
+// that the following pass may test against the prepass depth with GL_EQUAL.
+invariant gl_Position;
+
+uniform Camera camera;			// Camera Structure
+uniform Material material;		// tmp... MeshRenderer requires it for now
+
+void main() {
+	float a = material.refractiveIndex;
+	mat4 objTransform = getObjTransform();
+
+	gl_Position = camera.projection * objTransform * vertexIn.position;
+	vertexOut.position = (objTransform * vertexIn.position).xyz;
+}
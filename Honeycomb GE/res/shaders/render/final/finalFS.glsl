@@ -0,0 +1,20 @@
+///
+/// This Fragment Shader writes the final image to the window, applying the
+/// per-pixel post processing effects and the gamma correction on the way, so
+/// that none of them need a full screen pass of their own.
+///
+
+#version 410 core
+
+#include <postEffects.glsl>
+#include <../../standard/vertex/stdVertexFS.glsl>
+
+uniform sampler2D fsTexture; // The final image
+
+out vec4 color; // The post processed output image
+
+void main() {
+	// Post process the color but do not modify the alpha!
+	vec4 inColor = texture2D(fsTexture, vertexIn.texCoords0);
+	color = vec4(applyPostEffects(inColor.rgb), inColor.a);
+}
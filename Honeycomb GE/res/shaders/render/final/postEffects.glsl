@@ -0,0 +1,35 @@
+#ifndef POST_EFFECTS_GLSL
+#define POST_EFFECTS_GLSL
+
+///
+/// The per-pixel post processing effects, which are all applied at once by
+/// the pass which writes the final image to the window (see the PostEffect
+/// enum of the Renderer). The effects are applied in the order in which they
+/// are declared, followed by the gamma correction.
+///
+
+const int POST_EFFECT_TONEMAP		= 1; // Reinhard tone mapping
+const int POST_EFFECT_GRAYSCALE		= 2; // Luminance of the color
+const int POST_EFFECT_INVERSION		= 4; // One minus the color
+
+uniform int postEffects; // The bitmask of the enabled effects
+uniform float gamma; // The gamma value (one for the linear color space)
+
+/// Applies the enabled post processing effects and the gamma correction to
+/// the specified color.
+/// vec3 color : The linear color, which may exceed one.
+/// return : The post processed color.
+vec3 applyPostEffects(vec3 color) {
+	if ((postEffects & POST_EFFECT_TONEMAP) != 0)
+		color = color / (vec3(1.0F) + color);
+
+	if ((postEffects & POST_EFFECT_GRAYSCALE) != 0)
+		color = vec3(dot(color, vec3(0.2126F, 0.7152F, 0.0722F)));
+
+	if ((postEffects & POST_EFFECT_INVERSION) != 0)
+		color = vec3(1.0F) - clamp(color, 0.0F, 1.0F);
+
+	return pow(max(color, vec3(0.0F)), vec3(1.0F / gamma));
+}
+
+#endif
@@ -0,0 +1,201 @@
+///
+/// This Fragment Shader is used for shading the geometry in a single pass 
+/// using the Forward+ renderer. The point and spot lights which may affect 
+/// this fragment are fetched from the light list of the screen tile in which
+/// the fragment lies, while the ambient and directional lights are applied to
+/// every fragment. A single directional or spot light may cast a shadow, in
+/// which case it is written to its own uniform and samples the shadow map.
+///
+
+#version 410 core
+
+#include <../../util/dither.glsl>
+#include <../deferred/geometry/geometryMaterial.glsl>
+#include <../../standard/light/blinn-phong/blinnPhongAmbient.glsl>
+#include <../../standard/light/blinn-phong/blinnPhongDirectional.glsl>
+#include <../../standard/light/blinn-phong/blinnPhongPoint.glsl>
+#include <../../standard/light/blinn-phong/blinnPhongSpot.glsl>
+
+// Light Type "enumeration" (as written in the light data buffer)
+const int LIGHT_TYPE_POINT						= 0;
+const int LIGHT_TYPE_SPOT						= 1;
+const int LIGHT_TYPE_DIRECTIONAL				= 2;
+
+// Number of RGBA32F texels used by each light in the light data buffer
+const int LIGHT_DATA_STRIDE						= 4;
+
+uniform AmbientLight ambientLight;	// Sum of all of the Ambient Lights
+
+uniform samplerBuffer lightData;	// Data of all Directional, Point & Spot
+uniform usamplerBuffer lightGrid;	// Offset & Count of the Lights per Tile
+uniform usamplerBuffer lightIndices;// Light Indices of all of the Tiles
+
+uniform int directionalLightCount;	// Directional Lights at start of Data
+uniform int tileSize;				// Size of a Tile in pixels
+uniform int tileCountX;				// Number of Tiles in each row
+
+uniform int shadowLightType;		// Type of the Shadow Light (-1 if none)
+uniform DirectionalLight directionalLight;	// Shadow Light, if directional
+uniform SpotLight spotLight;		// Shadow Light, if spot
+uniform sampler2D shadowMap;		// Shadow Map of the Shadow Light
+
+layout (location = 0) out vec4 fragColor;
+
+/// Fetches the texel of the light at the specified index.
+/// int index : The index of the light in the light data buffer.
+/// int texel : The texel of the light [0, LIGHT_DATA_STRIDE).
+/// return : The texel.
+vec4 fetchLightTexel(int index, int texel) {
+	return texelFetch(lightData, index * LIGHT_DATA_STRIDE + texel);
+}
+
+/// Builds the base light of the light at the specified index.
+/// int index : The index of the light in the light data buffer.
+/// return : The base light.
+BaseLight readBaseLight(int index) {
+	vec4 colorIntensity = fetchLightTexel(index, 1);
+
+	BaseLight base;
+	base.color = colorIntensity.rgb;
+	base.intensity = colorIntensity.a;
+
+	return base;
+}
+
+/// Builds the attenuation of the light at the specified index.
+/// int index : The index of the light in the light data buffer.
+/// return : The attenuation.
+Attenuation readAttenuation(int index) {
+	vec4 attenType = fetchLightTexel(index, 2);
+
+	Attenuation atten;
+	atten.constant = attenType.x;
+	atten.linear = attenType.y;
+	atten.quadratic = attenType.z;
+
+	return atten;
+}
+
+/// Builds a shadow which is never cast.
+/// return : The shadow.
+Shadow readShadowNone() {
+	Shadow shadow;
+	shadow.shadowType = SHADOW_TYPE_NONE;
+	shadow.projection = mat4(1.0F);
+	shadow.intensity = 0.0F;
+	shadow.softness = 0.0F;
+	shadow.minBias = 0.0F;
+	shadow.maxBias = 0.0F;
+
+	return shadow;
+}
+
+/// Builds the directional light at the specified index.
+/// int index : The index of the light in the light data buffer.
+/// return : The directional light.
+DirectionalLight readDirectionalLight(int index) {
+	DirectionalLight dL;
+	dL.base = readBaseLight(index);
+	dL.shadow = readShadowNone();
+	dL.direction = fetchLightTexel(index, 3).xyz;
+
+	return dL;
+}
+
+/// Builds the point light at the specified index.
+/// int index : The index of the light in the light data buffer.
+/// return : The point light.
+PointLight readPointLight(int index) {
+	vec4 posRange = fetchLightTexel(index, 0);
+
+	PointLight pL;
+	pL.base = readBaseLight(index);
+	pL.attenuation = readAttenuation(index);
+	pL.position = posRange.xyz;
+	pL.range = posRange.w;
+
+	return pL;
+}
+
+/// Builds the spot light at the specified index.
+/// int index : The index of the light in the light data buffer.
+/// return : The spot light.
+SpotLight readSpotLight(int index) {
+	vec4 posRange = fetchLightTexel(index, 0);
+	vec4 dirAngle = fetchLightTexel(index, 3);
+
+	SpotLight sL;
+	sL.base = readBaseLight(index);
+	sL.shadow = readShadowNone();
+	sL.attenuation = readAttenuation(index);
+	sL.position = posRange.xyz;
+	sL.direction = dirAngle.xyz;
+	sL.range = posRange.w;
+	sL.angle = dirAngle.w;
+
+	return sL;
+}
+
+void main() {
+	ditherFade();
+
+	// Calculate Parallax Displaced Texture Coordinates once
+	calculateDisplacedTexCoords();
+
+	// Calculate the material exactly as the geometry pass would
+	vec3 normal = normalize(calculateNormal());
+	vec3 reflectionVec = calculateReflection();
+	vec3 albedoVec = calculateAlbedo() * reflectionVec;
+	vec3 ambientVec = calculateAmbient() * albedoVec;
+	vec3 diffuseVec = calculateDiffuse() * albedoVec;
+	vec4 specularVec = calculateSpecular();
+	
+	vec3 pos = vertexIn.position;
+	vec3 spec = specularVec.rgb;
+	float shine = specularVec.a * 255.0F;
+
+	vec3 color = calculateAmbientLight(ambientLight) * ambientVec;
+
+	// The light which casts the shadow is computed exactly as the deferred
+	// light shaders compute it.
+	if (shadowLightType == LIGHT_TYPE_DIRECTIONAL) {
+		vec4 shadowCoords = directionalLight.shadow.projection *
+			vec4(pos, 1.0F);
+		color += calculateDirectionalLight(directionalLight, camera, pos,
+			normal, shine, spec, diffuseVec, shadowMap, shadowCoords);
+	} else if (shadowLightType == LIGHT_TYPE_SPOT) {
+		vec4 shadowCoords = spotLight.shadow.projection * vec4(pos, 1.0F);
+		color += max(calculateSpotLight(spotLight, camera, pos, normal,
+			shine, spec, diffuseVec, shadowMap, shadowCoords), vec3(0.0F));
+	}
+
+	for (int i = 0; i < directionalLightCount; ++i) {
+		color += calculateDirectionalLight(readDirectionalLight(i), camera,
+			pos, normal, shine, spec, diffuseVec, shadowMap, vec4(0.0F));
+	}
+
+	// Fetch the light list of the tile containing this fragment
+	ivec2 tile = ivec2(gl_FragCoord.xy) / tileSize;
+	uvec2 cell = texelFetch(lightGrid, tile.y * tileCountX + tile.x).rg;
+
+	for (uint i = 0U; i < cell.y; ++i) {
+		int index = int(texelFetch(lightIndices, int(cell.x + i)).r);
+		int type = int(fetchLightTexel(index, 2).w);
+
+		// Unlike the deferred light volumes, the tile may contain fragments
+		// which lie outside of the range of the light, so the (negative)
+		// contributions of those must be clamped.
+		vec3 light;
+		if (type == LIGHT_TYPE_SPOT) {
+			light = calculateSpotLight(readSpotLight(index), camera, pos,
+				normal, shine, spec, diffuseVec, shadowMap, vec4(0.0F));
+		} else {
+			light = calculatePointLight(readPointLight(index), camera, pos,
+				normal, shine, spec, diffuseVec);
+		}
+
+		color += max(light, vec3(0.0F));
+	}
+
+	fragColor = vec4(color, 1.0F);
+}
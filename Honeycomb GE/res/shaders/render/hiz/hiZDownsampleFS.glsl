@@ -0,0 +1,44 @@
+///
+/// This Fragment Shader builds one level of the Hierarchical Depth Buffer by
+/// writing the farthest depth of each 2x2 texel block of the source level.
+///
+
+#version 410 core
+
+uniform sampler2D hiZSource; // The depth level which is to be downsampled
+uniform vec2 sourceSize; // The width & height of the source level
+
+out float depth; // The farthest depth of the source texel block
+
+void main() {
+	ivec2 size = ivec2(sourceSize);
+	ivec2 coord = ivec2(gl_FragCoord.xy) * 2;
+	ivec2 last = size - ivec2(1);
+
+	// Fetch the 2x2 block (clamped, in case the source is a single texel)
+	float d0 = texelFetch(hiZSource, min(coord, last), 0).r;
+	float d1 = texelFetch(hiZSource, min(coord + ivec2(1, 0), last), 0).r;
+	float d2 = texelFetch(hiZSource, min(coord + ivec2(0, 1), last), 0).r;
+	float d3 = texelFetch(hiZSource, min(coord + ivec2(1, 1), last), 0).r;
+	depth = max(max(d0, d1), max(d2, d3));
+
+	// If the source size is odd, the last column (row) of this level also
+	// covers the extra column (row) of the source.
+	bool extraX = coord.x + 3 == size.x;
+	bool extraY = coord.y + 3 == size.y;
+	if (extraX) {
+		depth = max(depth, texelFetch(hiZSource,
+			min(coord + ivec2(2, 0), last), 0).r);
+		depth = max(depth, texelFetch(hiZSource,
+			min(coord + ivec2(2, 1), last), 0).r);
+	}
+	if (extraY) {
+		depth = max(depth, texelFetch(hiZSource,
+			min(coord + ivec2(0, 2), last), 0).r);
+		depth = max(depth, texelFetch(hiZSource,
+			min(coord + ivec2(1, 2), last), 0).r);
+	}
+	if (extraX && extraY) {
+		depth = max(depth, texelFetch(hiZSource, coord + ivec2(2, 2), 0).r);
+	}
+}
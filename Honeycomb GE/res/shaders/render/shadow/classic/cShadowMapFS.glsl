@@ -1,7 +1,11 @@
 #version 330 core
 
+#include <../../../util/dither.glsl>
+
 out vec4 color;
 
 void main() {
+	ditherFade();
+
 	color = vec4(gl_FragCoord.z, 0.0F, 0.0F, 0.0F);
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #version 330 core
 
+#include <../../../util/dither.glsl>
 #include <../../../standard/vertex/stdVertexFS.glsl>
 
 out vec4 color;
@@ -8,6 +9,8 @@ uniform vec3 lightPos;    // The world position of the light
 uniform float zFar;       // The far plane of the shadow render box
 
 void main() {
+	ditherFade();
+
 	// Get the distance between the fragment and the light
 	vec3 fragToLight = vertexIn.position - lightPos;
 	float dist = length(fragToLight);
@@ -1,8 +1,12 @@
 #version 330 core
 
+#include <../../../util/dither.glsl>
+
 out vec4 color;
 
 void main() {
+	ditherFade();
+
 	// Fetch the Depth value and calculate the partial derivatives of the depth
 	// with respect to X and Y coordinates.
 	float depth = gl_FragCoord.z;
@@ -3,14 +3,15 @@
 #include <../../../standard/vertex/stdVertexVS.glsl>
 #include <../../../standard/structs/stdCamera.glsl>
 #include <../../../standard/structs/stdMaterial.glsl>
+#include <../../../standard/vertex/stdTransformVS.glsl>
 
 uniform Camera camera;
 uniform mat4 lightProjection;
-uniform mat4 objTransform;
 uniform Material material;			// tmp... need to get rid of this but MeshRenderer requires it for now
 
 void main() {
 	float a = material.refractiveIndex;
+	mat4 objTransform = getObjTransform();
 
 	gl_Position = lightProjection * objTransform * vertexIn.position;
 	vertexOut.position = (objTransform * vertexIn.position).xyz;
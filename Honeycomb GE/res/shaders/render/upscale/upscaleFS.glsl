@@ -0,0 +1,76 @@
+///
+/// This Fragment Shader upscales the image which was rendered at a fraction
+/// of the window size to the full window size, using a Catmull-Rom bicubic
+/// filter which keeps the edges sharper than bilinear filtering would. The
+/// filtered color is clamped to the four nearest texels, so that the filter
+/// does not ring around strong edges. The per-pixel post processing effects
+/// are applied to the upscaled color.
+///
+
+#version 410 core
+
+#include <../final/postEffects.glsl>
+#include <../../standard/vertex/stdVertexFS.glsl>
+
+uniform sampler2D fsTexture; // The image to be upscaled
+
+out vec4 color; // The upscaled output image
+
+/// Fetches the specified texel of the image, clamped to its edges.
+/// ivec2 texel : The coordinates of the texel.
+/// ivec2 size : The size of the image, in texels.
+/// return : The color of the texel.
+vec4 fetchTexel(ivec2 texel, ivec2 size) {
+	return texelFetch(fsTexture, clamp(texel, ivec2(0), size - ivec2(1)), 0);
+}
+
+/// Computes the Catmull-Rom weights of the four texels surrounding a sample
+/// along one axis.
+/// float t : The position of the sample between the two middle texels.
+/// return : The weights of the four texels, which sum up to one.
+vec4 catmullRomWeights(float t) {
+	float t2 = t * t;
+	float t3 = t2 * t;
+
+	return vec4(
+		-0.5F * t3 + t2 - 0.5F * t,
+		 1.5F * t3 - 2.5F * t2 + 1.0F,
+		-1.5F * t3 + 2.0F * t2 + 0.5F * t,
+		 0.5F * t3 - 0.5F * t2);
+}
+
+void main() {
+	// Find the texel to the bottom left of the sample, and the position of
+	// the sample between it and the texel to its top right.
+	ivec2 size = textureSize(fsTexture, 0);
+	vec2 position = vertexIn.texCoords0 * vec2(size) - vec2(0.5F);
+	ivec2 base = ivec2(floor(position));
+	vec4 weightsX = catmullRomWeights(position.x - float(base.x));
+	vec4 weightsY = catmullRomWeights(position.y - float(base.y));
+
+	vec4 sum = vec4(0.0F);
+	vec4 nearestMin = vec4(1.0e30F);
+	vec4 nearestMax = vec4(-1.0e30F);
+
+	// Filter the 4x4 texels surrounding the sample
+	for (int y = 0; y < 4; ++y) {
+		vec4 row = vec4(0.0F);
+
+		for (int x = 0; x < 4; ++x) {
+			vec4 texel = fetchTexel(base + ivec2(x - 1, y - 1), size);
+			row += texel * weightsX[x];
+
+			if (x == 1 || x == 2) {
+				if (y == 1 || y == 2) {
+					nearestMin = min(nearestMin, texel);
+					nearestMax = max(nearestMax, texel);
+				}
+			}
+		}
+
+		sum += row * weightsY[y];
+	}
+
+	vec4 upscaled = clamp(sum, nearestMin, nearestMax);
+	color = vec4(applyPostEffects(upscaled.rgb), upscaled.a);
+}
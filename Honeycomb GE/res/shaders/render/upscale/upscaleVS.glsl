@@ -0,0 +1 @@
+#include <../../post-processing/postProcessingVS.glsl>
\ No newline at end of file
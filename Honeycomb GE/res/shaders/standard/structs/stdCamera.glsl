@@ -9,8 +9,25 @@ struct Camera {
 	float height; // The height of the projection
 
     mat4 projection; // The projection of the Camera
+    mat4 projectionInverse; // The inverse of the projection of the Camera
     mat4 view; // The view of the camera (Projection / Orien. & Trans.)
     vec3 translation; // The position of the Camera
 };
 
+/// Reconstructs the world position of a fragment from its screen coordinates
+/// and the value stored in the depth buffer for that fragment.
+/// Camera cam : The camera with which the depth buffer was rendered.
+/// vec2 screenCoord : The screen coordinates of the fragment, in [0, 1].
+/// float depth : The depth buffer value of the fragment, in [0, 1].
+/// return : The world position of the fragment.
+vec3 reconstructWorldPosition(Camera cam, vec2 screenCoord, float depth) {
+	// Convert the screen coordinates and depth into normalized device
+	// coordinates and unproject them using the inverse camera projection.
+	vec4 ndc = vec4(screenCoord * 2.0F - vec2(1.0F), depth * 2.0F - 1.0F, 
+		1.0F);
+	vec4 world = cam.projectionInverse * ndc;
+
+	return world.xyz / world.w;
+}
+
 #endif
\ No newline at end of file
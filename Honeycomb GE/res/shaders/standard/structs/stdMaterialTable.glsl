@@ -0,0 +1,122 @@
+#ifndef STD_MATERIAL_TABLE_GLSL
+#define STD_MATERIAL_TABLE_GLSL
+
+///
+/// Defines the Material Table, from which the objects of a multi-draw batch
+/// read their Standard Materials (see MaterialTable). Each material is stored
+/// as twelve RGBA32F texels of the table, and each of its textures as one
+/// layer of one of the texture array pages. The index of the material of the
+/// object which is being drawn is written by the vertex shader, and is
+/// negative if the material is written to the material uniform instead.
+///
+
+#include <stdMaterial.glsl>
+
+// Number of RGBA32F texels used by each material in the table
+const int MATERIAL_TABLE_STRIDE					= 12;
+
+// Rows of each material (the texture rows hold the page, layer & intensity)
+const int MATERIAL_ROW_ALBEDO_COLOR				= 0;
+const int MATERIAL_ROW_AMBIENT_COLOR			= 1;
+const int MATERIAL_ROW_DIFFUSE_COLOR			= 2;
+const int MATERIAL_ROW_SPECULAR_COLOR			= 3;
+const int MATERIAL_ROW_SCALARS					= 4; // Shine, Refr., Refl.
+const int MATERIAL_ROW_TILING_OFFSET			= 5;
+const int MATERIAL_ROW_ALBEDO_TEXTURE			= 6;
+const int MATERIAL_ROW_AMBIENT_TEXTURE			= 7;
+const int MATERIAL_ROW_DIFFUSE_TEXTURE			= 8;
+const int MATERIAL_ROW_SPECULAR_TEXTURE			= 9;
+const int MATERIAL_ROW_NORMALS_TEXTURE			= 10;
+const int MATERIAL_ROW_DISPLACEMENT_TEXTURE		= 11;
+
+uniform samplerBuffer materialTable;	// Texels of all of the materials
+uniform sampler2DArray materialPage0;	// Pages of the material textures
+uniform sampler2DArray materialPage1;
+uniform sampler2DArray materialPage2;
+uniform sampler2DArray materialPage3;
+uniform sampler2DArray materialPage4;
+uniform sampler2DArray materialPage5;
+uniform sampler2DArray materialPage6;
+uniform sampler2DArray materialPage7;
+
+flat in int objMaterialIndex;			// Index of the material of the object
+
+/// Returns whether the material of this object is read from the table.
+/// return : True if the material is in the table, false if it is written to
+///			 the material uniform.
+bool isMaterialTabled() {
+	return objMaterialIndex >= 0;
+}
+
+/// Reads the specified row of the material of this object from the table.
+/// int row : The row, one of the MATERIAL_ROW constants.
+/// return : The texel of the row.
+vec4 readMaterialTable(int row) {
+	return texelFetch(materialTable,
+		objMaterialIndex * MATERIAL_TABLE_STRIDE + row);
+}
+
+/// Samples the specified texture of the material of this object from its
+/// page. The page is the same for every fragment of a draw, so the samplers
+/// are only ever indexed uniformly.
+/// int row : The row of the texture, one of the MATERIAL_ROW constants.
+/// vec2 coord : The texture coordinates.
+/// return : The RGBA value of the texture at the coordinates.
+vec4 sampleMaterialTable(int row, vec2 coord) {
+	vec4 slot = readMaterialTable(row);
+	vec3 layerCoord = vec3(coord, slot.y);
+
+	switch (int(slot.x)) {
+	case 0: return texture(materialPage0, layerCoord);
+	case 1: return texture(materialPage1, layerCoord);
+	case 2: return texture(materialPage2, layerCoord);
+	case 3: return texture(materialPage3, layerCoord);
+	case 4: return texture(materialPage4, layerCoord);
+	case 5: return texture(materialPage5, layerCoord);
+	case 6: return texture(materialPage6, layerCoord);
+	default: return texture(materialPage7, layerCoord);
+	}
+}
+
+/// Transforms the specified texture coordinates according to the parallax
+/// displacement map of the material of this object, in the same way in which
+/// parallaxTransform transforms them for the material uniform.
+/// vec2 original : The original texture coordinates, which are to be
+///					transformed.
+/// vec3 eye : The eye view vector.
+/// return : The transformed texture coordinates.
+vec2 parallaxTransformTable(vec2 original, vec3 eye, mat3 tbn) {
+	int row = MATERIAL_ROW_DISPLACEMENT_TEXTURE;
+	float intensity = readMaterialTable(row).z;
+
+	// See parallaxTransform for the details of the steep parallax mapping
+	vec3 viewTBN = normalize(-eye * tbn);
+	float steepness = abs(dot(vec3(0.0F, 0.0F, 1.0F), viewTBN));
+	float layerCount = mix(
+		MAX_DISPLACEMENT_LAYERS, MIN_DISPLACEMENT_LAYERS, steepness);
+	float eachLayerDepth = 1.0F / layerCount;
+	float currentLayerDepth = 0.0F;
+
+	vec2 parallaxValue = viewTBN.xy * (intensity / 10.0F);
+	vec2 deltaTexCoords = parallaxValue / layerCount;
+
+	vec2 currentTexCoords = original;
+	float currentTextureDepth = sampleMaterialTable(row, currentTexCoords).r;
+
+	while (currentLayerDepth < currentTextureDepth) {
+		currentTexCoords -= deltaTexCoords;
+		currentTextureDepth = sampleMaterialTable(row, currentTexCoords).r;
+		currentLayerDepth += eachLayerDepth;
+	}
+
+	vec2 previousTexCoords = currentTexCoords + deltaTexCoords;
+	float afterDepth = currentTextureDepth - currentLayerDepth;
+	float beforeDepth = sampleMaterialTable(row, previousTexCoords).r -
+		currentLayerDepth + eachLayerDepth;
+
+	float interpolation = afterDepth / (afterDepth - beforeDepth);
+	return previousTexCoords * interpolation +
+		currentTexCoords * (1.0F - interpolation);
+}
+
+#endif
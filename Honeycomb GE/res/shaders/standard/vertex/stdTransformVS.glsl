@@ -0,0 +1,44 @@
+#ifndef STD_TRANSFORM_GLSL
+#define STD_TRANSFORM_GLSL
+
+///
+/// Defines the transformation of the object which is being drawn. Objects
+/// which are drawn on their own write their transform to objTransform, while
+/// objects which are drawn as part of a multi-draw batch store the rows of
+/// their transforms in the objTransforms buffer texture, and read them using
+/// the index of their transform (which is supplied, along with the index of
+/// their material in the Material Table, as an instanced attribute that
+/// starts at the base instance of each draw).
+///
+
+layout (location = 4) in ivec2 in_vs_drawData; // Transform & Material Index
+
+uniform mat4 objTransform;				// Transform Matrix (pos, rot, scl)
+uniform bool objIsBatched;				// Is the object part of a batch?
+uniform samplerBuffer objTransforms;	// Transform Matrices of the batch
+
+flat out int objMaterialIndex;			// Material Index (see stdMaterialTable)
+
+/// Returns the index of the material of the object which is being drawn
+/// within the Material Table.
+/// return : The index of the material, or -1 if the material is not in the
+///			 table.
+int getObjMaterialIndex() {
+	return objIsBatched ? in_vs_drawData.y : -1;
+}
+
+/// Returns the transform of the object which is being drawn.
+/// return : The transform matrix.
+mat4 getObjTransform() {
+	if (!objIsBatched) return objTransform;
+
+	// The transforms are stored row by row, see MultiDrawBatch
+	int row = in_vs_drawData.x * 4;
+	return transpose(mat4(
+		texelFetch(objTransforms, row + 0),
+		texelFetch(objTransforms, row + 1),
+		texelFetch(objTransforms, row + 2),
+		texelFetch(objTransforms, row + 3)));
+}
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef DITHER_GLSL
+#define DITHER_GLSL
+
+uniform float objFade; // The cross-fade of the object (0 if not fading)
+
+/// Returns the threshold of the 4x4 ordered (Bayer) dither matrix at the
+/// specified fragment, in the (0, 1) range.
+/// vec2 fragCoord : The window coordinates of the fragment.
+/// return : The dither threshold of the fragment.
+float ditherThreshold(vec2 fragCoord) {
+	const float bayer[16] = float[16](
+		 0.0F,  8.0F,  2.0F, 10.0F,
+		12.0F,  4.0F, 14.0F,  6.0F,
+		 3.0F, 11.0F,  1.0F,  9.0F,
+		15.0F,  7.0F, 13.0F,  5.0F);
+
+	ivec2 cell = ivec2(fragCoord) & 3;
+	return (bayer[cell.y * 4 + cell.x] + 0.5F) / 16.0F;
+}
+
+/// Discards the current fragment if it is not covered by the cross-fade of
+/// the object. A positive fade keeps the fragments whose threshold is below
+/// the fade, and a negative fade keeps the complementary fragments, so that
+/// an object which is faded in with a fade of p and faded out with a fade of
+/// -p covers each fragment exactly once.
+void ditherFade() {
+	if (objFade == 0.0F) return;
+
+	float threshold = ditherThreshold(gl_FragCoord.xy);
+	if (objFade > 0.0F ? threshold >= objFade : threshold < -objFade)
+		discard;
+}
+
+#endif
@@ -61,4 +61,43 @@ vec4 unpackRGBA(float pack) {
 	return vec4(r, g, b, a);
 }
 
+/// Encodes the specified unit normal vector into two components using an
+/// octahedral mapping. The returned components are in the range [0, 1] so
+/// that they may be stored in an unsigned normalized (RG8 or RG16) texture.
+/// vec3 normal : The unit normal vector to be encoded.
+/// return : The octahedral encoded normal.
+vec2 packNormalOctahedron(vec3 normal) {
+	// Project the normal onto the octahedron |x| + |y| + |z| = 1 and then
+	// onto the z = 0 plane.
+	vec3 n = normal / (abs(normal.x) + abs(normal.y) + abs(normal.z));
+	vec2 oct = n.xy;
+
+	// Fold the lower hemisphere over the diagonals of the upper hemisphere
+	if (n.z < 0.0F) {
+		vec2 signs = vec2(n.x >= 0.0F ? 1.0F : -1.0F, 
+			n.y >= 0.0F ? 1.0F : -1.0F);
+		oct = (vec2(1.0F) - abs(n.yx)) * signs;
+	}
+
+	return oct * 0.5F + vec2(0.5F);
+}
+
+/// Decodes the specified octahedral encoded normal back into a unit normal
+/// vector.
+/// vec2 pack : The octahedral encoded normal, in the range [0, 1].
+/// return : The decoded unit normal vector.
+vec3 unpackNormalOctahedron(vec2 pack) {
+	vec2 oct = pack * 2.0F - vec2(1.0F);
+	vec3 n = vec3(oct.x, oct.y, 1.0F - abs(oct.x) - abs(oct.y));
+
+	// Unfold the lower hemisphere, if this normal was folded when encoded
+	if (n.z < 0.0F) {
+		vec2 signs = vec2(n.x >= 0.0F ? 1.0F : -1.0F, 
+			n.y >= 0.0F ? 1.0F : -1.0F);
+		n.xy = (vec2(1.0F) - abs(n.yx)) * signs;
+	}
+
+	return normalize(n);
+}
+
 #endif
\ No newline at end of file
@@ -1,3 +1,8 @@
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <thread>
+
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
@@ -7,14 +12,18 @@
 #include "../../include/base/GameTime.h"
 #include "../../include/base/GameWindow.h"
 #include "../../include/debug/Logger.h"
+#include "../../include/job/JobSystem.h"
 #include "../../include/scene/GameScene.h"
 #include "../../include/render/RenderingEngine.h"
 
 using Honeycomb::Debug::Logger;
+using Honeycomb::Job::JobSystem;
 using Honeycomb::Render::RenderingEngine;
 using Honeycomb::Render::RenderingType;
 using Honeycomb::Scene::GameScene;
 
+using std::chrono::microseconds;
+
 namespace Honeycomb { namespace Base {
 	BaseMain& BaseMain::getBaseMain() {
 		static BaseMain *baseMain = new BaseMain();
@@ -29,6 +38,29 @@ namespace Honeycomb { namespace Base {
 		this->stop();
 	}
 
+	void BaseMain::exchangeFrames(const int64_t &frameTime) {
+		std::unique_lock<std::mutex> lock(this->frameMutex);
+		this->frameCondition.wait(lock, [this]() {
+			return this->isFrameReady;
+		});
+
+		// The simulation thread is waiting, so the window events (which may
+		// resize the renderers & feed the input) and the game may safely touch
+		// the scene.
+		GameWindow::getGameWindow()->pollEvents();
+		GameTime::getGameTime()->setDeltaTimeMS(frameTime / 1000.0F);
+		this->game->render();
+		std::swap(this->frontFrame, this->backFrame);
+
+		// "Is game running" is based on the window close requested event
+		this->isGameRunning = !GameWindow::getGameWindow()->isCloseRequested();
+		this->pendingFrameTime = frameTime;
+		this->isFrameReady = false;
+
+		lock.unlock();
+		this->frameCondition.notify_all();
+	}
+
 	void BaseMain::render() {
 		this->game->render();
 		if (GameScene::getActiveScene() != nullptr)
@@ -38,61 +70,131 @@ namespace Honeycomb { namespace Base {
 	}
 
 	void BaseMain::run() {
-		// The expected time that we should spend rendering each frame in order
-		// to hit the desired FPS count.
-		const float msPerFrame = (FRAME_RATE_CAP > 0) ?
-			1.0F / FRAME_RATE_CAP * GameTime::SECOND :
-			0.00000000001F;
+		GameTime *gameTime = GameTime::getGameTime();
+
+		// The expected time that we should spend on each frame in order to
+		// hit the desired FPS count (in microseconds), or zero if unlimited.
+		const int64_t usPerFrame = (FRAME_RATE_CAP > 0) ?
+			1000000 / FRAME_RATE_CAP : 0;
 
-		// Last time a frame was renderered and the time between frame renders,
-		// both are in milliseconds.
-		float lastTime = GameTime::getGameTime()->getElapsedTimeMS();
-		float deltaTime = 0;
+		// The time (in microseconds) at which the last frame started
+		int64_t lastTime = gameTime->getElapsedTimeUS();
+		this->accumulator = 0;
 
 		// The number of frames rendered in some amount of time that we spent
 		// rendering them (used to calculate the FPS).
 		int framesRendered = 0;
-		float timeSpentRenderingFrames = 0;
+		int64_t timeSpentRenderingFrames = 0;
+
+		// Start the simulation thread, which extracts the first frame right
+		// away (without updating the game).
+		if (PIPELINE_FRAMES) {
+			this->frontFrame = &this->frames[0];
+			this->backFrame = &this->frames[1];
+			this->isFrameReady = false;
+			this->pendingFrameTime = 0;
+			this->isGameRunning = true;
+			this->simulationThread =
+				std::thread(&BaseMain::simulateFrames, this);
+		}
 
 		do {
-			// Get the game time at the start of the loop and calculate the 
-			// delta time between the last loop iteration and the current. 
-			// Reset the last render time to the current loop start time.
-			float currentTime = GameTime::getGameTime()->getElapsedTimeMS();
-			deltaTime += currentTime - lastTime;
+			// Get the game time at the start of the frame and calculate the
+			// time which has passed since the start of the last frame.
+			int64_t currentTime = gameTime->getElapsedTimeUS();
+			int64_t frameTime = currentTime - lastTime;
 			lastTime = currentTime;
 
-			// If the time between this iteration and last iteration exceeds
-			// the minimum amount of time between frames -> Render & update.
-			if (deltaTime >= msPerFrame) {
-				update(); // Update the game
-				render(); // Render the game & the game window.
-
-				// Time spent rendering frames is to increase by how long it 
-				// took to render this frame.
-				timeSpentRenderingFrames += deltaTime;
-				framesRendered++;
-
-				// Record the time between frames in the Time namespace and
-				// reset the delta time for future iterations of the loop.
-				GameTime::getGameTime()->setDeltaTimeMS(deltaTime);
-				deltaTime = 0;
-
-				// If we have spent at least one second rendering the frames,
-				// we have the current number of frames for the last second.
-				// Reset the variables so the FPS can be calculated next frame.
-				if (timeSpentRenderingFrames >= GameTime::SECOND) {
-					Logger::getLogger().logEntry(__FUNCTION__, __LINE__,
-						"FPS: " + std::to_string(framesRendered));
-
-					timeSpentRenderingFrames = 0;
-					framesRendered = 0;
-				}
+			if (PIPELINE_FRAMES) {
+				// Render the frame which the simulation thread has extracted,
+				// while it simulates the time of this frame into the next one.
+				this->exchangeFrames(frameTime);
+				this->renderingEngine->render(*this->frontFrame);
+				GameWindow::getGameWindow()->swapBuffers();
+			} else {
+				// Update the game for all of the time which has passed, and
+				// render it with the time since the last frame as the delta
+				// time.
+				this->simulate(frameTime);
+				gameTime->setDeltaTimeMS(frameTime / 1000.0F);
+				render();
+
+				// "Is game running" is based on the window close requested
+				// event.
+				isGameRunning =
+					!GameWindow::getGameWindow()->isCloseRequested();
+			}
+
+			// If we have spent at least one second rendering the frames,
+			// we have the current number of frames for the last second.
+			// Reset the variables so the FPS can be calculated next frame.
+			timeSpentRenderingFrames += frameTime;
+			framesRendered++;
+			if (timeSpentRenderingFrames >= 1000000) {
+				Logger::getLogger().logEntry(__FUNCTION__, __LINE__,
+					"FPS: " + std::to_string(framesRendered));
+
+				timeSpentRenderingFrames = 0;
+				framesRendered = 0;
 			}
 
-			// "Is game running" is based on the window close requested event
-			isGameRunning = !GameWindow::getGameWindow()->isCloseRequested();
+			// Wait out the rest of the frame, if the frame rate is capped
+			if (usPerFrame > 0) this->waitUntil(currentTime + usPerFrame);
 		} while (isGameRunning);
+
+		// The simulation thread stops once it sees that the game has stopped
+		if (PIPELINE_FRAMES) this->simulationThread.join();
+	}
+
+	void BaseMain::simulate(const int64_t &frameTime) {
+		GameTime *gameTime = GameTime::getGameTime();
+
+		// Update the game in fixed steps for all of the time which has
+		// passed. If the updates fall too far behind (e.g. after a stall),
+		// drop the remaining steps rather than spiraling into ever longer
+		// frames.
+		int64_t fixedStep = std::max((int64_t)1, (int64_t)(
+			gameTime->getFixedDeltaTimeMS() * 1000.0F));
+		this->accumulator += frameTime;
+
+		gameTime->setDeltaTimeMS(gameTime->getFixedDeltaTimeMS());
+		for (int i = 0; i < MAX_UPDATES_PER_FRAME &&
+				this->accumulator >= fixedStep; ++i) {
+			update();
+			this->accumulator -= fixedStep;
+		}
+		this->accumulator %= fixedStep;
+
+		// The frame is rendered between the last update and the next one
+		gameTime->setInterpolationAlpha((float)this->accumulator / fixedStep);
+	}
+
+	void BaseMain::simulateFrames() {
+		while (true) {
+			// Wait until the main thread has taken the last frame
+			int64_t frameTime;
+			{
+				std::unique_lock<std::mutex> lock(this->frameMutex);
+				this->frameCondition.wait(lock, [this]() {
+					return !this->isFrameReady;
+				});
+
+				if (!this->isGameRunning) return;
+				frameTime = this->pendingFrameTime;
+			}
+
+			this->simulate(frameTime);
+			if (GameScene::getActiveScene() != nullptr)
+				this->backFrame->extract(*GameScene::getActiveScene());
+			else
+				this->backFrame->clear();
+
+			{
+				std::lock_guard<std::mutex> lock(this->frameMutex);
+				this->isFrameReady = true;
+			}
+			this->frameCondition.notify_all();
+		}
 	}
 
 	void BaseMain::start() {
@@ -114,6 +216,13 @@ namespace Honeycomb { namespace Base {
 		Logger::getLogger().logEntry(__FUNCTION__, __LINE__,
 			"All GLEW and GLFW initializations complete!");
 
+		// Start the worker threads on which the game & engine may run jobs
+		this->jobSystem = JobSystem::getJobSystem();
+		this->jobSystem->initialize();
+		Logger::getLogger().logEntry(__FUNCTION__, __LINE__,
+			"Job System started with " +
+			std::to_string(this->jobSystem->getWorkerCount()) + " workers!");
+
 		// Initialize the Game & Start!
 		this->game->start();
 	}
@@ -123,7 +232,8 @@ namespace Honeycomb { namespace Base {
 
 		this->game->stop();
 		if (GameScene::getActiveScene()) GameScene::getActiveScene()->onStop();
-		
+
+		this->jobSystem->destroy(); // Stop the worker threads
 		glfwTerminate(); // Terminate GLFW
 	}
 
@@ -136,4 +246,17 @@ namespace Honeycomb { namespace Base {
 
 		GameInput::getGameInput()->clear(); // Clear input in between frames
 	}
+
+	void BaseMain::waitUntil(const int64_t &time) {
+		GameTime *gameTime = GameTime::getGameTime();
+
+		int64_t remaining = time - gameTime->getElapsedTimeUS();
+		while (remaining > SLEEP_MARGIN) {
+			std::this_thread::sleep_for(microseconds(remaining / 2));
+			remaining = time - gameTime->getElapsedTimeUS();
+		}
+
+		while (gameTime->getElapsedTimeUS() < time)
+			std::this_thread::yield();
+	}
 } }
@@ -1,9 +1,12 @@
 #include "../../include/base/GameTime.h"
 
-#include <ctime>
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
 
 namespace Honeycomb { namespace Base {
 	const float GameTime::SECOND = 1000.0F;
+	const float GameTime::DEFAULT_FIXED_DELTA_TIME = GameTime::SECOND / 60.0F;
 
 	const float& GameTime::getDeltaTimeMS() const {
 		return this->deltaTime;
@@ -13,12 +16,29 @@ namespace Honeycomb { namespace Base {
 		return (this->deltaTime / SECOND);
 	}
 
-	float GameTime::getElapsedTimeMS() const {
-		return ((float)clock() / CLOCKS_PER_SEC * 1000.0F);
+	int64_t GameTime::getElapsedTimeUS() const {
+		return duration_cast<microseconds>(steady_clock::now() -
+			this->startTime).count();
 	}
 
-	float GameTime::getElapsedTimeS() const {
-		return ((float)clock() / CLOCKS_PER_SEC);
+	double GameTime::getElapsedTimeMS() const {
+		return this->getElapsedTimeUS() / 1000.0;
+	}
+
+	double GameTime::getElapsedTimeS() const {
+		return this->getElapsedTimeUS() / 1000000.0;
+	}
+
+	const float& GameTime::getFixedDeltaTimeMS() const {
+		return this->fixedDeltaTime;
+	}
+
+	float GameTime::getFixedDeltaTimeS() const {
+		return (this->fixedDeltaTime / SECOND);
+	}
+
+	const float& GameTime::getInterpolationAlpha() const {
+		return this->alpha;
 	}
 
 	GameTime* GameTime::getGameTime() {
@@ -26,7 +46,23 @@ namespace Honeycomb { namespace Base {
 		return gameTime;
 	}
 
+	void GameTime::setFixedDeltaTimeMS(const float &ms) {
+		if (ms > 0.0F) this->fixedDeltaTime = ms;
+	}
+
+	GameTime::GameTime() {
+		this->startTime = steady_clock::now();
+
+		this->deltaTime = 0.0F;
+		this->fixedDeltaTime = DEFAULT_FIXED_DELTA_TIME;
+		this->alpha = 0.0F;
+	}
+
 	void GameTime::setDeltaTimeMS(const float &ms) {
 		this->deltaTime = ms;
 	}
+
+	void GameTime::setInterpolationAlpha(const float &alpha) {
+		this->alpha = alpha;
+	}
 } }
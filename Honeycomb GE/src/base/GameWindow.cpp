@@ -36,9 +36,13 @@ namespace Honeycomb { namespace Base {
 		return glfwWindowShouldClose(this->glfwWindow) == 1;
 	}
 
-	void GameWindow::refresh() {
+	void GameWindow::pollEvents() {
 		glfwPollEvents();                    // Update window input
-		glfwSwapBuffers(this->glfwWindow);   // Swap the two buffers
+	}
+
+	void GameWindow::refresh() {
+		this->pollEvents();
+		this->swapBuffers();
 	}
 
 	void GameWindow::setWindowSize(
@@ -58,6 +62,10 @@ namespace Honeycomb { namespace Base {
 		glfwSetWindowTitle(this->glfwWindow, title.c_str());
 	}
 
+	void GameWindow::swapBuffers() {
+		glfwSwapBuffers(this->glfwWindow);   // Swap the two buffers
+	}
+
 	GameWindow::GameWindow() {
 		// Fetch video mode and set default parameters
 		videoMode = glfwGetVideoMode(glfwGetPrimaryMonitor());
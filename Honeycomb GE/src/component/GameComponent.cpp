@@ -2,8 +2,10 @@
 
 #include <sstream>
 
+#include "../../include/memory/PoolAllocator.h"
 #include "../../include/object/GameObject.h"
 
+using Honeycomb::Memory::PoolAllocator;
 using Honeycomb::Object::GameObject;
 using Honeycomb::Shader::ShaderProgram;
 
@@ -41,7 +43,9 @@ namespace Honeycomb { namespace Component {
 
 	GameComponent::GameComponent() {
 		this->isSelfActive = false;
+		this->isActive = false;
 		this->attached = nullptr;
+		this->poolHandle = { 0U, 0U };
 	}
 
 	GameComponent::~GameComponent() {
@@ -54,11 +58,13 @@ namespace Honeycomb { namespace Component {
 
 	void GameComponent::doDisable() {
 		this->isSelfActive = false;
+		this->updateIsActive();
 		this->onDisable();
 	}
 
 	void GameComponent::doEnable() {
 		this->isSelfActive = true;
+		this->updateIsActive();
 		this->onEnable();
 	}
 
@@ -71,15 +77,17 @@ namespace Honeycomb { namespace Component {
 	}
 
 	bool GameComponent::getIsActive() const {
-		if (!this->attached) return false;
-
-		return this->getIsSelfActive() && this->attached->getIsActive();
+		return this->isActive;
 	}
 
 	const bool& GameComponent::getIsSelfActive() const {
 		return this->isSelfActive;
 	}
 
+	const GameComponentHandle& GameComponent::getPoolHandle() const {
+		return this->poolHandle;
+	}
+
 	bool GameComponent::isAttached() const {
 		return this->attached != nullptr;
 	}
@@ -120,6 +128,18 @@ namespace Honeycomb { namespace Component {
 
 	}
 
+	void GameComponent::onUpdateCommit() {
+
+	}
+
+	void* GameComponent::operator new(std::size_t size) {
+		return PoolAllocator::getPoolAllocator()->allocate(size);
+	}
+
+	void GameComponent::operator delete(void *block, std::size_t size) {
+		PoolAllocator::getPoolAllocator()->deallocate(block, size);
+	}
+
 	GameComponentID GameComponent::getGameComponentIDCounter(bool inc) 
 			noexcept {
 		static GameComponentID type = 0U;
@@ -135,4 +155,13 @@ namespace Honeycomb { namespace Component {
 	bool GameComponent::getProperty_Permanent() const noexcept {
 		return false;
 	}
+
+	UpdateAccess GameComponent::getProperty_UpdateAccess() const noexcept {
+		return UpdateAccess::UPDATE_ACCESS_ANY;
+	}
+
+	void GameComponent::updateIsActive() {
+		this->isActive = this->isSelfActive && this->attached != nullptr &&
+			this->attached->getIsActive();
+	}
 } }
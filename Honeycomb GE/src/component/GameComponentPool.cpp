@@ -0,0 +1,55 @@
+#include "../../include/component/GameComponentPool.h"
+
+namespace Honeycomb { namespace Component {
+	GameComponentHandle GameComponentPool::add(GameComponent *component) {
+		unsigned int slot;
+		if (this->freeSlots.empty()) {
+			slot = (unsigned int)this->slots.size();
+			this->slots.push_back({ 0U, 0U });
+		} else {
+			slot = this->freeSlots.back();
+			this->freeSlots.pop_back();
+		}
+
+		this->slots[slot].index = (unsigned int)this->components.size();
+		this->components.push_back(component);
+		this->slotOf.push_back(slot);
+
+		return { slot, this->slots[slot].generation };
+	}
+
+	GameComponent* GameComponentPool::get(const GameComponentHandle &handle)
+			const {
+		if (handle.slot >= this->slots.size()) return nullptr;
+
+		const Slot &slot = this->slots[handle.slot];
+		if (slot.generation != handle.generation) return nullptr;
+
+		return this->components[slot.index];
+	}
+
+	const std::vector<GameComponent*>& GameComponentPool::getComponents()
+			const {
+		return this->components;
+	}
+
+	void GameComponentPool::remove(const GameComponentHandle &handle) {
+		if (this->get(handle) == nullptr) return;
+
+		// Move the last component into the place of the removed one, so that
+		// the array stays packed, and point the slot of the moved component
+		// at its new index.
+		Slot &slot = this->slots[handle.slot];
+		unsigned int last = (unsigned int)this->components.size() - 1;
+
+		this->components[slot.index] = this->components[last];
+		this->slotOf[slot.index] = this->slotOf[last];
+		this->slots[this->slotOf[slot.index]].index = slot.index;
+
+		this->components.pop_back();
+		this->slotOf.pop_back();
+
+		++slot.generation;
+		this->freeSlots.push_back(handle.slot);
+	}
+} }
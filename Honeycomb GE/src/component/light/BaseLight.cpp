@@ -1,12 +1,10 @@
 #include "../../../include/component/light/BaseLight.h"
 
-#include <algorithm>
 #include <cmath>
 #include <vector>
 
+#include "../../../include/component/light/PointLight.h"
 #include "../../../include/debug/Logger.h"
-#include "../../../include/object/GameObject.h"
-#include "../../../include/scene/GameScene.h"
 
 using Honeycomb::Debug::Logger;
 using Honeycomb::Math::Matrix4f;
@@ -53,29 +51,6 @@ namespace Honeycomb { namespace Component { namespace Light {
 		return this->type;
 	}
 
-	void BaseLight::onAttach() {
-		// If the object to which we are attached is attached to some scene,
-		// add this light to the scene's lights list.
-		if (this->attached != nullptr &&
-				this->attached->getScene() != nullptr) {
-			this->attached->getScene()->sceneLights.push_back(std::ref(*this));
-		}
-	}
-
-	void BaseLight::onDetach() {
-		// If the object to which we are attached is attached to some scene,
-		// remove this light to the scene's lights list.
-		if (this->attached != nullptr &&
-				this->attached->getScene() != nullptr) {
-			auto &sceneLights = this->attached->getScene()->sceneLights;
-
-			sceneLights.erase(std::remove_if(
-				sceneLights.begin(), sceneLights.end(), [&](auto &light) {
-					return &light.get() == this;
-			}));
-		}
-	}
-
 	void BaseLight::setColor(const Honeycomb::Math::Vector3f &col) {
 		this->getColor() = col;
 	}
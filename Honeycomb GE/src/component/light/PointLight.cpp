@@ -111,4 +111,8 @@ namespace Honeycomb { namespace Component { namespace Light {
 
 		return pL;
 	}
+
+	UpdateAccess PointLight::getProperty_UpdateAccess() const noexcept {
+		return UpdateAccess::UPDATE_ACCESS_OWN_STATE;
+	}
 } } }
@@ -22,6 +22,8 @@ namespace Honeycomb { namespace Component { namespace Render {
 	CameraController *CameraController::activeCamera = nullptr;
 
 	const std::string CameraController::PROJECTION_MAT4 = "projection";
+	const std::string CameraController::PROJECTION_INVERSE_MAT4 = 
+		"projectionInverse";
 	const std::string CameraController::VIEW_MAT4 = "view";
 	const std::string CameraController::TRANSLATION_VEC3 = "translation";
 	const std::string CameraController::WIDTH_F = "width";
@@ -210,6 +212,8 @@ namespace Honeycomb { namespace Component { namespace Render {
 		// Write new projection and view matrices to the GenericStruct
 		this->glMatrix4fs.setValue(CameraController::PROJECTION_MAT4,
 			this->projection);
+		this->glMatrix4fs.setValue(CameraController::PROJECTION_INVERSE_MAT4,
+			this->projection.getInverse());
 		this->glMatrix4fs.setValue(CameraController::VIEW_MAT4,
 			this->projectionView * this->projectionOrien);
 
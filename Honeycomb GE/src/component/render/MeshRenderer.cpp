@@ -3,33 +3,67 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <iostream>
 
 #include "../../../include/file/FileIO.h"
 #include "../../../include/component/physics/Transform.h"
 #include "../../../include/component/render/CameraController.h"
+#include "../../../include/base/GameTime.h"
 #include "../../../include/object/GameObject.h"
 #include "../../../include/render/Renderer.h"
 
+using Honeycomb::Base::GameTime;
 using Honeycomb::Component::Render::CameraController;
 using Honeycomb::Component::Physics::Transform;
 using Honeycomb::Geometry::Mesh;
 using Honeycomb::Graphics::Material;
+using Honeycomb::Math::Matrix4f;
+using Honeycomb::Math::Vector3f;
 using Honeycomb::Shader::ShaderProgram;
 using Honeycomb::Render::Renderer;
+using Honeycomb::Render::RenderFrame;
 
 using namespace Honeycomb::File;
 
 namespace Honeycomb { namespace Component { namespace Render {
+	const float MeshRenderer::LEVEL_OF_DETAIL_HYSTERESIS = 0.1F;
+	const float MeshRenderer::LEVEL_OF_DETAIL_FADE_DURATION = 0.25F;
+
 	MeshRenderer::MeshRenderer() {
+		this->isOccluder = false;
+		this->transform = nullptr;
+
+		this->lodLevel = 0;
+		this->lodFadeLevel = -1;
+		this->lodFadeProgress = 0.0F;
+		this->doLodCrossFade = true;
+	}
+
+	void MeshRenderer::addLevelOfDetail(const std::vector<std::shared_ptr<
+			Mesh>> &meshes, const float &screenSize) {
+		assert(meshes.size() == this->meshes.size());
+
+		// Keep the levels sorted from the largest to the smallest size
+		auto position = std::find_if(
+			this->lodScreenSizes.begin(), this->lodScreenSizes.end(),
+			[&](const float &size) {
+				return size < screenSize;
+		});
+		std::size_t index = position - this->lodScreenSizes.begin();
 
+		this->lodScreenSizes.insert(position, screenSize);
+		this->lodMeshes.insert(this->lodMeshes.begin() + index, meshes);
 	}
 
 	void MeshRenderer::addMaterial(const std::shared_ptr<Material> &material) {
 		assert(material != nullptr);
 
 		this->materials.push_back(material);
+		if (!this->sharedMaterials.empty())
+			this->sharedMaterials.push_back(false);
 	}
 
 	void MeshRenderer::addMesh(const std::shared_ptr<Mesh> &mesh) {
@@ -42,17 +76,100 @@ namespace Honeycomb { namespace Component { namespace Render {
 		return std::unique_ptr<MeshRenderer>(this->cloneInternal());
 	}
 
+	void MeshRenderer::getBounds(Vector3f &min, Vector3f &max) const {
+		// Merge the local bounding boxes of all of the meshes
+		float lMin[3] = { 0.0F, 0.0F, 0.0F };
+		float lMax[3] = { 0.0F, 0.0F, 0.0F };
+		for (std::size_t i = 0; i < this->meshes.size(); ++i) {
+			const Vector3f &mMin = this->meshes[i]->getBoundsMin();
+			const Vector3f &mMax = this->meshes[i]->getBoundsMax();
+			float meshMin[3] = { mMin.getX(), mMin.getY(), mMin.getZ() };
+			float meshMax[3] = { mMax.getX(), mMax.getY(), mMax.getZ() };
+
+			for (int j = 0; j < 3; ++j) {
+				lMin[j] = (i == 0) ? meshMin[j] : std::min(lMin[j], meshMin[j]);
+				lMax[j] = (i == 0) ? meshMax[j] : std::max(lMax[j], meshMax[j]);
+			}
+		}
+
+		// Transform the center of the box and project its half extents onto
+		// the world axes, which yields the box containing the transformed box.
+		const Matrix4f &m = this->transform->getMatrixTransformation();
+		float wMin[3], wMax[3];
+		for (int r = 0; r < 3; ++r) {
+			float center = m.getAt(r, 3);
+			float extent = 0.0F;
+
+			for (int c = 0; c < 3; ++c) {
+				center += m.getAt(r, c) * (lMin[c] + lMax[c]) * 0.5F;
+				extent += std::abs(m.getAt(r, c)) * (lMax[c] - lMin[c]) * 0.5F;
+			}
+
+			wMin[r] = center - extent;
+			wMax[r] = center + extent;
+		}
+
+		min = Vector3f(wMin[0], wMin[1], wMin[2]);
+		max = Vector3f(wMax[0], wMax[1], wMax[2]);
+	}
+
+	const int& MeshRenderer::getLevelOfDetail() const {
+		return this->lodLevel;
+	}
+
+	int MeshRenderer::getLevelOfDetailCount() const {
+		return (int)this->lodMeshes.size() + 1;
+	}
+
+	bool MeshRenderer::getIsBatchable() const {
+		if (this->transform == nullptr || this->lodFadeLevel != -1 ||
+			this->transform->isOddNegativelyScaled()) return false;
+
+		const std::vector<std::shared_ptr<Mesh>> &meshes =
+			this->getLevelMeshes(this->lodLevel);
+		if (this->materials.size() != 1 &&
+			this->materials.size() != meshes.size()) return false;
+
+		for (auto &mesh : meshes)
+			if (!mesh->getIsInGeometryArena()) return false;
+
+		return true;
+	}
+
+	const bool& MeshRenderer::getIsOccluder() const {
+		return this->isOccluder;
+	}
+
 	GameComponentID MeshRenderer::getGameComponentID() const noexcept {
 		return GameComponent::getGameComponentTypeID<MeshRenderer>();
 	}
 
+	std::shared_ptr<const Material> MeshRenderer::getMaterial(
+			const std::size_t &index) const {
+		return this->materials[index];
+	}
+
+	std::size_t MeshRenderer::getMaterialCount() const {
+		return this->materials.size();
+	}
+
 	std::vector<std::shared_ptr<Material>>& MeshRenderer::getMaterials() {
+		// Any of the materials may be written to (and the list itself may be
+		// changed), so this Mesh Renderer can no longer share any of them.
+		for (std::size_t i = 0; i < this->sharedMaterials.size(); ++i) {
+			if (this->sharedMaterials[i])
+				this->materials[i] = std::make_shared<Material>(
+					*this->materials[i]);
+		}
+		this->sharedMaterials.clear();
+
 		return this->materials;
 	}
 
-	const std::vector<std::shared_ptr<Material>>& MeshRenderer::getMaterials() 
+	std::vector<std::shared_ptr<const Material>> MeshRenderer::getMaterials()
 			const {
-		return this->materials;
+		return std::vector<std::shared_ptr<const Material>>(
+			this->materials.begin(), this->materials.end());
 	}
 
 	std::vector<std::shared_ptr<Mesh>>& MeshRenderer::getMeshes() {
@@ -63,6 +180,19 @@ namespace Honeycomb { namespace Component { namespace Render {
 		return this->meshes;
 	}
 
+	std::shared_ptr<Material> MeshRenderer::getWritableMaterial(
+			const std::size_t &index) {
+		// Only this material may be written to, so only it is copied
+		if (index < this->sharedMaterials.size() &&
+				this->sharedMaterials[index]) {
+			this->materials[index] = std::make_shared<Material>(
+				*this->materials[index]);
+			this->sharedMaterials[index] = false;
+		}
+
+		return this->materials[index];
+	}
+
 	void MeshRenderer::onAttach() {
 		this->transform = &this->getAttached()->getComponent<Transform>();
 	}
@@ -72,44 +202,85 @@ namespace Honeycomb { namespace Component { namespace Render {
 	}
 
 	void MeshRenderer::onRender(ShaderProgram &shader) {
+		RenderFrame::Object object;
+		this->toRenderObject(object);
+
+		MeshRenderer::render(shader, object);
+	}
+
+	void MeshRenderer::onUpdate() {
+		// Advance the cross-fade, if one is in progress
+		if (this->lodFadeLevel != -1) {
+			this->lodFadeProgress += GameTime::getGameTime()->getDeltaTimeS() /
+				MeshRenderer::LEVEL_OF_DETAIL_FADE_DURATION;
+
+			if (this->lodFadeProgress >= 1.0F) {
+				this->lodFadeLevel = -1;
+				this->lodFadeProgress = 0.0F;
+			}
+		}
+
+		if (this->lodMeshes.empty()) return;
+
+		// Move to a coarser level while the size is clearly below the
+		// threshold of the next level, and to a finer level while the size
+		// is clearly above the threshold of the current level.
+		float size = this->calcScreenSize();
+		float lower = 1.0F - MeshRenderer::LEVEL_OF_DETAIL_HYSTERESIS;
+		float upper = 1.0F + MeshRenderer::LEVEL_OF_DETAIL_HYSTERESIS;
+		int level = this->lodLevel;
+		while (level < (int)this->lodScreenSizes.size() &&
+				size < this->lodScreenSizes[level] * lower)
+			++level;
+		while (level > 0 && size > this->lodScreenSizes[level - 1] * upper)
+			--level;
+
+		if (level == this->lodLevel) return;
+
+		// Start a new fade from the current level (if a fade is already in
+		// progress, its old level simply stops being rendered).
+		if (this->doLodCrossFade) {
+			this->lodFadeLevel = this->lodLevel;
+			this->lodFadeProgress = 0.0F;
+		}
+		this->lodLevel = level;
+	}
+
+	void MeshRenderer::render(ShaderProgram &shader,
+			const RenderFrame::Object &object) {
 		// Write the Transformation Matrix to the Shader
-		shader.setUniform_mat4("objTransform",
-			this->transform->getMatrixTransformation());
+		shader.setUniform_mat4("objTransform", object.transform);
 
-		// If the current Transform is negatively scaled on an odd number of
-		// axes, then flip the winding order for the front face.
+		// If the Transform is negatively scaled on an odd number of axes,
+		// then flip the winding order for the front face.
 		Renderer::WindingOrder frontFace = Renderer::getRenderer()->frontFace;
-		if (this->transform->isOddNegativelyScaled()) {
+		if (object.isOddNegativelyScaled) {
 			if (frontFace == Renderer::WindingOrder::CLOCKWISE)
 				glFrontFace(Renderer::WindingOrder::COUNTER_CLOCKWISE);
 			else
 				glFrontFace(Renderer::WindingOrder::CLOCKWISE);
 		}
 
-		// Assert meshes == materials if materials > 1
-		if (this->materials.size() > 1)
-			assert(this->meshes.size() == this->materials.size());
+		// While fading, the new level keeps the dithered texels in which the
+		// threshold is below the progress, and the old level keeps the rest.
+		if (!object.fading.empty()) {
+			shader.setUniform_f("objFade",
+				std::max(object.fadeProgress, 0.001F));
+			MeshRenderer::renderMeshes(shader, object.meshes,
+				object.materials);
 
-		// If meshes == materials == 1 -> Render the Mesh using the Material
-		if (this->meshes.size() == 1 && this->materials.size() == 1) {
-			this->materials[0]->toShader(shader, "material");
-			this->meshes[0]->render(shader);
-		} 
-		// If meshes > 1, materials == 1 -> Render each Mesh using the Material
-		else if (this->meshes.size() > 1 && this->materials.size() == 1) {
-			this->materials[0]->toShader(shader, "material");
-			for (auto &mesh : this->meshes) mesh->render(shader);
-		}
-		// If meshes == materials > 1 -> Render each Mesh using each Material
-		else {
-			for (std::size_t i = 0; i < this->meshes.size(); ++i) {
-				this->materials[i]->toShader(shader, "material");
-				this->meshes[i]->render(shader);
-			}
+			shader.setUniform_f("objFade", -object.fadeProgress);
+			MeshRenderer::renderMeshes(shader, object.fading,
+				object.materials);
+
+			shader.setUniform_f("objFade", 0.0F);
+		} else {
+			MeshRenderer::renderMeshes(shader, object.meshes,
+				object.materials);
 		}
 
 		// Undo the winding order flip for the front face, if necessary.
-		if (this->transform->isOddNegativelyScaled()) {
+		if (object.isOddNegativelyScaled) {
 			glFrontFace(frontFace);
 		}
 	}
@@ -123,6 +294,10 @@ namespace Honeycomb { namespace Component { namespace Render {
 		});
 		if (materialFind == this->materials.end()) return;
 
+		if (!this->sharedMaterials.empty()) {
+			this->sharedMaterials.erase(this->sharedMaterials.begin() +
+				(materialFind - this->materials.begin()));
+		}
 		this->materials.erase(materialFind);
 	}
 
@@ -137,12 +312,117 @@ namespace Honeycomb { namespace Component { namespace Render {
 		this->meshes.erase(meshFind);
 	}
 
+	void MeshRenderer::setDoLevelOfDetailCrossFade(const bool &fade) {
+		this->doLodCrossFade = fade;
+
+		if (!fade) {
+			this->lodFadeLevel = -1;
+			this->lodFadeProgress = 0.0F;
+		}
+	}
+
+	void MeshRenderer::setIsOccluder(const bool &occluder) {
+		this->isOccluder = occluder;
+	}
+
+	void MeshRenderer::shareMaterials() {
+		this->sharedMaterials.assign(this->materials.size(), true);
+	}
+
+	void MeshRenderer::toRenderObject(RenderFrame::Object &object) const {
+		object.transform = this->transform->getMatrixTransformation();
+		this->getBounds(object.boundsMin, object.boundsMax);
+		object.position = this->transform->getGlobalTranslation();
+		object.isOddNegativelyScaled = this->transform->isOddNegativelyScaled();
+		object.isBatchable = this->getIsBatchable();
+		object.isOccluder = this->isOccluder;
+
+		object.meshes = this->getLevelMeshes(this->lodLevel);
+		if (this->lodFadeLevel != -1)
+			object.fading = this->getLevelMeshes(this->lodFadeLevel);
+		else
+			object.fading.clear();
+		object.fadeProgress = this->lodFadeProgress;
+
+		if (this->isOccluder) object.occluderMeshes = this->meshes;
+		else object.occluderMeshes.clear();
+
+		object.materials = this->materials;
+	}
+
+	float MeshRenderer::calcScreenSize() const {
+		CameraController *camera = CameraController::getActiveCamera();
+		if (camera == nullptr || this->meshes.empty()) return 0.0F;
+
+		// Use the bounding sphere of the world space bounds
+		Vector3f min, max;
+		this->getBounds(min, max);
+		Vector3f center = (min + max) * 0.5F;
+		float radius = (max - min).magnitude() * 0.5F;
+
+		// The vertical projection scale is cot(FOV / 2) for a perspective
+		// camera and 1 / top for an orthographic camera, both of which map
+		// a size in view space onto the [-1, 1] height of the screen.
+		float scale = camera->getProjectionView().getAt(1, 1);
+		if (camera->getProjectionType() == CameraController::PERSPECTIVE) {
+			const Vector3f &eye = camera->getAttached()->
+				getComponent<Transform>().getGlobalTranslation();
+			float distance = (center - eye).magnitude();
+			if (distance <= radius) return 1.0F;
+
+			scale /= distance;
+		}
+
+		return radius * scale;
+	}
+
+	const std::vector<std::shared_ptr<Mesh>>& MeshRenderer::getLevelMeshes(
+			const int &level) const {
+		return (level == 0) ? this->meshes : this->lodMeshes[level - 1];
+	}
+
+	void MeshRenderer::renderMeshes(ShaderProgram &shader, 
+			const std::vector<std::shared_ptr<Mesh>> &meshes,
+			const std::vector<std::shared_ptr<Material>> &materials) {
+		// Assert meshes == materials if materials > 1
+		if (materials.size() > 1)
+			assert(meshes.size() == materials.size());
+
+		// If meshes == materials == 1 -> Render the Mesh using the Material
+		if (meshes.size() == 1 && materials.size() == 1) {
+			materials[0]->toShader(shader, "material");
+			meshes[0]->render(shader);
+		} 
+		// If meshes > 1, materials == 1 -> Render each Mesh using the Material
+		else if (meshes.size() > 1 && materials.size() == 1) {
+			materials[0]->toShader(shader, "material");
+			for (auto &mesh : meshes) mesh->render(shader);
+		}
+		// If meshes == materials > 1 -> Render each Mesh using each Material
+		else {
+			for (std::size_t i = 0; i < meshes.size(); ++i) {
+				materials[i]->toShader(shader, "material");
+				meshes[i]->render(shader);
+			}
+		}
+	}
+
 	MeshRenderer* MeshRenderer::cloneInternal() const {
 		MeshRenderer* mR = new MeshRenderer();
 
 		for (auto &m : this->meshes) mR->addMesh(m);
 		for (auto &m : this->materials) mR->addMaterial(m);
+		mR->setIsOccluder(this->isOccluder);
+		mR->sharedMaterials = this->sharedMaterials;
+
+		mR->lodMeshes = this->lodMeshes;
+		mR->lodScreenSizes = this->lodScreenSizes;
+		mR->doLodCrossFade = this->doLodCrossFade;
 
 		return mR;
 	}
+
+	UpdateAccess MeshRenderer::getProperty_UpdateAccess() const noexcept {
+		return UpdateAccess::UPDATE_ACCESS_OWN_STATE;
+	}
 } } }
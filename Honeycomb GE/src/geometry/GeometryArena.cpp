@@ -0,0 +1,334 @@
+#include "../../include/geometry/GeometryArena.h"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include "../../include/base/GLErrorException.h"
+
+using Honeycomb::Base::GLErrorException;
+using Honeycomb::Base::GLItemNotInitializedException;
+
+namespace Honeycomb { namespace Geometry {
+	const std::size_t GeometryArena::INITIAL_VERTEX_CAPACITY = 1 << 18;
+	const std::size_t GeometryArena::INITIAL_INDEX_CAPACITY = 1 << 20;
+
+	bool GeometryArena::isEnabled = true;
+
+	GeometryArena* GeometryArena::getGeometryArena() {
+		static GeometryArena *arena = new GeometryArena();
+		if (!arena->isInitialized) arena->initialize();
+
+		return arena;
+	}
+
+	const bool& GeometryArena::getIsEnabled() {
+		return GeometryArena::isEnabled;
+	}
+
+	void GeometryArena::setIsEnabled(const bool &enabled) {
+		GeometryArena::isEnabled = enabled;
+	}
+
+	int GeometryArena::allocateIndices(const std::size_t &count) {
+		return this->allocate(this->indices, count);
+	}
+
+	int GeometryArena::allocateVertices(const std::size_t &count) {
+		return this->allocate(this->vertices, count);
+	}
+
+	void GeometryArena::bindBuffers() const {
+		glBindBuffer(GL_ARRAY_BUFFER, this->vertices.bufferObject);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->indices.bufferObject);
+
+		// All of the attributes have the same number of elements, see
+		// Mesh::render.
+		for (int i = 0; i < Vertex::ATTRIBUTES_PER_VERTEX_COUNT; ++i) {
+			glEnableVertexAttribArray(i);
+			glVertexAttribPointer(i, Vertex::ELEMENTS_PER_ATTRIBUTE_COUNT,
+				GL_FLOAT, GL_FALSE, Vertex::ELEMENTS_PER_VERTEX_SIZE,
+				(void*)(std::size_t)(Vertex::ELEMENTS_PER_ATTRIBUTE_SIZE * i));
+		}
+	}
+
+	void GeometryArena::defragment() {
+		GLErrorException::clear();
+		if (!this->isInitialized) throw GLItemNotInitializedException(this);
+
+		this->defragment(this->vertices);
+		this->defragment(this->indices);
+
+		GLErrorException::checkGLError(__FILE__, __LINE__);
+	}
+
+	void GeometryArena::destroy() {
+		GLErrorException::clear();
+		if (!this->isInitialized) throw GLItemNotInitializedException(this);
+
+		GLuint vbo = this->vertices.bufferObject;
+		GLuint ibo = this->indices.bufferObject;
+		glDeleteBuffers(1, &vbo);
+		glDeleteBuffers(1, &ibo);
+
+		for (Pool *pool : { &this->vertices, &this->indices }) {
+			pool->bufferObject = 0;
+			pool->capacity = 0;
+			pool->freeRanges.clear();
+			pool->allocations.clear();
+		}
+
+		this->isInitialized = false;
+		GLErrorException::checkGLError(__FILE__, __LINE__);
+	}
+
+	const std::size_t& GeometryArena::getBaseVertex(const int &allocation)
+			const {
+		return this->vertices.allocations.at(allocation).offset;
+	}
+
+	const std::size_t& GeometryArena::getFirstIndex(const int &allocation)
+			const {
+		return this->indices.allocations.at(allocation).offset;
+	}
+
+	float GeometryArena::getFragmentation() const {
+		std::size_t freeCount = 0;
+		std::size_t largest = 0;
+		for (const Pool *pool : { &this->vertices, &this->indices }) {
+			std::size_t poolLargest = 0;
+			for (auto &range : pool->freeRanges) {
+				freeCount += range.second;
+				poolLargest = std::max(poolLargest, range.second);
+			}
+
+			largest += poolLargest;
+		}
+
+		return (freeCount == 0) ? 0.0F :
+			(float)(freeCount - largest) / freeCount;
+	}
+
+	const int& GeometryArena::getIndexBufferObject() const {
+		return this->indices.bufferObject;
+	}
+
+	const int& GeometryArena::getVertexBufferObject() const {
+		return this->vertices.bufferObject;
+	}
+
+	void GeometryArena::freeIndices(const int &allocation) {
+		auto find = this->indices.allocations.find(allocation);
+		if (find == this->indices.allocations.end()) return;
+
+		this->free(this->indices, find->second);
+		this->indices.allocations.erase(find);
+	}
+
+	void GeometryArena::freeVertices(const int &allocation) {
+		auto find = this->vertices.allocations.find(allocation);
+		if (find == this->vertices.allocations.end()) return;
+
+		this->free(this->vertices, find->second);
+		this->vertices.allocations.erase(find);
+	}
+
+	void GeometryArena::initialize() {
+		GLErrorException::clear();
+		GLItem::initialize();
+
+		this->reallocate(this->vertices,
+			GeometryArena::INITIAL_VERTEX_CAPACITY, { });
+		this->reallocate(this->indices,
+			GeometryArena::INITIAL_INDEX_CAPACITY, { });
+		this->free(this->vertices, { 0, this->vertices.capacity });
+		this->free(this->indices, { 0, this->indices.capacity });
+
+		GLErrorException::checkGLError(__FILE__, __LINE__);
+	}
+
+	void GeometryArena::unbindBuffers() const {
+		for (int i = 0; i < Vertex::ATTRIBUTES_PER_VERTEX_COUNT; ++i)
+			glDisableVertexAttribArray(i);
+	}
+
+	void GeometryArena::writeIndices(const int &allocation,
+			const unsigned int *indices, const std::size_t &count,
+			const std::size_t &offset) {
+		GLErrorException::clear();
+		if (!this->isInitialized) throw GLItemNotInitializedException(this);
+		if (count == 0) return;
+
+		const Range &range = this->indices.allocations.at(allocation);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, this->indices.bufferObject);
+		glBufferSubData(GL_COPY_WRITE_BUFFER,
+			(range.offset + offset) * this->indices.stride,
+			count * this->indices.stride, indices);
+
+		GLErrorException::checkGLError(__FILE__, __LINE__);
+	}
+
+	void GeometryArena::writeVertices(const int &allocation,
+			const Vertex *vertices, const std::size_t &count,
+			const std::size_t &offset) {
+		GLErrorException::clear();
+		if (!this->isInitialized) throw GLItemNotInitializedException(this);
+		if (count == 0) return;
+
+		// Write the vertex elements directly into the mapped range
+		const Range &range = this->vertices.allocations.at(allocation);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, this->vertices.bufferObject);
+		void *mapped = glMapBufferRange(GL_COPY_WRITE_BUFFER,
+			(range.offset + offset) * this->vertices.stride,
+			count * this->vertices.stride,
+			GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+		if (mapped != nullptr) {
+			Vertex::writeFloatBuffer(vertices, count,
+				static_cast<float*>(mapped));
+			glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+		}
+
+		GLErrorException::checkGLError(__FILE__, __LINE__);
+	}
+
+	GeometryArena::GeometryArena() {
+		this->vertices.bufferObject = 0;
+		this->vertices.stride = Vertex::ELEMENTS_PER_VERTEX_SIZE;
+		this->vertices.capacity = 0;
+
+		this->indices.bufferObject = 0;
+		this->indices.stride = sizeof(unsigned int);
+		this->indices.capacity = 0;
+
+		this->nextAllocation = 0;
+	}
+
+	int GeometryArena::allocate(Pool &pool, const std::size_t &count) {
+		if (!this->isInitialized) throw GLItemNotInitializedException(this);
+
+		int handle = this->nextAllocation++;
+		if (count == 0) {
+			pool.allocations[handle] = { 0, 0 };
+			return handle;
+		}
+
+		// Find the first free range which is large enough, growing the pool
+		// if there is none (after which the last range is large enough).
+		auto fit = [&]() {
+			return std::find_if(pool.freeRanges.begin(),
+				pool.freeRanges.end(), [&](auto &range) {
+					return range.second >= count;
+			});
+		};
+		auto found = fit();
+		if (found == pool.freeRanges.end()) {
+			this->grow(pool, count);
+			found = fit();
+		}
+
+		// Take the start of the free range and keep the rest free
+		Range range = { found->first, count };
+		std::size_t remaining = found->second - count;
+		pool.freeRanges.erase(found);
+		if (remaining > 0)
+			pool.freeRanges[range.offset + count] = remaining;
+
+		pool.allocations[handle] = range;
+		return handle;
+	}
+
+	void GeometryArena::defragment(Pool &pool) {
+		// Pack the allocations in the order of their current offsets
+		std::vector<std::pair<std::size_t, int>> order;
+		for (auto &allocation : pool.allocations) {
+			if (allocation.second.count > 0)
+				order.push_back({ allocation.second.offset, allocation.first });
+		}
+		std::sort(order.begin(), order.end());
+
+		std::map<std::size_t, Range> ranges;
+		std::size_t used = 0;
+		for (auto &entry : order) {
+			Range &range = pool.allocations[entry.second];
+			ranges[used] = range;
+
+			range.offset = used;
+			used += range.count;
+		}
+
+		this->reallocate(pool, pool.capacity, ranges);
+
+		pool.freeRanges.clear();
+		if (used < pool.capacity) pool.freeRanges[used] = pool.capacity - used;
+	}
+
+	void GeometryArena::free(Pool &pool, const Range &range) {
+		if (range.count == 0) return;
+
+		std::size_t offset = range.offset;
+		std::size_t count = range.count;
+
+		// Merge with the free range which follows, if they are adjacent
+		auto next = pool.freeRanges.lower_bound(offset);
+		if (next != pool.freeRanges.end() && next->first == offset + count) {
+			count += next->second;
+			next = pool.freeRanges.erase(next);
+		}
+
+		// Merge with the free range which precedes, if they are adjacent
+		if (next != pool.freeRanges.begin()) {
+			auto previous = std::prev(next);
+			if (previous->first + previous->second == offset) {
+				previous->second += count;
+				return;
+			}
+		}
+
+		pool.freeRanges[offset] = count;
+	}
+
+	void GeometryArena::grow(Pool &pool, const std::size_t &count) {
+		// The free range at the end of the pool (if any) only needs to be
+		// extended by the missing number of elements.
+		std::size_t tail = 0;
+		if (!pool.freeRanges.empty()) {
+			auto last = std::prev(pool.freeRanges.end());
+			if (last->first + last->second == pool.capacity)
+				tail = last->second;
+		}
+
+		std::size_t oldCapacity = pool.capacity;
+		std::size_t capacity = std::max(oldCapacity * 2,
+			oldCapacity + count - tail);
+
+		this->reallocate(pool, capacity, { { 0, { 0, oldCapacity } } });
+		this->free(pool, { oldCapacity, capacity - oldCapacity });
+	}
+
+	void GeometryArena::reallocate(Pool &pool, const std::size_t &capacity,
+			const std::map<std::size_t, Range> &ranges) {
+		GLuint buffer = 0;
+		glGenBuffers(1, &buffer);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+		glBufferData(GL_COPY_WRITE_BUFFER, capacity * pool.stride, nullptr,
+			GL_STATIC_DRAW);
+
+		// Copy the ranges on the GPU, without reading them back
+		glBindBuffer(GL_COPY_READ_BUFFER, pool.bufferObject);
+		for (auto &range : ranges) {
+			if (range.second.count == 0) continue;
+
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+				range.second.offset * pool.stride, range.first * pool.stride,
+				range.second.count * pool.stride);
+		}
+
+		GLuint old = pool.bufferObject;
+		if (old != 0) glDeleteBuffers(1, &old);
+
+		pool.bufferObject = buffer;
+		pool.capacity = capacity;
+	}
+} }
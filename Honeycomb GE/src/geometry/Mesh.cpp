@@ -1,5 +1,7 @@
 #include "../../include/geometry/Mesh.h"
 
+#include <algorithm>
+#include <cassert>
 #include <iostream>
 #include <sstream>
 #include <vector>
@@ -8,6 +10,7 @@
 
 #include "../../include/base/GLErrorException.h"
 #include "../../include/file/FileIO.h"
+#include "../../include/geometry/GeometryArena.h"
 #include "../../include/math/Vector3f.h"
 #include "../../include/geometry/Vertex.h"
 
@@ -19,22 +22,26 @@ using Honeycomb::Math::Vector3f;
 using Honeycomb::Shader::ShaderProgram;
 
 namespace Honeycomb { namespace Geometry {
+	const int Mesh::STREAM_RING_SIZE = 3;
+
 	int Mesh::meshCount = 0;
 
 	const int& Mesh::getInitializedMeshCount() {
 		return Mesh::meshCount;
 	}
 
-	std::shared_ptr<Mesh> Mesh::newMeshShared() {
+	std::shared_ptr<Mesh> Mesh::newMeshShared(const MeshUsage &usage) {
 		std::shared_ptr<Mesh> ptr = std::shared_ptr<Mesh>(new Mesh());
 		ptr->initialize();
+		ptr->usage = usage;
 
 		return ptr;
 	}
 
-	std::unique_ptr<Mesh> Mesh::newMeshUnique() {
+	std::unique_ptr<Mesh> Mesh::newMeshUnique(const MeshUsage &usage) {
 		std::unique_ptr<Mesh> ptr = std::unique_ptr<Mesh>(new Mesh());
 		ptr->initialize();
+		ptr->usage = usage;
 
 		return ptr;
 	}
@@ -66,10 +73,11 @@ namespace Honeycomb { namespace Geometry {
 		GLErrorException::clear();
 		if (!this->isInitialized) throw GLItemNotInitializedException(this);
 
+		this->freeArena(false, true);
 		this->indices.clear();
+		this->indexCapacity = 0;
 		glBindBuffer(GL_ARRAY_BUFFER, this->indexBufferObject);
-		glBufferData(GL_ARRAY_BUFFER, this->indices.size() * sizeof(int),
-			nullptr, GL_STATIC_DRAW);
+		glBufferData(GL_ARRAY_BUFFER, 0, nullptr, this->getUsageGL());
 
 		GLErrorException::checkGLError(__FILE__, __LINE__);
 	}
@@ -78,11 +86,12 @@ namespace Honeycomb { namespace Geometry {
 		GLErrorException::clear();
 		if (!this->isInitialized) throw GLItemNotInitializedException(this);
 
+		this->freeArena(true, false);
+		this->destroyStream();
 		this->vertices.clear();
+		this->vertexCapacity = 0;
 		glBindBuffer(GL_ARRAY_BUFFER, this->vertexBufferObject);
-		glBufferData(GL_ARRAY_BUFFER, 
-			this->vertices.size() * Vertex::ELEMENTS_PER_VERTEX_SIZE,
-			nullptr, GL_STATIC_DRAW);
+		glBufferData(GL_ARRAY_BUFFER, 0, nullptr, this->getUsageGL());
 
 		GLErrorException::checkGLError(__FILE__, __LINE__);
 	}
@@ -91,6 +100,9 @@ namespace Honeycomb { namespace Geometry {
 		GLErrorException::clear();
 		if (!this->isInitialized) throw GLItemNotInitializedException(this);
 		
+		this->freeArena(true, true);
+		this->destroyStream();
+
 		// Placeholders to store the buffer ID for the glDeleteBuffers func.
 		GLuint ibo = this->indexBufferObject;
 		GLuint vbo = this->vertexBufferObject;;
@@ -103,7 +115,32 @@ namespace Honeycomb { namespace Geometry {
 		GLErrorException::checkGLError(__FILE__, __LINE__);
 	}
 
+	std::size_t Mesh::getBaseVertex() const {
+		if (this->arenaVertices == -1) return 0;
+
+		return GeometryArena::getGeometryArena()->getBaseVertex(
+			this->arenaVertices);
+	}
+
+	const Vector3f& Mesh::getBoundsMax() const {
+		return this->boundsMax;
+	}
+
+	const Vector3f& Mesh::getBoundsMin() const {
+		return this->boundsMin;
+	}
+
+	std::size_t Mesh::getFirstIndex() const {
+		if (this->arenaIndices == -1) return 0;
+
+		return GeometryArena::getGeometryArena()->getFirstIndex(
+			this->arenaIndices);
+	}
+
 	const int& Mesh::getIndexBufferObject() const {
+		if (this->arenaIndices != -1)
+			return GeometryArena::getGeometryArena()->getIndexBufferObject();
+
 		return this->indexBufferObject;
 	}
 
@@ -111,7 +148,18 @@ namespace Honeycomb { namespace Geometry {
 		return this->indices;
 	}
 
+	bool Mesh::getIsInGeometryArena() const {
+		return this->arenaVertices != -1 && this->arenaIndices != -1;
+	}
+
+	const MeshUsage& Mesh::getUsage() const {
+		return this->usage;
+	}
+
 	const int& Mesh::getVertexBufferObject() const {
+		if (this->arenaVertices != -1)
+			return GeometryArena::getGeometryArena()->getVertexBufferObject();
+
 		return this->vertexBufferObject;
 	}
 
@@ -148,8 +196,14 @@ namespace Honeycomb { namespace Geometry {
 		for (int i = 0; i < Vertex::ATTRIBUTES_PER_VERTEX_COUNT; ++i)
 			glEnableVertexAttribArray(i);
 
-		// Bind the buffer to the VBO.
-		glBindBuffer(GL_ARRAY_BUFFER, this->vertexBufferObject);
+		// Bind the buffer to the VBO (which may be the VBO of the arena).
+		glBindBuffer(GL_ARRAY_BUFFER, this->getVertexBufferObject());
+
+		// If the Mesh is streamed, the vertices are read from the region of
+		// the ring buffer which was written last.
+		std::size_t base = (this->streamMapping == nullptr) ? 0 :
+			this->streamRegion * this->vertexCapacity *
+			Vertex::ELEMENTS_PER_VERTEX_SIZE;
 
 		// Set the attribute pointer for each attribute of the vertex. Since
 		// all attributes are uniform in the number of elements, the same
@@ -158,15 +212,17 @@ namespace Honeycomb { namespace Geometry {
 		for (int i = 0; i < Vertex::ATTRIBUTES_PER_VERTEX_COUNT; ++i)
 			glVertexAttribPointer(i, Vertex::ELEMENTS_PER_ATTRIBUTE_COUNT,
 				GL_FLOAT, GL_FALSE, Vertex::ELEMENTS_PER_VERTEX_SIZE,
-				(void*)(Vertex::ELEMENTS_PER_ATTRIBUTE_SIZE * i));
+				(void*)(base + Vertex::ELEMENTS_PER_ATTRIBUTE_SIZE * i));
 
-		// Bind the buffer to the IBO.
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->indexBufferObject);
+		// Bind the buffer to the IBO (which may be the IBO of the arena).
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->getIndexBufferObject());
 
 		// Draw the vertex array data as triangles, from the starting vertex to
-		// the final one.
-		glDrawElements(GL_TRIANGLES, this->indices.size(), GL_UNSIGNED_INT,
-			(void*)0);
+		// the final one. If the Mesh is in the arena, its indices start at
+		// its first index and are offset by its base vertex.
+		glDrawElementsBaseVertex(GL_TRIANGLES, this->indices.size(),
+			GL_UNSIGNED_INT, (void*)(this->getFirstIndex() * sizeof(int)),
+			(GLint)this->getBaseVertex());
 
 		// Disable attribute arrays for each attribute of the vertex
 		for (int i = 0; i < Vertex::ATTRIBUTES_PER_VERTEX_COUNT; ++i)
@@ -179,36 +235,144 @@ namespace Honeycomb { namespace Geometry {
 		GLErrorException::clear();
 		if (!this->isInitialized) throw GLItemNotInitializedException(this);
 
-		// Bind the Buffer & invalidate it, in case there is already some data
-		this->bindIndexBuffer();
-		this->clearIndices();
 		this->indices = indices;
-
-		// Send the index data to the buffer (Static Draw indicates that the
-		// data is constant).
-		glBufferData(GL_ARRAY_BUFFER, this->indices.size() * sizeof(int),
-			&this->indices[0], GL_STATIC_DRAW);
+		this->freeArena(false, true);
+
+		// Static indices are suballocated from the arena, in which case the
+		// storage of the index buffer of this Mesh is released.
+		if (this->usage == MeshUsage::USAGE_STATIC && 
+				GeometryArena::getIsEnabled()) {
+			GeometryArena *arena = GeometryArena::getGeometryArena();
+			this->arenaIndices = arena->allocateIndices(this->indices.size());
+			arena->writeIndices(this->arenaIndices, this->indices.data(),
+				this->indices.size(), 0);
+
+			if (this->indexCapacity > 0) {
+				this->bindIndexBuffer();
+				glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_STATIC_DRAW);
+				this->indexCapacity = 0;
+			}
+		} else {
+			// Reuse the storage of a dynamic buffer if the indices fit in
+			// it, else (re)allocate the buffer with the indices.
+			this->bindIndexBuffer();
+			std::size_t size = this->indices.size() * sizeof(int);
+			if (this->usage != MeshUsage::USAGE_STATIC && 
+					!this->indices.empty() &&
+					this->indices.size() <= this->indexCapacity) {
+				glBufferSubData(GL_ARRAY_BUFFER, 0, size, 
+					this->indices.data());
+			} else {
+				glBufferData(GL_ARRAY_BUFFER, size, this->indices.data(),
+					this->getUsageGL());
+				this->indexCapacity = this->indices.size();
+			}
+		}
 
 		GLErrorException::checkGLError(__FILE__, __LINE__);
 	}
 
+	void Mesh::setUsage(const MeshUsage &usage) {
+		GLErrorException::clear();
+		if (!this->isInitialized) throw GLItemNotInitializedException(this);
+		if (this->usage == usage) return;
+
+		// Release the current storage and upload the data using the new usage
+		this->destroyStream();
+		this->usage = usage;
+		this->vertexCapacity = 0;
+		this->indexCapacity = 0;
+
+		std::vector<Vertex> verts;
+		std::vector<unsigned int> inds;
+		verts.swap(this->vertices);
+		inds.swap(this->indices);
+		this->setVertexData(verts);
+		this->setIndexData(inds);
+	}
+
 	void Mesh::setVertexData(const std::vector<Vertex> &verts) {
 		GLErrorException::clear();
 		if (!this->isInitialized) throw GLItemNotInitializedException(this);
 
-		// Bind the Buffer & invalidate it, in case there is already some data
-		this->bindVertexBuffer();
-		this->clearVertices();
 		this->vertices = verts;
+		this->calcBounds();
+		this->freeArena(true, false);
+
+		// Static vertices are suballocated from the arena, in which case the
+		// storage of the vertex buffer of this Mesh is released.
+		if (this->usage == MeshUsage::USAGE_STATIC &&
+				GeometryArena::getIsEnabled()) {
+			GeometryArena *arena = GeometryArena::getGeometryArena();
+			this->arenaVertices = arena->allocateVertices(
+				this->vertices.size());
+			arena->writeVertices(this->arenaVertices, this->vertices.data(),
+				this->vertices.size(), 0);
+
+			if (this->vertexCapacity > 0) {
+				this->bindVertexBuffer();
+				glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_STATIC_DRAW);
+				this->vertexCapacity = 0;
+			}
+		} else if (this->usage == MeshUsage::USAGE_STREAM) {
+			this->writeStream();
+		} else {
+			// Reuse the storage of a dynamic buffer if the vertices fit in
+			// it, else (re)allocate the buffer.
+			if (this->usage == MeshUsage::USAGE_STATIC ||
+					this->vertices.size() > this->vertexCapacity) {
+				this->bindVertexBuffer();
+				glBufferData(GL_ARRAY_BUFFER, this->vertices.size() * 
+					Vertex::ELEMENTS_PER_VERTEX_SIZE, nullptr,
+					this->getUsageGL());
+				this->vertexCapacity = this->vertices.size();
+			}
+
+			this->writeVertices(0, this->vertices.size(), true);
+		}
+
+		GLErrorException::checkGLError(__FILE__, __LINE__);
+	}
+
+	void Mesh::updateIndexData(const std::vector<unsigned int> &inds,
+			const std::size_t &offset) {
+		GLErrorException::clear();
+		if (!this->isInitialized) throw GLItemNotInitializedException(this);
+		assert(offset + inds.size() <= this->indices.size());
+		if (inds.empty()) return;
 
-		// Convert the verticies into a float buffer which OpenGL understands
-		std::vector<float> vertFloats = Vertex::toFloatBuffer(verts);
+		std::copy(inds.begin(), inds.end(), this->indices.begin() + offset);
 
-		// Send the vertex data to the buffer (Static Draw indicates that the
-		// data is constant).
-		glBufferData(GL_ARRAY_BUFFER,
-			this->vertices.size() * Vertex::ELEMENTS_PER_VERTEX_SIZE, 
-			&vertFloats[0], GL_STATIC_DRAW);
+		if (this->arenaIndices != -1) {
+			GeometryArena::getGeometryArena()->writeIndices(
+				this->arenaIndices, inds.data(), inds.size(), offset);
+			return;
+		}
+
+		this->bindIndexBuffer();
+		glBufferSubData(GL_ARRAY_BUFFER, offset * sizeof(int),
+			inds.size() * sizeof(int), inds.data());
+
+		GLErrorException::checkGLError(__FILE__, __LINE__);
+	}
+
+	void Mesh::updateVertexData(const std::vector<Vertex> &verts,
+			const std::size_t &offset) {
+		GLErrorException::clear();
+		if (!this->isInitialized) throw GLItemNotInitializedException(this);
+		assert(offset + verts.size() <= this->vertices.size());
+		if (verts.empty()) return;
+
+		std::copy(verts.begin(), verts.end(), this->vertices.begin() + offset);
+		this->calcBounds();
+
+		if (this->arenaVertices != -1)
+			GeometryArena::getGeometryArena()->writeVertices(
+				this->arenaVertices, verts.data(), verts.size(), offset);
+		else if (this->usage == MeshUsage::USAGE_STREAM)
+			this->writeStream();
+		else
+			this->writeVertices(offset, verts.size(), false);
 
 		GLErrorException::checkGLError(__FILE__, __LINE__);
 	}
@@ -226,5 +390,156 @@ namespace Honeycomb { namespace Geometry {
 	Mesh::Mesh() {
 		this->vertexBufferObject = -1;
 		this->indexBufferObject = -1;
+
+		this->usage = MeshUsage::USAGE_STATIC;
+		this->arenaVertices = -1;
+		this->arenaIndices = -1;
+		this->vertexCapacity = 0;
+		this->indexCapacity = 0;
+
+		this->streamMapping = nullptr;
+		this->streamRegion = 0;
+	}
+
+	void Mesh::calcBounds() {
+		const std::vector<Vertex> &verts = this->vertices;
+
+		this->boundsMin = verts.empty() ? Vector3f() : verts[0].getPosition();
+		this->boundsMax = this->boundsMin;
+		for (const Vertex &vert : verts) {
+			const Vector3f &pos = vert.getPosition();
+
+			this->boundsMin = Vector3f(
+				std::min(this->boundsMin.getX(), pos.getX()),
+				std::min(this->boundsMin.getY(), pos.getY()),
+				std::min(this->boundsMin.getZ(), pos.getZ()));
+			this->boundsMax = Vector3f(
+				std::max(this->boundsMax.getX(), pos.getX()),
+				std::max(this->boundsMax.getY(), pos.getY()),
+				std::max(this->boundsMax.getZ(), pos.getZ()));
+		}
+	}
+
+	void Mesh::freeArena(const bool &vertices, const bool &indices) {
+		if (vertices && this->arenaVertices != -1) {
+			GeometryArena::getGeometryArena()->freeVertices(
+				this->arenaVertices);
+			this->arenaVertices = -1;
+		}
+
+		if (indices && this->arenaIndices != -1) {
+			GeometryArena::getGeometryArena()->freeIndices(
+				this->arenaIndices);
+			this->arenaIndices = -1;
+		}
+	}
+
+	void Mesh::destroyStream() {
+		if (this->streamMapping == nullptr) return;
+
+		for (void *fence : this->streamFences) {
+			if (fence != nullptr) glDeleteSync(static_cast<GLsync>(fence));
+		}
+		this->streamFences.clear();
+		this->streamMapping = nullptr;
+		this->streamRegion = 0;
+		this->vertexCapacity = 0;
+
+		// The GPU may still read the old buffer; OpenGL defers its deletion
+		glBindBuffer(GL_ARRAY_BUFFER, this->vertexBufferObject);
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+
+		GLuint vbo = this->vertexBufferObject;
+		glDeleteBuffers(1, &vbo);
+		glGenBuffers(1, &vbo);
+		this->vertexBufferObject = vbo;
+	}
+
+	int Mesh::getUsageGL() const {
+		switch (this->usage) {
+		case MeshUsage::USAGE_DYNAMIC:
+			return GL_DYNAMIC_DRAW;
+		case MeshUsage::USAGE_STREAM:
+			return GL_STREAM_DRAW;
+		default:
+			return GL_STATIC_DRAW;
+		}
+	}
+
+	void Mesh::writeStream() {
+		std::size_t count = this->vertices.size();
+		std::size_t regionSize = count * Vertex::ELEMENTS_PER_VERTEX_SIZE;
+
+		// Without buffer storage, orphan the buffer and refill it instead
+		if (!GLEW_ARB_buffer_storage) {
+			this->bindVertexBuffer();
+			glBufferData(GL_ARRAY_BUFFER, regionSize, nullptr, 
+				GL_STREAM_DRAW);
+			this->vertexCapacity = count;
+
+			this->writeVertices(0, count, true);
+			return;
+		}
+
+		if (this->streamMapping == nullptr || count > this->vertexCapacity) {
+			// (Re)allocate the ring buffer, with one region per frame in
+			// flight, and keep it mapped for the lifetime of the storage.
+			this->destroyStream();
+			if (count == 0) return;
+
+			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT |
+				GL_MAP_COHERENT_BIT;
+			this->bindVertexBuffer();
+			glBufferStorage(GL_ARRAY_BUFFER, regionSize * 
+				Mesh::STREAM_RING_SIZE, nullptr, flags);
+			this->streamMapping = static_cast<float*>(glMapBufferRange(
+				GL_ARRAY_BUFFER, 0, regionSize * Mesh::STREAM_RING_SIZE,
+				flags));
+			if (this->streamMapping == nullptr) return;
+
+			this->streamFences.assign(Mesh::STREAM_RING_SIZE, nullptr);
+			this->streamRegion = 0;
+			this->vertexCapacity = count;
+		} else {
+			// Fence all of the draws issued so far, which are the only draws
+			// that may read the current region, and move to the next region.
+			this->streamFences[this->streamRegion] = glFenceSync(
+				GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			this->streamRegion = 
+				(this->streamRegion + 1) % Mesh::STREAM_RING_SIZE;
+
+			// Wait until the GPU is done reading the next region
+			GLsync fence = static_cast<GLsync>(
+				this->streamFences[this->streamRegion]);
+			if (fence != nullptr) {
+				while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+					1000000) == GL_TIMEOUT_EXPIRED);
+				glDeleteSync(fence);
+				this->streamFences[this->streamRegion] = nullptr;
+			}
+		}
+
+		if (count == 0) return;
+		Vertex::writeFloatBuffer(&this->vertices[0], count, 
+			this->streamMapping + this->streamRegion * 
+			this->vertexCapacity * Vertex::ELEMENTS_PER_VERTEX_COUNT);
+	}
+
+	void Mesh::writeVertices(const std::size_t &first, 
+			const std::size_t &count, const bool &invalidate) {
+		if (count == 0) return;
+
+		GLbitfield access = GL_MAP_WRITE_BIT | (invalidate ? 
+			GL_MAP_INVALIDATE_BUFFER_BIT : GL_MAP_INVALIDATE_RANGE_BIT);
+		this->bindVertexBuffer();
+		void *mapped = glMapBufferRange(GL_ARRAY_BUFFER, 
+			first * Vertex::ELEMENTS_PER_VERTEX_SIZE,
+			count * Vertex::ELEMENTS_PER_VERTEX_SIZE, access);
+		if (mapped == nullptr) return;
+
+		// Write the vertex elements directly into the mapped memory
+		Vertex::writeFloatBuffer(&this->vertices[first], count,
+			static_cast<float*>(mapped));
+		glUnmapBuffer(GL_ARRAY_BUFFER);
 	}
 } }
@@ -0,0 +1,338 @@
+#include "../../include/geometry/MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+using Honeycomb::Math::Vector3f;
+
+namespace Honeycomb { namespace Geometry {
+	const int MeshOptimizer::ANALYSIS_CACHE_SIZE = 16;
+
+	const int MeshOptimizer::FORSYTH_CACHE_SIZE = 32;
+	const float MeshOptimizer::FORSYTH_CACHE_DECAY = 1.5F;
+	const float MeshOptimizer::FORSYTH_LAST_TRIANGLE_SCORE = 0.75F;
+	const float MeshOptimizer::FORSYTH_VALENCE_SCALE = 2.0F;
+	const float MeshOptimizer::FORSYTH_VALENCE_POWER = 0.5F;
+
+	VertexCacheStatistics::VertexCacheStatistics() {
+		this->transformCount = 0;
+		this->triangleCount = 0;
+		this->vertexCount = 0;
+	}
+
+	float VertexCacheStatistics::getACMR() const {
+		if (this->triangleCount == 0) return 0.0F;
+
+		return (float)this->transformCount / this->triangleCount;
+	}
+
+	float VertexCacheStatistics::getATVR() const {
+		if (this->vertexCount == 0) return 0.0F;
+
+		return (float)this->transformCount / this->vertexCount;
+	}
+
+	VertexCacheStatistics& VertexCacheStatistics::operator+=(
+			const VertexCacheStatistics &stats) {
+		this->transformCount += stats.transformCount;
+		this->triangleCount += stats.triangleCount;
+		this->vertexCount += stats.vertexCount;
+
+		return *this;
+	}
+
+	MeshOptimizationReport& MeshOptimizationReport::operator+=(
+			const MeshOptimizationReport &report) {
+		this->before += report.before;
+		this->after += report.after;
+
+		return *this;
+	}
+
+	VertexCacheStatistics MeshOptimizer::analyzeVertexCache(
+			const std::vector<unsigned int> &indices,
+			const std::size_t &vertexCount, const int &cacheSize) {
+		VertexCacheStatistics stats;
+		stats.triangleCount = indices.size() / 3;
+
+		// Each vertex stores the time at which it entered the FIFO cache,
+		// where the time advances on every miss. A vertex is still in the
+		// cache if fewer than cacheSize misses happened since it entered.
+		std::vector<std::size_t> cacheTime(vertexCount, 0);
+		std::vector<bool> referenced(vertexCount, false);
+		std::size_t time = (std::size_t)cacheSize + 1;
+		for (unsigned int index : indices) {
+			if (!referenced[index]) {
+				referenced[index] = true;
+				++stats.vertexCount;
+			}
+
+			if (time - cacheTime[index] > (std::size_t)cacheSize) {
+				cacheTime[index] = time++;
+				++stats.transformCount;
+			}
+		}
+
+		return stats;
+	}
+
+	MeshOptimizationReport MeshOptimizer::optimize(
+			std::vector<Vertex> &vertices, std::vector<unsigned int> &indices,
+			const float &overdrawThreshold) {
+		MeshOptimizationReport report;
+		report.before = MeshOptimizer::analyzeVertexCache(indices,
+			vertices.size());
+
+		MeshOptimizer::optimizeVertexCache(indices, vertices.size());
+		MeshOptimizer::optimizeOverdraw(indices, vertices, overdrawThreshold);
+		MeshOptimizer::optimizeVertexFetch(vertices, indices);
+
+		report.after = MeshOptimizer::analyzeVertexCache(indices,
+			vertices.size());
+		return report;
+	}
+
+	void MeshOptimizer::optimizeVertexCache(std::vector<unsigned int> &indices,
+			const std::size_t &vertexCount) {
+		std::size_t triangleCount = indices.size() / 3;
+		if (triangleCount == 0) return;
+
+		// Build the list of the triangles around each vertex. The first
+		// remaining[v] entries of the list of v are the triangles of v which
+		// have yet to be emitted.
+		std::vector<unsigned int> remaining(vertexCount, 0);
+		for (std::size_t i = 0; i < triangleCount * 3; ++i)
+			++remaining[indices[i]];
+
+		std::vector<unsigned int> offsets(vertexCount + 1, 0);
+		for (std::size_t v = 0; v < vertexCount; ++v)
+			offsets[v + 1] = offsets[v] + remaining[v];
+
+		std::vector<unsigned int> adjacency(triangleCount * 3);
+		std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+		for (std::size_t i = 0; i < triangleCount * 3; ++i)
+			adjacency[fill[indices[i]]++] = (unsigned int)(i / 3);
+
+		// Score all of the vertices and triangles
+		std::vector<int> cachePosition(vertexCount, -1);
+		std::vector<float> vertexScores(vertexCount);
+		for (std::size_t v = 0; v < vertexCount; ++v)
+			vertexScores[v] = MeshOptimizer::calcVertexScore(-1, remaining[v]);
+
+		std::vector<float> triangleScores(triangleCount);
+		std::vector<bool> emitted(triangleCount, false);
+		std::size_t best = 0;
+		for (std::size_t t = 0; t < triangleCount; ++t) {
+			triangleScores[t] = vertexScores[indices[t * 3 + 0]] +
+				vertexScores[indices[t * 3 + 1]] +
+				vertexScores[indices[t * 3 + 2]];
+
+			if (triangleScores[t] > triangleScores[best]) best = t;
+		}
+
+		std::vector<unsigned int> result;
+		result.reserve(triangleCount * 3);
+		std::vector<unsigned int> cache;
+		std::vector<unsigned int> newCache;
+		std::size_t cursor = 0;
+
+		while (result.size() < triangleCount * 3) {
+			// If none of the triangles around the cache could be emitted,
+			// continue with the next triangle in the input order.
+			if (best == triangleCount) {
+				while (emitted[cursor]) ++cursor;
+				best = cursor;
+			}
+
+			// Emit the best triangle and remove it from its vertices
+			const unsigned int *tri = &indices[best * 3];
+			emitted[best] = true;
+			for (int k = 0; k < 3; ++k) {
+				unsigned int v = tri[k];
+				result.push_back(v);
+
+				unsigned int *list = &adjacency[offsets[v]];
+				unsigned int *end = list + remaining[v];
+				*std::find(list, end, (unsigned int)best) = *(end - 1);
+				--remaining[v];
+			}
+
+			// Move the vertices of the triangle to the front of the cache. The
+			// vertices which fall off the end must be scored as well.
+			newCache.assign(tri, tri + 3);
+			for (unsigned int v : cache) {
+				if (v != tri[0] && v != tri[1] && v != tri[2])
+					newCache.push_back(v);
+			}
+
+			for (std::size_t i = 0; i < newCache.size(); ++i) {
+				unsigned int v = newCache[i];
+				cachePosition[v] = (i < (std::size_t)MeshOptimizer::
+					FORSYTH_CACHE_SIZE) ? (int)i : -1;
+				vertexScores[v] = MeshOptimizer::calcVertexScore(
+					cachePosition[v], remaining[v]);
+			}
+
+			// Rescore the triangles around the cache and pick the best one
+			best = triangleCount;
+			float bestScore = -1.0F;
+			for (unsigned int v : newCache) {
+				for (unsigned int j = 0; j < remaining[v]; ++j) {
+					unsigned int t = adjacency[offsets[v] + j];
+					triangleScores[t] = vertexScores[indices[t * 3 + 0]] +
+						vertexScores[indices[t * 3 + 1]] +
+						vertexScores[indices[t * 3 + 2]];
+
+					if (triangleScores[t] > bestScore) {
+						bestScore = triangleScores[t];
+						best = t;
+					}
+				}
+			}
+
+			if (newCache.size() > (std::size_t)MeshOptimizer::
+					FORSYTH_CACHE_SIZE)
+				newCache.resize(MeshOptimizer::FORSYTH_CACHE_SIZE);
+			cache.swap(newCache);
+		}
+
+		std::copy(result.begin(), result.end(), indices.begin());
+	}
+
+	void MeshOptimizer::optimizeOverdraw(std::vector<unsigned int> &indices,
+			const std::vector<Vertex> &vertices, const float &threshold) {
+		std::size_t triangleCount = indices.size() / 3;
+		if (triangleCount == 0) return;
+
+		VertexCacheStatistics stats = MeshOptimizer::analyzeVertexCache(
+			indices, vertices.size());
+
+		// Split the triangles into clusters where all three vertices of a
+		// triangle miss the cache, since reordering the clusters at these
+		// points does not cause any additional cache misses.
+		std::vector<std::size_t> clusters;
+		std::vector<std::size_t> cacheTime(vertices.size(), 0);
+		std::size_t size = (std::size_t)MeshOptimizer::ANALYSIS_CACHE_SIZE;
+		std::size_t time = size + 1;
+		for (std::size_t t = 0; t < triangleCount; ++t) {
+			int misses = 0;
+			for (int k = 0; k < 3; ++k) {
+				unsigned int v = indices[t * 3 + k];
+				if (time - cacheTime[v] > size) {
+					cacheTime[v] = time++;
+					++misses;
+				}
+			}
+
+			if (t == 0 || misses == 3) clusters.push_back(t);
+		}
+		if (clusters.size() < 2) return;
+		clusters.push_back(triangleCount);
+
+		// Compute the area weighted centroid and normal of each cluster, and
+		// the area weighted centroid of the whole mesh.
+		std::size_t clusterCount = clusters.size() - 1;
+		std::vector<Vector3f> centroids(clusterCount);
+		std::vector<Vector3f> normals(clusterCount);
+		Vector3f meshCentroid;
+		float meshArea = 0.0F;
+		for (std::size_t c = 0; c < clusterCount; ++c) {
+			Vector3f centroid;
+			Vector3f normal;
+			float area = 0.0F;
+
+			for (std::size_t t = clusters[c]; t < clusters[c + 1]; ++t) {
+				const Vector3f &p0 = vertices[indices[t * 3 + 0]].getPosition();
+				const Vector3f &p1 = vertices[indices[t * 3 + 1]].getPosition();
+				const Vector3f &p2 = vertices[indices[t * 3 + 2]].getPosition();
+
+				Vector3f n = (p1 - p0).cross(p2 - p0);
+				float a = n.magnitude() * 0.5F;
+
+				centroid += (p0 + p1 + p2) * (a / 3.0F);
+				normal += n;
+				area += a;
+			}
+
+			meshCentroid += centroid;
+			meshArea += area;
+			centroids[c] = (area > 0.0F) ? centroid / area : centroid;
+			normals[c] = normal;
+		}
+		if (meshArea > 0.0F) meshCentroid /= meshArea;
+
+		// Sort the clusters which face away from the center first
+		std::vector<float> keys(clusterCount);
+		std::vector<std::size_t> order(clusterCount);
+		for (std::size_t c = 0; c < clusterCount; ++c) {
+			float length = normals[c].magnitude();
+			keys[c] = (length > 0.0F) ?
+				(centroids[c] - meshCentroid).dot(normals[c]) / length : 0.0F;
+			order[c] = c;
+		}
+		std::stable_sort(order.begin(), order.end(),
+			[&](const std::size_t &x, const std::size_t &y) {
+				return keys[x] > keys[y];
+		});
+
+		std::vector<unsigned int> result;
+		result.reserve(triangleCount * 3);
+		for (std::size_t c : order) {
+			result.insert(result.end(), indices.begin() + clusters[c] * 3,
+				indices.begin() + clusters[c + 1] * 3);
+		}
+
+		// Keep the new order only if the vertex cache is not hurt too much
+		VertexCacheStatistics sorted = MeshOptimizer::analyzeVertexCache(
+			result, vertices.size());
+		if (sorted.getACMR() <= stats.getACMR() * threshold)
+			std::copy(result.begin(), result.end(), indices.begin());
+	}
+
+	void MeshOptimizer::optimizeVertexFetch(std::vector<Vertex> &vertices,
+			std::vector<unsigned int> &indices) {
+		std::vector<unsigned int> remap(vertices.size(), (unsigned int)-1);
+		std::vector<Vertex> result;
+		result.reserve(vertices.size());
+
+		for (unsigned int &index : indices) {
+			if (remap[index] == (unsigned int)-1) {
+				remap[index] = (unsigned int)result.size();
+				result.push_back(vertices[index]);
+			}
+
+			index = remap[index];
+		}
+
+		// Keep the vertices which are not referenced at the end
+		for (std::size_t i = 0; i < vertices.size(); ++i) {
+			if (remap[i] == (unsigned int)-1) result.push_back(vertices[i]);
+		}
+
+		vertices.swap(result);
+	}
+
+	float MeshOptimizer::calcVertexScore(const int &cachePosition,
+			const unsigned int &remaining) {
+		// A vertex with no remaining triangles is of no use
+		if (remaining == 0) return -1.0F;
+
+		float score = 0.0F;
+		if (cachePosition >= 0) {
+			// The vertices of the last triangle get a fixed score, so that
+			// the next triangle does not simply reuse the same edge.
+			if (cachePosition < 3) {
+				score = MeshOptimizer::FORSYTH_LAST_TRIANGLE_SCORE;
+			} else {
+				float scale = 1.0F / (MeshOptimizer::FORSYTH_CACHE_SIZE - 3);
+				score = std::pow(1.0F - (cachePosition - 3) * scale,
+					MeshOptimizer::FORSYTH_CACHE_DECAY);
+			}
+		}
+
+		// Boost the vertices with few remaining triangles
+		score += MeshOptimizer::FORSYTH_VALENCE_SCALE * std::pow(
+			(float)remaining, -MeshOptimizer::FORSYTH_VALENCE_POWER);
+		return score;
+	}
+} }
@@ -0,0 +1,301 @@
+#include "../../include/geometry/MeshSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+using Honeycomb::Math::Vector3f;
+
+namespace Honeycomb { namespace Geometry {
+	std::unique_ptr<Mesh> MeshSimplifier::newSimplifiedMesh(const Mesh &mesh,
+			const float &ratio, const float &targetError) {
+		const std::vector<Vertex> &vertices = mesh.getVertices();
+		std::size_t target = (std::size_t)(mesh.getIndices().size() *
+			std::max(0.0F, std::min(1.0F, ratio))) / 3 * 3;
+		std::vector<unsigned int> indices = MeshSimplifier::simplify(
+			vertices, mesh.getIndices(), target, targetError);
+
+		// Copy only the vertices which are still referenced
+		std::vector<unsigned int> remap(vertices.size(), (unsigned int)-1);
+		std::vector<Vertex> simplifiedVertices;
+		for (unsigned int &index : indices) {
+			if (remap[index] == (unsigned int)-1) {
+				remap[index] = (unsigned int)simplifiedVertices.size();
+				simplifiedVertices.push_back(vertices[index]);
+			}
+
+			index = remap[index];
+		}
+
+		std::unique_ptr<Mesh> simplified = Mesh::newMeshUnique();
+		if (!indices.empty()) {
+			simplified->setVertexData(simplifiedVertices);
+			simplified->setIndexData(indices);
+		}
+
+		return simplified;
+	}
+
+	std::vector<unsigned int> MeshSimplifier::simplify(
+			const std::vector<Vertex> &vertices,
+			const std::vector<unsigned int> &indices,
+			const std::size_t &targetIndexCount, const float &targetError) {
+		std::vector<unsigned int> result(indices.begin(),
+			indices.begin() + indices.size() / 3 * 3);
+		if (result.size() <= targetIndexCount || vertices.empty())
+			return result;
+
+		std::size_t vertexCount = vertices.size();
+
+		// Measure the size of the mesh
+		Vector3f min = vertices[0].getPosition();
+		Vector3f max = min;
+		for (const Vertex &vertex : vertices) {
+			const Vector3f &p = vertex.getPosition();
+			min = Vector3f(std::min(min.getX(), p.getX()),
+				std::min(min.getY(), p.getY()),
+				std::min(min.getZ(), p.getZ()));
+			max = Vector3f(std::max(max.getX(), p.getX()),
+				std::max(max.getY(), p.getY()),
+				std::max(max.getZ(), p.getZ()));
+		}
+		double extent = std::max({ max.getX() - min.getX(),
+			max.getY() - min.getY(), max.getZ() - min.getZ() });
+
+		// Lock the vertices which share their position with another vertex
+		// (seams of the normals or texture coordinates). The positions are
+		// compared on a grid of 2^21 steps across the mesh, rather than bit
+		// for bit, so that -0 and +0 (and rounding noise) are welded.
+		const double steps = (double)((1 << 21) - 1);
+		double scale = (extent > 0.0) ? steps / extent : 0.0;
+		std::vector<bool> locked(vertexCount, false);
+		std::unordered_map<unsigned long long, unsigned int> positions;
+		for (std::size_t i = 0; i < vertexCount; ++i) {
+			const Vector3f &p = vertices[i].getPosition();
+			unsigned long long key = 0;
+			for (double c : { p.getX() - min.getX(), p.getY() - min.getY(),
+					p.getZ() - min.getZ() })
+				key = (key << 21) | (unsigned long long)std::llround(
+					std::min(c * scale, steps));
+
+			auto inserted = positions.insert({ key, (unsigned int)i });
+			if (!inserted.second) {
+				locked[i] = true;
+				locked[inserted.first->second] = true;
+			}
+		}
+
+		// Lock the vertices on open borders, which are the vertices of the
+		// edges which are used by a single triangle.
+		std::unordered_map<unsigned long long, int> edgeUses;
+		for (std::size_t i = 0; i < result.size(); i += 3) {
+			for (int e = 0; e < 3; ++e) {
+				unsigned long long a = result[i + e];
+				unsigned long long b = result[i + (e + 1) % 3];
+				++edgeUses[(std::min(a, b) << 32) | std::max(a, b)];
+			}
+		}
+		for (auto &edge : edgeUses) {
+			if (edge.second != 1) continue;
+
+			locked[(std::size_t)(edge.first >> 32)] = true;
+			locked[(std::size_t)(edge.first & 0xFFFFFFFFULL)] = true;
+		}
+
+		// Accumulate the area weighted plane of each triangle into the
+		// quadric of each of its vertices.
+		std::vector<Quadric> quadrics(vertexCount, Quadric { });
+		for (std::size_t i = 0; i < result.size(); i += 3) {
+			Quadric q = MeshSimplifier::newTriangleQuadric(
+				vertices[result[i + 0]].getPosition(),
+				vertices[result[i + 1]].getPosition(),
+				vertices[result[i + 2]].getPosition());
+
+			for (int j = 0; j < 3; ++j)
+				MeshSimplifier::addQuadric(quadrics[result[i + j]], q);
+		}
+
+		// The error of a collapse is the area weighted mean of the squared
+		// distances to the planes of its quadric, so it is compared against
+		// the squared target distance.
+		double maxError = (double)targetError * extent;
+		maxError = maxError * maxError;
+
+		std::vector<unsigned int> collapseTo(vertexCount);
+		std::vector<bool> touched(vertexCount);
+		std::vector<unsigned int> adjacencyOffsets(vertexCount + 1);
+		std::vector<unsigned int> adjacency;
+		std::vector<Collapse> collapses;
+
+		while (result.size() > targetIndexCount) {
+			// Build the list of the triangles around each vertex
+			std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+			for (unsigned int index : result) ++adjacencyOffsets[index + 1];
+			for (std::size_t i = 0; i < vertexCount; ++i)
+				adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+
+			adjacency.resize(result.size());
+			std::vector<unsigned int> fill(adjacencyOffsets.begin(),
+				adjacencyOffsets.end() - 1);
+			for (std::size_t i = 0; i < result.size(); ++i)
+				adjacency[fill[result[i]]++] = (unsigned int)(i / 3);
+
+			// Find the error of collapsing each edge in both directions
+			collapses.clear();
+			for (std::size_t i = 0; i < result.size(); i += 3) {
+				for (int e = 0; e < 3; ++e) {
+					unsigned int a = result[i + e];
+					unsigned int b = result[i + (e + 1) % 3];
+
+					Quadric q = quadrics[a];
+					MeshSimplifier::addQuadric(q, quadrics[b]);
+					if (!locked[a]) collapses.push_back({ a, b, MeshSimplifier::
+						evaluateQuadric(q, vertices[b].getPosition()) });
+					if (!locked[b]) collapses.push_back({ b, a, MeshSimplifier::
+						evaluateQuadric(q, vertices[a].getPosition()) });
+				}
+			}
+			std::sort(collapses.begin(), collapses.end(),
+				[](const Collapse &x, const Collapse &y) {
+					return x.error < y.error;
+			});
+
+			// Perform the cheapest collapses, but at most one collapse around
+			// each vertex per pass, so that the adjacency stays valid.
+			for (std::size_t i = 0; i < vertexCount; ++i)
+				collapseTo[i] = (unsigned int)i;
+			std::fill(touched.begin(), touched.end(), false);
+
+			std::size_t indexCount = result.size();
+			std::size_t collapsed = 0;
+			for (const Collapse &collapse : collapses) {
+				if (collapse.error > maxError) break;
+				if (indexCount <= targetIndexCount) break;
+				if (touched[collapse.from] || touched[collapse.to]) continue;
+
+				// Reject the collapse if it would flip any of the triangles
+				// which remain around the collapsed vertex.
+				bool flips = false;
+				std::size_t removed = 0;
+				for (unsigned int j = adjacencyOffsets[collapse.from];
+						j < adjacencyOffsets[collapse.from + 1]; ++j) {
+					const unsigned int *tri = &result[adjacency[j] * 3];
+					if (tri[0] == collapse.to || tri[1] == collapse.to ||
+						tri[2] == collapse.to) {
+						++removed;
+						continue;
+					}
+
+					Vector3f p[3], q[3];
+					for (int k = 0; k < 3; ++k) {
+						p[k] = vertices[tri[k]].getPosition();
+						q[k] = (tri[k] == collapse.from) ?
+							vertices[collapse.to].getPosition() : p[k];
+					}
+
+					Vector3f before = MeshSimplifier::triangleNormal(
+						p[0], p[1], p[2]);
+					Vector3f after = MeshSimplifier::triangleNormal(
+						q[0], q[1], q[2]);
+					if (before.dot(after) <= 0.0F) {
+						flips = true;
+						break;
+					}
+				}
+				if (flips) continue;
+
+				collapseTo[collapse.from] = collapse.to;
+				MeshSimplifier::addQuadric(quadrics[collapse.to],
+					quadrics[collapse.from]);
+				indexCount -= removed * 3;
+				++collapsed;
+
+				// Mark the vertices around the collapse as touched
+				for (unsigned int v : { collapse.from, collapse.to }) {
+					for (unsigned int j = adjacencyOffsets[v];
+							j < adjacencyOffsets[v + 1]; ++j) {
+						const unsigned int *tri = &result[adjacency[j] * 3];
+						touched[tri[0]] = true;
+						touched[tri[1]] = true;
+						touched[tri[2]] = true;
+					}
+				}
+			}
+
+			if (collapsed == 0) break;
+
+			// Apply the collapses and remove the degenerate triangles
+			std::size_t write = 0;
+			for (std::size_t i = 0; i < result.size(); i += 3) {
+				unsigned int a = collapseTo[result[i + 0]];
+				unsigned int b = collapseTo[result[i + 1]];
+				unsigned int c = collapseTo[result[i + 2]];
+				if (a == b || b == c || c == a) continue;
+
+				result[write++] = a;
+				result[write++] = b;
+				result[write++] = c;
+			}
+			result.resize(write);
+		}
+
+		return result;
+	}
+
+	void MeshSimplifier::addQuadric(Quadric &q, const Quadric &add) {
+		for (int i = 0; i < 10; ++i) q.m[i] += add.m[i];
+		q.weight += add.weight;
+	}
+
+	double MeshSimplifier::evaluateQuadric(const Quadric &q,
+			const Vector3f &p) {
+		if (q.weight <= 0.0) return 0.0;
+		double x = p.getX(), y = p.getY(), z = p.getZ();
+
+		// Evaluates [x y z 1] * Q * [x y z 1]^T using the upper triangle,
+		// divided by the total weight of the planes.
+		double error = q.m[0] * x * x + 2 * q.m[1] * x * y +
+			2 * q.m[2] * x * z + 2 * q.m[3] * x + q.m[4] * y * y +
+			2 * q.m[5] * y * z + 2 * q.m[6] * y + q.m[7] * z * z +
+			2 * q.m[8] * z + q.m[9];
+		return std::max(0.0, error / q.weight);
+	}
+
+	MeshSimplifier::Quadric MeshSimplifier::newTriangleQuadric(
+			const Vector3f &p0, const Vector3f &p1, const Vector3f &p2) {
+		Quadric q = { };
+
+		Vector3f n = MeshSimplifier::triangleNormal(p0, p1, p2);
+		double length = std::sqrt((double)n.getX() * n.getX() +
+			(double)n.getY() * n.getY() + (double)n.getZ() * n.getZ());
+		if (length <= 0.0) return q;
+
+		// The plane a * x + b * y + c * z + d = 0, weighted by the area
+		double plane[4] = { n.getX() / length, n.getY() / length,
+			n.getZ() / length, 0.0 };
+		plane[3] = -(plane[0] * p0.getX() + plane[1] * p0.getY() +
+			plane[2] * p0.getZ());
+		double area = length * 0.5;
+
+		int k = 0;
+		for (int r = 0; r < 4; ++r)
+			for (int c = r; c < 4; ++c)
+				q.m[k++] = area * plane[r] * plane[c];
+		q.weight = area;
+
+		return q;
+	}
+
+	Vector3f MeshSimplifier::triangleNormal(const Vector3f &p0,
+			const Vector3f &p1, const Vector3f &p2) {
+		float ux = p1.getX() - p0.getX();
+		float uy = p1.getY() - p0.getY();
+		float uz = p1.getZ() - p0.getZ();
+		float vx = p2.getX() - p0.getX();
+		float vy = p2.getY() - p0.getY();
+		float vz = p2.getZ() - p0.getZ();
+
+		return Vector3f(uy * vz - uz * vy, uz * vx - ux * vz,
+			ux * vy - uy * vx);
+	}
+} }
@@ -1,5 +1,6 @@
 #include "../../include/geometry/Model.h"
 
+#include <cmath>
 #include <iostream>
 #include <sstream>
 
@@ -11,6 +12,8 @@
 #include "../../include/component/render/MeshRenderer.h"
 #include "../../include/debug/Logger.h"
 #include "../../include/file/ImageIO.h"
+#include "../../include/geometry/MeshOptimizer.h"
+#include "../../include/geometry/MeshSimplifier.h"
 #include "../../include/geometry/Vertex.h"
 #include "../../include/graphics/Material.h"
 #include "../../include/graphics/Texture2D.h"
@@ -31,6 +34,7 @@ using Honeycomb::Graphics::Material;
 using Honeycomb::Graphics::Texture2D;
 using Honeycomb::Graphics::Texture2DCommonFillColor;
 using Honeycomb::Object::GameObject;
+using Honeycomb::Object::Prefab;
 using Honeycomb::Math::Vector2f;
 using Honeycomb::Math::Vector3f;
 using Honeycomb::Math::Vector4f;
@@ -56,6 +60,13 @@ namespace Honeycomb { namespace Geometry {
 		this->optimizeGraph         = false;
 		this->flipUVs               = true;
 		this->flipWindingOrder      = false;
+
+		this->optimizeVertexOrder   = true;
+		this->overdrawThreshold     = 1.05F;
+
+		this->lodLevels             = 0;
+		this->lodReduction          = 0.5F;
+		this->lodScreenSize         = 0.25F;
 	}
 
 	unsigned int ModelSettings::toPFlags() const {
@@ -82,7 +93,11 @@ namespace Honeycomb { namespace Geometry {
 	}
 
 	std::unique_ptr<GameObject> Model::getGameObjectClone() const {
-		return this->gameObject->clone();
+		return this->prefab->instantiate();
+	}
+
+	const MeshOptimizationReport& Model::getOptimizationReport() const {
+		return this->optimizationReport;
 	}
 
 	const std::string& Model::getPath() const {
@@ -178,8 +193,21 @@ namespace Honeycomb { namespace Geometry {
 			throw ModelLoadException(this->path, aImp.GetErrorString());
 		}
 
-		// Initialize the Model Game Object from the Scene Root node
-		this->gameObject = this->processAiNode(this->scene->mRootNode);
+		// Initialize the Model prefab from the Scene Root node
+		this->optimizationReport = MeshOptimizationReport();
+		this->prefab = std::make_unique<Prefab>(
+			*this->processAiNode(this->scene->mRootNode));
+
+		if (this->settings.optimizeVertexOrder) {
+			const MeshOptimizationReport &r = this->optimizationReport;
+			std::ostringstream report;
+			report << "Optimized " << this->path << ": ACMR " <<
+				r.before.getACMR() << " -> " << r.after.getACMR() <<
+				", ATVR " << r.before.getATVR() << " -> " <<
+				r.after.getATVR();
+			Logger::getLogger().logEntry(__FUNCTION__, __LINE__,
+				report.str());
+		}
 	}
 
 	std::shared_ptr<Material> Model::processAiMeshMaterial(aiMaterial* aMat) {
@@ -274,6 +302,19 @@ namespace Honeycomb { namespace Geometry {
 			}
 		}
 
+		// Reorder the triangles and the vertices for the GPU, and keep track
+		// of how much the vertex cache efficiency improved.
+		if (this->settings.optimizeVertexOrder) {
+			this->optimizationReport += MeshOptimizer::optimize(vertices,
+				indices, this->settings.overdrawThreshold);
+		} else {
+			MeshOptimizationReport report;
+			report.before = MeshOptimizer::analyzeVertexCache(indices,
+				vertices.size());
+			report.after = report.before;
+			this->optimizationReport += report;
+		}
+
 		// Create a new Honeycomb Mesh with the fetched vertex and index data.
 		std::unique_ptr<Mesh> mesh = Mesh::newMeshUnique();
 		mesh->setVertexData(vertices);
@@ -327,6 +368,22 @@ namespace Honeycomb { namespace Geometry {
 			meshRen->addMaterial(mat);
 			meshRen->addMesh(mesh);
 		}
+
+		// Generate the coarser levels of detail by simplifying the meshes
+		int lodLevels = (aNode->mNumMeshes > 0) ? this->settings.lodLevels : 0;
+		for (int k = 1; k <= lodLevels; ++k) {
+			float ratio = std::pow(this->settings.lodReduction, (float)k);
+
+			std::vector<std::shared_ptr<Mesh>> levelMeshes;
+			for (auto &mesh : meshRen->getMeshes()) {
+				levelMeshes.push_back(
+					MeshSimplifier::newSimplifiedMesh(*mesh, ratio));
+			}
+
+			meshRen->addLevelOfDetail(levelMeshes, this->settings.
+				lodScreenSize / std::pow(2.0F, (float)(k - 1)));
+		}
+
 		if (aNode->mNumMeshes > 0) object->addComponent(std::move(meshRen));
 
 		// Process all of the Children of the Object
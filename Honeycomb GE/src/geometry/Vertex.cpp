@@ -8,45 +8,47 @@ using Honeycomb::Math::Vector3f;
 namespace Honeycomb { namespace Geometry {
 	std::vector<float> Vertex::toFloatBuffer(const std::vector<Vertex> 
 			&verts) {
-		// Create a buffer and set its capacity to the number of elements to be
-		// written to the buffer.
-		std::vector<float> buffer;
-		buffer.reserve(ELEMENTS_PER_ATTRIBUTE_SIZE * verts.size());
+		// Create a buffer large enough for all of the elements to be written
+		std::vector<float> buffer(ELEMENTS_PER_VERTEX_COUNT * verts.size());
+		if (!verts.empty())
+			Vertex::writeFloatBuffer(&verts[0], verts.size(), &buffer[0]);
 
-		for (int i = 0; i < verts.size(); ++i) {
+		return buffer; // Return the float buffer
+	}
+
+	void Vertex::writeFloatBuffer(const Vertex *verts, 
+			const std::size_t &count, float *buffer) {
+		for (std::size_t i = 0; i < count; ++i) {
 			// Get the attributes of the vertex
-			Vertex vertex = verts[i];
-			Vector3f curPos  = vertex.getPosition();
-			Vector3f curNorm = vertex.getNormal();
-			Vector3f curTan  = vertex.getTangent();
-			Vector2f curTC0  = vertex.getTexCoords0();
-
-			// Push { P.x, P.y, P.z, 1.0F } for the Position Vector
-			buffer.push_back(curPos.getX());
-			buffer.push_back(curPos.getY());
-			buffer.push_back(curPos.getZ());
-			buffer.push_back(1.0F);
-
-			// Push { N.x, N.y, N.z, 0.0F } for the Normal Vector
-			buffer.push_back(curNorm.getX());
-			buffer.push_back(curNorm.getY());
-			buffer.push_back(curNorm.getZ());
-			buffer.push_back(0.0F);
-
-			// Push { T.x, T.y, T.z, 0.0F } for the Tangent Vector
-			buffer.push_back(curTan.getX());
-			buffer.push_back(curTan.getY());
-			buffer.push_back(curTan.getZ());
-			buffer.push_back(0.0F);
-
-			// Push { TC0.x, TC0.y, 0.0F, 1.0F } for Texture Coords 0 Vector
-			buffer.push_back(curTC0.getX());
-			buffer.push_back(curTC0.getY());
-			buffer.push_back(0.0F);
-			buffer.push_back(1.0F);
+			const Vector3f &curPos  = verts[i].position;
+			const Vector3f &curNorm = verts[i].normal;
+			const Vector3f &curTan  = verts[i].tangent;
+			const Vector2f &curTC0  = verts[i].texCoords0;
+
+			// Write { P.x, P.y, P.z, 1.0F } for the Position Vector
+			*buffer++ = curPos.getX();
+			*buffer++ = curPos.getY();
+			*buffer++ = curPos.getZ();
+			*buffer++ = 1.0F;
+
+			// Write { N.x, N.y, N.z, 0.0F } for the Normal Vector
+			*buffer++ = curNorm.getX();
+			*buffer++ = curNorm.getY();
+			*buffer++ = curNorm.getZ();
+			*buffer++ = 0.0F;
+
+			// Write { T.x, T.y, T.z, 0.0F } for the Tangent Vector
+			*buffer++ = curTan.getX();
+			*buffer++ = curTan.getY();
+			*buffer++ = curTan.getZ();
+			*buffer++ = 0.0F;
+
+			// Write { TC0.x, TC0.y, 0.0F, 1.0F } for Texture Coords 0 Vector
+			*buffer++ = curTC0.getX();
+			*buffer++ = curTC0.getY();
+			*buffer++ = 0.0F;
+			*buffer++ = 1.0F;
 		}
-
-		return buffer; // Return the float buffer
 	}
 
 	Vertex::Vertex() {
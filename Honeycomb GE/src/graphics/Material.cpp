@@ -26,4 +26,9 @@ namespace Honeycomb { namespace Graphics {
 	const std::string& Material::getName() const {
 		return this->name;
 	}
+
+	bool Material::getIsStandard() const {
+		return this->name == Material::DEFAULT_STRUCT &&
+			this->getShaderSource().getFile() == Material::DEFAULT_FILE;
+	}
 } }
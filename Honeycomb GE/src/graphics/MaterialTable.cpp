@@ -0,0 +1,377 @@
+#include "../../include/graphics/MaterialTable.h"
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+#include "../../include/base/GLErrorException.h"
+#include "../../include/math/Vector2f.h"
+#include "../../include/math/Vector3f.h"
+
+using Honeycomb::Base::GLErrorException;
+using Honeycomb::Base::GLItemNotInitializedException;
+using Honeycomb::Math::Vector2f;
+using Honeycomb::Math::Vector3f;
+using Honeycomb::Shader::ShaderProgram;
+
+namespace Honeycomb { namespace Graphics {
+	const int MaterialTable::PAGE_COUNT = 8;
+	const int MaterialTable::ROWS_PER_MATERIAL = 12;
+	const int MaterialTable::INITIAL_PAGE_CAPACITY = 4;
+	const std::string MaterialTable::TEXTURE_SLOTS[] = { "albedoTexture",
+		"ambientTexture", "diffuseTexture", "specularTexture",
+		"normalsTexture", "displacementTexture" };
+
+	void MaterialTable::setTextureUnits(ShaderProgram &shader,
+			const int &unit) {
+		// Every page sampler is given its own unit (even if the page does not
+		// exist), since samplers of different types may not share a unit.
+		shader.setUniform_i("materialTable", unit);
+		for (int i = 0; i < MaterialTable::PAGE_COUNT; ++i) {
+			shader.setUniform_i("materialPage" + std::to_string(i),
+				unit - MaterialTable::PAGE_COUNT + i);
+		}
+	}
+
+	MaterialTable::MaterialTable() {
+		this->isUploaded = false;
+
+		this->tableBuffer = 0;
+		this->tableTexture = 0;
+		this->capacity = 0;
+		this->frameBuffer = 0;
+	}
+
+	MaterialTable::~MaterialTable() {
+
+	}
+
+	int MaterialTable::add(const Material &material) {
+		if (!this->isInitialized) throw GLItemNotInitializedException(this);
+		if (!material.getIsStandard()) return -1;
+
+		auto find = this->materialIndices.find(&material);
+		if (find != this->materialIndices.end()) return find->second;
+
+		// Every texture of the material must be stored in a page
+		const Layer *textures[6];
+		for (int i = 0; i < 6; ++i) {
+			textures[i] = this->findLayer(material.getSampler2Ds().getValue(
+				MaterialTable::TEXTURE_SLOTS[i] + ".sampler"));
+			if (textures[i] == nullptr) return -1;
+		}
+
+		const auto &floats = material.getFloats();
+		const auto &vec2s = material.getVector2fs();
+		const auto &vec3s = material.getVector3fs();
+
+		// The colors, the scalars and the tiling & offset of the material,
+		// followed by the page, layer and intensity of each texture (see
+		// stdMaterialTable.glsl).
+		for (const char *color : { "albedoColor", "ambientColor",
+				"diffuseColor", "specularColor" }) {
+			const Vector3f &value = vec3s.getValue(color);
+			this->rows.insert(this->rows.end(),
+				{ value.getX(), value.getY(), value.getZ(), 0.0F });
+		}
+
+		this->rows.insert(this->rows.end(), { floats.getValue("shininess"),
+			floats.getValue("refractiveIndex"),
+			floats.getValue("reflectionStrength"), 0.0F });
+
+		const Vector2f &tiling = vec2s.getValue("globalTiling");
+		const Vector2f &offset = vec2s.getValue("globalOffset");
+		this->rows.insert(this->rows.end(), { tiling.getX(), tiling.getY(),
+			offset.getX(), offset.getY() });
+
+		for (int i = 0; i < 6; ++i) {
+			this->rows.insert(this->rows.end(), {
+				(float)textures[i]->page, (float)textures[i]->layer,
+				floats.getValue(MaterialTable::TEXTURE_SLOTS[i] +
+					".intensity"), 0.0F });
+		}
+
+		int index = (int)this->materialIndices.size();
+		this->materialIndices[&material] = index;
+		this->isUploaded = false;
+
+		return index;
+	}
+
+	void MaterialTable::clear() {
+		this->materialIndices.clear();
+		this->rows.clear();
+		this->isUploaded = false;
+
+		// Free the layers of the textures which were destroyed
+		for (auto it = this->layers.begin(); it != this->layers.end(); ) {
+			if (it->second.texture.expired()) {
+				if (it->second.page >= 0) {
+					this->pages[it->second.page].freeLayers.push_back(
+						it->second.layer);
+				}
+				it = this->layers.erase(it);
+			} else {
+				++it;
+			}
+		}
+	}
+
+	void MaterialTable::destroy() {
+		GLErrorException::clear();
+		if (!this->isInitialized) throw GLItemNotInitializedException(this);
+
+		for (Page &page : this->pages) {
+			GLuint texture = page.texture;
+			glDeleteTextures(1, &texture);
+		}
+
+		GLuint buffer = this->tableBuffer;
+		GLuint texture = this->tableTexture;
+		GLuint frameBuffer = this->frameBuffer;
+		glDeleteBuffers(1, &buffer);
+		glDeleteTextures(1, &texture);
+		glDeleteFramebuffers(1, &frameBuffer);
+
+		this->pages.clear();
+		this->layers.clear();
+		this->materialIndices.clear();
+		this->rows.clear();
+		this->isUploaded = false;
+
+		this->tableBuffer = 0;
+		this->tableTexture = 0;
+		this->capacity = 0;
+		this->frameBuffer = 0;
+
+		GLItem::destroy();
+		GLErrorException::checkGLError(__FILE__, __LINE__);
+	}
+
+	std::size_t MaterialTable::getMaterialCount() const {
+		return this->materialIndices.size();
+	}
+
+	void MaterialTable::initialize() {
+		GLErrorException::clear();
+		GLItem::initialize();
+
+		GLuint buffer;
+		GLuint texture;
+		GLuint frameBuffer;
+		glGenBuffers(1, &buffer);
+		glGenTextures(1, &texture);
+		glGenFramebuffers(1, &frameBuffer);
+		this->tableBuffer = buffer;
+		this->tableTexture = texture;
+		this->frameBuffer = frameBuffer;
+
+		GLErrorException::checkGLError(__FILE__, __LINE__);
+	}
+
+	void MaterialTable::toShader(ShaderProgram &shader, const int &unit) {
+		GLErrorException::clear();
+		if (!this->isInitialized) throw GLItemNotInitializedException(this);
+
+		if (!this->isUploaded) {
+			// The mipmaps of a page are only generated once all of the new
+			// textures have been copied into it.
+			for (Page &page : this->pages) {
+				if (page.isMipmapped) continue;
+
+				glBindTexture(GL_TEXTURE_2D_ARRAY, page.texture);
+				glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+				page.isMipmapped = true;
+			}
+
+			// Orphan the old texels, since they may still be in use
+			std::size_t count = this->materialIndices.size();
+			if (count > this->capacity)
+				this->capacity = std::max(count, this->capacity * 2);
+
+			glBindBuffer(GL_TEXTURE_BUFFER, this->tableBuffer);
+			glBufferData(GL_TEXTURE_BUFFER, this->capacity *
+				MaterialTable::ROWS_PER_MATERIAL * 4 * sizeof(float), nullptr,
+				GL_STREAM_DRAW);
+			if (!this->rows.empty()) {
+				glBufferSubData(GL_TEXTURE_BUFFER, 0,
+					this->rows.size() * sizeof(float), &this->rows[0]);
+			}
+			glBindTexture(GL_TEXTURE_BUFFER, this->tableTexture);
+			glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, this->tableBuffer);
+			glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+			this->isUploaded = true;
+		}
+
+		MaterialTable::setTextureUnits(shader, unit);
+		glActiveTexture(GL_TEXTURE0 + unit);
+		glBindTexture(GL_TEXTURE_BUFFER, this->tableTexture);
+
+		for (int i = 0; i < MaterialTable::PAGE_COUNT; ++i) {
+			glActiveTexture(GL_TEXTURE0 + unit - MaterialTable::PAGE_COUNT + i);
+			glBindTexture(GL_TEXTURE_2D_ARRAY, (i < (int)this->pages.size()) ?
+				this->pages[i].texture : 0);
+		}
+
+		GLErrorException::checkGLError(__FILE__, __LINE__);
+	}
+
+	bool MaterialTable::isPageable(const TextureDataInternalFormat &format) {
+		switch (format) {
+		case INTERNAL_FORMAT_RED:
+		case INTERNAL_FORMAT_RG:
+		case INTERNAL_FORMAT_RGB:
+		case INTERNAL_FORMAT_RGBA:
+		case INTERNAL_FORMAT_R8:
+		case INTERNAL_FORMAT_RG8:
+		case INTERNAL_FORMAT_RGB8:
+		case INTERNAL_FORMAT_RGBA8:
+		case INTERNAL_FORMAT_SRGB8:
+		case INTERNAL_FORMAT_SRGB8_ALPHA8:
+		case INTERNAL_FORMAT_R16F:
+		case INTERNAL_FORMAT_RG16F:
+		case INTERNAL_FORMAT_RGBA16F:
+		case INTERNAL_FORMAT_R32F:
+		case INTERNAL_FORMAT_RG32F:
+		case INTERNAL_FORMAT_RGBA32F:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	const MaterialTable::Layer* MaterialTable::findLayer(
+			const std::shared_ptr<const Texture2D> &texture) {
+		if (texture == nullptr || !texture->getIsInitialized() ||
+				texture->getWidth() <= 0 || texture->getHeight() <= 0)
+			return nullptr;
+
+		// Reuse the layer of the texture, unless the texture was destroyed
+		// (and its address reused), its image data was set again or it is no
+		// longer sampled by default.
+		auto find = this->layers.find(texture.get());
+		if (find != this->layers.end()) {
+			Layer &entry = find->second;
+			if (!entry.texture.expired() &&
+					entry.revision == texture->getRevision() &&
+					(entry.page < 0 || texture->getHasDefaultSampling()))
+				return (entry.page < 0) ? nullptr : &entry;
+
+			if (entry.page >= 0)
+				this->pages[entry.page].freeLayers.push_back(entry.layer);
+			this->layers.erase(find);
+		}
+
+		// Remember the texture as one which can not be stored in a page
+		// until it has been copied into one. The pages are sampled as the
+		// textures are by default, so textures sampled otherwise are left out.
+		Layer &entry = this->layers[texture.get()];
+		entry = { texture, texture->getRevision(), -1, -1 };
+		if (!texture->getHasDefaultSampling() ||
+				!MaterialTable::isPageable(texture->getInternalFormat()))
+			return nullptr;
+
+		// The texture is copied through a framebuffer, which may not be
+		// complete for every format on every driver.
+		GLErrorException::clear();
+		GLint oldFrameBuffer;
+		glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &oldFrameBuffer);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, this->frameBuffer);
+		glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+			GL_TEXTURE_2D, texture->getTextureID(), 0);
+
+		// Find the page of the size & format of the texture, creating it if
+		// there is none and there is room for another page.
+		auto page = std::find_if(this->pages.begin(), this->pages.end(),
+			[&](const Page &p) {
+				return p.width == texture->getWidth() &&
+					p.height == texture->getHeight() &&
+					p.format == texture->getInternalFormat();
+		});
+		bool isCopyable = glCheckFramebufferStatus(GL_READ_FRAMEBUFFER) ==
+			GL_FRAMEBUFFER_COMPLETE;
+		if (isCopyable && page == this->pages.end()) {
+			if ((int)this->pages.size() < MaterialTable::PAGE_COUNT) {
+				this->pages.push_back({ texture->getWidth(),
+					texture->getHeight(), texture->getInternalFormat(),
+					0, 0, 0, { }, false });
+				page = std::prev(this->pages.end());
+			} else {
+				isCopyable = false;
+			}
+		}
+
+		if (isCopyable) {
+			int layer;
+			if (!page->freeLayers.empty()) {
+				layer = page->freeLayers.back();
+				page->freeLayers.pop_back();
+			} else {
+				if (page->layerCount == page->capacity) {
+					this->reallocate(*page, std::max(page->capacity * 2,
+						MaterialTable::INITIAL_PAGE_CAPACITY));
+
+					// The reallocation reads through the framebuffer too
+					glFramebufferTexture2D(GL_READ_FRAMEBUFFER,
+						GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+						texture->getTextureID(), 0);
+				}
+
+				layer = page->layerCount++;
+			}
+
+			// Copy the texture into its layer on the graphics card
+			glBindTexture(GL_TEXTURE_2D_ARRAY, page->texture);
+			glCopyTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, 0, 0,
+				page->width, page->height);
+
+			page->isMipmapped = false;
+			entry.page = (int)(page - this->pages.begin());
+			entry.layer = layer;
+		}
+
+		glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+			GL_TEXTURE_2D, 0, 0);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, oldFrameBuffer);
+		GLErrorException::checkGLError(__FILE__, __LINE__);
+
+		return isCopyable ? &entry : nullptr;
+	}
+
+	void MaterialTable::reallocate(Page &page, const int &capacity) {
+		GLuint texture;
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0,
+			getGLintInternalDataFormat(page.format), page.width, page.height,
+			capacity, 0, GL_RGBA, GL_FLOAT, nullptr);
+
+		// Only textures which are sampled as set by default are stored in
+		// the pages (see Texture2D::getHasDefaultSampling).
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER,
+			GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER,
+			GL_LINEAR);
+
+		// Copy the old layers over, one layer at a time, through the read
+		// framebuffer (which is bound by findLayer).
+		for (int i = 0; i < page.layerCount; ++i) {
+			glFramebufferTextureLayer(GL_READ_FRAMEBUFFER,
+				GL_COLOR_ATTACHMENT0, page.texture, 0, i);
+			glCopyTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, i, 0, 0,
+				page.width, page.height);
+		}
+
+		GLuint old = page.texture;
+		if (old != 0) glDeleteTextures(1, &old);
+
+		page.texture = texture;
+		page.capacity = capacity;
+		page.isMipmapped = false;
+	}
+} }
@@ -128,10 +128,22 @@ namespace Honeycomb { namespace Graphics {
 		GLErrorException::checkGLError(__FILE__, __LINE__);
 	}
 
+	const bool& Texture2D::getHasDefaultSampling() const {
+		return this->hasDefaultSampling;
+	}
+
 	const int& Texture2D::getHeight() const {
 		return this->height;
 	}
 
+	const TextureDataInternalFormat& Texture2D::getInternalFormat() const {
+		return this->internalFormat;
+	}
+
+	const unsigned int& Texture2D::getRevision() const {
+		return this->revision;
+	}
+
 	const int& Texture2D::getTextureID() const {
 		return this->textureID;
 	}
@@ -168,6 +180,7 @@ namespace Honeycomb { namespace Graphics {
 		if (!this->isInitialized) throw GLItemNotInitializedException(this);
 
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, aniso);
+		this->hasDefaultSampling = false;
 
 		GLErrorException::checkGLError(__FILE__, __LINE__);
 	}
@@ -181,6 +194,7 @@ namespace Honeycomb { namespace Graphics {
 			getGLintFilterMagMode(filter));
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
 			getGLintFilterMagMode(filter));
+		this->hasDefaultSampling = false;
 		GLErrorException::checkGLError(__FILE__, __LINE__);
 	}
 
@@ -194,6 +208,7 @@ namespace Honeycomb { namespace Graphics {
 			getGLintFilterMinMode(min));
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
 			getGLintFilterMagMode(mag));
+		this->hasDefaultSampling = false;
 		GLErrorException::checkGLError(__FILE__, __LINE__);
 	}
 
@@ -205,10 +220,15 @@ namespace Honeycomb { namespace Graphics {
 
 		this->width = 1;
 		this->height = 1;
+		this->internalFormat = INTERNAL_FORMAT_RGBA;
 		GLubyte color[] = { (GLubyte)r, (GLubyte)g, (GLubyte)b, (GLubyte)a };
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA,
 			GL_UNSIGNED_BYTE, color);
 
+		// A single texel is sampled the same with any wrap & filtering
+		++this->revision;
+		this->hasDefaultSampling = true;
+
 		GLErrorException::checkGLError(__FILE__, __LINE__);
 	}
 
@@ -234,6 +254,7 @@ namespace Honeycomb { namespace Graphics {
 		// Write the data to the texture
 		this->width = width;
 		this->height = height;
+		this->internalFormat = iformat;
 		glTexImage2D(GL_TEXTURE_2D, 0,
 			getGLintInternalDataFormat(iformat),
 			width, height, 0,
@@ -255,6 +276,9 @@ namespace Honeycomb { namespace Graphics {
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
 		}
+
+		++this->revision;
+		this->hasDefaultSampling = mipmap;
 		GLErrorException::checkGLError(__FILE__, __LINE__);
 	}
 
@@ -267,6 +291,7 @@ namespace Honeycomb { namespace Graphics {
 			getGLintWrapMode(wrap));
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,
 			getGLintWrapMode(wrap));
+		this->hasDefaultSampling = false;
 		GLErrorException::checkGLError(__FILE__, __LINE__);
 	}
 
@@ -280,6 +305,7 @@ namespace Honeycomb { namespace Graphics {
 			getGLintWrapMode(s));
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, 
 			getGLintWrapMode(t));
+		this->hasDefaultSampling = false;
 		GLErrorException::checkGLError(__FILE__, __LINE__);
 	}
 
@@ -297,5 +323,8 @@ namespace Honeycomb { namespace Graphics {
 
 		this->width = 0;
 		this->height = 0;
+		this->internalFormat = INTERNAL_FORMAT_RGBA;
+		this->revision = 0;
+		this->hasDefaultSampling = false;
 	}
 } }
@@ -0,0 +1,184 @@
+#include "../../include/job/JobSystem.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace Honeycomb { namespace Job {
+	JobCounter::JobCounter() : count(0) {
+
+	}
+
+	bool JobCounter::getIsDone() const {
+		return this->count.load(std::memory_order_acquire) == 0;
+	}
+
+	const int JobSystem::CHUNKS_PER_WORKER = 4;
+	thread_local int JobSystem::workerIndex = -1;
+
+	void JobSystem::destroy() {
+		if (this->workers.empty()) return;
+
+		{
+			std::lock_guard<std::mutex> lock(this->sleepMutex);
+			this->isRunning = false;
+		}
+		this->sleepCondition.notify_all();
+
+		for (std::size_t i = 1; i < this->workers.size(); ++i)
+			this->workers[i]->thread.join();
+
+		this->workers.clear();
+		this->pendingJobs = 0;
+		JobSystem::workerIndex = -1;
+	}
+
+	JobSystem* JobSystem::getJobSystem() {
+		static JobSystem *jobSystem = new JobSystem();
+		return jobSystem;
+	}
+
+	int JobSystem::getWorkerCount() const {
+		return std::max(1, (int)this->workers.size());
+	}
+
+	void JobSystem::initialize(const int &threadCount) {
+		if (!this->workers.empty()) return;
+
+		int count = (threadCount > 0) ? threadCount :
+			(int)std::max(1U, std::thread::hardware_concurrency());
+		for (int i = 0; i < count; ++i)
+			this->workers.push_back(std::unique_ptr<Worker>(new Worker()));
+
+		// The calling thread is the first worker, and the others get threads
+		// of their own (which are only started once all of the deques exist,
+		// since they steal from each other).
+		this->isRunning = true;
+		JobSystem::workerIndex = 0;
+		for (int i = 1; i < count; ++i)
+			this->workers[i]->thread = std::thread(&JobSystem::work, this, i);
+	}
+
+	void JobSystem::parallelFor(const int &count, const int &grain,
+			const std::function<void(int, int)> &body) {
+		if (count <= 0) return;
+
+		int chunk = (grain > 0) ? grain : std::max(1, count /
+			(this->getWorkerCount() * CHUNKS_PER_WORKER));
+		if (chunk >= count || this->workers.empty()) {
+			body(0, count);
+			return;
+		}
+
+		JobCounter counter;
+		for (int begin = chunk; begin < count; begin += chunk) {
+			int end = std::min(begin + chunk, count);
+			this->run([&body, begin, end]() { body(begin, end); }, counter);
+		}
+
+		body(0, chunk);
+		this->wait(counter);
+	}
+
+	void JobSystem::run(const std::function<void()> &job,
+			JobCounter &counter) {
+		if (this->workers.empty()) {
+			job();
+			return;
+		}
+
+		// Jobs queued by threads which are not workers are spread across
+		// the deques of all of the workers.
+		int index = JobSystem::workerIndex;
+		if (index < 0)
+			index = this->nextWorker++ % (int)this->workers.size();
+
+		counter.count.fetch_add(1, std::memory_order_relaxed);
+		{
+			Worker &worker = *this->workers[index];
+			std::lock_guard<std::mutex> lock(worker.mutex);
+			worker.jobs.push_back({ job, &counter });
+		}
+
+		// Count the job while holding the sleep mutex, so that a worker may
+		// not miss it between checking for jobs and going to sleep.
+		{
+			std::lock_guard<std::mutex> lock(this->sleepMutex);
+			++this->pendingJobs;
+		}
+		this->sleepCondition.notify_one();
+	}
+
+	void JobSystem::wait(const JobCounter &counter) {
+		while (!counter.getIsDone()) {
+			Job job;
+			if (this->take(JobSystem::workerIndex, job, &counter))
+				this->execute(job);
+			else std::this_thread::yield();
+		}
+	}
+
+	JobSystem::JobSystem() : pendingJobs(0), nextWorker(0) {
+		this->isRunning = false;
+	}
+
+	void JobSystem::execute(Job &job) {
+		job.function();
+		job.counter->count.fetch_sub(1, std::memory_order_release);
+	}
+
+	bool JobSystem::take(const int &index, Job &job,
+			const JobCounter *counter) {
+		int count = (int)this->workers.size();
+		auto isTakeable = [counter](const Job &queued) {
+			return counter == nullptr || queued.counter == counter;
+		};
+
+		// Take the newest job of the own deque, since its data is the most
+		// likely to still be in the cache, and otherwise steal the oldest
+		// job of the other deques (which tends to be the largest).
+		for (int i = 0; i < count; ++i) {
+			int victim = (index < 0) ? i : (index + i) % count;
+			Worker &worker = *this->workers[victim];
+			std::lock_guard<std::mutex> lock(worker.mutex);
+
+			std::deque<Job>::iterator it;
+			if (victim == index) {
+				auto rit = std::find_if(worker.jobs.rbegin(),
+					worker.jobs.rend(), isTakeable);
+				if (rit == worker.jobs.rend()) continue;
+				it = std::prev(rit.base());
+			} else {
+				it = std::find_if(worker.jobs.begin(), worker.jobs.end(),
+					isTakeable);
+				if (it == worker.jobs.end()) continue;
+			}
+
+			job = std::move(*it);
+			worker.jobs.erase(it);
+
+			--this->pendingJobs;
+			return true;
+		}
+
+		return false;
+	}
+
+	void JobSystem::work(const int &index) {
+		JobSystem::workerIndex = index;
+
+		while (true) {
+			Job job;
+			if (this->take(index, job)) {
+				this->execute(job);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(this->sleepMutex);
+			this->sleepCondition.wait(lock, [this]() {
+				return this->pendingJobs > 0 || !this->isRunning;
+			});
+
+			if (!this->isRunning) return;
+		}
+	}
+} }
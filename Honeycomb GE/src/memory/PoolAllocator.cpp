@@ -0,0 +1,88 @@
+#include "../../include/memory/PoolAllocator.h"
+
+#include <algorithm>
+#include <new>
+
+namespace Honeycomb { namespace Memory {
+	const std::size_t PoolAllocator::BLOCK_ALIGNMENT = 16;
+	const std::size_t PoolAllocator::MAX_BLOCK_SIZE = 1024;
+	const std::size_t PoolAllocator::SLAB_SIZE = 16384;
+
+	PoolAllocator* PoolAllocator::getPoolAllocator() {
+		static PoolAllocator *poolAllocator = new PoolAllocator();
+		return poolAllocator;
+	}
+
+	void* PoolAllocator::allocate(const std::size_t &size) {
+		std::lock_guard<std::mutex> lock(this->mutex);
+		++this->statistics.allocations;
+
+		if (size == 0 || size > MAX_BLOCK_SIZE) {
+			++this->statistics.fallbackAllocations;
+			return ::operator new(size);
+		}
+
+		std::size_t sizeClass = (size - 1) / BLOCK_ALIGNMENT;
+		if (this->freeLists[sizeClass] == nullptr)
+			this->reserveSlab(sizeClass);
+
+		Block *block = this->freeLists[sizeClass];
+		this->freeLists[sizeClass] = block->next;
+
+		++this->statistics.liveBlocks;
+		return block;
+	}
+
+	void PoolAllocator::deallocate(void *block, const std::size_t &size) {
+		if (block == nullptr) return;
+
+		std::lock_guard<std::mutex> lock(this->mutex);
+		++this->statistics.deallocations;
+
+		if (size == 0 || size > MAX_BLOCK_SIZE) {
+			::operator delete(block);
+			return;
+		}
+
+		std::size_t sizeClass = (size - 1) / BLOCK_ALIGNMENT;
+		Block *freed = static_cast<Block*>(block);
+		freed->next = this->freeLists[sizeClass];
+		this->freeLists[sizeClass] = freed;
+
+		--this->statistics.liveBlocks;
+	}
+
+	PoolStatistics PoolAllocator::getStatistics() const {
+		std::lock_guard<std::mutex> lock(this->mutex);
+		return this->statistics;
+	}
+
+	PoolAllocator::PoolAllocator() :
+			freeLists(MAX_BLOCK_SIZE / BLOCK_ALIGNMENT, nullptr) {
+		this->statistics = { 0, 0, 0, 0, 0, 0 };
+	}
+
+	void PoolAllocator::reserveSlab(const std::size_t &sizeClass) {
+		// The slabs are allocated with new, so they are aligned for any type,
+		// and since the block size is a multiple of the alignment, so is each
+		// block of the slab.
+		std::size_t blockSize = (sizeClass + 1) * BLOCK_ALIGNMENT;
+		std::size_t blockCount = std::max((std::size_t)1,
+			SLAB_SIZE / blockSize);
+
+		this->slabs.push_back(std::unique_ptr<char[]>(
+			new char[blockSize * blockCount]));
+		char *slab = this->slabs.back().get();
+
+		// Link the blocks in order, so that they are handed out in the order
+		// of their addresses.
+		for (std::size_t i = blockCount; i-- > 0; ) {
+			Block *block = reinterpret_cast<Block*>(slab + i * blockSize);
+			block->next = this->freeLists[sizeClass];
+			this->freeLists[sizeClass] = block;
+		}
+
+		++this->statistics.slabs;
+		this->statistics.reservedBytes += blockSize * blockCount;
+	}
+} }
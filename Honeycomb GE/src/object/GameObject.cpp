@@ -4,15 +4,19 @@
 #include <iostream>
 #include <sstream>
 
+#include "../../include/memory/PoolAllocator.h"
 #include "../../include/scene/GameScene.h"
 #include "../../include/shader/ShaderProgram.h"
 #include "../../include/component/physics/Transform.h"
 
 using Honeycomb::Component::GameComponent;
 using Honeycomb::Component::GameComponentDisallowsMultipleException;
+using Honeycomb::Component::GameComponentID;
 using Honeycomb::Component::GameComponentPermanentException;
 using Honeycomb::Component::Physics::Transform;
+using Honeycomb::Component::UpdateAccess;
 using Honeycomb::Debug::Logger;
+using Honeycomb::Memory::PoolAllocator;
 using Honeycomb::Shader::ShaderProgram;
 using Honeycomb::Scene::GameScene;
 
@@ -80,15 +84,19 @@ namespace Honeycomb { namespace Object {
 		// Get the components of the same type as the Game Component passed in
 		// and move the Game Component into the list. Get a reference to the
 		// back of the list since that is where the Component was moved to.
-		auto& componentsOfType = this->getComponentsInternal(
-			component->getGameComponentID());
+		GameComponentID id = component->getGameComponentID();
+		auto& componentsOfType = this->getComponentsInternal(id);
 		componentsOfType.push_back(std::move(component));
 		GameComponent &componentRef = *componentsOfType.back();
 
 		// Increment the number of components, and notify the component that it
 		// has been attached to a new Game Object.
 		++this->numComponents;
+		this->componentMask[id] = true;
 		componentRef.attached = this;
+		componentRef.updateIsActive();
+		this->addToScenePool(componentRef);
+		if (this->scene != nullptr) this->scene->updateQueries(*this);
 		componentRef.onAttach();
 		return componentRef;
 	}
@@ -117,11 +125,13 @@ namespace Honeycomb { namespace Object {
 	void GameObject::doDisable() {
 		this->isSelfActive = false;
 		this->onDisable();
+		this->updateIsActive();
 	}
 
 	void GameObject::doEnable() {
 		this->isSelfActive = true;
 		this->onEnable();
+		this->updateIsActive();
 	}
 
 	GameObject& GameObject::getChild(const std::string &name) {
@@ -185,9 +195,7 @@ namespace Honeycomb { namespace Object {
 	}
 
 	bool GameObject::getIsActive() const {
-		if (!this->hasParent()) return false;
-
-		return this->isSelfActive && this->parent->getIsActive();
+		return this->isActive;
 	}
 
 	const bool& GameObject::getIsSelfActive() const {
@@ -204,7 +212,7 @@ namespace Honeycomb { namespace Object {
 
 	unsigned int GameObject::getNumberOfComponents(const unsigned int &id) 
 			const {
-		return this->getComponentsInternal(id).size();
+		return (unsigned int)this->getComponentsInternal(id).size();
 	}
 
 	GameObject* GameObject::getParent() {
@@ -232,7 +240,7 @@ namespace Honeycomb { namespace Object {
 	}
 
 	bool GameObject::hasComponent(const unsigned int &id) const {
-		return this->getNumberOfComponents(id) > 0;
+		return id < this->componentMask.size() && this->componentMask[id];
 	}
 
 	bool GameObject::hasParent() const {
@@ -328,10 +336,9 @@ namespace Honeycomb { namespace Object {
 		// Move the unique pointer out of the vector, so that this Game Object
 		// no longer owns it.
 		std::unique_ptr<GameObject> childPtr = std::move(*child);
-		childPtr->parent = nullptr;
-		childPtr->scene = nullptr;
 
-		// Trigger the onDetach event for the child
+		// Trigger the onDetach event for the child (which also detaches it
+		// and its children from the scene).
 		childPtr->onDetach(this);
 		
 		// Erase the child from my children vector, and move the pointer out
@@ -370,12 +377,17 @@ namespace Honeycomb { namespace Object {
 		
 		// Notify the Game Component that it has lost a parent
 		compPtr->onDetach();
+		this->removeFromScenePool(*compPtr);
 		compPtr->attached = nullptr;
+		compPtr->updateIsActive();
 		
 		// Erase the component from my components vector, and move the pointer
 		// out of this instance.
 		--this->numComponents;
 		componentsOfType.erase(comp);
+		if (componentsOfType.empty())
+			this->componentMask[component->getGameComponentID()] = false;
+		if (this->scene != nullptr) this->scene->updateQueries(*this);
 		return std::move(compPtr);
 	}
 
@@ -383,19 +395,41 @@ namespace Honeycomb { namespace Object {
 		this->name = name;
 	}
 
+	void* GameObject::operator new(std::size_t size) {
+		return PoolAllocator::getPoolAllocator()->allocate(size);
+	}
+
+	void GameObject::operator delete(void *block, std::size_t size) {
+		PoolAllocator::getPoolAllocator()->deallocate(block, size);
+	}
+
 	GameObject::GameObject(const std::string &name, 
 			const bool &attachTransform) {
 		this->name = name;
 		this->isSelfActive = false;
+		this->isActive = false;
 		this->parent = nullptr;
 		this->scene = nullptr;
 
-		this->components.resize(32);
 		this->numComponents = 0;
 
 		if (attachTransform) this->addComponent<Transform>();
 	}
 
+	void GameObject::addToScenePool(GameComponent &component) {
+		if (this->scene == nullptr) return;
+
+		component.poolHandle = this->scene->getComponentPool(
+			component.getGameComponentID()).add(&component);
+		this->scene->addSceneLight(component);
+	}
+
+	bool GameObject::calcIsActive() const {
+		if (!this->hasParent()) return false;
+
+		return this->isSelfActive && this->parent->isActive;
+	}
+
 	std::vector<std::unique_ptr<GameComponent>>& 
 			GameObject::getComponentsInternal(const unsigned int &id) {
 		this->resizeComponents();
@@ -404,8 +438,12 @@ namespace Honeycomb { namespace Object {
 
 	const std::vector<std::unique_ptr<GameComponent>>&
 			GameObject::getComponentsInternal(const unsigned int &id) const {
-		this->resizeComponents();
-		return this->components.at(id);
+		// A Game Object which has never had a component of the type has no
+		// list for it, rather than resizing on every lookup.
+		static const std::vector<std::unique_ptr<GameComponent>> none;
+
+		if (id >= this->components.size()) return none;
+		return this->components[id];
 	}
 
 	void GameObject::onAttach(GameObject *object) {
@@ -417,11 +455,19 @@ namespace Honeycomb { namespace Object {
 
 		// Attach this object to the same scene as the new parent
 		this->onAttach(object->scene);
+		this->updateIsActive();
 	}
 
 	void GameObject::onAttach(GameScene *scene) {
 		this->scene = scene;
 
+		for (auto &componentsOfType : this->components) {
+			for (auto &component : componentsOfType) {
+				this->addToScenePool(*component);
+			}
+		}
+		if (scene != nullptr) scene->updateQueries(*this);
+
 		for (auto &child : this->children) {
 			child->onAttach(scene);
 		}
@@ -432,9 +478,17 @@ namespace Honeycomb { namespace Object {
 		this->getComponent<Transform>().setParent(nullptr);
 
 		this->onDetach(this->scene);
+		this->updateIsActive();
 	}
 
 	void GameObject::onDetach(GameScene *scene) {
+		for (auto &componentsOfType : this->components) {
+			for (auto &component : componentsOfType) {
+				this->removeFromScenePool(*component);
+			}
+		}
+		if (this->scene != nullptr) this->scene->removeFromQueries(*this);
+
 		this->scene = nullptr;
 
 		for (auto &child : this->children) {
@@ -442,10 +496,60 @@ namespace Honeycomb { namespace Object {
 		}
 	}
 
-	void GameObject::resizeComponents() const {
+	void GameObject::removeFromScenePool(GameComponent &component) {
+		if (this->scene == nullptr) return;
+
+		this->scene->getComponentPool(component.getGameComponentID()).
+			remove(component.poolHandle);
+		this->scene->removeSceneLight(component);
+	}
+
+	void GameObject::resizeComponents() {
 		auto componentCount = GameComponent::getGameComponentIDCounter(false);
 
-		if (componentCount >= this->components.size())
-			this->components.resize(2 * componentCount);
+		if (componentCount > this->components.size()) {
+			this->components.resize(componentCount);
+			this->componentMask.resize(componentCount, false);
+		}
+	}
+
+	void GameObject::updateIsActive() {
+		bool active = this->calcIsActive();
+		if (active == this->isActive) return;
+
+		// The activeness of the components and children only depends on the
+		// activeness of this, so they only need to be updated if it changed.
+		this->isActive = active;
+		for (auto &componentsOfType : this->components) {
+			for (auto &component : componentsOfType) {
+				component->updateIsActive();
+			}
+		}
+
+		for (auto &child : this->children) {
+			child->updateIsActive();
+		}
+	}
+
+	void GameObject::updateSequential(
+			std::vector<std::vector<GameComponent*>> &parallel) {
+		for (std::size_t id = 0; id < this->components.size(); ++id) {
+			for (auto &component : this->components[id]) {
+				if (!component->getIsActive()) continue;
+
+				if (component->getProperty_UpdateAccess() ==
+						UpdateAccess::UPDATE_ACCESS_ANY) {
+					component->onUpdate();
+					continue;
+				}
+
+				if (parallel.size() <= id) parallel.resize(id + 1);
+				parallel[id].push_back(component.get());
+			}
+		}
+
+		for (auto &child : this->children) {
+			if (child->getIsActive()) child->updateSequential(parallel);
+		}
 	}
 } }
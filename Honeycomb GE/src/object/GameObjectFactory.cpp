@@ -10,6 +10,7 @@
 #include "../../include/component/physics/Transform.h"
 #include "../../include/component/render/CameraController.h"
 #include "../../include/math/Vector4f.h"
+#include "../../include/object/Prefab.h"
 
 using Honeycomb::Component::Light::AmbientLight;
 using Honeycomb::Component::Light::BaseLight;
@@ -21,6 +22,7 @@ using Honeycomb::Component::Render::CameraController;
 using Honeycomb::Geometry::Model;
 using Honeycomb::Geometry::ModelSettings;
 using Honeycomb::Math::Vector4f;
+using Honeycomb::Object::Prefab;
 
 namespace Honeycomb { namespace Object {
 	GameObjectFactory& GameObjectFactory::getFactory() {
@@ -50,13 +52,15 @@ namespace Honeycomb { namespace Object {
 	}
 
 	std::unique_ptr<GameObject> GameObjectFactory::newCone() {
-		static Model cone{ "../Honeycomb GE/res/models/default/cone.fbx" };
-		return newDefaultImport(cone, "Cone");
+		static Prefab cone{ *newDefaultImport(Model{
+			"../Honeycomb GE/res/models/default/cone.fbx" }, "Cone") };
+		return cone.instantiate();
 	}
 
 	std::unique_ptr<GameObject> GameObjectFactory::newCube() {
-		static Model cube{ "../Honeycomb GE/res/models/default/cube.fbx" };
-		return newDefaultImport(cube, "Cube");
+		static Prefab cube{ *newDefaultImport(Model{
+			"../Honeycomb GE/res/models/default/cube.fbx" }, "Cube") };
+		return cube.instantiate();
 	}
 
 	std::unique_ptr<GameObject> GameObjectFactory::newGameObject(
@@ -65,13 +69,16 @@ namespace Honeycomb { namespace Object {
 	}
 
 	std::unique_ptr<GameObject> GameObjectFactory::newIcosphere() {
-		static Model ico{ "../Honeycomb GE/res/models/default/icosphere.fbx" };
-		return newDefaultImport(ico, "Icosphere");
+		static Prefab ico{ *newDefaultImport(Model{
+			"../Honeycomb GE/res/models/default/icosphere.fbx" },
+			"Icosphere") };
+		return ico.instantiate();
 	}
 
 	std::unique_ptr<GameObject> GameObjectFactory::newPlane() {
-		static Model plane{ "../Honeycomb GE/res/models/default/plane.fbx" };
-		return newDefaultImport(plane, "Plane");
+		static Prefab plane{ *newDefaultImport(Model{
+			"../Honeycomb GE/res/models/default/plane.fbx" }, "Plane") };
+		return plane.instantiate();
 	}
 
 	std::unique_ptr<GameObject> GameObjectFactory::newPointLight() {
@@ -82,8 +89,9 @@ namespace Honeycomb { namespace Object {
 	}
 
 	std::unique_ptr<GameObject> GameObjectFactory::newSphere() {
-		static Model sphere{ "../Honeycomb GE/res/models/default/sphere.fbx" };
-		return newDefaultImport(sphere, "Sphere");
+		static Prefab sphere{ *newDefaultImport(Model{
+			"../Honeycomb GE/res/models/default/sphere.fbx" }, "Sphere") };
+		return sphere.instantiate();
 	}
 
 	std::unique_ptr<GameObject> GameObjectFactory::newSpotLight() {
@@ -94,8 +102,9 @@ namespace Honeycomb { namespace Object {
 	}
 
 	std::unique_ptr<GameObject> GameObjectFactory::newSuzanne() {
-		static Model suz{ "../Honeycomb GE/res/models/default/suzanne.fbx" };
-		return newDefaultImport(suz, "Suzanne");
+		static Prefab suz{ *newDefaultImport(Model{
+			"../Honeycomb GE/res/models/default/suzanne.fbx" }, "Suzanne") };
+		return suz.instantiate();
 	}
 
 	std::unique_ptr<GameObject> GameObjectFactory::newDefaultImport(
@@ -0,0 +1,147 @@
+#include "../../include/object/Prefab.h"
+
+#include "../../include/component/physics/Transform.h"
+#include "../../include/component/render/MeshRenderer.h"
+
+using Honeycomb::Component::GameComponent;
+using Honeycomb::Component::GameComponentID;
+using Honeycomb::Component::Physics::Transform;
+using Honeycomb::Component::Render::MeshRenderer;
+
+namespace Honeycomb { namespace Object {
+	Prefab::Prefab(const GameObject &object) {
+		this->flatten(object, -1);
+		this->precomputeTransforms();
+	}
+
+	std::size_t Prefab::getNodeCount() const {
+		return this->nodes.size();
+	}
+
+	std::unique_ptr<GameObject> Prefab::instantiate() const {
+		std::unique_ptr<GameObject> root;
+		std::vector<GameObject*> instances(this->nodes.size(), nullptr);
+		std::vector<Transform*> transforms(this->nodes.size(), nullptr);
+
+		for (std::size_t i = 0; i < this->nodes.size(); ++i) {
+			const Node &node = this->nodes[i];
+
+			// Create the Game Object without a Transform, since the Transform
+			// is cloned from its prototype along with the other components.
+			std::unique_ptr<GameObject> object(
+				new GameObject(node.name, false));
+			object->children.reserve(node.childCount);
+			object->resizeComponents();
+
+			// The prototypes came from a valid Game Object, so the components
+			// are put straight into their lists, without the checks of
+			// addComponent. The instance has no scene, so there are no pools
+			// or queries to update either.
+			for (std::size_t c = 0; c < node.componentCount; ++c) {
+				std::size_t index = node.firstComponent + c;
+				std::unique_ptr<GameComponent> component =
+					this->prototypes[index]->clone();
+				GameComponentID id = component->getGameComponentID();
+
+				if ((int)index == node.transform)
+					transforms[i] = static_cast<Transform*>(component.get());
+
+				component->attached = object.get();
+				object->componentMask[id] = true;
+				object->components[id].push_back(std::move(component));
+			}
+			object->numComponents = (unsigned int)node.componentCount;
+
+			// The components are only notified once all of them are in place,
+			// since they may look up the other components of the object.
+			for (auto &componentsOfType : object->components) {
+				for (auto &component : componentsOfType) {
+					component->updateIsActive();
+					component->onAttach();
+				}
+			}
+
+			// The parent always precedes its children in the nodes, so it
+			// has been built already. The global transformation was computed
+			// when the Prefab was made, so the Transform is only linked to
+			// its parent, and nothing is recomputed. The instance has no
+			// parent, so all of its Game Objects stay inactive.
+			instances[i] = object.get();
+			Transform *transform = transforms[i];
+			if (node.parent >= 0) {
+				GameObject *parent = instances[node.parent];
+				Transform *parentTransform = transforms[node.parent];
+				if (transform != nullptr && parentTransform != nullptr) {
+					transform->parent = parentTransform;
+					parentTransform->changedEvent += &transform->parentChanged;
+				}
+
+				object->parent = parent;
+				parent->children.push_back(std::move(object));
+			} else {
+				root = std::move(object);
+			}
+
+			// Only the components of this node listen to its Transform so
+			// far (e.g. the lights, which cache their direction), so this
+			// notifies them without reaching any other Game Object.
+			if (transform != nullptr) transform->changedEvent.onEvent();
+		}
+
+		return root;
+	}
+
+	void Prefab::flatten(const GameObject &object, const int &parent) {
+		Node node;
+		node.name = object.getName();
+		node.parent = parent;
+		node.firstComponent = this->prototypes.size();
+		node.componentCount = 0;
+		node.childCount = object.children.size();
+		node.transform = -1;
+
+		for (auto &componentsOfType : object.components) {
+			for (auto &component : componentsOfType) {
+				std::unique_ptr<GameComponent> prototype = component->clone();
+
+				// The materials of the instances are shared with the prototype
+				// until an instance writes to them.
+				if (prototype->getGameComponentID() == GameComponent::
+						getGameComponentTypeID<MeshRenderer>()) {
+					static_cast<MeshRenderer&>(*prototype).shareMaterials();
+				} else if (prototype->getGameComponentID() == GameComponent::
+						getGameComponentTypeID<Transform>()) {
+					node.transform = (int)this->prototypes.size();
+				}
+
+				this->prototypes.push_back(std::move(prototype));
+				++node.componentCount;
+			}
+		}
+
+		int index = (int)this->nodes.size();
+		this->nodes.push_back(node);
+
+		for (auto &child : object.children)
+			this->flatten(*child, index);
+	}
+
+	void Prefab::precomputeTransforms() {
+		// The parent always precedes its children, so its global
+		// transformation is already computed. The prototypes are only linked
+		// while their own transformation is computed.
+		for (const Node &node : this->nodes) {
+			if (node.transform < 0) continue;
+
+			Transform &transform = static_cast<Transform&>(
+				*this->prototypes[node.transform]);
+			if (node.parent >= 0 && this->nodes[node.parent].transform >= 0) {
+				transform.parent = static_cast<Transform*>(this->prototypes[
+					this->nodes[node.parent].transform].get());
+			}
+
+			transform.onParentChange();
+			transform.parent = nullptr;
+		}
+	}
+} }
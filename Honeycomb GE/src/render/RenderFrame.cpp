@@ -0,0 +1,181 @@
+#include "../../include/render/RenderFrame.h"
+
+#include "../../include/component/light/DirectionalLight.h"
+#include "../../include/component/light/PointLight.h"
+#include "../../include/component/light/SpotLight.h"
+#include "../../include/component/physics/Transform.h"
+#include "../../include/component/render/CameraController.h"
+#include "../../include/component/render/MeshRenderer.h"
+#include "../../include/scene/GameScene.h"
+
+using Honeycomb::Component::GameComponent;
+using Honeycomb::Component::Light::Attenuation;
+using Honeycomb::Component::Light::BaseLight;
+using Honeycomb::Component::Light::DirectionalLight;
+using Honeycomb::Component::Light::LightType;
+using Honeycomb::Component::Light::PointLight;
+using Honeycomb::Component::Light::Shadow;
+using Honeycomb::Component::Light::SpotLight;
+using Honeycomb::Component::Physics::Transform;
+using Honeycomb::Component::Render::CameraController;
+using Honeycomb::Component::Render::MeshRenderer;
+using Honeycomb::Graphics::Material;
+using Honeycomb::Math::Matrix4f;
+using Honeycomb::Scene::GameScene;
+using Honeycomb::Shader::GenericStruct;
+using Honeycomb::Shader::ShaderProgram;
+
+namespace Honeycomb { namespace Render {
+	RenderFrame::Light::Light(const BaseLight &light) : uniforms(light) {
+		this->type = light.getType();
+		this->color = light.getColor();
+		this->intensity = light.getIntensity();
+		this->range = 0.0F;
+		this->angle = 0.0F;
+
+		if (this->type != LightType::LIGHT_TYPE_AMBIENT) {
+			const Transform &transform =
+				light.getAttached()->getComponent<Transform>();
+			this->transform = transform.getMatrixTransformation();
+			this->position = transform.getGlobalTranslation();
+		}
+
+		// The type of a light determines its class, so no RTTI is needed to
+		// downcast it.
+		switch (this->type) {
+		case LightType::LIGHT_TYPE_DIRECTIONAL: {
+			auto &dL = static_cast<const DirectionalLight&>(light);
+			this->direction = dL.getDirection();
+			this->shadow.reset(new Shadow(dL.getShadow()));
+			break;
+		}
+		case LightType::LIGHT_TYPE_POINT: {
+			auto &pL = static_cast<const PointLight&>(light);
+			this->range = pL.getRange();
+			this->attenuation.reset(new Attenuation(pL.getAttenuation()));
+			break;
+		}
+		case LightType::LIGHT_TYPE_SPOT: {
+			auto &sL = static_cast<const SpotLight&>(light);
+			this->direction = sL.getDirection();
+			this->range = sL.getRange();
+			this->angle = sL.getAngle();
+			this->attenuation.reset(new Attenuation(sL.getAttenuation()));
+			this->shadow.reset(new Shadow(sL.getShadow()));
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	void RenderFrame::Light::toShader(ShaderProgram &shader,
+			const std::string &uni) const {
+		this->uniforms.toShader(shader, uni);
+
+		if (this->attenuation)
+			this->attenuation->toShader(shader, uni + ".attenuation");
+		if (this->shadow)
+			this->shadow->toShader(shader, uni + ".shadow");
+	}
+
+	RenderFrame::RenderFrame() {
+
+	}
+
+	RenderFrame::~RenderFrame() {
+
+	}
+
+	void RenderFrame::clear() {
+		this->objects.clear();
+		this->lights.clear();
+		this->materials.clear();
+		this->camera.reset();
+	}
+
+	void RenderFrame::extract(GameScene &scene) {
+		// Objects are assigned rather than recreated, so that the lists of
+		// meshes & materials keep their storage from frame to frame. The Mesh
+		// Renderers are read straight from their pool, rather than searched
+		// for in the hierarchy.
+		std::size_t count = 0;
+		for (GameComponent *component :
+				scene.getComponentPool<MeshRenderer>().getComponents()) {
+			const MeshRenderer &mR = *static_cast<MeshRenderer*>(component);
+			if (!mR.getIsActive()) continue;
+
+			if (count == this->objects.size()) this->objects.emplace_back();
+			mR.toRenderObject(this->objects[count++]);
+		}
+		this->objects.resize(count);
+
+		// Replace the materials of the objects with copies, so that the game
+		// may write the materials while this frame is rendered. Each material
+		// is copied once, however many objects use it, so that the renderers
+		// may still batch the objects by material. The copies of materials
+		// which are no longer used are released.
+		std::unordered_map<const Material*, std::shared_ptr<Material>> last;
+		last.swap(this->materials);
+		for (Object &object : this->objects) {
+			for (std::shared_ptr<Material> &material : object.materials) {
+				std::shared_ptr<Material> &copy =
+					this->materials[material.get()];
+
+				if (!copy) {
+					auto find = last.find(material.get());
+					if (find != last.end()) {
+						copy = std::move(find->second);
+						*copy = *material;
+					} else {
+						copy = std::make_shared<Material>(*material);
+					}
+				}
+
+				material = copy;
+			}
+		}
+
+		this->lights.clear();
+		for (const BaseLight &bL : scene.getSceneLights()) {
+			if (bL.getIsActive()) this->lights.emplace_back(bL);
+		}
+
+		// Only the uniforms of the camera are copied, rather than the whole
+		// component (the projection is computed lazily, so compute it first).
+		CameraController *active = CameraController::getActiveCamera();
+		if (active == nullptr) {
+			this->camera.reset();
+		} else {
+			this->cameraProjection = active->getProjection();
+
+			if (this->camera) *this->camera = *active;
+			else this->camera.reset(new GenericStruct(*active));
+		}
+	}
+
+	const GenericStruct& RenderFrame::getCamera() const {
+		return *this->camera;
+	}
+
+	const Matrix4f& RenderFrame::getCameraProjection() const {
+		return this->cameraProjection;
+	}
+
+	bool RenderFrame::getHasCamera() const {
+		return this->camera != nullptr;
+	}
+
+	const std::vector<RenderFrame::Light>& RenderFrame::getLights() const {
+		return this->lights;
+	}
+
+	const std::vector<RenderFrame::Object>& RenderFrame::getObjects() const {
+		return this->objects;
+	}
+
+	void RenderFrame::renderObjects(ShaderProgram &shader) const {
+		for (const Object &object : this->objects)
+			MeshRenderer::render(shader, object);
+	}
+} }
@@ -3,11 +3,14 @@
 #include <GL/glew.h>
 
 #include "../../include/component/render/MeshRenderer.h"
+#include "../../include/geometry/Vertex.h"
 #include "../../include/object/GameObjectFactory.h"
 #include "../../include/object/GameObject.h"
 #include "../../include/render/RenderingEngine.h"
 
 using Honeycomb::Component::Render::MeshRenderer;
+using Honeycomb::Geometry::Mesh;
+using Honeycomb::Geometry::Vertex;
 using Honeycomb::Graphics::Cubemap;
 using Honeycomb::Graphics::Texture2D;
 using Honeycomb::Graphics::TextureFilterMagMode;
@@ -16,8 +19,9 @@ using Honeycomb::Graphics::TextureDataInternalFormat;
 using Honeycomb::Graphics::TextureDataType;
 using Honeycomb::Graphics::TextureWrapMode;
 using Honeycomb::Object::GameObjectFactory;
+using Honeycomb::Math::Vector2f;
+using Honeycomb::Math::Vector3f;
 using Honeycomb::Math::Vector4f;
-using Honeycomb::Scene::GameScene;
 using Honeycomb::Shader::ShaderProgram;
 using Honeycomb::Shader::ShaderType;
 
@@ -49,7 +53,7 @@ namespace Honeycomb { namespace Render {
 		return this->SHADOW_MAP_WIDTH;
 	}
 
-	void Renderer::render(GameScene &scene) {
+	void Renderer::render(const RenderFrame &frame) {
 
 	}
 
@@ -93,6 +97,11 @@ namespace Honeycomb { namespace Render {
 		this->doPostProcess = b;
 	}
 
+	void Renderer::setDoPostEffect(const PostEffect &e, const bool &b) {
+		if (b) this->postEffects |= e;
+		else this->postEffects &= ~e;
+	}
+
 	void Renderer::setFrontFace(const WindingOrder &w) {
 		this->frontFace = w;
 		glFrontFace((GLenum)w);
@@ -124,10 +133,14 @@ namespace Honeycomb { namespace Render {
 	}
 
 	Renderer::Renderer() {
+		this->frame = nullptr;
+
+		this->initializeQuad();
+
 		this->initializeFXAAShader();
 		this->setAntiAliasing(AntiAliasing::FXAA);
 
-		this->initializeGammaShader();
+		this->initializeFinalShader();
 		this->setColorSpace(ColorSpace::GAMMA_POST);
 
 		this->initializeCubemapDependencies();
@@ -138,6 +151,7 @@ namespace Honeycomb { namespace Render {
 		this->initializeShadowMapDependencies();
 
 		this->setDoPostProcess(true);
+		this->postEffects = 0;
 
 		this->setFrontFace(WindingOrder::COUNTER_CLOCKWISE);
 		this->setCullingFace(PolygonFace::BACK);
@@ -189,15 +203,39 @@ namespace Honeycomb { namespace Render {
 		this->fxaaShader.setUniform_f("reduceMul", 1.0F / 8.0F);
 	}
 
-	void Renderer::initializeGammaShader() {
-		this->gammaShader.initialize();
-		this->gammaShader.addShader("../Honeycomb GE/res/shaders/render/"
-			"gamma/gammaVS.glsl", ShaderType::VERTEX_SHADER);
-		this->gammaShader.addShader("../Honeycomb GE/res/shaders/render/"
-			"gamma/gammaFS.glsl", ShaderType::FRAGMENT_SHADER);
-		this->gammaShader.finalizeShaderProgram();
+	void Renderer::initializeQuad() {
+		// The vertices for a full screen Quad
+		Vertex quadVerts[4] = {
+			Vertex(Vector3f(-1.0F, -1.0F, 0.0F), Vector3f(0.0F, 0.0F, 0.0F),
+				Vector3f(0.0F, 0.0F, 0.0F), Vector2f(0.0F, 0.0F)),
+			Vertex(Vector3f(-1.0F,  1.0F, 0.0F), Vector3f(0.0F, 0.0F, 0.0F),
+				Vector3f(0.0F, 0.0F, 0.0F), Vector2f(0.0F, 1.0F)),
+			Vertex(Vector3f( 1.0F,  1.0F, 0.0F), Vector3f(0.0F, 0.0F, 0.0F),
+				Vector3f(0.0F, 0.0F, 0.0F), Vector2f(1.0F, 1.0F)),
+			Vertex(Vector3f( 1.0F, -1.0F, 0.0F), Vector3f(0.0F, 0.0F, 0.0F),
+				Vector3f(0.0F, 0.0F, 0.0F), Vector2f(1.0F, 0.0F))
+		};
+
+		// The indices of the two triangles of the Quad
+		unsigned int indices[6] = { 0, 3, 2, 2, 1, 0 };
+
+		// Build the Quad Mesh & initialize so that it may be drawn
+		this->quad = Mesh::newMeshUnique();
+		this->quad->setVertexData(
+			std::vector<Vertex>(quadVerts, quadVerts + 4));
+		this->quad->setIndexData(
+			std::vector<unsigned int>(indices, indices + 6));
+	}
+
+	void Renderer::initializeFinalShader() {
+		this->finalShader.initialize();
+		this->finalShader.addShader("../Honeycomb GE/res/shaders/render/"
+			"final/finalVS.glsl", ShaderType::VERTEX_SHADER);
+		this->finalShader.addShader("../Honeycomb GE/res/shaders/render/"
+			"final/finalFS.glsl", ShaderType::FRAGMENT_SHADER);
+		this->finalShader.finalizeShaderProgram();
 
-		this->gammaShader.setUniform_f("gamma", 2.2F);
+		this->finalShader.setUniform_f("gamma", 2.2F);
 	}
 
 	void Renderer::initializeShadowMapDependencies() {
@@ -322,6 +360,11 @@ namespace Honeycomb { namespace Render {
 	}
 
 	void Renderer::setGamma(const float &g) {
-		this->gammaShader.setUniform_f("gamma", g);
+		this->finalShader.setUniform_f("gamma", g);
+	}
+
+	void Renderer::writePostEffectsToShader(ShaderProgram &shader) {
+		shader.setUniform_i("postEffects",
+			this->doPostProcess ? this->postEffects : 0);
 	}
 } }
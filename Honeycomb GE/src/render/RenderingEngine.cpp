@@ -1,9 +1,11 @@
 #include "../../include/render/RenderingEngine.h"
 
 #include "../../include/render/deferred/DeferredRenderer.h"
+#include "../../include/render/forward/ForwardPlusRenderer.h"
 
 using Honeycomb::Scene::GameScene;
 using Honeycomb::Render::Deferred::DeferredRenderer;
+using Honeycomb::Render::Forward::ForwardPlusRenderer;
 
 namespace Honeycomb { namespace Render {
 	RenderingEngine *RenderingEngine::renderingEngine = nullptr;
@@ -15,16 +17,33 @@ namespace Honeycomb { namespace Render {
 		return renderingEngine;
 	}
 
+	void RenderingEngine::render(const RenderFrame &frame) {
+		// Nothing can be rendered without a camera
+		if (!frame.getHasCamera()) return;
+
+		this->renderer->render(frame);
+	}
+
 	void RenderingEngine::render(GameScene &scene) {
-		this->renderer->render(scene);
+		this->frame.extract(scene);
+		this->render(this->frame);
 	}
 
 	void RenderingEngine::setRenderingType(const RenderingType &type) {
+		this->type = type;
+
 		switch (type) {
 		case RenderingType::TYPE_DEFERRED_RENDERER:
 			this->renderer = DeferredRenderer::getDeferredRenderer();
 			break;
+		case RenderingType::TYPE_FORWARD_PLUS_RENDERER:
+			this->renderer = ForwardPlusRenderer::getForwardPlusRenderer();
+			break;
 		}
+
+		// Keep the Renderer singleton in sync so that the components always
+		// fetch the settings of the renderer which is actually in use.
+		Renderer::renderer = this->renderer;
 	}
 	
 	RenderingEngine::RenderingEngine() {
@@ -0,0 +1,406 @@
+#include "../../../include/render/batch/MultiDrawBatch.h"
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <array>
+
+#include "../../../include/base/GLErrorException.h"
+#include "../../../include/geometry/GeometryArena.h"
+
+using Honeycomb::Base::GLErrorException;
+using Honeycomb::Base::GLItemNotInitializedException;
+using Honeycomb::Geometry::GeometryArena;
+using Honeycomb::Geometry::Mesh;
+using Honeycomb::Graphics::Material;
+using Honeycomb::Graphics::MaterialTable;
+using Honeycomb::Math::Matrix4f;
+using Honeycomb::Math::Vector3f;
+using Honeycomb::Render::Culling::HiZBuffer;
+using Honeycomb::Shader::ShaderProgram;
+using Honeycomb::Shader::ShaderType;
+
+namespace Honeycomb { namespace Render { namespace Batch {
+	const int MultiDrawBatch::CULL_GROUP_SIZE = 64;
+
+	bool MultiDrawBatch::isSupported() {
+		return GLEW_ARB_multi_draw_indirect && GLEW_ARB_base_instance;
+	}
+
+	bool MultiDrawBatch::isCullingSupported() {
+		return MultiDrawBatch::isSupported() && GLEW_ARB_compute_shader &&
+			GLEW_ARB_shader_storage_buffer_object;
+	}
+
+	void MultiDrawBatch::setTextureUnits(ShaderProgram &shader) {
+		shader.setUniform_i("objTransforms",
+			TextureUnit::TEXTURE_UNIT_TRANSFORMS);
+		MaterialTable::setTextureUnits(shader,
+			TextureUnit::TEXTURE_UNIT_MATERIAL_TABLE);
+	}
+
+	MultiDrawBatch::MultiDrawBatch() {
+		this->bucketCount = 0;
+		this->drawCount = 0;
+		this->isUploaded = false;
+		this->isCulled = false;
+		this->isCompacted = false;
+
+		this->commandBuffer = 0;
+		this->drawDataBuffer = 0;
+		this->transformBuffer = 0;
+		this->transformTexture = 0;
+		this->capacity = 0;
+
+		this->cullDataBuffer = 0;
+		this->culledCommandBuffer = 0;
+		this->drawCountBuffer = 0;
+	}
+
+	MultiDrawBatch::~MultiDrawBatch() {
+
+	}
+
+	bool MultiDrawBatch::add(const RenderFrame::Object &object) {
+		if (!object.isBatchable) return false;
+
+		const std::vector<std::shared_ptr<Mesh>> &meshes = object.meshes;
+		const auto &materials = object.materials;
+
+		// Every mesh of the object shares the same transform
+		int transformIndex = (int)this->drawCount;
+		std::array<float, 16> rows = object.transform.get();
+		this->transforms.insert(this->transforms.end(), rows.begin(),
+			rows.end());
+
+		for (std::size_t i = 0; i < meshes.size(); ++i) {
+			const Mesh &mesh = *meshes[i];
+			const Material *material = (materials.size() == 1) ?
+				materials[0].get() : materials[i].get();
+
+			// Find the bucket of the material (or the bucket of the Material
+			// Table), reusing an old bucket (and its storage) if a new one is
+			// needed.
+			int materialIndex = this->materialTable.add(*material);
+			if (materialIndex >= 0) material = nullptr;
+
+			auto find = this->bucketIndices.find(material);
+			if (find == this->bucketIndices.end()) {
+				if (this->bucketCount == this->buckets.size())
+					this->buckets.push_back(Bucket());
+
+				Bucket &bucket = this->buckets[this->bucketCount];
+				bucket.material = material;
+				bucket.commands.clear();
+				bucket.cullData.clear();
+				bucket.draws.clear();
+
+				find = this->bucketIndices.insert(
+					{ material, this->bucketCount++ }).first;
+			}
+
+			// The base instance is only known once the batch is uploaded
+			Bucket &bucket = this->buckets[find->second];
+			bucket.commands.push_back({
+				(unsigned int)mesh.getIndices().size(), 1,
+				(unsigned int)mesh.getFirstIndex(),
+				(int)mesh.getBaseVertex(), 0 });
+			bucket.draws.push_back({ transformIndex, materialIndex });
+
+			// The offset of the bucket is only known once it is uploaded
+			const Vector3f &min = mesh.getBoundsMin();
+			const Vector3f &max = mesh.getBoundsMax();
+			bucket.cullData.push_back({
+				{ min.getX(), min.getY(), min.getZ() },
+				(unsigned int)find->second,
+				{ max.getX(), max.getY(), max.getZ() }, 0 });
+		}
+
+		++this->drawCount;
+		this->isUploaded = false;
+		this->isCulled = false;
+
+		return true;
+	}
+
+	void MultiDrawBatch::clear() {
+		this->bucketCount = 0;
+		this->bucketIndices.clear();
+		this->transforms.clear();
+		this->drawCount = 0;
+		this->materialTable.clear();
+		this->isUploaded = false;
+		this->isCulled = false;
+	}
+
+	void MultiDrawBatch::cull(const Matrix4f &proj, const HiZBuffer *hiZ) {
+		GLErrorException::clear();
+		if (!this->isInitialized) throw GLItemNotInitializedException(this);
+		if (!MultiDrawBatch::isCullingSupported() || this->drawCount == 0)
+			return;
+
+		if (!this->isUploaded) this->upload();
+		if (this->commands.empty()) return;
+
+		// Reset the number of visible commands of each bucket
+		this->isCompacted = GLEW_ARB_indirect_parameters;
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->drawCountBuffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER,
+			this->bucketCount * sizeof(GLuint), nullptr, GL_STREAM_DRAW);
+		glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI,
+			GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+		this->cullShader.bindShaderProgram();
+		this->cullShader.setUniform_i("commandCount",
+			(int)this->commands.size());
+		this->cullShader.setUniform_i("doCompact", this->isCompacted);
+		this->cullShader.setUniform_mat4("cullProjection", proj);
+
+		// The depth pyramid can only be tested against once it holds depths
+		bool doOcclusion = hiZ != nullptr && hiZ->getHasPyramid();
+		this->cullShader.setUniform_i("doOcclusion", doOcclusion);
+		if (doOcclusion) {
+			this->cullShader.setUniform_mat4("hiZProjection",
+				hiZ->getPyramidProjection());
+			this->cullShader.setUniform_i("hiZPyramid",
+				TextureUnit::TEXTURE_UNIT_HI_Z);
+			glActiveTexture(GL_TEXTURE0 + TextureUnit::TEXTURE_UNIT_HI_Z);
+			glBindTexture(GL_TEXTURE_2D, hiZ->getPyramidTexture());
+		}
+
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, this->commandBuffer);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1,
+			this->culledCommandBuffer);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, this->cullDataBuffer);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, this->transformBuffer);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, this->drawCountBuffer);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, this->drawDataBuffer);
+
+		GLuint groups = (GLuint)((this->commands.size() +
+			MultiDrawBatch::CULL_GROUP_SIZE - 1) /
+			MultiDrawBatch::CULL_GROUP_SIZE);
+		glDispatchCompute(groups, 1, 1);
+
+		// The commands and counts are read by the indirect draws
+		glMemoryBarrier(GL_COMMAND_BARRIER_BIT);
+		for (GLuint i = 0; i < 6; ++i)
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, i, 0);
+
+		this->isCulled = true;
+		GLErrorException::checkGLError(__FILE__, __LINE__);
+	}
+
+	void MultiDrawBatch::destroy() {
+		GLErrorException::clear();
+		if (!this->isInitialized) throw GLItemNotInitializedException(this);
+
+		GLuint buffers[6] = { (GLuint)this->commandBuffer,
+			(GLuint)this->drawDataBuffer, (GLuint)this->transformBuffer,
+			(GLuint)this->cullDataBuffer, (GLuint)this->culledCommandBuffer,
+			(GLuint)this->drawCountBuffer };
+		glDeleteBuffers(6, buffers);
+
+		GLuint texture = this->transformTexture;
+		glDeleteTextures(1, &texture);
+
+		this->commandBuffer = 0;
+		this->drawDataBuffer = 0;
+		this->transformBuffer = 0;
+		this->transformTexture = 0;
+		this->capacity = 0;
+		this->cullDataBuffer = 0;
+		this->culledCommandBuffer = 0;
+		this->drawCountBuffer = 0;
+		this->isUploaded = false;
+		this->isCulled = false;
+
+		if (MultiDrawBatch::isCullingSupported()) this->cullShader.destroy();
+		this->materialTable.destroy();
+
+		GLItem::destroy();
+		GLErrorException::checkGLError(__FILE__, __LINE__);
+	}
+
+	const std::size_t& MultiDrawBatch::getDrawCount() const {
+		return this->drawCount;
+	}
+
+	void MultiDrawBatch::initialize() {
+		GLErrorException::clear();
+		GLItem::initialize();
+
+		GLuint buffers[6];
+		glGenBuffers(6, buffers);
+		this->commandBuffer = buffers[0];
+		this->drawDataBuffer = buffers[1];
+		this->transformBuffer = buffers[2];
+		this->cullDataBuffer = buffers[3];
+		this->culledCommandBuffer = buffers[4];
+		this->drawCountBuffer = buffers[5];
+
+		GLuint texture;
+		glGenTextures(1, &texture);
+		this->transformTexture = texture;
+		this->materialTable.initialize();
+
+		// The culling shader requires OpenGL 4.3, so it is only compiled if
+		// it is supported.
+		if (MultiDrawBatch::isCullingSupported()) {
+			this->cullShader.initialize();
+			this->cullShader.addShader("../Honeycomb GE/res/shaders/"
+				"render/culling/cullDrawsCS.glsl",
+				ShaderType::COMPUTE_SHADER);
+			this->cullShader.finalizeShaderProgram();
+		}
+
+		GLErrorException::checkGLError(__FILE__, __LINE__);
+	}
+
+	void MultiDrawBatch::render(ShaderProgram &shader,
+			const bool &doMaterials) {
+		GLErrorException::clear();
+		if (!this->isInitialized) throw GLItemNotInitializedException(this);
+		if (this->drawCount == 0) return;
+
+		if (!this->isUploaded) this->upload();
+		if (this->commands.empty()) return;
+
+		shader.bindShaderProgram();
+		shader.setUniform_i("objIsBatched", 1);
+		shader.setUniform_i("objTransforms",
+			TextureUnit::TEXTURE_UNIT_TRANSFORMS);
+		glActiveTexture(GL_TEXTURE0 + TextureUnit::TEXTURE_UNIT_TRANSFORMS);
+		glBindTexture(GL_TEXTURE_BUFFER, this->transformTexture);
+		if (doMaterials) {
+			this->materialTable.toShader(shader,
+				TextureUnit::TEXTURE_UNIT_MATERIAL_TABLE);
+		}
+
+		// The draw data advances once per instance, and starts at the base
+		// instance of each command.
+		GeometryArena *arena = GeometryArena::getGeometryArena();
+		arena->bindBuffers();
+		glBindBuffer(GL_ARRAY_BUFFER, this->drawDataBuffer);
+		glEnableVertexAttribArray(4);
+		glVertexAttribIPointer(4, 2, GL_INT, 0, nullptr);
+		glVertexAttribDivisor(4, 1);
+
+		// If the compacted commands are drawn, the number of commands of
+		// each bucket is read from the draw count buffer.
+		bool doCount = this->isCulled && this->isCompacted;
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, this->isCulled ?
+			this->culledCommandBuffer : this->commandBuffer);
+		if (doCount)
+			glBindBuffer(GL_PARAMETER_BUFFER_ARB, this->drawCountBuffer);
+
+		if (doMaterials || doCount) {
+			for (std::size_t i = 0; i < this->bucketCount; ++i) {
+				const Bucket &bucket = this->buckets[i];
+				if (doMaterials && bucket.material != nullptr)
+					bucket.material->toShader(shader, "material");
+
+				void *offset = (void*)(bucket.offset * sizeof(DrawCommand));
+				if (doCount) {
+					glMultiDrawElementsIndirectCountARB(GL_TRIANGLES,
+						GL_UNSIGNED_INT, offset, i * sizeof(GLuint),
+						(GLsizei)bucket.commands.size(), 0);
+				} else {
+					glMultiDrawElementsIndirect(GL_TRIANGLES,
+						GL_UNSIGNED_INT, offset,
+						(GLsizei)bucket.commands.size(), 0);
+				}
+			}
+		} else {
+			glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+				nullptr, (GLsizei)this->commands.size(), 0);
+		}
+
+		if (doCount) glBindBuffer(GL_PARAMETER_BUFFER_ARB, 0);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+		glVertexAttribDivisor(4, 0);
+		glDisableVertexAttribArray(4);
+		arena->unbindBuffers();
+
+		shader.setUniform_i("objIsBatched", 0);
+		GLErrorException::checkGLError(__FILE__, __LINE__);
+	}
+
+	void MultiDrawBatch::upload() {
+		// Flatten the buckets into a single list of commands, each of which
+		// reads the draw data at its own index.
+		this->commands.clear();
+		this->cullData.clear();
+		this->drawData.clear();
+		for (std::size_t i = 0; i < this->bucketCount; ++i) {
+			Bucket &bucket = this->buckets[i];
+			bucket.offset = this->commands.size();
+			for (DrawCommand command : bucket.commands) {
+				command.baseInstance = (unsigned int)this->commands.size();
+				this->commands.push_back(command);
+			}
+			this->drawData.insert(this->drawData.end(),
+				bucket.draws.begin(), bucket.draws.end());
+
+			for (DrawCullData data : bucket.cullData) {
+				data.bucketOffset = (unsigned int)bucket.offset;
+				this->cullData.push_back(data);
+			}
+		}
+
+		// Nothing is uploaded if the objects of the batch have no meshes
+		this->isUploaded = true;
+		if (this->commands.empty()) return;
+
+		// Grow the buffers to fit all of the draws
+		std::size_t draws = std::max(this->drawCount, this->commands.size());
+		if (draws > this->capacity) {
+			this->capacity = std::max(draws, this->capacity * 2);
+
+			// The culled commands are only ever written by the GPU
+			glBindBuffer(GL_ARRAY_BUFFER, this->culledCommandBuffer);
+			glBufferData(GL_ARRAY_BUFFER, this->capacity * sizeof(DrawCommand),
+				nullptr, GL_DYNAMIC_COPY);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+
+		// Orphan the old contents, since they may still be in use by the
+		// previous frame.
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, this->commandBuffer);
+		glBufferData(GL_DRAW_INDIRECT_BUFFER,
+			this->capacity * sizeof(DrawCommand), nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0,
+			this->commands.size() * sizeof(DrawCommand), this->commands.data());
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+		glBindBuffer(GL_ARRAY_BUFFER, this->drawDataBuffer);
+		glBufferData(GL_ARRAY_BUFFER, this->capacity * sizeof(DrawData),
+			nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0,
+			this->drawData.size() * sizeof(DrawData), this->drawData.data());
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		// Each transform is stored as four texels, one per row
+		glBindBuffer(GL_TEXTURE_BUFFER, this->transformBuffer);
+		glBufferData(GL_TEXTURE_BUFFER,
+			this->capacity * 16 * sizeof(float), nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_TEXTURE_BUFFER, 0,
+			this->transforms.size() * sizeof(float), this->transforms.data());
+		glBindTexture(GL_TEXTURE_BUFFER, this->transformTexture);
+		glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, this->transformBuffer);
+		glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+		// The cull data is only needed if the batch may be culled
+		if (MultiDrawBatch::isCullingSupported()) {
+			glBindBuffer(GL_ARRAY_BUFFER, this->cullDataBuffer);
+			glBufferData(GL_ARRAY_BUFFER,
+				this->capacity * sizeof(DrawCullData), nullptr,
+				GL_STREAM_DRAW);
+			glBufferSubData(GL_ARRAY_BUFFER, 0,
+				this->cullData.size() * sizeof(DrawCullData),
+				this->cullData.data());
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+	}
+} } }
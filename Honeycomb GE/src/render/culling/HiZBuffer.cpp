@@ -0,0 +1,395 @@
+#include "../../../include/render/culling/HiZBuffer.h"
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "../../../include/math/Vector2f.h"
+#include "../../../include/math/Vector4f.h"
+
+using Honeycomb::Base::GLItemNotInitializedException;
+using Honeycomb::Geometry::Mesh;
+using Honeycomb::Graphics::Texture2D;
+using Honeycomb::Math::Matrix4f;
+using Honeycomb::Math::Vector2f;
+using Honeycomb::Math::Vector3f;
+using Honeycomb::Math::Vector4f;
+using Honeycomb::Shader::ShaderType;
+
+namespace Honeycomb { namespace Render { namespace Culling {
+	const int HiZBuffer::READ_BACK_MAX_WIDTH = 256;
+
+	HiZBuffer::HiZBuffer() {
+		for (int i = 0; i < READ_BACK_BUFFERS; ++i) {
+			this->readBackBuffers[i] = 0;
+			this->readBackFences[i] = nullptr;
+		}
+
+		this->pyramidTexture = 0;
+		this->frameBuffer = 0;
+		this->sourceWidth = 0;
+		this->sourceHeight = 0;
+		this->readBackLevel = 0;
+		this->readBackIndex = 0;
+		this->hasCpuLevels = false;
+		this->hasPyramid = false;
+	}
+
+	HiZBuffer::~HiZBuffer() {
+
+	}
+
+	void HiZBuffer::destroy() {
+		if (!this->isInitialized) return;
+
+		for (int i = 0; i < READ_BACK_BUFFERS; ++i) {
+			if (this->readBackFences[i] != nullptr)
+				glDeleteSync(static_cast<GLsync>(this->readBackFences[i]));
+			this->readBackFences[i] = nullptr;
+
+			GLuint buffer = this->readBackBuffers[i];
+			glDeleteBuffers(1, &buffer);
+		}
+
+		GLuint texture = this->pyramidTexture;
+		glDeleteTextures(1, &texture);
+
+		GLuint fbo = this->frameBuffer;
+		glDeleteFramebuffers(1, &fbo);
+
+		this->downsampleShader.destroy();
+		this->levelWidths.clear();
+		this->levelHeights.clear();
+		this->sourceWidth = 0;
+		this->sourceHeight = 0;
+		this->hasCpuLevels = false;
+		this->hasPyramid = false;
+
+		GLItem::destroy();
+	}
+
+	void HiZBuffer::initialize() {
+		GLItem::initialize();
+
+		GLuint texture;
+		glGenTextures(1, &texture);
+		this->pyramidTexture = texture;
+
+		GLuint fbo;
+		glGenFramebuffers(1, &fbo);
+		this->frameBuffer = fbo;
+
+		GLuint buffers[READ_BACK_BUFFERS];
+		glGenBuffers(READ_BACK_BUFFERS, buffers);
+		for (int i = 0; i < READ_BACK_BUFFERS; ++i)
+			this->readBackBuffers[i] = buffers[i];
+
+		this->downsampleShader.initialize();
+		this->downsampleShader.addShader("../Honeycomb GE/res/shaders/"
+			"render/deferred/geometry/simpleVS.glsl",
+			ShaderType::VERTEX_SHADER);
+		this->downsampleShader.addShader("../Honeycomb GE/res/shaders/"
+			"render/hiz/hiZDownsampleFS.glsl",
+			ShaderType::FRAGMENT_SHADER);
+		this->downsampleShader.finalizeShaderProgram();
+	}
+
+	const bool& HiZBuffer::getHasPyramid() const {
+		return this->hasPyramid;
+	}
+
+	const Matrix4f& HiZBuffer::getPyramidProjection() const {
+		return this->pyramidProjection;
+	}
+
+	const int& HiZBuffer::getPyramidTexture() const {
+		return this->pyramidTexture;
+	}
+
+	bool HiZBuffer::isVisible(const Vector3f &min, const Vector3f &max)
+			const {
+		if (!this->hasCpuLevels) return true;
+
+		// Project the corners of the box into the normalized device
+		// coordinates of the camera with which the depths were rendered.
+		const float inf = std::numeric_limits<float>::infinity();
+		float ndcMin[3] = {  inf,  inf,  inf };
+		float ndcMax[3] = { -inf, -inf, -inf };
+		for (int i = 0; i < 8; ++i) {
+			Vector4f corner = this->cpuProjection * Vector4f(
+				(i & 1) ? max.getX() : min.getX(),
+				(i & 2) ? max.getY() : min.getY(),
+				(i & 4) ? max.getZ() : min.getZ(), 1.0F);
+
+			// A corner behind the camera cannot be projected, so the box
+			// might cover the entire screen.
+			if (corner.getW() <= 0.0F) return true;
+
+			float ndc[3] = { corner.getX() / corner.getW(),
+				corner.getY() / corner.getW(), corner.getZ() / corner.getW() };
+			for (int j = 0; j < 3; ++j) {
+				ndcMin[j] = std::min(ndcMin[j], ndc[j]);
+				ndcMax[j] = std::max(ndcMax[j], ndc[j]);
+			}
+		}
+
+		// The parts of a box outside of the old screen have no depths to be
+		// tested against, and may have come into view since, so a box which
+		// is not entirely on the old screen is kept.
+		if (ndcMin[0] < -1.0F || ndcMax[0] > 1.0F ||
+			ndcMin[1] < -1.0F || ndcMax[1] > 1.0F) return true;
+
+		// Find the rectangle of texels covered by the box in the finest level
+		int width = this->cpuWidths[0];
+		int height = this->cpuHeights[0];
+		int x0 = (int)((ndcMin[0] * 0.5F + 0.5F) * width);
+		int x1 = (int)((ndcMax[0] * 0.5F + 0.5F) * width);
+		int y0 = (int)((ndcMin[1] * 0.5F + 0.5F) * height);
+		int y1 = (int)((ndcMax[1] * 0.5F + 0.5F) * height);
+		x0 = std::min(x0, width - 1);  x1 = std::min(x1, width - 1);
+		y0 = std::min(y0, height - 1); y1 = std::min(y1, height - 1);
+
+		// Go down the levels until the rectangle spans at most 2x2 texels.
+		// The last texel of a level with an odd source size also covers the
+		// extra texel of the source, hence the clamp.
+		int level = 0;
+		while ((x1 - x0 > 1 || y1 - y0 > 1) &&
+				level + 1 < (int)this->cpuLevels.size()) {
+			++level;
+			x0 = std::min(x0 / 2, this->cpuWidths[level] - 1);
+			x1 = std::min(x1 / 2, this->cpuWidths[level] - 1);
+			y0 = std::min(y0 / 2, this->cpuHeights[level] - 1);
+			y1 = std::min(y1 / 2, this->cpuHeights[level] - 1);
+		}
+
+		// Find the farthest depth stored in the rectangle
+		const std::vector<float> &depths = this->cpuLevels[level];
+		float farthest = 0.0F;
+		for (int y = y0; y <= y1; ++y)
+			for (int x = x0; x <= x1; ++x)
+				farthest = std::max(farthest,
+					depths[y * this->cpuWidths[level] + x]);
+
+		// The box is visible if its nearest point is in front of the farthest
+		// occluding depth.
+		return ndcMin[2] * 0.5F + 0.5F <= farthest;
+	}
+
+	void HiZBuffer::update(const Texture2D &depth, const Matrix4f &proj,
+			const Mesh &quad) {
+		if (!this->isInitialized) throw GLItemNotInitializedException(this);
+
+		this->collectReadBack();
+
+		// Save the state which is modified for drawing the levels
+		GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+		GLboolean cullFace = glIsEnabled(GL_CULL_FACE);
+		GLboolean blend = glIsEnabled(GL_BLEND);
+		glDisable(GL_DEPTH_TEST);
+		glDisable(GL_CULL_FACE);
+		glDisable(GL_BLEND);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, this->frameBuffer);
+		glDrawBuffer(GL_COLOR_ATTACHMENT0);
+
+		this->downsampleShader.bindShaderProgram();
+		this->downsampleShader.setUniform_i("hiZSource", 0);
+		glActiveTexture(GL_TEXTURE0);
+
+		// Each level stores the farthest depth of the 2x2 texel blocks of the
+		// previous level, with the first level being built from the depth
+		// texture itself.
+		for (int i = 0; i <= this->readBackLevel; ++i) {
+			if (i == 0) {
+				depth.bind(0);
+				this->downsampleShader.setUniform_vec2("sourceSize",
+					Vector2f((float)depth.getWidth(),
+						(float)depth.getHeight()));
+			} else {
+				// Restrict the pyramid to the previous level while reading,
+				// so that the level being written is never sampled.
+				glBindTexture(GL_TEXTURE_2D, this->pyramidTexture);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, i - 1);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, i - 1);
+				this->downsampleShader.setUniform_vec2("sourceSize",
+					Vector2f((float)this->levelWidths[i - 1],
+						(float)this->levelHeights[i - 1]));
+			}
+
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+				GL_TEXTURE_2D, this->pyramidTexture, i);
+			glViewport(0, 0, this->levelWidths[i], this->levelHeights[i]);
+
+			quad.render(this->downsampleShader);
+		}
+
+		glBindTexture(GL_TEXTURE_2D, this->pyramidTexture);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL,
+			this->readBackLevel);
+		this->pyramidProjection = proj;
+		this->hasPyramid = true;
+
+		// Discard the copy which is about to be overwritten if it still has
+		// not completed.
+		int index = this->readBackIndex;
+		if (this->readBackFences[index] != nullptr)
+			glDeleteSync(static_cast<GLsync>(this->readBackFences[index]));
+
+		// Start copying the read back level into the pixel buffer. The copy
+		// happens asynchronously; it is collected in a later frame once the
+		// fence has been signaled.
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, this->readBackBuffers[index]);
+		glGetTexImage(GL_TEXTURE_2D, this->readBackLevel, GL_RED, GL_FLOAT,
+			nullptr);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		this->readBackFences[index] = glFenceSync(
+			GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		this->readBackProjections[index] = proj;
+		this->readBackIndex = (index + 1) % READ_BACK_BUFFERS;
+
+		// Restore the modified state
+		if (depthTest) glEnable(GL_DEPTH_TEST);
+		if (cullFace) glEnable(GL_CULL_FACE);
+		if (blend) glEnable(GL_BLEND);
+	}
+
+	void HiZBuffer::buildCpuLevels() {
+		for (int i = 1; i < (int)this->cpuLevels.size(); ++i) {
+			const std::vector<float> &src = this->cpuLevels[i - 1];
+			std::vector<float> &dst = this->cpuLevels[i];
+			int srcWidth = this->cpuWidths[i - 1];
+			int srcHeight = this->cpuHeights[i - 1];
+			int dstWidth = this->cpuWidths[i];
+			int dstHeight = this->cpuHeights[i];
+
+			for (int y = 0; y < dstHeight; ++y) {
+				// The last row (column) also covers the extra source row
+				// (column) if the source size is odd.
+				int sy1 = (y == dstHeight - 1) ? srcHeight : 2 * y + 2;
+				for (int x = 0; x < dstWidth; ++x) {
+					int sx1 = (x == dstWidth - 1) ? srcWidth : 2 * x + 2;
+
+					float farthest = 0.0F;
+					for (int sy = 2 * y; sy < sy1; ++sy)
+						for (int sx = 2 * x; sx < sx1; ++sx)
+							farthest = std::max(farthest,
+								src[sy * srcWidth + sx]);
+
+					dst[y * dstWidth + x] = farthest;
+				}
+			}
+		}
+	}
+
+	void HiZBuffer::collectReadBack() {
+		// Check the oldest copy first, so that the newest completed copy is
+		// the one which is used.
+		bool collected = false;
+		for (int i = 0; i < READ_BACK_BUFFERS; ++i) {
+			int index = (this->readBackIndex + i) % READ_BACK_BUFFERS;
+			GLsync fence = static_cast<GLsync>(this->readBackFences[index]);
+			if (fence == nullptr) continue;
+
+			// Do not stall if the copy has not yet completed
+			GLenum status = glClientWaitSync(fence, 0, 0);
+			if (status != GL_ALREADY_SIGNALED &&
+				status != GL_CONDITION_SATISFIED) continue;
+
+			glDeleteSync(fence);
+			this->readBackFences[index] = nullptr;
+
+			std::vector<float> &level = this->cpuLevels[0];
+			GLsizeiptr size = level.size() * sizeof(float);
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, this->readBackBuffers[index]);
+			void *data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size,
+				GL_MAP_READ_BIT);
+			if (data != nullptr) {
+				std::memcpy(level.data(), data, size);
+				glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+
+				this->cpuProjection = this->readBackProjections[index];
+				this->hasCpuLevels = true;
+				collected = true;
+			}
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		}
+
+		if (collected) this->buildCpuLevels();
+	}
+
+	void HiZBuffer::resize(const int &width, const int &height) {
+		if (!this->isInitialized) throw GLItemNotInitializedException(this);
+		if (width == this->sourceWidth && height == this->sourceHeight)
+			return;
+		this->sourceWidth = width;
+		this->sourceHeight = height;
+
+		// The finest level is half of the depth texture's size, since it
+		// already stores the farthest depth of the 2x2 texel blocks.
+		int levelWidth = std::max(1, width / 2);
+		int levelHeight = std::max(1, height / 2);
+
+		// Allocate the levels down to the first level which is small enough
+		// to be read back every frame.
+		this->levelWidths.clear();
+		this->levelHeights.clear();
+		glBindTexture(GL_TEXTURE_2D, this->pyramidTexture);
+		while (true) {
+			glTexImage2D(GL_TEXTURE_2D, (GLint)this->levelWidths.size(),
+				GL_R32F, levelWidth, levelHeight, 0, GL_RED, GL_FLOAT, nullptr);
+			this->levelWidths.push_back(levelWidth);
+			this->levelHeights.push_back(levelHeight);
+
+			if (levelWidth <= READ_BACK_MAX_WIDTH) break;
+			levelWidth = std::max(1, levelWidth / 2);
+			levelHeight = std::max(1, levelHeight / 2);
+		}
+		this->readBackLevel = (int)this->levelWidths.size() - 1;
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL,
+			this->readBackLevel);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		// Allocate the read back buffers and drop any pending copies, since
+		// they have the old size.
+		for (int i = 0; i < READ_BACK_BUFFERS; ++i) {
+			if (this->readBackFences[i] != nullptr)
+				glDeleteSync(static_cast<GLsync>(this->readBackFences[i]));
+			this->readBackFences[i] = nullptr;
+
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, this->readBackBuffers[i]);
+			glBufferData(GL_PIXEL_PACK_BUFFER,
+				levelWidth * levelHeight * sizeof(float), nullptr,
+				GL_STREAM_READ);
+		}
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		// The CPU levels continue from the read back level down to 1x1
+		this->cpuLevels.clear();
+		this->cpuWidths.clear();
+		this->cpuHeights.clear();
+		while (true) {
+			this->cpuLevels.push_back(
+				std::vector<float>(levelWidth * levelHeight));
+			this->cpuWidths.push_back(levelWidth);
+			this->cpuHeights.push_back(levelHeight);
+
+			if (levelWidth == 1 && levelHeight == 1) break;
+			levelWidth = std::max(1, levelWidth / 2);
+			levelHeight = std::max(1, levelHeight / 2);
+		}
+
+		this->hasCpuLevels = false;
+		this->hasPyramid = false;
+	}
+} } }
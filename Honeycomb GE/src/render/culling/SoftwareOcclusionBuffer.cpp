@@ -0,0 +1,301 @@
+#include "../../../include/render/culling/SoftwareOcclusionBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+	(defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HONEYCOMB_OCCLUSION_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "../../../include/job/JobSystem.h"
+#include "../../../include/math/Vector4f.h"
+
+using Honeycomb::Geometry::Mesh;
+using Honeycomb::Geometry::Vertex;
+using Honeycomb::Job::JobSystem;
+using Honeycomb::Math::Matrix4f;
+using Honeycomb::Math::Vector3f;
+using Honeycomb::Math::Vector4f;
+
+namespace Honeycomb { namespace Render { namespace Culling {
+	const int SoftwareOcclusionBuffer::TILE_WIDTH = 32;
+	const int SoftwareOcclusionBuffer::TILE_HEIGHT = 16;
+
+	SoftwareOcclusionBuffer::SoftwareOcclusionBuffer() {
+		this->width = 0;
+		this->height = 0;
+		this->stride = 0;
+		this->tilesX = 0;
+		this->tilesY = 0;
+	}
+
+	void SoftwareOcclusionBuffer::addOccluder(const Mesh &mesh,
+			const Matrix4f &transform) {
+		const std::vector<Vertex> &verts = mesh.getVertices();
+		const std::vector<unsigned int> &indices = mesh.getIndices();
+
+		// Transform each vertex into screen space once: x & y in pixels, z
+		// in the [0, 1] depth range and w kept only to detect vertices
+		// which are behind the near plane.
+		Matrix4f mvp = this->projection * transform;
+		float m[4][4];
+		for (int r = 0; r < 4; ++r)
+			for (int c = 0; c < 4; ++c)
+				m[r][c] = mvp.getAt(r, c);
+
+		this->screenVerts.resize(verts.size() * 4);
+		for (std::size_t i = 0; i < verts.size(); ++i) {
+			const Vector3f &p = verts[i].getPosition();
+			float clip[4];
+			for (int r = 0; r < 4; ++r)
+				clip[r] = m[r][0] * p.getX() + m[r][1] * p.getY() +
+					m[r][2] * p.getZ() + m[r][3];
+
+			float *s = &this->screenVerts[i * 4];
+			s[3] = clip[3];
+			if (clip[3] <= 1e-5F) continue;
+
+			s[0] = (clip[0] / clip[3] * 0.5F + 0.5F) * this->width;
+			s[1] = (clip[1] / clip[3] * 0.5F + 0.5F) * this->height;
+			s[2] = clip[2] / clip[3] * 0.5F + 0.5F;
+		}
+
+		for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+			const float *v[3] = {
+				&this->screenVerts[indices[i + 0] * 4],
+				&this->screenVerts[indices[i + 1] * 4],
+				&this->screenVerts[indices[i + 2] * 4]
+			};
+			if (v[0][3] <= 1e-5F || v[1][3] <= 1e-5F || v[2][3] <= 1e-5F)
+				continue;
+
+			// Occluders are rasterized regardless of their facing, so make the
+			// winding counter clockwise for the edge functions.
+			float area = (v[1][0] - v[0][0]) * (v[2][1] - v[0][1]) -
+				(v[2][0] - v[0][0]) * (v[1][1] - v[0][1]);
+			if (std::abs(area) < 1e-6F) continue;
+			if (area < 0.0F) {
+				std::swap(v[1], v[2]);
+				area = -area;
+			}
+
+			// Find the pixels which may lie entirely inside of the triangle
+			Triangle tri;
+			tri.minX = std::max(0, (int)std::ceil(std::min({
+				v[0][0], v[1][0], v[2][0] })));
+			tri.maxX = std::min(this->width - 1, (int)std::floor(std::max({
+				v[0][0], v[1][0], v[2][0] })) - 1);
+			tri.minY = std::max(0, (int)std::ceil(std::min({
+				v[0][1], v[1][1], v[2][1] })));
+			tri.maxY = std::min(this->height - 1, (int)std::floor(std::max({
+				v[0][1], v[1][1], v[2][1] })) - 1);
+			if (tri.minX > tri.maxX || tri.minY > tri.maxY) continue;
+
+			// The edge functions are evaluated at the pixel centers, so pull
+			// each edge inwards by half a pixel (along both axes), so that a
+			// center only passes if the whole pixel is inside of the edge.
+			for (int e = 0; e < 3; ++e) {
+				const float *a = v[e];
+				const float *b = v[(e + 1) % 3];
+				tri.edgeA[e] = a[1] - b[1];
+				tri.edgeB[e] = b[0] - a[0];
+				tri.edgeC[e] = a[0] * b[1] - b[0] * a[1] - 0.5F *
+					(std::abs(tri.edgeA[e]) + std::abs(tri.edgeB[e]));
+			}
+
+			// Likewise, push the depth plane back by half a pixel, so that
+			// the depth at a pixel center is the farthest depth of the
+			// triangle within the pixel.
+			tri.depthDx = ((v[1][2] - v[0][2]) * (v[2][1] - v[0][1]) -
+				(v[2][2] - v[0][2]) * (v[1][1] - v[0][1])) / area;
+			tri.depthDy = ((v[2][2] - v[0][2]) * (v[1][0] - v[0][0]) -
+				(v[1][2] - v[0][2]) * (v[2][0] - v[0][0])) / area;
+			tri.depth = v[0][2] - tri.depthDx * v[0][0] -
+				tri.depthDy * v[0][1] + 0.5F *
+				(std::abs(tri.depthDx) + std::abs(tri.depthDy));
+
+			// Bin the triangle into each of the tiles which it overlaps
+			int index = (int)this->triangles.size();
+			this->triangles.push_back(tri);
+			for (int ty = tri.minY / TILE_HEIGHT;
+					ty <= tri.maxY / TILE_HEIGHT; ++ty)
+				for (int tx = tri.minX / TILE_WIDTH;
+						tx <= tri.maxX / TILE_WIDTH; ++tx)
+					this->tileBins[ty * this->tilesX + tx].push_back(index);
+		}
+	}
+
+	void SoftwareOcclusionBuffer::clear(const Matrix4f &proj,
+			const int &width, const int &height) {
+		this->projection = proj;
+
+		if (width != this->width || height != this->height) {
+			this->width = std::max(1, width);
+			this->height = std::max(1, height);
+			this->tilesX = (this->width + TILE_WIDTH - 1) / TILE_WIDTH;
+			this->tilesY = (this->height + TILE_HEIGHT - 1) / TILE_HEIGHT;
+			this->stride = this->tilesX * TILE_WIDTH;
+
+			this->depths.resize(this->stride * this->tilesY * TILE_HEIGHT);
+			this->tileBins.resize(this->tilesX * this->tilesY);
+		}
+
+		std::fill(this->depths.begin(), this->depths.end(), 1.0F);
+		for (auto &bin : this->tileBins) bin.clear();
+		this->triangles.clear();
+	}
+
+	float SoftwareOcclusionBuffer::getDepth(const int &x, const int &y)
+			const {
+		return this->depths[y * this->stride + x];
+	}
+
+	const int& SoftwareOcclusionBuffer::getHeight() const {
+		return this->height;
+	}
+
+	const int& SoftwareOcclusionBuffer::getWidth() const {
+		return this->width;
+	}
+
+	bool SoftwareOcclusionBuffer::isVisible(const Vector3f &min,
+			const Vector3f &max) const {
+		if (this->triangles.empty()) return true;
+
+		// Project the corners of the box into normalized device coordinates
+		const float inf = std::numeric_limits<float>::infinity();
+		float ndcMin[3] = {  inf,  inf,  inf };
+		float ndcMax[3] = { -inf, -inf, -inf };
+		for (int i = 0; i < 8; ++i) {
+			Vector4f corner = this->projection * Vector4f(
+				(i & 1) ? max.getX() : min.getX(),
+				(i & 2) ? max.getY() : min.getY(),
+				(i & 4) ? max.getZ() : min.getZ(), 1.0F);
+
+			// A corner behind the camera cannot be projected, so the box
+			// might cover the entire screen.
+			if (corner.getW() <= 0.0F) return true;
+
+			float ndc[3] = { corner.getX() / corner.getW(),
+				corner.getY() / corner.getW(), corner.getZ() / corner.getW() };
+			for (int j = 0; j < 3; ++j) {
+				ndcMin[j] = std::min(ndcMin[j], ndc[j]);
+				ndcMax[j] = std::max(ndcMax[j], ndc[j]);
+			}
+		}
+
+		// Boxes outside of the screen cannot be seen
+		if (ndcMax[0] < -1.0F || ndcMin[0] > 1.0F ||
+			ndcMax[1] < -1.0F || ndcMin[1] > 1.0F) return false;
+
+		// Find every pixel which the box touches, even partially
+		float w = (float)this->width;
+		float h = (float)this->height;
+		int x0 = (int)((std::max(ndcMin[0], -1.0F) * 0.5F + 0.5F) * w);
+		int x1 = (int)((std::min(ndcMax[0],  1.0F) * 0.5F + 0.5F) * w);
+		int y0 = (int)((std::max(ndcMin[1], -1.0F) * 0.5F + 0.5F) * h);
+		int y1 = (int)((std::min(ndcMax[1],  1.0F) * 0.5F + 0.5F) * h);
+		x0 = std::min(x0, this->width - 1);
+		x1 = std::min(x1, this->width - 1);
+		y0 = std::min(y0, this->height - 1);
+		y1 = std::min(y1, this->height - 1);
+
+		// The box is visible if its nearest point is in front of any of the
+		// occluder depths which it covers. Since each occluder depth is the
+		// farthest depth of the occluders which fully cover the pixel, this
+		// never culls a box which is visible.
+		float nearest = ndcMin[2] * 0.5F + 0.5F;
+		for (int y = y0; y <= y1; ++y) {
+			const float *row = &this->depths[y * this->stride];
+			for (int x = x0; x <= x1; ++x)
+				if (nearest <= row[x]) return true;
+		}
+
+		return false;
+	}
+
+	void SoftwareOcclusionBuffer::rasterize() {
+		// Each tile is a job of its own, so that the workers which finish
+		// the tiles covered by few occluders steal the remaining tiles.
+		JobSystem::getJobSystem()->parallelFor(this->tilesX * this->tilesY, 1,
+			[this](int begin, int end) {
+				for (int tile = begin; tile < end; ++tile)
+					this->rasterizeTile(tile);
+		});
+	}
+
+	void SoftwareOcclusionBuffer::rasterizeTile(const int &tile) {
+		int tileX0 = (tile % this->tilesX) * TILE_WIDTH;
+		int tileY0 = (tile / this->tilesX) * TILE_HEIGHT;
+		int tileX1 = tileX0 + TILE_WIDTH - 1;
+		int tileY1 = tileY0 + TILE_HEIGHT - 1;
+
+		for (int index : this->tileBins[tile]) {
+			const Triangle &tri = this->triangles[index];
+
+			// Clip the bounds of the triangle to the tile. The columns start
+			// at a multiple of four so that four pixels are always written
+			// (the rows are padded to a whole number of tiles).
+			int minX = std::max(tri.minX, tileX0) & ~3;
+			int maxX = std::min(tri.maxX, tileX1);
+			int minY = std::max(tri.minY, tileY0);
+			int maxY = std::min(tri.maxY, tileY1);
+
+			for (int y = minY; y <= maxY; ++y) {
+				float *row = &this->depths[y * this->stride];
+				float py = y + 0.5F;
+
+#ifdef HONEYCOMB_OCCLUSION_SSE2
+				// Evaluate the (inner) edge functions & the (farthest) depth
+				// plane for four pixel centers at once.
+				__m128 rowEdge[3], edgeA[3];
+				for (int e = 0; e < 3; ++e) {
+					rowEdge[e] = _mm_set1_ps(tri.edgeB[e] * py + tri.edgeC[e]);
+					edgeA[e] = _mm_set1_ps(tri.edgeA[e]);
+				}
+				__m128 rowDepth = _mm_set1_ps(tri.depth + tri.depthDy * py);
+				__m128 depthDx = _mm_set1_ps(tri.depthDx);
+				__m128 zero = _mm_setzero_ps();
+				__m128 offsets = _mm_set_ps(3.5F, 2.5F, 1.5F, 0.5F);
+
+				for (int x = minX; x <= maxX; x += 4) {
+					__m128 px = _mm_add_ps(_mm_set1_ps((float)x), offsets);
+
+					__m128 inside = _mm_cmpge_ps(_mm_add_ps(rowEdge[0],
+						_mm_mul_ps(edgeA[0], px)), zero);
+					inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(
+						rowEdge[1], _mm_mul_ps(edgeA[1], px)), zero));
+					inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(
+						rowEdge[2], _mm_mul_ps(edgeA[2], px)), zero));
+					if (_mm_movemask_ps(inside) == 0) continue;
+
+					__m128 depth = _mm_add_ps(rowDepth,
+						_mm_mul_ps(depthDx, px));
+					__m128 old = _mm_loadu_ps(row + x);
+					__m128 nearest = _mm_min_ps(old, depth);
+					_mm_storeu_ps(row + x, _mm_or_ps(
+						_mm_and_ps(inside, nearest),
+						_mm_andnot_ps(inside, old)));
+				}
+#else
+				for (int x = minX; x <= maxX; ++x) {
+					float px = x + 0.5F;
+
+					bool inside = true;
+					for (int e = 0; e < 3; ++e)
+						inside = inside && tri.edgeA[e] * px +
+							tri.edgeB[e] * py + tri.edgeC[e] >= 0.0F;
+					if (!inside) continue;
+
+					float depth = tri.depth + tri.depthDx * px +
+						tri.depthDy * py;
+					row[x] = std::min(row[x], depth);
+				}
+#endif
+			}
+		}
+	}
+} } }
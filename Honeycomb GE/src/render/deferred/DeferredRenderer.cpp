@@ -2,46 +2,41 @@
 
 #include <GL/glew.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include "../../../include/base/GameWindow.h"
 
-#include "../../../include/component/light/AmbientLight.h"
 #include "../../../include/component/light/BaseLight.h"
-#include "../../../include/component/light/DirectionalLight.h"
-#include "../../../include/component/light/PointLight.h"
-#include "../../../include/component/light/SpotLight.h"
-#include "../../../include/component/physics/Transform.h"
-#include "../../../include/component/render/CameraController.h"
 #include "../../../include/component/render/MeshRenderer.h"
 
 #include "../../../include/geometry/Model.h"
-#include "../../../include/geometry/Vertex.h"
+#include "../../../include/job/JobSystem.h"
 #include "../../../include/math/MathUtils.h"
 #include "../../../include/object/GameObjectFactory.h"
+#include "../../../include/render/TextureUnit.h"
 
 using Honeycomb::Base::GameWindow;
-using Honeycomb::Component::Light::BaseLight;
-using Honeycomb::Component::Light::AmbientLight;
-using Honeycomb::Component::Light::DirectionalLight;
-using Honeycomb::Component::Light::PointLight;
-using Honeycomb::Component::Light::SpotLight;
 using Honeycomb::Component::Light::LightType;
 using Honeycomb::Component::Light::Shadow;
 using Honeycomb::Component::Light::ShadowType;
-using Honeycomb::Component::Physics::Transform;
-using Honeycomb::Component::Render::CameraController;
 using Honeycomb::Component::Render::MeshRenderer;
 using Honeycomb::Geometry::Mesh;
 using Honeycomb::Geometry::Model;
-using Honeycomb::Geometry::Vertex;
 using Honeycomb::Graphics::Texture2D;
+using Honeycomb::Graphics::TextureDataFormat;
+using Honeycomb::Graphics::TextureDataType;
+using Honeycomb::Job::JobSystem;
 using Honeycomb::Math::Matrix4f;
 using Honeycomb::Math::Vector2f;
 using Honeycomb::Math::Vector3f;
 using Honeycomb::Math::Vector4f;
 using Honeycomb::Math::Utils::PI;
+using Honeycomb::Render::Batch::MultiDrawBatch;
+using Honeycomb::Render::Graph::FrameGraph;
+using Honeycomb::Render::RenderFrame;
 using Honeycomb::Object::GameObjectFactory;
 using Honeycomb::Object::GameObject;
-using Honeycomb::Scene::GameScene;
 using Honeycomb::Shader::ShaderType;
 using Honeycomb::Shader::ShaderProgram;
 
@@ -53,6 +48,12 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 	const std::string DeferredRenderer::SPOT_LIGHT_VOLUME_MODEL =
 		"../Honeycomb GE/res/models/light-volumes/spotLight.fbx";
 	const int DeferredRenderer::SHADOW_MAP_INDEX = GBufferTextureType::COUNT;
+	const int DeferredRenderer::SOFTWARE_OCCLUSION_WIDTH = 256;
+	const float DeferredRenderer::MIN_RENDER_SCALE = 0.5F;
+	const float DeferredRenderer::RENDER_SCALE_STEP = 0.05F;
+	const int DeferredRenderer::FRAME_QUERY_COUNT = 4;
+	const float DeferredRenderer::FRAME_TIME_SMOOTHING = 0.1F;
+	const float DeferredRenderer::FRAME_TIME_RAISE_THRESHOLD = 0.85F;
 
 	DeferredRenderer* DeferredRenderer::getDeferredRenderer() {
 		if (DeferredRenderer::deferredRenderer == nullptr)
@@ -61,31 +62,119 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		return DeferredRenderer::deferredRenderer;
 	}
 
-	void DeferredRenderer::render(Honeycomb::Scene::GameScene &scene) {
-		CameraController::getActiveCamera()->toShader(this->geometryShader,
-			"camera");
-		this->gBuffer.frameBegin(); 
+	const GBufferLayout& DeferredRenderer::getGBufferLayout() const {
+		return this->gBuffer.getLayout();
+	}
 
-		this->renderPassGeometry(scene);		// Render Geometry
-		this->renderPassLight(scene);			// Render Lights
-		this->renderBackground();				// Render Background Cubebox
-		
-		Texture2D& target = this->renderPassPostProcess(); // Post Process the Final Image
-		this->renderTexture(target);			// Render the final image
+	const float& DeferredRenderer::getRenderScale() const {
+		return this->gBuffer.getRenderScale();
+	}
+
+	void DeferredRenderer::render(const RenderFrame &frame) {
+		this->frame = &frame;
+		this->beginFrameTimer();
+
+		// Everything up to the final image is rendered at the G Buffer size
+		glViewport(0, 0, this->gBuffer.getRenderWidth(),
+			this->gBuffer.getRenderHeight());
+
+		frame.getCamera().toShader(this->getGeometryShader(), "camera");
+		if (this->doDepthPrepass)
+			frame.getCamera().toShader(this->depthShader, "camera");
+
+		// Declare the passes of this frame, cull the ones whose results are
+		// not needed for the final texture, and render the others.
+		this->buildFrameGraph();
+		this->frameGraph.compile();
+		this->frameGraph.execute();
+
+		this->endFrameTimer();
+		this->frame = nullptr;
 	}
 
 	void DeferredRenderer::setFinalTexture(const FinalTexture &fin) {
 		this->final = fin;
 	}
 
+	void DeferredRenderer::setDoDepthPrepass(const bool &b) {
+		this->doDepthPrepass = b;
+	}
+
+	void DeferredRenderer::setDoDynamicResolution(const bool &b) {
+		// Forget the frame time measured before, since the scene or the
+		// render scale may have changed since.
+		if (b && !this->doDynamicResolution) this->frameTime = -1.0F;
+
+		this->doDynamicResolution = b;
+	}
+
+	void DeferredRenderer::setDoGpuCulling(const bool &b) {
+		this->doGpuCulling = b && MultiDrawBatch::isCullingSupported();
+	}
+
+	void DeferredRenderer::setDoMultiDrawIndirect(const bool &b) {
+		this->doMultiDrawIndirect = b && MultiDrawBatch::isSupported();
+	}
+
+	void DeferredRenderer::setGBufferLayout(const GBufferLayout &layout) {
+		this->gBuffer.setLayout(layout);
+	}
+
+	void DeferredRenderer::setOcclusionCulling(const OcclusionCulling &mode) {
+		this->occlusionCulling = mode;
+	}
+
+	void DeferredRenderer::setRenderScale(const float &scale) {
+		this->gBuffer.setRenderScale(
+			std::min(std::max(scale, MIN_RENDER_SCALE), 1.0F));
+		this->resizeHiZBuffer();
+		this->framesSinceRescale = 0;
+	}
+
+	void DeferredRenderer::setTargetFrameRate(const float &fps) {
+		this->targetFrameTime = 1000.0F / fps;
+	}
+
 	DeferredRenderer::DeferredRenderer() : Renderer() {
 		this->gBuffer.initialize();
+		this->hiZBuffer.initialize();
+		this->resizeHiZBuffer();
+
+		// The G Buffer was subscribed to the resize event first, so its
+		// textures have already been resized when the handler is invoked.
+		GameWindow::getGameWindow()->getResizeEvent() +=
+			&this->windowResizeHandler;
+		this->windowResizeHandler += std::bind(
+			&DeferredRenderer::resizeHiZBuffer, this);
+
+		this->multiDrawBatch.initialize();
+		this->isBatchHoldingFrame = false;
+		this->frameGraph.initialize();
+
+		// Generate the timer queries which measure the frame time
+		this->frameQueries.resize(FRAME_QUERY_COUNT);
+		for (int &query : this->frameQueries) {
+			GLuint id;
+			glGenQueries(1, &id);
+			query = id;
+		}
+		this->frameQueryIndex = 0;
+		this->frameQueryCount = 0;
+		this->framesSinceRescale = 0;
+		this->frameTime = -1.0F;
+		this->doDynamicResolution = false;
 
 		this->initializeLightVolumes();
-		this->initializeQuad();
 		this->initializeShaders();
 
 		this->setFinalTexture(FinalTexture::FINAL);
+		this->setDoDepthPrepass(false);
+		this->setOcclusionCulling(OcclusionCulling::OCCLUSION_CULLING_NONE);
+		this->setDoMultiDrawIndirect(true);
+		this->setDoGpuCulling(true);
+		this->setDoDynamicResolution(false);
+		this->setRenderScale(1.0F);
+		this->setTargetFrameRate(60.0F);
 		
 		// Even though the color space is set in the parent Renderer class, we
 		// have to set it here again since we must write the gamma value to our
@@ -97,6 +186,288 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		
 	}
 
+	void DeferredRenderer::beginFrameTimer() {
+		if (!this->doDynamicResolution) return;
+
+		// Once all of the queries were issued, the query of this frame holds
+		// the time of the frame rendered FRAME_QUERY_COUNT frames ago. Only
+		// read it if it is ready, so that the renderer never stalls on it.
+		GLuint query = this->frameQueries[this->frameQueryIndex];
+		if (this->frameQueryCount == FRAME_QUERY_COUNT) {
+			GLint isAvailable = GL_FALSE;
+			glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE,
+				&isAvailable);
+
+			if (isAvailable == GL_TRUE) {
+				GLuint64 nanoseconds;
+				glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+				this->updateRenderScale(nanoseconds / 1000000.0F);
+			}
+		}
+
+		glBeginQuery(GL_TIME_ELAPSED, query);
+	}
+
+	void DeferredRenderer::buildFrameGraph() {
+		FrameGraph &graph = this->frameGraph;
+		graph.clear();
+
+		// The G Buffer (written by the geometry), the final buffer (into
+		// which the lights & background are rendered) and the shadow maps
+		// are owned by the renderer, and only order the passes.
+		const Texture2D &finalTexture =
+			*this->gBuffer.bufferTextures[GBufferTextureType::FINAL_1];
+		int gBufferRes = graph.addImport("G Buffer");
+		int finalRes = graph.addImport("Final Buffer", &finalTexture);
+		int shadowRes = graph.addImport("Shadow Maps");
+
+		int geometry = graph.addPass("Geometry", [this]() {
+			this->renderPassGeometry();
+		});
+		graph.addWrite(geometry, gBufferRes);
+
+		int light = graph.addPass("Light", [this]() {
+			this->gBuffer.copyDepth();
+			this->gBuffer.frameBegin();
+			this->renderPassLight();
+		});
+		graph.addRead(light, gBufferRes);
+		graph.addWrite(light, finalRes);
+		graph.addWrite(light, shadowRes);
+
+		int background = graph.addPass("Background", [this]() {
+			this->renderBackground();
+		});
+		graph.addRead(background, gBufferRes);
+		graph.addWrite(background, finalRes);
+
+		// The post processing targets are transient textures of the same
+		// size & format as the final buffer.
+		FrameGraph::TextureDescription description;
+		description.width = this->gBuffer.getRenderWidth();
+		description.height = this->gBuffer.getRenderHeight();
+		description.type = TextureDataType::DATA_FLOAT;
+		description.internalFormat = finalTexture.getInternalFormat();
+		description.format = TextureDataFormat::FORMAT_RGB;
+
+		// Any final texture other than the lit image is first copied into a
+		// transient texture, so that it may be post processed. Since only the
+		// passes which lead to the final texture are kept, the lights are
+		// culled when a G Buffer texture is shown, and vice versa.
+		int current = finalRes;
+		if (this->final != FinalTexture::FINAL) {
+			int copyRes = graph.addTexture("Copy", description);
+			int copy = graph.addPass("Copy", [this, copyRes]() {
+				this->renderPassCopy(copyRes);
+			});
+			graph.addRead(copy, this->final < FinalTexture::FINAL ?
+				gBufferRes : shadowRes);
+			graph.addWrite(copy, copyRes);
+
+			current = copyRes;
+		}
+
+		// Post Process the image with all of the user's custom post process
+		// shaders, and then with FXAA.
+		std::vector<ShaderProgram*> shaders;
+		if (this->doPostProcess) {
+			for (ShaderProgram &s : this->getPostShaders())
+				shaders.push_back(&s);
+		}
+		if (this->antiAliasing == AntiAliasing::FXAA)
+			shaders.push_back(&this->fxaaShader);
+
+		for (ShaderProgram *shader : shaders) {
+			int read = current;
+			int write = graph.addTexture("Post Process", description);
+			int post = graph.addPass("Post Process",
+					[this, shader, read, write]() {
+				if (shader == &this->fxaaShader)
+					this->writeCameraToShader(*shader);
+				this->renderPostProcessShader(*shader, read, write);
+			});
+			graph.addRead(post, read);
+			graph.addWrite(post, write);
+
+			current = write;
+		}
+
+		// Render the post processed image to the window, which applies the
+		// per-pixel post effects & gamma correction.
+		int window = graph.addPass("Window", [this, current]() {
+			this->renderTexture(this->frameGraph.getTexture(current));
+		}, true);
+		graph.addRead(window, current);
+	}
+
+	void DeferredRenderer::buildRenderQueue() {
+		const Matrix4f &proj = this->frame->getCameraProjection();
+		const std::vector<RenderFrame::Object> &objects =
+			this->frame->getObjects();
+
+		// Rasterize the occluders before any of the objects are tested
+		if (this->occlusionCulling ==
+				OcclusionCulling::OCCLUSION_CULLING_SOFTWARE) {
+			int width = GameWindow::getGameWindow()->getWindowWidth();
+			int height = GameWindow::getGameWindow()->getWindowHeight();
+			this->softwareBuffer.clear(proj, SOFTWARE_OCCLUSION_WIDTH,
+				SOFTWARE_OCCLUSION_WIDTH * height / std::max(width, 1));
+
+			for (const RenderFrame::Object &object : objects) {
+				for (auto &mesh : object.occluderMeshes)
+					this->softwareBuffer.addOccluder(*mesh, object.transform);
+			}
+
+			this->softwareBuffer.rasterize();
+		}
+		
+		// The batched objects are culled on the graphics card, unless they
+		// are to be tested against the software occlusion buffer (which only
+		// exists on the CPU). In that case, every batchable object goes
+		// straight into the batch, and only the others are queued.
+		this->isBatchHoldingFrame = this->doMultiDrawIndirect &&
+			this->doGpuCulling && this->occlusionCulling !=
+			OcclusionCulling::OCCLUSION_CULLING_SOFTWARE;
+
+		this->multiDrawBatch.clear();
+		this->unbatchedQueue.clear();
+		this->shadowQueue.clear();
+		for (const RenderFrame::Object &object : objects) {
+			if (!this->isBatchHoldingFrame ||
+				!this->multiDrawBatch.add(object))
+				this->shadowQueue.push_back(&object);
+		}
+
+		// Cull the objects which are not in the batch in parallel, each job
+		// writing the entries of its own range of the queue (null if the
+		// object is culled), and then compact the queue in its original
+		// order.
+		this->renderQueue.assign(this->shadowQueue.size(), { 0.0F, nullptr });
+		JobSystem::getJobSystem()->parallelFor((int)this->shadowQueue.size(),
+				0, [&](int begin, int end) {
+			for (int i = begin; i < end; ++i) {
+				const RenderFrame::Object &object = *this->shadowQueue[i];
+
+				// Skip the objects which are outside of the view frustum or
+				// hidden behind the occluders.
+				const Vector3f &min = object.boundsMin;
+				const Vector3f &max = object.boundsMax;
+				if (!DeferredRenderer::isInFrustum(proj, min, max))
+					continue;
+
+				bool isVisible = true;
+				if (this->occlusionCulling ==
+						OcclusionCulling::OCCLUSION_CULLING_HI_Z)
+					isVisible = this->hiZBuffer.isVisible(min, max);
+				else if (this->occlusionCulling ==
+						OcclusionCulling::OCCLUSION_CULLING_SOFTWARE)
+					isVisible = this->softwareBuffer.isVisible(min, max);
+				if (!isVisible) continue;
+
+				// Use the clip space depth (which increases with the view
+				// depth for both projections) as the sorting key.
+				float depth = 0.0F;
+				if (this->doDepthPrepass) {
+					const Vector3f &pos = object.position;
+					depth = (proj * Vector4f(pos.getX(), pos.getY(), 
+						pos.getZ(), 1.0F)).getZ();
+				}
+
+				this->renderQueue[i] = { depth, &object };
+			}
+		});
+
+		this->renderQueue.erase(std::remove_if(this->renderQueue.begin(),
+			this->renderQueue.end(), [](const auto &queued) {
+				return queued.second == nullptr;
+		}), this->renderQueue.end());
+
+		// Sort front to back so that the prepass rejects the most fragments
+		if (this->doDepthPrepass) {
+			std::sort(this->renderQueue.begin(), this->renderQueue.end(),
+				[](const auto &a, const auto &b) {
+					return a.first < b.first;
+			});
+		}
+
+		// Batch the queued objects which can be batched (unless the batch
+		// already holds them), keeping the order of the queue within each
+		// material.
+		for (auto &queued : this->renderQueue) {
+			if (this->isBatchHoldingFrame || !this->doMultiDrawIndirect ||
+				!this->multiDrawBatch.add(*queued.second))
+				this->unbatchedQueue.push_back(queued.second);
+		}
+
+		if (this->isBatchHoldingFrame) {
+			this->multiDrawBatch.cull(proj, (this->occlusionCulling ==
+				OcclusionCulling::OCCLUSION_CULLING_HI_Z) ?
+				&this->hiZBuffer : nullptr);
+		}
+	}
+
+	void DeferredRenderer::endFrameTimer() {
+		if (!this->doDynamicResolution) return;
+
+		glEndQuery(GL_TIME_ELAPSED);
+
+		this->frameQueryIndex = (this->frameQueryIndex + 1) %
+			FRAME_QUERY_COUNT;
+		this->frameQueryCount = std::min(this->frameQueryCount + 1,
+			FRAME_QUERY_COUNT);
+	}
+
+	ShaderProgram& DeferredRenderer::getGeometryShader() {
+		if (this->gBuffer.getLayout() == GBufferLayout::LAYOUT_COMPACT)
+			return this->geometryCompactShader;
+		
+		return this->geometryShader;
+	}
+
+	ShaderProgram& DeferredRenderer::getLightShader(const LightType &type) {
+		bool isCompact = 
+			this->gBuffer.getLayout() == GBufferLayout::LAYOUT_COMPACT;
+
+		switch (type) {
+		case LightType::LIGHT_TYPE_DIRECTIONAL:
+			return isCompact ? this->directionalLightCompactShader :
+				this->directionalLightShader;
+		case LightType::LIGHT_TYPE_POINT:
+			return isCompact ? this->pointLightCompactShader :
+				this->pointLightShader;
+		case LightType::LIGHT_TYPE_SPOT:
+			return isCompact ? this->spotLightCompactShader :
+				this->spotLightShader;
+		case LightType::LIGHT_TYPE_AMBIENT:
+		default:
+			return isCompact ? this->ambientCompactShader :
+				this->ambientShader;
+		}
+	}
+
+	bool DeferredRenderer::isInFrustum(const Matrix4f &proj,
+			const Vector3f &min, const Vector3f &max) {
+		// Count the corners which are outside of each clip plane
+		int outside[6] = { 0, 0, 0, 0, 0, 0 };
+		for (int i = 0; i < 8; ++i) {
+			Vector4f corner = proj * Vector4f(
+				(i & 1) ? max.getX() : min.getX(),
+				(i & 2) ? max.getY() : min.getY(),
+				(i & 4) ? max.getZ() : min.getZ(), 1.0F);
+
+			float clip[3] = { corner.getX(), corner.getY(), corner.getZ() };
+			for (int j = 0; j < 3; ++j) {
+				if (clip[j] < -corner.getW()) ++outside[j * 2];
+				if (clip[j] > corner.getW()) ++outside[j * 2 + 1];
+			}
+		}
+
+		for (int j = 0; j < 6; ++j)
+			if (outside[j] == 8) return false;
+
+		return true;
+	}
+
 	void DeferredRenderer::initializeLightVolumes() {
 		// Get the models containing the Light Volumes
 		auto pLModel = GameObjectFactory::getFactory().newGameObject(
@@ -157,6 +528,13 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 			ShaderType::FRAGMENT_SHADER);
 		this->geometryShader.finalizeShaderProgram();
 
+		this->depthShader.initialize();
+		this->depthShader.addShader("../Honeycomb GE/res/shaders/"
+			"render/depth/depthVS.glsl", ShaderType::VERTEX_SHADER);
+		this->depthShader.addShader("../Honeycomb GE/res/shaders/"
+			"render/depth/depthFS.glsl", ShaderType::FRAGMENT_SHADER);
+		this->depthShader.finalizeShaderProgram();
+
 		this->stencilShader.initialize();
 		this->stencilShader.addShader("../Honeycomb GE/res/shaders/"
 			"render/deferred/geometry/stencilVS.glsl", 
@@ -166,6 +544,60 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 			ShaderType::FRAGMENT_SHADER);
 		this->stencilShader.finalizeShaderProgram();
 
+		this->geometryCompactShader.initialize();
+		this->geometryCompactShader.addShader("../Honeycomb GE/res/shaders/"
+			"render/deferred/geometry/geometryVS.glsl", 
+			ShaderType::VERTEX_SHADER);
+		this->geometryCompactShader.addShader("../Honeycomb GE/res/shaders/"
+			"render/deferred/geometry/geometryCompactFS.glsl", 
+			ShaderType::FRAGMENT_SHADER);
+		this->geometryCompactShader.finalizeShaderProgram();
+
+		// The samplers of the batches may not share the units of the material
+		MultiDrawBatch::setTextureUnits(this->geometryShader);
+		MultiDrawBatch::setTextureUnits(this->geometryCompactShader);
+		MultiDrawBatch::setTextureUnits(this->depthShader);
+		MultiDrawBatch::setTextureUnits(this->cShadowMapShader);
+		MultiDrawBatch::setTextureUnits(this->cShadowMapLinearShader);
+		MultiDrawBatch::setTextureUnits(this->vShadowMapShader);
+		MultiDrawBatch::setTextureUnits(this->vShadowMapLinearShader);
+
+		this->ambientCompactShader.initialize();
+		this->ambientCompactShader.addShader("../Honeycomb GE/res/shaders/"
+			"render/deferred/geometry/simpleVS.glsl", 
+			ShaderType::VERTEX_SHADER);
+		this->ambientCompactShader.addShader("../Honeycomb GE/res/shaders/"
+			"render/deferred/light/blinn-phong/ambientLightCompactFS.glsl",
+			ShaderType::FRAGMENT_SHADER);
+		this->ambientCompactShader.finalizeShaderProgram();
+
+		this->directionalLightCompactShader.initialize();
+		this->directionalLightCompactShader.addShader("../Honeycomb GE/res/"
+			"shaders/render/deferred/geometry/simpleVS.glsl", 
+			ShaderType::VERTEX_SHADER);
+		this->directionalLightCompactShader.addShader("../Honeycomb GE/res/"
+			"shaders/render/deferred/light/blinn-phong/"
+			"directionalLightCompactFS.glsl", ShaderType::FRAGMENT_SHADER);
+		this->directionalLightCompactShader.finalizeShaderProgram();
+
+		this->pointLightCompactShader.initialize();
+		this->pointLightCompactShader.addShader("../Honeycomb GE/res/shaders/"
+			"render/deferred/light/blinn-phong/lightVS.glsl",
+			ShaderType::VERTEX_SHADER);
+		this->pointLightCompactShader.addShader("../Honeycomb GE/res/shaders/"
+			"render/deferred/light/blinn-phong/pointLightCompactFS.glsl",
+			ShaderType::FRAGMENT_SHADER);
+		this->pointLightCompactShader.finalizeShaderProgram();
+
+		this->spotLightCompactShader.initialize();
+		this->spotLightCompactShader.addShader("../Honeycomb GE/res/shaders/"
+			"render/deferred/light/blinn-phong/lightVS.glsl",
+			ShaderType::VERTEX_SHADER);
+		this->spotLightCompactShader.addShader("../Honeycomb GE/res/shaders/"
+			"render/deferred/light/blinn-phong/spotLightCompactFS.glsl",
+			ShaderType::FRAGMENT_SHADER);
+		this->spotLightCompactShader.finalizeShaderProgram();
+
 		this->quadShader.initialize();
 		this->quadShader.addShader("../Honeycomb GE/res/shaders/"
 			"render/deferred/geometry/simpleVS.glsl", 
@@ -174,30 +606,13 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 			"render/deferred/geometry/simpleFS.glsl", 
 			ShaderType::FRAGMENT_SHADER);
 		this->quadShader.finalizeShaderProgram();
-	}
-
-	void DeferredRenderer::initializeQuad() {
-		// The vertices for a full screen Quad
-		Vertex quadVerts[4] = {
-			Vertex(Vector3f(-1.0F, -1.0F, 0.0F), Vector3f(0.0F, 0.0F, 0.0F),
-				Vector3f(0.0F, 0.0F, 0.0F), Vector2f(0.0F, 0.0F)),
-			Vertex(Vector3f(-1.0F,  1.0F, 0.0F), Vector3f(0.0F, 0.0F, 0.0F),
-				Vector3f(0.0F, 0.0F, 0.0F), Vector2f(0.0F, 1.0F)),
-			Vertex(Vector3f( 1.0F,  1.0F, 0.0F), Vector3f(0.0F, 0.0F, 0.0F),
-				Vector3f(0.0F, 0.0F, 0.0F), Vector2f(1.0F, 1.0F)),
-			Vertex(Vector3f( 1.0F, -1.0F, 0.0F), Vector3f(0.0F, 0.0F, 0.0F),
-				Vector3f(0.0F, 0.0F, 0.0F), Vector2f(1.0F, 0.0F))
-		};
-
-		// The indices of the two triangles of the Quad
-		unsigned int indices[6] = { 0, 3, 2, 2, 1, 0 };
 
-		// Build the Quad Mesh & initialize so that it may be drawn
-		this->quad = Mesh::newMeshUnique();
-		this->quad->setVertexData(
-			std::vector<Vertex>(quadVerts, quadVerts + 4));
-		this->quad->setIndexData(
-			std::vector<unsigned int>(indices, indices + 6));
+		this->upscaleShader.initialize();
+		this->upscaleShader.addShader("../Honeycomb GE/res/shaders/"
+			"render/upscale/upscaleVS.glsl", ShaderType::VERTEX_SHADER);
+		this->upscaleShader.addShader("../Honeycomb GE/res/shaders/"
+			"render/upscale/upscaleFS.glsl", ShaderType::FRAGMENT_SHADER);
+		this->upscaleShader.finalizeShaderProgram();
 	}
 
 	void DeferredRenderer::renderBackground() {
@@ -220,8 +635,7 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		switch (this->backgroundMode) {
 		case BackgroundMode::SKYBOX:
 			this->skyboxShader.bindShaderProgram();
-			CameraController::getActiveCamera()->toShader(
-				this->skyboxShader, "camera");
+			this->frame->getCamera().toShader(this->skyboxShader, "camera");
 			this->skyboxShader.setUniform_i("cube", 0);
 			this->skybox->bind(0);
 
@@ -229,8 +643,8 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 			break;
 		case BackgroundMode::SOLID_COLOR:
 			this->solidColorShader.bindShaderProgram();
-			CameraController::getActiveCamera()->toShader(
-				this->solidColorShader, "camera");
+			this->frame->getCamera().toShader(this->solidColorShader,
+				"camera");
 			this->solidColorShader.setUniform_vec4(
 				"solidColor", this->solidColor);
 
@@ -244,15 +658,16 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		glDepthMask(GL_TRUE);
 	}
 
-	void DeferredRenderer::renderLightAmbient(const AmbientLight &aL) {
+	void DeferredRenderer::renderLightAmbient(const RenderFrame::Light &aL) {
 		glDisable(GL_STENCIL_TEST);
-		this->renderLightQuad(aL, this->ambientShader, "ambientLight");
+		this->renderLightQuad(aL, this->getLightShader(aL.type),
+			"ambientLight");
 		glEnable(GL_STENCIL_TEST);
 	}
 
-	void DeferredRenderer::renderLightDirectional(const DirectionalLight &dL,
-			GameScene &scene) {
-		this->renderTextureShadowMap(false, dL.getShadow(), scene);
+	void DeferredRenderer::renderLightDirectional(
+			const RenderFrame::Light &dL) {
+		this->renderTextureShadowMap(false, *dL.shadow);
 		
 		// Do not render the light itself if we are only looking for a shadow
 		// map.
@@ -260,29 +675,27 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 			this->final == FinalTexture::VARIANCE_SHADOW_MAP) return;
 
 		// Write the shadow map to the shader and render the light quad
+		ShaderProgram &shader = this->getLightShader(dL.type);
 		glDisable(GL_STENCIL_TEST);
-		this->writeShadowMapToShader(dL.getShadow().getShadowType(),
-			this->directionalLightShader);
-		this->renderLightQuad(dL, this->directionalLightShader,
-				"directionalLight");
+		this->writeShadowMapToShader(dL.shadow->getShadowType(), shader);
+		this->renderLightQuad(dL, shader, "directionalLight");
 		glEnable(GL_STENCIL_TEST);
 	}
 
-	void DeferredRenderer::renderLightPoint(const PointLight &pL) {
+	void DeferredRenderer::renderLightPoint(const RenderFrame::Light &pL) {
 		this->writePointLightTransform(pL);
 		
 		glEnable(GL_STENCIL_TEST);
 		this->stencilLightVolume(*this->lightVolumePoint);
 		this->renderLightVolume(pL, *this->lightVolumePoint,
-			this->pointLightShader, "pointLight");
+			this->getLightShader(pL.type), "pointLight");
 		glDisable(GL_STENCIL_TEST);
 	}
 
-	void DeferredRenderer::renderLightSpot(const SpotLight &sL, 
-			GameScene &scene) {
+	void DeferredRenderer::renderLightSpot(const RenderFrame::Light &sL) {
 		this->writeSpotLightTransform(sL);
-		this->renderTextureShadowMap(true, sL.getShadow(), scene,
-				sL.getPosition(), sL.getRange());
+		this->renderTextureShadowMap(true, *sL.shadow, sL.position,
+			sL.range);
 		
 		// Do not render the light itself if we are only looking for a shadow
 		// map.
@@ -290,18 +703,18 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 			this->final == FinalTexture::VARIANCE_SHADOW_MAP) return;
 
 		// Write the shadow map to the shader and render the light volume
+		ShaderProgram &shader = this->getLightShader(sL.type);
 		glEnable(GL_STENCIL_TEST);
-		this->writeShadowMapToShader(sL.getShadow().getShadowType(),
-			this->spotLightShader);
+		this->writeShadowMapToShader(sL.shadow->getShadowType(), shader);
 		this->stencilLightVolume(*this->lightVolumeSpot);
-		this->renderLightVolume(sL, *this->lightVolumeSpot,
-			this->spotLightShader, "spotLight");
+		this->renderLightVolume(sL, *this->lightVolumeSpot, shader, 
+			"spotLight");
 		glDisable(GL_STENCIL_TEST);
 	}
 
-	void DeferredRenderer::renderLightQuad(const BaseLight &bL,
+	void DeferredRenderer::renderLightQuad(const RenderFrame::Light &bL,
 			ShaderProgram &shader, const std::string &name) {
-		CameraController::getActiveCamera()->toShader(shader, "camera");
+		this->writeCameraToShader(shader);
 		bL.toShader(shader, name);
 
 		glDisable(GL_DEPTH_TEST); // Light does not need Depth Testing
@@ -310,7 +723,7 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		glBlendFunc(GL_ONE, GL_ONE);  // equal contribution from each source
 		glEnable(GL_CULL_FACE);
 
-		this->gBuffer.bindDrawLight(shader, bL.getType());
+		this->gBuffer.bindDrawLight(shader, bL.type);
 		
 		quad->render(shader);
 
@@ -320,13 +733,13 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		glEnable(GL_DEPTH_TEST);
 	}
 
-	void DeferredRenderer::renderLightVolume(const BaseLight &bL,
+	void DeferredRenderer::renderLightVolume(const RenderFrame::Light &bL,
 			Mesh &volume, ShaderProgram &shader, const std::string &name) {
 		// Write the Camera Projection & Light to the Point Light Shader
-		CameraController::getActiveCamera()->toShader(shader, "camera");
+		this->writeCameraToShader(shader);
 		bL.toShader(shader, name);
 
-		this->gBuffer.bindDrawLight(shader, bL.getType());
+		this->gBuffer.bindDrawLight(shader, bL.type);
 
 		// Set the Stencil Function to pass when the stencil value != 0
 		glStencilFunc(GL_NOTEQUAL, 0, 0xFF);
@@ -348,7 +761,27 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		glEnable(GL_DEPTH_TEST);
 	}
 
-	void DeferredRenderer::renderPassGeometry(GameScene &scene) {
+	void DeferredRenderer::renderPassDepth() {
+		// Write the depth only
+		glDepthFunc(GL_LESS);
+		glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+
+		// The depth shader does not use the materials, so the whole batch
+		// is drawn with a single call.
+		this->depthShader.bindShaderProgram();
+		this->multiDrawBatch.render(this->depthShader, false);
+		for (const RenderFrame::Object *object : this->unbatchedQueue)
+			MeshRenderer::render(this->depthShader, *object);
+
+		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+	}
+
+	void DeferredRenderer::renderPassGeometry() {
+		// Find the objects which are to be rendered this frame (the shadow
+		// maps draw from the same batch, so this is done even if only a
+		// shadow map is rendered).
+		this->buildRenderQueue();
+
 		// Skip if we're only rendering a Shadow Map
 		if (this->final == FinalTexture::CLASSIC_SHADOW_MAP ||
 			this->final == FinalTexture::VARIANCE_SHADOW_MAP) return;
@@ -371,18 +804,45 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		glDepthMask(GL_TRUE); // Only Geometry Render writes to the Depth
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // Clear Buffer
 
-		// Bind the skybox for Reflection (reason for binding it to 31 is so
+		// If the depth was already written by the prepass, only shade the
+		// fragments whose depth equals the nearest depth.
+		if (this->doDepthPrepass) {
+			this->renderPassDepth();
+
+			glDepthMask(GL_FALSE);
+			glDepthFunc(GL_EQUAL);
+		}
+
+		// Bind the skybox for Reflection (it is bound to a reserved unit so
 		// that the material can take the other GL_TEXTURE fields for itself).
-		this->geometryShader.bindShaderProgram();
-		this->geometryShader.setUniform_i("skybox", 31);
-		this->skybox->bind(31);
+		ShaderProgram &shader = this->getGeometryShader();
+		shader.bindShaderProgram();
+		shader.setUniform_i("skybox", TextureUnit::TEXTURE_UNIT_SKYBOX);
+		this->skybox->bind(TextureUnit::TEXTURE_UNIT_SKYBOX);
 
-		scene.onRender(this->geometryShader); // Render the Game Scene Meshes
+		// Render the Game Scene Meshes
+		this->multiDrawBatch.render(shader);
+		for (const RenderFrame::Object *object : this->unbatchedQueue)
+			MeshRenderer::render(shader, *object);
 
+		glDepthFunc(GL_LESS);
 		glDepthMask(GL_FALSE); // Only Geometry Render writes to the Depth
+
+		// Build the depth pyramid against which the next frames are culled,
+		// and restore the G Buffer & viewport which it changes.
+		if (this->occlusionCulling ==
+				OcclusionCulling::OCCLUSION_CULLING_HI_Z) {
+			this->hiZBuffer.update(
+				*this->gBuffer.bufferTextures[GBufferTextureType::DEPTH],
+				this->frame->getCameraProjection(), *this->quad);
+
+			this->gBuffer.bindDrawGeometry();
+			glViewport(0, 0, this->gBuffer.getRenderWidth(),
+				this->gBuffer.getRenderHeight());
+		}
 	}
 
-	void DeferredRenderer::renderPassLight(GameScene &scene) {
+	void DeferredRenderer::renderPassLight() {
 		// Don't render any lights if we are not using the final render target
 		// or we are not rendering a shadow map
 		if (this->final != FinalTexture::FINAL &&
@@ -393,24 +853,19 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		// mode when drawing lights.
 		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
-		auto sceneLights = scene.getSceneLights();
-		for (auto &bL : sceneLights) {
-			if (!bL.get().getIsActive()) continue;
-
-			switch (bL.get().getType()) {
+		for (const RenderFrame::Light &light : this->frame->getLights()) {
+			switch (light.type) {
 			case LightType::LIGHT_TYPE_AMBIENT:
-				this->renderLightAmbient(*(bL.get().downcast<AmbientLight>()));
+				this->renderLightAmbient(light);
 				break;
 			case LightType::LIGHT_TYPE_DIRECTIONAL:
-				this->renderLightDirectional(*(
-					bL.get().downcast<DirectionalLight>()), scene);
+				this->renderLightDirectional(light);
 				break;
 			case LightType::LIGHT_TYPE_POINT:
-				this->renderLightPoint(*(bL.get().downcast<PointLight>()));
+				this->renderLightPoint(light);
 				break;
 			case LightType::LIGHT_TYPE_SPOT:
-				this->renderLightSpot(*(bL.get().downcast<SpotLight>()), 
-					scene);
+				this->renderLightSpot(light);
 				break;
 			}
 		}
@@ -420,75 +875,40 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		glDisable(GL_STENCIL_TEST);
 	}
 
-	Texture2D& DeferredRenderer::renderPassPostProcess() {
-		// Bind the FINAL_2 buffer so that we may write the rendered (geometry
-		// and light) image into it.
-		this->gBuffer.bind();
-		glDrawBuffer(GL_COLOR_ATTACHMENT0 + GBufferTextureType::FINAL_2);
+	void DeferredRenderer::renderPassCopy(const int &write) {
+		this->frameGraph.bindRenderTarget(write);
 
 		// Depth test must be disabled, since we just want to render a texture
-		// to FINAL_2.
 		glDisable(GL_DEPTH_TEST);
 
 		// Bind the texture to the quad shader
 		this->quadShader.setUniform_i("fsTexture", 0);
-		if (this->final <= FinalTexture::FINAL) {
-			this->gBuffer.bufferTextures[this->final]->bind(0);
+		if (this->final < FinalTexture::FINAL) {
+			// Textures which are not used by the G Buffer layout are black
+			if (this->gBuffer.bufferTextures[this->final] != nullptr)
+				this->gBuffer.bufferTextures[this->final]->bind(0);
+			else
+				Texture2D::getTextureBlack()->bind(0);
 		} else if (this->final == FinalTexture::CLASSIC_SHADOW_MAP) {
 			this->cShadowMapTexture->bind(0);
 		} else if (this->final == FinalTexture::VARIANCE_SHADOW_MAP) {
 			this->vShadowMapTexture->bind(0);
 		}
 
-		// Render the texture using the quad shader into the FINAL_2 buffer
+		// Render the texture using the quad shader into the write texture
 		this->quad->render(this->quadShader);
-
-		// Now the FINAL_2 buffer contains the geometry + light rendered data.
-		// When post processing, we will read from the read buffer and write to
-		// the write buffer, then swap the buffers for each shader (since we
-		// cannot read to and write from the same buffer).
-		int read = GBufferTextureType::FINAL_2;
-		int write = GBufferTextureType::FINAL_1;
-
-		// Post Process the image with all of the user's custom post process
-		// shaders.
-		if (this->doPostProcess) {
-			for (ShaderProgram &s : this->getPostShaders()) {
-				this->renderPostProcessShader(s, read, write);
-			}
-		}
-
-		// FXAA post process
-		if (this->antiAliasing == AntiAliasing::FXAA) {
-			CameraController::getActiveCamera()->toShader(this->fxaaShader,
-				"camera");
-			this->renderPostProcessShader(this->fxaaShader, read, write);
-		}
-
-		// Gamma post process
-		if (this->colorSpace == ColorSpace::GAMMA_POST) {
-			this->renderPostProcessShader(this->gammaShader, read, write);
-		}
-
-		// Now return the texture containing the last texture we wrote into
-		// (which is now the read texture). This contains the final post
-		// processed image.
-		return *this->gBuffer.bufferTextures[read];
 	}
 
 	void DeferredRenderer::renderPostProcessShader(ShaderProgram &shader,
-			int &read, int &write) {
-		// Set the draw buffer to write and render image using this
-		// post processing shader
-		glDrawBuffer(GL_COLOR_ATTACHMENT0 + write);
-		this->gBuffer.bindTexture((GBufferTextureType)read, shader, 
-				"gBufferFinal");
-		this->quad->render(shader);
+			const int &read, const int &write) {
+		// Bind the write texture and render the read texture into it using
+		// this post processing shader.
+		this->frameGraph.bindRenderTarget(write);
+		glDisable(GL_DEPTH_TEST);
 
-		// Now read and write the other way (swap read and write)
-		int tmp = read;
-		read = write;
-		write = tmp;
+		this->frameGraph.getTexture(read).bind(0);
+		shader.setUniform_i("gBufferFinal", 0);
+		this->quad->render(shader);
 	}
 
 	void DeferredRenderer::renderPostProcessShader(ShaderProgram &shader,
@@ -503,8 +923,7 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 	}
 
 	void DeferredRenderer::renderTextureShadowMap(const bool &linear,
-			const Shadow &shadow, GameScene &scene, const Vector3f &pos, 
-			const float &zFar) {
+			const Shadow &shadow, const Vector3f &pos, const float &zFar) {
 		// Do not bother rendering the shadow map if the light is not going to
 		// use it!
 		if (shadow.getShadowType() == ShadowType::SHADOW_NONE) return;
@@ -529,14 +948,14 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		glViewport(0, 0, this->SHADOW_MAP_WIDTH, this->SHADOW_MAP_HEIGHT);
 
 		// Fetch the Light Projection matrix and write it to the light shaders,
-		// and render the scene from the perspective of the camera using the
+		// and render the scene from the perspective of the light using the
 		// shadow shader.
 		Matrix4f lP = shadow.getProjection();
 		if (Shadow::isClassicShadow(shadowType)) {
 			if (!linear) { // Use standard CSM depth shader for non linear
 				this->cShadowMapShader.setUniform_mat4("lightProjection", lP);
 				
-				scene.onRender(this->cShadowMapShader);
+				this->renderShadowCasters(this->cShadowMapShader, lP);
 			} else {       // Use linear CSM depth shader for linear
 				this->cShadowMapLinearShader.setUniform_mat4("lightProjection",
 					lP);
@@ -544,13 +963,13 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 					pos);
 				this->cShadowMapLinearShader.setUniform_f("zFar", zFar);
 
-				scene.onRender(this->cShadowMapLinearShader);
+				this->renderShadowCasters(this->cShadowMapLinearShader, lP);
 			}
 		} else if (Shadow::isVarianceShadow(shadowType)) {
 			if (!linear) { // Use standard VSM depth shader for non linear
 				this->vShadowMapShader.setUniform_mat4("lightProjection", lP);
 
-				scene.onRender(this->vShadowMapShader);
+				this->renderShadowCasters(this->vShadowMapShader, lP);
 			} else {       // Use linear VSM depth shader for linear
 				this->vShadowMapLinearShader.setUniform_mat4("lightProjection",
 					lP);
@@ -558,7 +977,7 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 					pos);
 				this->vShadowMapLinearShader.setUniform_f("zFar", zFar);
 
-				scene.onRender(this->vShadowMapLinearShader);
+				this->renderShadowCasters(this->vShadowMapLinearShader, lP);
 			}
 		}
 
@@ -605,10 +1024,9 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 			glEnable(GL_DEPTH_TEST); // Undo depth test mod
 		}
 
-		// Set the window render viewport size back to the Window Size
-		glViewport(0, 0,
-			GameWindow::getGameWindow()->getWindowWidth(),
-			GameWindow::getGameWindow()->getWindowHeight());
+		// Set the render viewport size back to the G Buffer Size
+		glViewport(0, 0, this->gBuffer.getRenderWidth(),
+			this->gBuffer.getRenderHeight());
 
 		// Undo Culling & Depth Mask Changes
 		glCullFace(GL_BACK);
@@ -619,27 +1037,58 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		this->gBuffer.bind();
 	}
 
+	void DeferredRenderer::renderShadowCasters(ShaderProgram &shader,
+			const Matrix4f &lP) {
+		// The batch is culled against the light, which overwrites the cull
+		// of the camera; the geometry pass has already drawn the batch.
+		if (this->isBatchHoldingFrame) {
+			this->multiDrawBatch.cull(lP);
+			this->multiDrawBatch.render(shader, false);
+		}
+
+		for (const RenderFrame::Object *object : this->shadowQueue) {
+			if (DeferredRenderer::isInFrustum(lP, object->boundsMin,
+					object->boundsMax))
+				MeshRenderer::render(shader, *object);
+		}
+	}
+
 	void DeferredRenderer::renderTexture(const Texture2D &tex) {
 		this->gBuffer.unbind();
 		glDisable(GL_DEPTH_TEST);
 
+		// The texture is rendered at the G Buffer size, so upscale it to the
+		// window if it is any smaller.
+		glViewport(0, 0,
+			GameWindow::getGameWindow()->getWindowWidth(),
+			GameWindow::getGameWindow()->getWindowHeight());
+		ShaderProgram &shader = (this->gBuffer.getRenderScale() < 1.0F) ?
+			this->upscaleShader : this->finalShader;
+		this->writePostEffectsToShader(shader);
+
 		tex.bind(0);
-		this->quadShader.setUniform_i("fsTexture", 0);
-		quad->render(this->quadShader);
+		shader.setUniform_i("fsTexture", 0);
+		quad->render(shader);
 
 		glEnable(GL_DEPTH_TEST);
 	}
 
+	void DeferredRenderer::resizeHiZBuffer() {
+		this->hiZBuffer.resize(this->gBuffer.getRenderWidth(),
+			this->gBuffer.getRenderHeight());
+	}
+
 	void DeferredRenderer::setGamma(const float &g) {
 		Renderer::setGamma(g);
 
 		this->geometryShader.setUniform_f("gamma", g);
+		this->geometryCompactShader.setUniform_f("gamma", g);
 		this->skyboxShader.setUniform_f("gamma", g);
+		this->upscaleShader.setUniform_f("gamma", g);
 	}
 
 	void DeferredRenderer::stencilLightVolume(Mesh &volume) {
-		CameraController::getActiveCamera()->toShader(this->stencilShader,
-			"camera");
+		this->frame->getCamera().toShader(this->stencilShader, "camera");
 		this->gBuffer.bindStencil(); // Bind buffer for Stencil information
 
 		glEnable(GL_DEPTH_TEST); // Enable depth testing for stencil
@@ -666,29 +1115,72 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		this->gBuffer.bindDraw();
 	}
 
-	void DeferredRenderer::writePointLightTransform(const PointLight &pL) {
-		const Transform &pLT = pL.getAttached()->getComponent<Transform>();
-		Matrix4f transformM = pLT.getMatrixTransformation();
-		float pLRange = pL.getRange();
+	void DeferredRenderer::updateRenderScale(const float &time) {
+		// Smooth the frame time, so that a single slow frame does not change
+		// the render scale.
+		if (this->frameTime < 0.0F)
+			this->frameTime = time;
+		else
+			this->frameTime += (time - this->frameTime) *
+				FRAME_TIME_SMOOTHING;
+
+		// Wait until all of the measurements in flight were rendered at the
+		// current scale before changing it again.
+		if (++this->framesSinceRescale < FRAME_QUERY_COUNT * 2) return;
+
+		// Leave the scale as it is while the frame time is within the target
+		// and not far below it, so that the scale does not oscillate.
+		if (this->frameTime <= this->targetFrameTime &&
+			this->frameTime >= this->targetFrameTime *
+				FRAME_TIME_RAISE_THRESHOLD) return;
+
+		// Most of the cost of the deferred passes grows with the number of
+		// pixels, which grows with the square of the scale. The scale drops
+		// all at once, but only rises one step at a time.
+		float current = this->gBuffer.getRenderScale();
+		float scale = current * std::sqrt(this->targetFrameTime /
+			this->frameTime);
+		scale = std::round(scale / RENDER_SCALE_STEP) * RENDER_SCALE_STEP;
+		scale = std::min(scale, current + RENDER_SCALE_STEP);
+		scale = std::min(std::max(scale, MIN_RENDER_SCALE), 1.0F);
+
+		if (std::abs(scale - current) < RENDER_SCALE_STEP * 0.5F) return;
+		this->setRenderScale(scale);
+	}
+
+	void DeferredRenderer::writeCameraToShader(ShaderProgram &shader) {
+		this->frame->getCamera().toShader(shader, "camera");
+		shader.setUniform_f("camera.width",
+			(float)this->gBuffer.getRenderWidth());
+		shader.setUniform_f("camera.height",
+			(float)this->gBuffer.getRenderHeight());
+	}
+
+	void DeferredRenderer::writePointLightTransform(
+			const RenderFrame::Light &pL) {
+		const Matrix4f &transformM = pL.transform;
+		float pLRange = pL.range;
 
-		this->pointLightShader.setUniform_mat4("objTransform", transformM);
-		this->pointLightShader.setUniform_f("lvRange", pLRange);
-		this->pointLightShader.setUniform_f("lvSpotAngle", PI);
+		ShaderProgram &shader = this->getLightShader(pL.type);
+		shader.setUniform_mat4("objTransform", transformM);
+		shader.setUniform_f("lvRange", pLRange);
+		shader.setUniform_f("lvSpotAngle", PI);
 
 		this->stencilShader.setUniform_mat4("objTransform", transformM);
 		this->stencilShader.setUniform_f("lvRange", pLRange);
 		this->stencilShader.setUniform_f("lvSpotAngle", PI);
 	}
 
-	void DeferredRenderer::writeSpotLightTransform(const SpotLight &sL) {
-		const Transform &sLT = sL.getAttached()->getComponent<Transform>();
-		Matrix4f transformM = sLT.getMatrixTransformation();
-		float sLRange = sL.getRange();
-		float sLAngle = sL.getAngle();
+	void DeferredRenderer::writeSpotLightTransform(
+			const RenderFrame::Light &sL) {
+		const Matrix4f &transformM = sL.transform;
+		float sLRange = sL.range;
+		float sLAngle = sL.angle;
 
-		this->spotLightShader.setUniform_mat4("objTransform", transformM);
-		this->spotLightShader.setUniform_f("lvRange", sLRange);
-		this->spotLightShader.setUniform_f("lvSpotAngle", sLAngle);
+		ShaderProgram &shader = this->getLightShader(sL.type);
+		shader.setUniform_mat4("objTransform", transformM);
+		shader.setUniform_f("lvRange", sLRange);
+		shader.setUniform_f("lvSpotAngle", sLAngle);
 
 		this->stencilShader.setUniform_mat4("objTransform", transformM);
 		this->stencilShader.setUniform_f("lvRange", sLRange);
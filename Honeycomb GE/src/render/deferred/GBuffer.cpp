@@ -2,6 +2,8 @@
 
 #include <GL/glew.h>
 
+#include <algorithm>
+
 #include "../../../include/base/GameWindow.h"
 #include "../../../include/debug/Logger.h"
 
@@ -21,15 +23,17 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		"gBufferNormal",
 
 		"gBufferMaterial",
+		"gBufferMaterialAmbient",
+		"gBufferMaterialSpecular",
 
 		"gBufferDepth",
 
-		"gBufferFinal",
 		"gBufferFinal"
 	};
 
 	GBuffer::GBuffer() {
-
+		this->layout = GBufferLayout::LAYOUT_STANDARD;
+		this->renderScale = 1.0F;
 	}
 
 	GBuffer::~GBuffer() {
@@ -47,12 +51,13 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 	void GBuffer::bindDrawGeometry() {
 		this->bindDraw();
 
-		// Set the drawing buffers
-		GLenum drawBuffers[] = {
-			GL_COLOR_ATTACHMENT0 + GBufferTextureType::POSITION, 
-			GL_COLOR_ATTACHMENT0 + GBufferTextureType::NORMAL,
-			GL_COLOR_ATTACHMENT0 + GBufferTextureType::MATERIAL
-		};
+		// Set the drawing buffers. The fragment output at location i is drawn
+		// to color attachment i, unless the layout does not use attachment i.
+		GLenum drawBuffers[GBufferTextureType::DEPTH];
+		for (int i = 0; i < GBufferTextureType::DEPTH; ++i) {
+			drawBuffers[i] = (this->bufferTextures[i] != nullptr) ?
+				GL_COLOR_ATTACHMENT0 + i : GL_NONE;
+		}
 		glDrawBuffers(GBufferTextureType::DEPTH, drawBuffers);
 	}
 
@@ -69,8 +74,12 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		
 		switch (type) {
 		case LightType::LIGHT_TYPE_AMBIENT:
-			this->bindTexture(GBufferTextureType::MATERIAL, 
-				shader);
+			if (this->layout == GBufferLayout::LAYOUT_COMPACT)
+				this->bindTexture(GBufferTextureType::MATERIAL_AMBIENT,
+					shader);
+			else
+				this->bindTexture(GBufferTextureType::MATERIAL, 
+					shader);
 			return;
 		case LightType::LIGHT_TYPE_DIRECTIONAL:
 		case LightType::LIGHT_TYPE_POINT:
@@ -101,18 +110,40 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 	}
 
 	void GBuffer::bindColorTextures(ShaderProgram &shader) {
-		this->bindTexture(GBufferTextureType::POSITION, shader);
-		this->bindTexture(GBufferTextureType::NORMAL, shader);
-		this->bindTexture(GBufferTextureType::MATERIAL, shader);
+		for (int i = 0; i < GBufferTextureType::DEPTH; ++i) {
+			if (this->bufferTextures[i] != nullptr)
+				this->bindTexture((GBufferTextureType)i, shader);
+		}
+
+		// The compact layout reconstructs the position from the depth buffer.
+		// The depth texture stays attached for the stencil test, so its copy
+		// is sampled instead.
+		if (this->layout == GBufferLayout::LAYOUT_COMPACT) {
+			shader.setUniform_i(TEXTURE_SHADER_NAMES[GBufferTextureType::
+				DEPTH], GBufferTextureType::DEPTH);
+			this->depthCopyTexture->bind(GBufferTextureType::DEPTH);
+		}
 	}
 
 	void GBuffer::bindStencil() {
 		glDrawBuffer(GL_NONE); // Disable drawing to buffers in stencil pass
 	}
 
+	void GBuffer::copyDepth() {
+		if (this->depthCopyTexture == nullptr) return;
+
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, this->frameBufferObj);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, this->depthCopyFrameBufferObj);
+		glBlitFramebuffer(0, 0, this->textureWidth, this->textureHeight,
+			0, 0, this->textureWidth, this->textureHeight,
+			GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+		glBindFramebuffer(GL_FRAMEBUFFER, this->frameBufferObj);
+	}
+
 	void GBuffer::destroy() {
-		GLuint fbo = this->frameBufferObj;
-		glDeleteFramebuffers(1, &fbo);
+		GLuint fbos[] = { (GLuint)this->frameBufferObj,
+			(GLuint)this->depthCopyFrameBufferObj };
+		glDeleteFramebuffers(2, fbos);
 	}
 
 	void GBuffer::frameBegin() {
@@ -126,6 +157,22 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		return this->frameBufferObj;
 	}
 
+	const GBufferLayout& GBuffer::getLayout() const {
+		return this->layout;
+	}
+
+	const int& GBuffer::getRenderHeight() const {
+		return this->textureHeight;
+	}
+
+	const float& GBuffer::getRenderScale() const {
+		return this->renderScale;
+	}
+
+	const int& GBuffer::getRenderWidth() const {
+		return this->textureWidth;
+	}
+
 	void GBuffer::initialize() {
 		GLItem::initialize();
 
@@ -133,109 +180,36 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 			&this->windowResizeHandler;
 		this->windowResizeHandler += std::bind(&GBuffer::resizeTextures, this);
 
-		// Fetch the Height and Width of the Game Window
-		this->textureHeight = GameWindow::getGameWindow()->getWindowHeight();
-		this->textureWidth = GameWindow::getGameWindow()->getWindowWidth();
-
-		// Generate the Frame Buffer Object for this G-Buffer
-		GLuint fbo;
-		glGenFramebuffers(1, &fbo);
-		this->frameBufferObj = fbo;
-		
-		// Bind the Buffer so that it may be written to and modified in the
-		// remaining initialization steps.
-		glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+		// Generate the Frame Buffer Objects for this G-Buffer & depth copy
+		GLuint fbos[2];
+		glGenFramebuffers(2, fbos);
+		this->frameBufferObj = fbos[0];
+		this->depthCopyFrameBufferObj = fbos[1];
 		
-		// Stores all of the color (non-depth) buffers, for a test to see if
-		// everything was correctly initialized.
-		GLenum colorBuffers[GBufferTextureType::DEPTH];
-
-		// Generate RGB16F textures for the POSITION and NORMAL
-		int i = 0;
-		for (; i < GBufferTextureType::MATERIAL; i++) {
-			// Create an empty texture. Use RGB16F, to allow us to store
-			// values in the texture outside of the standard [0, 1] clamp.
-			this->bufferTextures[i] = Texture2D::newTexture2DUnique();
-			this->bufferTextures[i]->setImageDataManual(
-				nullptr, TextureDataType::DATA_FLOAT,
-				TextureDataInternalFormat::INTERNAL_FORMAT_RGB16F,
-				TextureDataFormat::FORMAT_RGB,
-				this->textureWidth, this->textureHeight);
-			this->bufferTextures[i]->setFiltering(
-				TextureFilterMagMode::FILTER_MAG_NEAREST);
-
-			// Bind the texture to the Frame Buffer Object
-			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i,
-				GL_TEXTURE_2D, this->bufferTextures[i]->getTextureID(), 0);
-
-			colorBuffers[i] = GL_COLOR_ATTACHMENT0 + i; // Add to Color Buffers
-		}
+		// Allocate all of the buffer textures used by the layout, at the
+		// scaled size of the Game Window.
+		this->resizeTextures();
+	}
 
-		// Generate RGB32F textures for the MATERIAL
-		for (; i < GBufferTextureType::DEPTH; i++) {
-			// Same as above but 32F required since we are encoding the colors
-			// into large floating point numbers.
-			this->bufferTextures[i] = Texture2D::newTexture2DUnique();
-			this->bufferTextures[i]->setImageDataManual(
-				nullptr, TextureDataType::DATA_UNSIGNED_INT,
-				TextureDataInternalFormat::INTERNAL_FORMAT_RGBA32UI,
-				TextureDataFormat::FORMAT_RGBA_INTEGER,
-				this->textureWidth, this->textureHeight);
-			this->bufferTextures[i]->setFiltering(
-				TextureFilterMagMode::FILTER_MAG_NEAREST);
-
-			// Bind the texture to the Frame Buffer Object
-			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i,
-				GL_TEXTURE_2D, this->bufferTextures[i]->getTextureID(), 0);
-
-			colorBuffers[i] = GL_COLOR_ATTACHMENT0 + i; // Add to Color Buffers
-		}
+	void GBuffer::setLayout(const GBufferLayout &layout) {
+		this->layout = layout;
 
-		// Create the Depth Buffer Texture
-		for (; i < GBufferTextureType::FINAL_1; i++) {
-			this->bufferTextures[i] = Texture2D::newTexture2DUnique();
-			this->bufferTextures[i]->bind();
-			this->bufferTextures[i]->setImageDataManual(
-				nullptr,
-				TextureDataType::DATA_FLOAT_32_UNSIGNED_INT_24_8_REV,
-				TextureDataInternalFormat::INTERNAL_FORMAT_DEPTH32F_STENCIL8,
-				TextureDataFormat::FORMAT_DEPTH_STENCIL,
-				this->textureWidth, this->textureHeight);
-			this->bufferTextures[i]->setFiltering(
-				TextureFilterMagMode::FILTER_MAG_NEAREST);
-
-			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
-				GL_TEXTURE_2D, this->bufferTextures[i]->getTextureID(), 0);
-		}
+		// Reallocate the textures if they have already been allocated
+		if (this->isInitialized) this->allocateTextures();
+	}
 
-		// Create the FINAL_1 and FINAL_2 Image Texture
-		for (; i <= GBufferTextureType::FINAL_2; ++i) {
-			this->bufferTextures[i] = Texture2D::newTexture2DUnique();
-			this->bufferTextures[i]->bind();
-			this->bufferTextures[i]->setImageDataManual(
-				nullptr,
-				TextureDataType::DATA_FLOAT,
-				TextureDataInternalFormat::INTERNAL_FORMAT_RGB,
-				TextureDataFormat::FORMAT_RGB,
-				this->textureWidth, this->textureHeight);
-			this->bufferTextures[i]->setFiltering(
-				TextureFilterMagMode::FILTER_MAG_NEAREST);
-
-			glFramebufferTexture2D(GL_FRAMEBUFFER,
-				GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, 
-				this->bufferTextures[i]->getTextureID(), 0);
-		}
+	void GBuffer::setRenderScale(const float &scale) {
+		if (scale == this->renderScale) return;
+		this->renderScale = scale;
 
-		// Bind the 5 buffers as the color buffers which will be used when
-		// drawing & check that all the color buffers were initialized properly
-		glDrawBuffers(GBufferTextureType::DEPTH, colorBuffers);
-		
-		GLenum bufferStatus = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-		if (bufferStatus != GL_FRAMEBUFFER_COMPLETE) {
-			Logger::getLogger().logError(__FUNCTION__, __LINE__,
-				"Unable to Create Deferred GBuffer!");
-		}
-		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0); // Bind Default FrameBuffer
+		// Only reallocate the textures if their size actually changes
+		if (!this->isInitialized) return;
+		int height = this->textureHeight;
+		int width = this->textureWidth;
+		this->updateTextureSize();
+
+		if (height != this->textureHeight || width != this->textureWidth)
+			this->allocateTextures();
 	}
 
 	void GBuffer::unbind() {
@@ -250,56 +224,163 @@ namespace Honeycomb { namespace Render { namespace Deferred {
 		glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
 	}
 
-	void GBuffer::resizeTextures() {
-		this->textureHeight = GameWindow::getGameWindow()->getWindowHeight();
-		this->textureWidth = GameWindow::getGameWindow()->getWindowWidth();
+	void GBuffer::allocateTexture(const GBufferTextureType &type) {
+		bool isCompact = this->layout == GBufferLayout::LAYOUT_COMPACT;
+		bool isUsed = true;
+
+		TextureDataType dataType;
+		TextureDataInternalFormat iFormat;
+		TextureDataFormat format;
 		
-		int i = 0;
-
-		// Resize RGB16F textures (POSITION and NORMAL)
-		for (; i < GBufferTextureType::MATERIAL; i++) {
-			this->bufferTextures[i]->setImageDataManual(
-				nullptr, TextureDataType::DATA_FLOAT,
-				TextureDataInternalFormat::INTERNAL_FORMAT_RGB16F,
-				TextureDataFormat::FORMAT_RGB,
-				this->textureWidth, this->textureHeight);
-			this->bufferTextures[i]->setFiltering(
-				TextureFilterMagMode::FILTER_MAG_NEAREST);
+		switch (type) {
+		case GBufferTextureType::POSITION:
+			// Use RGB16F, to allow us to store values in the texture outside
+			// of the standard [0, 1] clamp. The compact layout reconstructs
+			// the position from the depth buffer instead.
+			isUsed = !isCompact;
+			dataType = TextureDataType::DATA_FLOAT;
+			iFormat = TextureDataInternalFormat::INTERNAL_FORMAT_RGB16F;
+			format = TextureDataFormat::FORMAT_RGB;
+			break;
+		case GBufferTextureType::NORMAL:
+			// The compact layout stores the octahedral encoded normal, which
+			// is in the range [0, 1], so 16 bit normalized channels suffice.
+			dataType = TextureDataType::DATA_FLOAT;
+			iFormat = isCompact ?
+				TextureDataInternalFormat::INTERNAL_FORMAT_RG16 :
+				TextureDataInternalFormat::INTERNAL_FORMAT_RGB16F;
+			format = isCompact ?
+				TextureDataFormat::FORMAT_RG : TextureDataFormat::FORMAT_RGB;
+			break;
+		case GBufferTextureType::MATERIAL:
+			// 32 bit integer channels are required by the standard layout 
+			// since we are encoding the colors into large numbers.
+			dataType = isCompact ? TextureDataType::DATA_UNSIGNED_BYTE :
+				TextureDataType::DATA_UNSIGNED_INT;
+			iFormat = isCompact ?
+				TextureDataInternalFormat::INTERNAL_FORMAT_RGBA8 :
+				TextureDataInternalFormat::INTERNAL_FORMAT_RGBA32UI;
+			format = isCompact ? TextureDataFormat::FORMAT_RGBA :
+				TextureDataFormat::FORMAT_RGBA_INTEGER;
+			break;
+		case GBufferTextureType::MATERIAL_AMBIENT:
+		case GBufferTextureType::MATERIAL_SPECULAR:
+			// Only the compact layout splits the material into textures
+			isUsed = isCompact;
+			dataType = TextureDataType::DATA_UNSIGNED_BYTE;
+			iFormat = TextureDataInternalFormat::INTERNAL_FORMAT_RGBA8;
+			format = TextureDataFormat::FORMAT_RGBA;
+			break;
+		case GBufferTextureType::DEPTH:
+			dataType = isCompact ?
+				TextureDataType::DATA_UNSIGNED_INT_24_8 :
+				TextureDataType::DATA_FLOAT_32_UNSIGNED_INT_24_8_REV;
+			iFormat = isCompact ?
+				TextureDataInternalFormat::INTERNAL_FORMAT_DEPTH24_STENCIL8 :
+				TextureDataInternalFormat::INTERNAL_FORMAT_DEPTH32F_STENCIL8;
+			format = TextureDataFormat::FORMAT_DEPTH_STENCIL;
+			break;
+		case GBufferTextureType::FINAL_1:
+			// The light is accumulated into half precision floating point
+			// textures, so that it may exceed one until it is tone mapped. The
+			// compact layout packs it further, into 32 bits per texel.
+			dataType = TextureDataType::DATA_FLOAT;
+			iFormat = isCompact ?
+				TextureDataInternalFormat::INTERNAL_FORMAT_R11F_G11F_B10F :
+				TextureDataInternalFormat::INTERNAL_FORMAT_RGB16F;
+			format = TextureDataFormat::FORMAT_RGB;
+			break;
+		default:
+			return;
 		}
-		
-		// Resize RGBA32F textures (MATERIAL)
-		for (; i < GBufferTextureType::DEPTH; i++) {
-			this->bufferTextures[i]->setImageDataManual(
-				nullptr, TextureDataType::DATA_UNSIGNED_INT,
-				TextureDataInternalFormat::INTERNAL_FORMAT_RGBA32UI,
-				TextureDataFormat::FORMAT_RGBA_INTEGER,
-				this->textureWidth, this->textureHeight);
-			this->bufferTextures[i]->setFiltering(
-				TextureFilterMagMode::FILTER_MAG_NEAREST);
+
+		GLenum attachment = (type == GBufferTextureType::DEPTH) ?
+			GL_DEPTH_STENCIL_ATTACHMENT : GL_COLOR_ATTACHMENT0 + type;
+
+		// If the texture is not used by this layout, detach and destroy it
+		if (!isUsed) {
+			if (this->bufferTextures[type] != nullptr) {
+				glFramebufferTexture2D(GL_FRAMEBUFFER, attachment,
+					GL_TEXTURE_2D, 0, 0);
+				this->bufferTextures[type].reset();
+			}
+
+			return;
 		}
 
-		// Resize DEPTH32F_STENCIL8 texture (DEPTH)
-		for (; i < GBufferTextureType::FINAL_1; i++) {
-			this->bufferTextures[i]->setImageDataManual(
-				nullptr,
-				TextureDataType::DATA_FLOAT_32_UNSIGNED_INT_24_8_REV,
-				TextureDataInternalFormat::INTERNAL_FORMAT_DEPTH32F_STENCIL8,
-				TextureDataFormat::FORMAT_DEPTH_STENCIL,
-				this->textureWidth, this->textureHeight);
-			this->bufferTextures[i]->setFiltering(
-				TextureFilterMagMode::FILTER_MAG_NEAREST);
+		// Create an empty texture of the appropriate format & size
+		if (this->bufferTextures[type] == nullptr)
+			this->bufferTextures[type] = Texture2D::newTexture2DUnique();
+		this->bufferTextures[type]->setImageDataManual(
+			nullptr, dataType, iFormat, format,
+			this->textureWidth, this->textureHeight);
+		this->bufferTextures[type]->setFiltering(
+			TextureFilterMagMode::FILTER_MAG_NEAREST);
+
+		// Bind the texture to the Frame Buffer Object
+		glFramebufferTexture2D(GL_FRAMEBUFFER, attachment,
+			GL_TEXTURE_2D, this->bufferTextures[type]->getTextureID(), 0);
+	}
+
+	void GBuffer::allocateDepthCopy() {
+		if (this->layout != GBufferLayout::LAYOUT_COMPACT) {
+			this->depthCopyTexture.reset();
+			return;
 		}
 
-		// Resize the final RGB textures (FINAL_1 and FINAL_2)
-		for (int i = GBufferTextureType::FINAL_1; i <= FINAL_2; ++i) {
-			this->bufferTextures[i]->setImageDataManual(
-				nullptr,
-				TextureDataType::DATA_FLOAT,
-				TextureDataInternalFormat::INTERNAL_FORMAT_RGB,
-				TextureDataFormat::FORMAT_RGB,
-				this->textureWidth, this->textureHeight);
-			this->bufferTextures[i]->setFiltering(
-				TextureFilterMagMode::FILTER_MAG_NEAREST);
+		// The blit requires the copy to have the same format as the depth
+		// texture of the compact layout.
+		if (this->depthCopyTexture == nullptr)
+			this->depthCopyTexture = Texture2D::newTexture2DUnique();
+		this->depthCopyTexture->setImageDataManual(nullptr,
+			TextureDataType::DATA_UNSIGNED_INT_24_8,
+			TextureDataInternalFormat::INTERNAL_FORMAT_DEPTH24_STENCIL8,
+			TextureDataFormat::FORMAT_DEPTH_STENCIL,
+			this->textureWidth, this->textureHeight);
+		this->depthCopyTexture->setFiltering(
+			TextureFilterMagMode::FILTER_MAG_NEAREST);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, this->depthCopyFrameBufferObj);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
+			GL_TEXTURE_2D, this->depthCopyTexture->getTextureID(), 0);
+		glDrawBuffer(GL_NONE);
+		glReadBuffer(GL_NONE);
+	}
+
+	void GBuffer::allocateTextures() {
+		this->allocateDepthCopy();
+
+		// Bind the Buffer so that it may be written to and modified
+		glBindFramebuffer(GL_FRAMEBUFFER, this->frameBufferObj);
+
+		for (int i = 0; i < GBufferTextureType::COUNT; ++i)
+			this->allocateTexture((GBufferTextureType)i);
+
+		// Bind the color buffers which will be used when drawing & check 
+		// that all the buffers were initialized properly
+		this->bindDrawGeometry();
+
+		GLenum bufferStatus = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+		if (bufferStatus != GL_FRAMEBUFFER_COMPLETE) {
+			Logger::getLogger().logError(__FUNCTION__, __LINE__,
+				"Unable to Create Deferred GBuffer!");
 		}
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0); // Bind Default FrameBuffer
+	}
+
+	void GBuffer::resizeTextures() {
+		this->updateTextureSize();
+		this->allocateTextures();
+	}
+
+	void GBuffer::updateTextureSize() {
+		int height = GameWindow::getGameWindow()->getWindowHeight();
+		int width = GameWindow::getGameWindow()->getWindowWidth();
+
+		// Round the scaled size, but never let a texture become empty
+		this->textureHeight = std::max(1,
+			(int)(height * this->renderScale + 0.5F));
+		this->textureWidth = std::max(1,
+			(int)(width * this->renderScale + 0.5F));
 	}
 } } }
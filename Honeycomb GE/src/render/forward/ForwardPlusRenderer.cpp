@@ -0,0 +1,724 @@
+#include "../../../include/render/forward/ForwardPlusRenderer.h"
+
+#include <GL/glew.h>
+
+#include <algorithm>
+
+#include "../../../include/base/GameWindow.h"
+
+#include "../../../include/component/light/BaseLight.h"
+
+#include "../../../include/debug/Logger.h"
+#include "../../../include/job/JobSystem.h"
+#include "../../../include/render/TextureUnit.h"
+#include "../../../include/render/batch/MultiDrawBatch.h"
+
+using Honeycomb::Base::GameWindow;
+using Honeycomb::Component::Light::Attenuation;
+using Honeycomb::Component::Light::LightType;
+using Honeycomb::Component::Light::Shadow;
+using Honeycomb::Component::Light::ShadowType;
+using Honeycomb::Debug::Logger;
+using Honeycomb::Graphics::Texture2D;
+using Honeycomb::Graphics::TextureDataFormat;
+using Honeycomb::Graphics::TextureDataInternalFormat;
+using Honeycomb::Graphics::TextureDataType;
+using Honeycomb::Graphics::TextureFilterMagMode;
+using Honeycomb::Job::JobSystem;
+using Honeycomb::Math::Matrix4f;
+using Honeycomb::Math::Vector2f;
+using Honeycomb::Math::Vector3f;
+using Honeycomb::Math::Vector4f;
+using Honeycomb::Render::Batch::MultiDrawBatch;
+using Honeycomb::Render::RenderFrame;
+using Honeycomb::Shader::ShaderProgram;
+using Honeycomb::Shader::ShaderType;
+
+namespace Honeycomb { namespace Render { namespace Forward {
+	ForwardPlusRenderer* ForwardPlusRenderer::forwardPlusRenderer = nullptr;
+
+	const int ForwardPlusRenderer::TILE_SIZE = 16;
+
+	ForwardPlusRenderer* ForwardPlusRenderer::getForwardPlusRenderer() {
+		if (ForwardPlusRenderer::forwardPlusRenderer == nullptr)
+			ForwardPlusRenderer::forwardPlusRenderer =
+				new ForwardPlusRenderer();
+
+		return ForwardPlusRenderer::forwardPlusRenderer;
+	}
+
+	const int& ForwardPlusRenderer::getSampleCount() const {
+		return this->sampleCount;
+	}
+
+	void ForwardPlusRenderer::render(const RenderFrame &frame) {
+		this->frame = &frame;
+		frame.getCamera().toShader(this->depthShader, "camera");
+		frame.getCamera().toShader(this->forwardShader, "camera");
+
+		this->cullLights();					// Cull Lights against Tiles
+		this->renderPassShadow();			// Render the Shadow Map
+		this->renderPassDepth();			// Render Depth Prepass
+		this->renderPassShading();			// Render Geometry & Lights
+		this->renderBackground();			// Render Background Cubebox
+
+		// Post Process the final image and render it to the window
+		Texture2D& target = this->renderPassPostProcess();
+		this->renderTexture(target);
+		this->frame = nullptr;
+	}
+
+	void ForwardPlusRenderer::setSampleCount(const int &samples) {
+		GLint maxSamples;
+		glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+
+		this->sampleCount = std::max(1, std::min(samples, (int)maxSamples));
+		if (this->msaaBuffer != 0) this->resizeBuffers();
+	}
+
+	ForwardPlusRenderer::ForwardPlusRenderer() : Renderer() {
+		this->msaaBuffer = 0;
+		this->resolveBuffer = 0;
+		this->shadowLight = nullptr;
+		this->isShadowLimitLogged = false;
+		this->setSampleCount(4);
+
+		this->initializeBuffers();
+		this->initializeLightBuffers();
+		this->initializeShaders();
+
+		// Even though the color space is set in the parent Renderer class, we
+		// have to set it here again since we must write the gamma value to our
+		// shading pass shader.
+		this->setColorSpace(ColorSpace::GAMMA_POST);
+	}
+
+	ForwardPlusRenderer::~ForwardPlusRenderer() {
+
+	}
+
+	void ForwardPlusRenderer::cullLights() {
+		const Matrix4f &proj = this->frame->getCameraProjection();
+		int tilesX = (this->bufferWidth + TILE_SIZE - 1) / TILE_SIZE;
+		int tilesY = (this->bufferHeight + TILE_SIZE - 1) / TILE_SIZE;
+
+		this->lightData.clear();
+		this->lightTiles.clear();
+
+		// Writes the data of a single light to the light data buffer, in the
+		// texel layout expected by the Forward+ shading shader.
+		auto writeLight = [this](const Vector3f &pos, const float &range,
+				const RenderFrame::Light &bL, const Attenuation *atten,
+				const int &type, const Vector3f &dir, const float &angle) {
+			float data[16] = {
+				pos.getX(), pos.getY(), pos.getZ(), range,
+				bL.color.getX(), bL.color.getY(), bL.color.getZ(),
+					bL.intensity,
+				atten ? atten->getConstantTerm() : 1.0F,
+				atten ? atten->getLinearTerm() : 0.0F,
+				atten ? atten->getQuadraticTerm() : 0.0F, (float)type,
+				dir.getX(), dir.getY(), dir.getZ(), angle
+			};
+
+			this->lightData.insert(this->lightData.end(), data, data + 16);
+		};
+
+		// The shading pass samples a single shadow map, so only the first
+		// directional or spot light which casts a shadow is rendered with
+		// it. That light is shaded on its own, outside of the light buffers.
+		const std::vector<RenderFrame::Light> &lights =
+			this->frame->getLights();
+		int shadowCount = 0;
+		this->shadowLight = nullptr;
+		for (const RenderFrame::Light &bL : lights) {
+			if ((bL.type != LightType::LIGHT_TYPE_DIRECTIONAL &&
+				bL.type != LightType::LIGHT_TYPE_SPOT) ||
+				bL.shadow == nullptr || bL.shadow->getShadowType() ==
+				ShadowType::SHADOW_NONE) continue;
+
+			if (this->shadowLight == nullptr) this->shadowLight = &bL;
+			++shadowCount;
+		}
+
+		if (shadowCount > 1 && !this->isShadowLimitLogged) {
+			Logger::getLogger().logWarning(__FUNCTION__, __LINE__,
+				"The Forward+ renderer only renders the shadow of one "
+				"light per frame. The other lights are shaded without "
+				"their shadows.");
+			this->isShadowLimitLogged = true;
+		}
+
+		// The ambient lights are summed into a single light and the
+		// directional lights are written to the start of the light data
+		// buffer, since they affect every fragment.
+		Vector3f ambient;
+		int directionalCount = 0;
+		for (const RenderFrame::Light &bL : lights) {
+			if (&bL == this->shadowLight) continue;
+
+			if (bL.type == LightType::LIGHT_TYPE_AMBIENT) {
+				ambient += bL.color * bL.intensity;
+			} else if (bL.type == LightType::LIGHT_TYPE_DIRECTIONAL) {
+				writeLight(Vector3f(), 0.0F, bL, nullptr, 2, bL.direction,
+					0.0F);
+				++directionalCount;
+			}
+		}
+
+		// The point and spot lights are written after the directional lights,
+		// but only if they cover at least one tile of the screen.
+		int localCount = 0;
+		for (const RenderFrame::Light &bL : lights) {
+			if (&bL == this->shadowLight) continue;
+
+			if (bL.type == LightType::LIGHT_TYPE_POINT) {
+				if (!this->cullLightSphere(proj, bL.position, bL.range))
+					continue;
+
+				writeLight(bL.position, bL.range, bL, bL.attenuation.get(),
+					0, Vector3f(), 0.0F);
+				++localCount;
+			} else if (bL.type == LightType::LIGHT_TYPE_SPOT) {
+				if (!this->cullLightSphere(proj, bL.position, bL.range))
+					continue;
+
+				writeLight(bL.position, bL.range, bL, bL.attenuation.get(),
+					1, bL.direction, bL.angle);
+				++localCount;
+			}
+		}
+
+		// Count the number of lights in each tile (the grid stores an offset
+		// into the index buffer and a count for each tile). Each job bins a
+		// range of tile rows, so no two jobs write to the same tile.
+		this->lightGrid.assign(tilesX * tilesY * 2, 0);
+		JobSystem::getJobSystem()->parallelFor(tilesY, 1,
+			[this, tilesX, localCount](int begin, int end) {
+				for (int l = 0; l < localCount; ++l) {
+					const int *rect = &this->lightTiles[l * 4];
+					int y0 = std::max(rect[1], begin);
+					int y1 = std::min(rect[3], end - 1);
+
+					for (int y = y0; y <= y1; ++y)
+						for (int x = rect[0]; x <= rect[2]; ++x)
+							++this->lightGrid[(y * tilesX + x) * 2 + 1];
+				}
+			});
+
+		// Convert the counts to offsets
+		unsigned int offset = 0;
+		for (int t = 0; t < tilesX * tilesY; ++t) {
+			this->lightGrid[t * 2] = offset;
+			offset += this->lightGrid[t * 2 + 1];
+		}
+
+		// Write the light indices of each tile, again over rows of tiles. The
+		// lights are visited in order, so the indices of a tile are sorted.
+		this->lightIndices.resize(offset);
+		JobSystem::getJobSystem()->parallelFor(tilesY, 1,
+			[this, tilesX, localCount, directionalCount](int begin, int end) {
+				std::vector<unsigned int> written(tilesX * (end - begin), 0);
+
+				for (int l = 0; l < localCount; ++l) {
+					const int *rect = &this->lightTiles[l * 4];
+					int y0 = std::max(rect[1], begin);
+					int y1 = std::min(rect[3], end - 1);
+
+					for (int y = y0; y <= y1; ++y) {
+						for (int x = rect[0]; x <= rect[2]; ++x) {
+							int tile = y * tilesX + x;
+							unsigned int &count =
+								written[(y - begin) * tilesX + x];
+							this->lightIndices[this->lightGrid[tile * 2] +
+								count++] = directionalCount + l;
+						}
+					}
+				}
+			});
+
+		// Upload the buffers (a buffer texture may not be empty, so at least
+		// a single element is always allocated).
+		glBindBuffer(GL_TEXTURE_BUFFER, this->lightDataBuffer);
+		glBufferData(GL_TEXTURE_BUFFER,
+			std::max<size_t>(this->lightData.size(), 4) * sizeof(float),
+			this->lightData.empty() ? nullptr : this->lightData.data(),
+			GL_STREAM_DRAW);
+		glBindBuffer(GL_TEXTURE_BUFFER, this->lightGridBuffer);
+		glBufferData(GL_TEXTURE_BUFFER,
+			this->lightGrid.size() * sizeof(unsigned int),
+			this->lightGrid.data(), GL_STREAM_DRAW);
+		glBindBuffer(GL_TEXTURE_BUFFER, this->lightIndicesBuffer);
+		glBufferData(GL_TEXTURE_BUFFER,
+			std::max<size_t>(this->lightIndices.size(), 1) *
+				sizeof(unsigned int),
+			this->lightIndices.empty() ? nullptr : this->lightIndices.data(),
+			GL_STREAM_DRAW);
+		glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+		// Write the global lights and the tile layout to the shading shader
+		this->forwardShader.setUniform_vec3("ambientLight.base.color",
+			ambient);
+		this->forwardShader.setUniform_f("ambientLight.base.intensity", 1.0F);
+		this->forwardShader.setUniform_i("directionalLightCount",
+			directionalCount);
+		this->forwardShader.setUniform_i("tileSize", TILE_SIZE);
+		this->forwardShader.setUniform_i("tileCountX", tilesX);
+
+		// Write the light which casts the shadow (with the light type of the
+		// light data buffer, or -1 if there is none) to the shading shader.
+		int shadowLightType = -1;
+		if (this->shadowLight != nullptr) {
+			if (this->shadowLight->type == LightType::LIGHT_TYPE_DIRECTIONAL) {
+				this->shadowLight->toShader(this->forwardShader,
+					"directionalLight");
+				shadowLightType = 2;
+			} else {
+				this->shadowLight->toShader(this->forwardShader, "spotLight");
+				shadowLightType = 1;
+			}
+		}
+		this->forwardShader.setUniform_i("shadowLightType", shadowLightType);
+	}
+
+	bool ForwardPlusRenderer::cullLightSphere(const Matrix4f &proj,
+			const Vector3f &center, const float &radius) {
+		int tilesX = (this->bufferWidth + TILE_SIZE - 1) / TILE_SIZE;
+		int tilesY = (this->bufferHeight + TILE_SIZE - 1) / TILE_SIZE;
+
+		// Project the corners of the bounding box of the sphere and find the
+		// screen rectangle which contains all of them.
+		float minX = 1.0F, minY = 1.0F, maxX = -1.0F, maxY = -1.0F;
+		int behind = 0;
+		for (int i = 0; i < 8; ++i) {
+			Vector4f corner = proj * Vector4f(
+				center.getX() + ((i & 1) ? radius : -radius),
+				center.getY() + ((i & 2) ? radius : -radius),
+				center.getZ() + ((i & 4) ? radius : -radius), 1.0F);
+
+			if (corner.getW() <= 0.0F) {
+				++behind;
+				continue;
+			}
+
+			float x = corner.getX() / corner.getW();
+			float y = corner.getY() / corner.getW();
+			minX = std::min(minX, x);
+			minY = std::min(minY, y);
+			maxX = std::max(maxX, x);
+			maxY = std::max(maxY, y);
+		}
+
+		// If the box is entirely behind the camera, the light is invisible; if
+		// the box straddles the camera plane, the projected rectangle is not
+		// reliable so the light is assumed to cover the whole screen.
+		int rect[4] = { 0, 0, tilesX - 1, tilesY - 1 };
+		if (behind == 8) {
+			return false;
+		} else if (behind == 0) {
+			if (maxX < -1.0F || minX > 1.0F || maxY < -1.0F || minY > 1.0F)
+				return false;
+
+			rect[0] = (int)((minX * 0.5F + 0.5F) * this->bufferWidth);
+			rect[1] = (int)((minY * 0.5F + 0.5F) * this->bufferHeight);
+			rect[2] = (int)((maxX * 0.5F + 0.5F) * this->bufferWidth);
+			rect[3] = (int)((maxY * 0.5F + 0.5F) * this->bufferHeight);
+
+			rect[0] = std::max(0, std::min(rect[0] / TILE_SIZE, tilesX - 1));
+			rect[1] = std::max(0, std::min(rect[1] / TILE_SIZE, tilesY - 1));
+			rect[2] = std::max(0, std::min(rect[2] / TILE_SIZE, tilesX - 1));
+			rect[3] = std::max(0, std::min(rect[3] / TILE_SIZE, tilesY - 1));
+		}
+
+		this->lightTiles.insert(this->lightTiles.end(), rect, rect + 4);
+		return true;
+	}
+
+	void ForwardPlusRenderer::initializeBuffers() {
+		GLuint msaa;
+		glGenFramebuffers(1, &msaa);
+		this->msaaBuffer = msaa;
+
+		GLuint renderBuffers[2];
+		glGenRenderbuffers(2, renderBuffers);
+		this->msaaColorBuffer = renderBuffers[0];
+		this->msaaDepthBuffer = renderBuffers[1];
+
+		GLuint resolve;
+		glGenFramebuffers(1, &resolve);
+		this->resolveBuffer = resolve;
+
+		this->resolveTextures[0] = Texture2D::newTexture2DUnique();
+		this->resolveTextures[1] = Texture2D::newTexture2DUnique();
+
+		GameWindow::getGameWindow()->getResizeEvent() +=
+			&this->windowResizeHandler;
+		this->windowResizeHandler += std::bind(
+			&ForwardPlusRenderer::resizeBuffers, this);
+
+		this->resizeBuffers();
+	}
+
+	void ForwardPlusRenderer::initializeLightBuffers() {
+		GLuint buffers[3];
+		glGenBuffers(3, buffers);
+		this->lightDataBuffer = buffers[0];
+		this->lightGridBuffer = buffers[1];
+		this->lightIndicesBuffer = buffers[2];
+
+		GLuint textures[3];
+		glGenTextures(3, textures);
+		this->lightDataTexture = textures[0];
+		this->lightGridTexture = textures[1];
+		this->lightIndicesTexture = textures[2];
+
+		// Each light is made up of four RGBA32F texels, each tile of an offset
+		// and count pair and each index of a single unsigned integer.
+		GLenum formats[3] = { GL_RGBA32F, GL_RG32UI, GL_R32UI };
+		for (int i = 0; i < 3; ++i) {
+			glBindBuffer(GL_TEXTURE_BUFFER, buffers[i]);
+			glBufferData(GL_TEXTURE_BUFFER, 4 * sizeof(float), nullptr,
+				GL_STREAM_DRAW);
+
+			glBindTexture(GL_TEXTURE_BUFFER, textures[i]);
+			glTexBuffer(GL_TEXTURE_BUFFER, formats[i], buffers[i]);
+		}
+
+		glBindTexture(GL_TEXTURE_BUFFER, 0);
+		glBindBuffer(GL_TEXTURE_BUFFER, 0);
+	}
+
+	void ForwardPlusRenderer::initializeShaders() {
+		this->depthShader.initialize();
+		this->depthShader.addShader("../Honeycomb GE/res/shaders/"
+			"render/depth/depthVS.glsl", ShaderType::VERTEX_SHADER);
+		this->depthShader.addShader("../Honeycomb GE/res/shaders/"
+			"render/depth/depthFS.glsl", ShaderType::FRAGMENT_SHADER);
+		this->depthShader.finalizeShaderProgram();
+
+		this->forwardShader.initialize();
+		this->forwardShader.addShader("../Honeycomb GE/res/shaders/"
+			"render/deferred/geometry/geometryVS.glsl",
+			ShaderType::VERTEX_SHADER);
+		this->forwardShader.addShader("../Honeycomb GE/res/shaders/"
+			"render/forward/forwardPlusFS.glsl",
+			ShaderType::FRAGMENT_SHADER);
+		this->forwardShader.finalizeShaderProgram();
+
+		// The samplers of the batches may not share the units of the material
+		MultiDrawBatch::setTextureUnits(this->forwardShader);
+		MultiDrawBatch::setTextureUnits(this->depthShader);
+		MultiDrawBatch::setTextureUnits(this->cShadowMapShader);
+		MultiDrawBatch::setTextureUnits(this->cShadowMapLinearShader);
+		MultiDrawBatch::setTextureUnits(this->vShadowMapShader);
+		MultiDrawBatch::setTextureUnits(this->vShadowMapLinearShader);
+	}
+
+	void ForwardPlusRenderer::renderBackground() {
+		// Do NOT write to the depth buffer, but do enable a depth test and
+		// render the skybox if the depth buffer value is less than or equal to
+		// 1.0F (skybox depth is at 1.0F, so it must be less than or equal).
+		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+		glDepthMask(GL_FALSE);
+		glEnable(GL_DEPTH_TEST);
+		glDepthFunc(GL_LEQUAL);
+		glDisable(GL_CULL_FACE);
+
+		switch (this->backgroundMode) {
+		case BackgroundMode::SKYBOX:
+			this->skyboxShader.bindShaderProgram();
+			this->frame->getCamera().toShader(this->skyboxShader, "camera");
+			this->skyboxShader.setUniform_i("cube", 0);
+			this->skybox->bind(0);
+
+			this->cubemapMesh->render(this->skyboxShader);
+			break;
+		case BackgroundMode::SOLID_COLOR:
+			this->solidColorShader.bindShaderProgram();
+			this->frame->getCamera().toShader(this->solidColorShader,
+				"camera");
+			this->solidColorShader.setUniform_vec4(
+				"solidColor", this->solidColor);
+
+			this->cubemapMesh->render(this->solidColorShader);
+			break;
+		}
+
+		// Undo the changes to OpenGL rendering
+		glEnable(GL_CULL_FACE);
+		glDepthFunc(GL_LESS);
+		glDepthMask(GL_TRUE);
+	}
+
+	void ForwardPlusRenderer::renderPassDepth() {
+		glBindFramebuffer(GL_FRAMEBUFFER, this->msaaBuffer);
+
+		// Draw the geometry using the mode requested by the user
+		glPolygonMode(PolygonFace::FRONT, this->polygonModeFront);
+		glPolygonMode(PolygonFace::BACK, this->polygonModeBack);
+
+		// Cull faces as necessary, if the user wants to
+		glFrontFace(this->frontFace);
+		glCullFace(this->cullingFace);
+		this->setBoolSettingGL(GL_CULL_FACE, this->doCullFaces);
+
+		// Enable Depth Testing, if the user wants to.
+		this->setBoolSettingGL(GL_DEPTH_TEST, this->doDepthTest);
+
+		// Clear the color & depth, then write the depth only
+		glDepthMask(GL_TRUE);
+		glDepthFunc(GL_LESS);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+
+		this->depthShader.bindShaderProgram();
+		this->frame->renderObjects(this->depthShader);
+
+		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+	}
+
+	void ForwardPlusRenderer::renderPassShadow() {
+		if (this->shadowLight == nullptr) return;
+
+		// Spot lights write their linear depth, like in the deferred renderer
+		const Shadow &shadow = *this->shadowLight->shadow;
+		ShadowType shadowType = shadow.getShadowType();
+		bool isLinear = this->shadowLight->type == LightType::LIGHT_TYPE_SPOT;
+		bool isClassic = Shadow::isClassicShadow(shadowType);
+
+		// Bind and clear the Shadow Map Buffer
+		glBindFramebuffer(GL_FRAMEBUFFER, isClassic ?
+			this->cShadowMapBuffer : this->vShadowMapBuffer);
+		glViewport(0, 0, SHADOW_MAP_WIDTH, SHADOW_MAP_HEIGHT);
+		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+		glDepthMask(GL_TRUE);
+		glEnable(GL_DEPTH_TEST);
+		glDepthFunc(GL_LESS);
+		glEnable(GL_CULL_FACE);
+		glCullFace(GL_BACK);
+		glClear(isClassic ? GL_DEPTH_BUFFER_BIT :
+			GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		// Render the scene from the perspective of the light
+		ShaderProgram &shader = isClassic ?
+			(isLinear ? this->cShadowMapLinearShader : this->cShadowMapShader) :
+			(isLinear ? this->vShadowMapLinearShader : this->vShadowMapShader);
+		shader.setUniform_mat4("lightProjection", shadow.getProjection());
+		if (isLinear) {
+			shader.setUniform_vec3("lightPos", this->shadowLight->position);
+			shader.setUniform_f("zFar", this->shadowLight->range);
+		}
+		this->frame->renderObjects(shader);
+
+		// Blur the Antialiased Variance Shadow Map horizontally into the
+		// VSM AA texture and then vertically back into the VSM texture, just
+		// as the deferred renderer does.
+		if (shadowType == ShadowType::SHADOW_VARIANCE_AA &&
+				shadow.getSoftness() >= 0.05F) {
+			glDepthMask(GL_FALSE);
+			glDisable(GL_DEPTH_TEST);
+
+			const float MAX_RADIUS = 1.0F;
+			float radius = shadow.getSoftness() * MAX_RADIUS;
+			this->vsmGaussianBlurShader.setUniform_vec2("resolution",
+				Vector2f(SHADOW_MAP_WIDTH, SHADOW_MAP_HEIGHT));
+			this->vsmGaussianBlurShader.setUniform_vec2("radius",
+				Vector2f(radius, radius));
+			this->vsmGaussianBlurShader.setUniform_i("gBufferFinal", 0);
+
+			this->vsmGaussianBlurShader.setUniform_vec2("direction",
+				Vector2f(1.0F, 0.0F));
+			glDrawBuffer(GL_COLOR_ATTACHMENT1);
+			this->vShadowMapTexture->bind(0);
+			this->quad->render(this->vsmGaussianBlurShader);
+
+			this->vsmGaussianBlurShader.setUniform_vec2("direction",
+				Vector2f(0.0F, 1.0F));
+			glDrawBuffer(GL_COLOR_ATTACHMENT0);
+			this->vShadowMapTextureAA->bind(0);
+			this->quad->render(this->vsmGaussianBlurShader);
+
+			glEnable(GL_DEPTH_TEST);
+		}
+
+		// Restore the viewport of the Frame Buffers
+		glViewport(0, 0, this->bufferWidth, this->bufferHeight);
+	}
+
+	void ForwardPlusRenderer::renderPassShading() {
+		// The depth buffer already contains the nearest surface, so only the
+		// fragments which are equal to it are shaded (and the depth buffer is
+		// not written to again).
+		glDepthMask(GL_FALSE);
+		glDepthFunc(GL_LEQUAL);
+
+		// Bind the skybox for Reflection (it is bound to a reserved unit so
+		// that the material can take the other GL_TEXTURE fields for itself).
+		this->forwardShader.bindShaderProgram();
+		this->forwardShader.setUniform_i("skybox",
+			TextureUnit::TEXTURE_UNIT_SKYBOX);
+		this->skybox->bind(TextureUnit::TEXTURE_UNIT_SKYBOX);
+
+		// Bind the light buffers to their reserved units
+		this->forwardShader.setUniform_i("lightData",
+			TextureUnit::TEXTURE_UNIT_LIGHT_DATA);
+		this->forwardShader.setUniform_i("lightGrid",
+			TextureUnit::TEXTURE_UNIT_LIGHT_GRID);
+		this->forwardShader.setUniform_i("lightIndices",
+			TextureUnit::TEXTURE_UNIT_LIGHT_INDICES);
+		glActiveTexture(GL_TEXTURE0 + TextureUnit::TEXTURE_UNIT_LIGHT_DATA);
+		glBindTexture(GL_TEXTURE_BUFFER, this->lightDataTexture);
+		glActiveTexture(GL_TEXTURE0 + TextureUnit::TEXTURE_UNIT_LIGHT_GRID);
+		glBindTexture(GL_TEXTURE_BUFFER, this->lightGridTexture);
+		glActiveTexture(GL_TEXTURE0 +
+			TextureUnit::TEXTURE_UNIT_LIGHT_INDICES);
+		glBindTexture(GL_TEXTURE_BUFFER, this->lightIndicesTexture);
+		glActiveTexture(GL_TEXTURE0);
+
+		// Bind the shadow map of the light which casts the shadow, if any
+		// (the same texture as the deferred renderer samples for the type).
+		this->forwardShader.setUniform_i("shadowMap",
+			TextureUnit::TEXTURE_UNIT_FORWARD_SHADOW_MAP);
+		if (this->shadowLight != nullptr) {
+			ShadowType type = this->shadowLight->shadow->getShadowType();
+			if (Shadow::isClassicShadow(type))
+				this->cShadowMapTexture->bind(
+					TextureUnit::TEXTURE_UNIT_FORWARD_SHADOW_MAP);
+			else if (type == ShadowType::SHADOW_VARIANCE)
+				this->vShadowMapTexture->bind(
+					TextureUnit::TEXTURE_UNIT_FORWARD_SHADOW_MAP);
+			else if (type == ShadowType::SHADOW_VARIANCE_AA)
+				this->vShadowMapTextureAA->bind(
+					TextureUnit::TEXTURE_UNIT_FORWARD_SHADOW_MAP);
+		}
+
+		// Render the Game Scene Meshes
+		this->frame->renderObjects(this->forwardShader);
+
+		glDepthFunc(GL_LESS);
+	}
+
+	Texture2D& ForwardPlusRenderer::renderPassPostProcess() {
+		// Resolve the multisampled image into the first resolve texture
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, this->msaaBuffer);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, this->resolveBuffer);
+		glReadBuffer(GL_COLOR_ATTACHMENT0);
+		glDrawBuffer(GL_COLOR_ATTACHMENT0);
+		glBlitFramebuffer(0, 0, this->bufferWidth, this->bufferHeight,
+			0, 0, this->bufferWidth, this->bufferHeight,
+			GL_COLOR_BUFFER_BIT, GL_NEAREST);
+		glBindFramebuffer(GL_FRAMEBUFFER, this->resolveBuffer);
+
+		// Depth test must be disabled, since we just want to render textures
+		glDisable(GL_DEPTH_TEST);
+
+		// When post processing, we will read from the read texture and write
+		// to the write texture, then swap the textures for each shader (since
+		// we cannot read to and write from the same texture).
+		int read = 0;
+		int write = 1;
+
+		// Post Process the image with all of the user's custom post process
+		// shaders.
+		if (this->doPostProcess) {
+			for (ShaderProgram &s : this->getPostShaders()) {
+				this->renderPostProcessShader(s, read, write);
+			}
+		}
+
+		// FXAA post process (this is applied on top of the multisampling, so
+		// it may be disabled to save bandwidth).
+		if (this->antiAliasing == AntiAliasing::FXAA) {
+			this->frame->getCamera().toShader(this->fxaaShader, "camera");
+			this->renderPostProcessShader(this->fxaaShader, read, write);
+		}
+
+		// Now return the texture containing the last texture we wrote into
+		// (which is now the read texture). The per-pixel post effects and the
+		// gamma correction are applied as it is rendered.
+		return *this->resolveTextures[read];
+	}
+
+	void ForwardPlusRenderer::renderPostProcessShader(ShaderProgram &shader,
+			int &read, int &write) {
+		// Set the draw buffer to write and render image using this
+		// post processing shader
+		glDrawBuffer(GL_COLOR_ATTACHMENT0 + write);
+		this->resolveTextures[read]->bind(0);
+		shader.setUniform_i("gBufferFinal", 0);
+		this->quad->render(shader);
+
+		// Now read and write the other way (swap read and write)
+		int tmp = read;
+		read = write;
+		write = tmp;
+	}
+
+	void ForwardPlusRenderer::renderTexture(const Texture2D &tex) {
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glDisable(GL_DEPTH_TEST);
+
+		tex.bind(0);
+		this->finalShader.setUniform_i("fsTexture", 0);
+		this->writePostEffectsToShader(this->finalShader);
+		this->quad->render(this->finalShader);
+
+		glEnable(GL_DEPTH_TEST);
+	}
+
+	void ForwardPlusRenderer::resizeBuffers() {
+		this->bufferWidth = GameWindow::getGameWindow()->getWindowWidth();
+		this->bufferHeight = GameWindow::getGameWindow()->getWindowHeight();
+
+		// A sample count of zero allocates a standard (single sample) buffer
+		int samples = this->sampleCount > 1 ? this->sampleCount : 0;
+
+		// Allocate the multisampled HDR color and depth buffers
+		glBindRenderbuffer(GL_RENDERBUFFER, this->msaaColorBuffer);
+		glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples,
+			GL_RGBA16F, this->bufferWidth, this->bufferHeight);
+		glBindRenderbuffer(GL_RENDERBUFFER, this->msaaDepthBuffer);
+		glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples,
+			GL_DEPTH_COMPONENT32F, this->bufferWidth, this->bufferHeight);
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, this->msaaBuffer);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+			GL_RENDERBUFFER, this->msaaColorBuffer);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+			GL_RENDERBUFFER, this->msaaDepthBuffer);
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) !=
+				GL_FRAMEBUFFER_COMPLETE) {
+			Logger::getLogger().logError(__FUNCTION__, __LINE__,
+				"Unable to Create Forward+ Multisample Buffer!");
+		}
+
+		// Allocate the single sample resolve textures
+		glBindFramebuffer(GL_FRAMEBUFFER, this->resolveBuffer);
+		for (int i = 0; i < 2; ++i) {
+			this->resolveTextures[i]->setImageDataManual(
+				nullptr, TextureDataType::DATA_FLOAT,
+				TextureDataInternalFormat::INTERNAL_FORMAT_RGBA16F,
+				TextureDataFormat::FORMAT_RGBA,
+				this->bufferWidth, this->bufferHeight, false);
+			this->resolveTextures[i]->setFiltering(
+				TextureFilterMagMode::FILTER_MAG_NEAREST);
+
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i,
+				GL_TEXTURE_2D, this->resolveTextures[i]->getTextureID(), 0);
+		}
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) !=
+				GL_FRAMEBUFFER_COMPLETE) {
+			Logger::getLogger().logError(__FUNCTION__, __LINE__,
+				"Unable to Create Forward+ Resolve Buffer!");
+		}
+
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+
+	void ForwardPlusRenderer::setGamma(const float &g) {
+		Renderer::setGamma(g);
+
+		this->forwardShader.setUniform_f("gamma", g);
+		this->skyboxShader.setUniform_f("gamma", g);
+	}
+} } }
@@ -0,0 +1,348 @@
+#include "../../../include/render/graph/FrameGraph.h"
+
+#include <GL/glew.h>
+
+#include "../../../include/base/GLErrorException.h"
+#include "../../../include/debug/Logger.h"
+
+using Honeycomb::Base::GLErrorException;
+using Honeycomb::Base::GLItemNotInitializedException;
+using Honeycomb::Debug::Logger;
+using Honeycomb::Graphics::Texture2D;
+using Honeycomb::Graphics::TextureFilterMagMode;
+
+namespace Honeycomb { namespace Render { namespace Graph {
+	const int FrameGraph::POOL_RELEASE_COMPILES = 8;
+	const int FrameGraph::ATTACHMENTS_PER_FRAMEBUFFER = 4;
+
+	bool FrameGraph::TextureDescription::operator==(
+			const TextureDescription &rhs) const {
+		return this->width == rhs.width && this->height == rhs.height &&
+			this->type == rhs.type &&
+			this->internalFormat == rhs.internalFormat &&
+			this->format == rhs.format;
+	}
+
+	FrameGraph::FrameGraph() {
+
+	}
+
+	FrameGraph::~FrameGraph() {
+
+	}
+
+	int FrameGraph::addPass(const std::string &name,
+			const std::function<void()> &execute, const bool &hasSideEffects) {
+		Pass pass;
+		pass.name = name;
+		pass.execute = execute;
+		pass.hasSideEffects = hasSideEffects;
+		pass.refCount = 0;
+		pass.isCulled = false;
+
+		this->passes.push_back(pass);
+		return (int)this->passes.size() - 1;
+	}
+
+	void FrameGraph::addRead(const int &pass, const int &resource) {
+		this->passes[pass].reads.push_back(resource);
+	}
+
+	int FrameGraph::addImport(const std::string &name,
+			const Texture2D *texture) {
+		Resource resource;
+		resource.name = name;
+		resource.isTransient = false;
+		resource.imported = texture;
+		resource.pooled = -1;
+		resource.refCount = 0;
+		resource.firstUse = -1;
+		resource.lastUse = -1;
+
+		this->resources.push_back(resource);
+		return (int)this->resources.size() - 1;
+	}
+
+	int FrameGraph::addTexture(const std::string &name,
+			const TextureDescription &description) {
+		int index = this->addImport(name);
+		this->resources[index].isTransient = true;
+		this->resources[index].description = description;
+
+		return index;
+	}
+
+	void FrameGraph::addWrite(const int &pass, const int &resource) {
+		this->passes[pass].writes.push_back(resource);
+		this->resources[resource].writers.push_back(pass);
+	}
+
+	void FrameGraph::bindRenderTarget(const int &resource) {
+		GLErrorException::clear();
+		if (!this->isInitialized) throw GLItemNotInitializedException(this);
+
+		const PooledTexture &pooled =
+			this->pool[this->resources[resource].pooled];
+
+		// Switching the draw buffer is much cheaper than switching the
+		// framebuffer, so only bind the framebuffer if it is not bound.
+		GLint bound;
+		glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &bound);
+		if (bound != pooled.frameBuffer)
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, pooled.frameBuffer);
+		glDrawBuffer(GL_COLOR_ATTACHMENT0 + pooled.attachment);
+
+		GLErrorException::checkGLError(__FILE__, __LINE__);
+	}
+
+	void FrameGraph::clear() {
+		this->passes.clear();
+		this->resources.clear();
+	}
+
+	void FrameGraph::compile() {
+		GLErrorException::clear();
+		if (!this->isInitialized) throw GLItemNotInitializedException(this);
+
+		// Each pass is used once for each of its writes, and each resource
+		// once for each pass which reads it.
+		std::vector<int> unused;
+		for (Pass &pass : this->passes) {
+			pass.refCount = (int)pass.writes.size();
+			pass.isCulled = false;
+
+			for (int read : pass.reads)
+				++this->resources[read].refCount;
+		}
+
+		for (int i = 0; i < (int)this->resources.size(); ++i) {
+			if (this->resources[i].refCount == 0) unused.push_back(i);
+		}
+
+		// The passes which write nothing at all are never used
+		for (int i = 0; i < (int)this->passes.size(); ++i) {
+			Pass &pass = this->passes[i];
+			if (pass.refCount > 0 || pass.hasSideEffects) continue;
+
+			pass.isCulled = true;
+			for (int read : pass.reads) {
+				if (--this->resources[read].refCount == 0)
+					unused.push_back(read);
+			}
+		}
+
+		// Cull the writers of the unused resources whose writes are now all
+		// unused, which in turn may leave the resources they read unused.
+		while (!unused.empty()) {
+			int resource = unused.back();
+			unused.pop_back();
+
+			for (int writer : this->resources[resource].writers) {
+				Pass &pass = this->passes[writer];
+				if (pass.isCulled || --pass.refCount > 0 ||
+					pass.hasSideEffects) continue;
+
+				pass.isCulled = true;
+				for (int read : pass.reads) {
+					if (--this->resources[read].refCount == 0)
+						unused.push_back(read);
+				}
+			}
+		}
+
+		// Find the first and last live pass which uses each resource
+		for (int i = 0; i < (int)this->passes.size(); ++i) {
+			Pass &pass = this->passes[i];
+			if (pass.isCulled) continue;
+
+			for (auto *list : { &pass.reads, &pass.writes }) {
+				for (int index : *list) {
+					Resource &resource = this->resources[index];
+					if (resource.firstUse < 0) resource.firstUse = i;
+					resource.lastUse = i;
+				}
+			}
+		}
+
+		// Destroy the pooled textures which have not been used for a while
+		for (int i = (int)this->pool.size() - 1; i >= 0; --i) {
+			PooledTexture &pooled = this->pool[i];
+			pooled.isInUse = false;
+
+			if (++pooled.compilesUnused > POOL_RELEASE_COMPILES)
+				this->release(i);
+		}
+
+		// Walk through the live passes, taking the texture of each transient
+		// resource from the pool at its first use, and giving it back after
+		// its last use, so that it may be aliased by the later resources.
+		for (int i = 0; i < (int)this->passes.size(); ++i) {
+			Pass &pass = this->passes[i];
+			if (pass.isCulled) continue;
+
+			for (auto *list : { &pass.reads, &pass.writes }) {
+				for (int index : *list) {
+					Resource &resource = this->resources[index];
+					if (!resource.isTransient || resource.firstUse != i ||
+						resource.pooled >= 0) continue;
+
+					if (resource.writers.empty()) {
+						Logger::getLogger().logWarning(__FUNCTION__,
+							__LINE__, "Transient texture " + resource.name +
+							" is read by " + pass.name +
+							" but never written!");
+					}
+
+					resource.pooled = this->acquire(resource.description);
+				}
+			}
+
+			for (auto *list : { &pass.reads, &pass.writes }) {
+				for (int index : *list) {
+					Resource &resource = this->resources[index];
+					if (resource.lastUse == i && resource.pooled >= 0)
+						this->pool[resource.pooled].isInUse = false;
+				}
+			}
+		}
+
+		GLErrorException::checkGLError(__FILE__, __LINE__);
+	}
+
+	void FrameGraph::destroy() {
+		if (!this->isInitialized) return;
+
+		for (int i = (int)this->pool.size() - 1; i >= 0; --i)
+			this->release(i);
+		this->clear();
+
+		GLItem::destroy();
+	}
+
+	void FrameGraph::execute() {
+		for (Pass &pass : this->passes) {
+			if (!pass.isCulled) pass.execute();
+		}
+	}
+
+	bool FrameGraph::getIsPassCulled(const int &pass) const {
+		return this->passes[pass].isCulled;
+	}
+
+	const Texture2D& FrameGraph::getTexture(const int &resource) const {
+		const Resource &res = this->resources[resource];
+		if (!res.isTransient) return *res.imported;
+
+		return *this->pool[res.pooled].texture;
+	}
+
+	void FrameGraph::initialize() {
+		GLItem::initialize();
+	}
+
+	int FrameGraph::acquire(const TextureDescription &description) {
+		for (int i = 0; i < (int)this->pool.size(); ++i) {
+			PooledTexture &pooled = this->pool[i];
+			if (pooled.isInUse || !(pooled.description == description))
+				continue;
+
+			pooled.isInUse = true;
+			pooled.compilesUnused = 0;
+			return i;
+		}
+
+		// No texture is free, so allocate a new one
+		PooledTexture pooled;
+		pooled.description = description;
+		pooled.texture = Texture2D::newTexture2DUnique();
+		pooled.texture->setImageDataManual(nullptr, description.type,
+			description.internalFormat, description.format,
+			description.width, description.height);
+		pooled.texture->setFiltering(TextureFilterMagMode::FILTER_MAG_NEAREST);
+		pooled.isInUse = true;
+		pooled.compilesUnused = 0;
+		this->attach(pooled);
+
+		this->pool.push_back(std::move(pooled));
+		return (int)this->pool.size() - 1;
+	}
+
+	void FrameGraph::attach(PooledTexture &pooled) {
+		// Find a framebuffer of textures of the same size with a free
+		// attachment (the attachments of one framebuffer may not differ in
+		// size, since drawing is limited to the smallest of them).
+		std::vector<bool> isTaken;
+		int frameBuffer = 0;
+		for (const PooledTexture &other : this->pool) {
+			if (other.description.width != pooled.description.width ||
+				other.description.height != pooled.description.height)
+				continue;
+
+			int count = 0;
+			for (const PooledTexture &sibling : this->pool)
+				if (sibling.frameBuffer == other.frameBuffer) ++count;
+			if (count >= ATTACHMENTS_PER_FRAMEBUFFER) continue;
+
+			frameBuffer = other.frameBuffer;
+			break;
+		}
+
+		if (frameBuffer == 0) {
+			GLuint fbo;
+			glGenFramebuffers(1, &fbo);
+			frameBuffer = fbo;
+		}
+
+		// Take the first attachment which is free within the framebuffer
+		isTaken.resize(ATTACHMENTS_PER_FRAMEBUFFER, false);
+		for (const PooledTexture &other : this->pool) {
+			if (other.frameBuffer == frameBuffer)
+				isTaken[other.attachment] = true;
+		}
+
+		pooled.frameBuffer = frameBuffer;
+		pooled.attachment = 0;
+		while (isTaken[pooled.attachment]) ++pooled.attachment;
+
+		// Attach the texture without disturbing the framebuffer which is
+		// currently bound.
+		GLint bound;
+		glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &bound);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, frameBuffer);
+		glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER,
+			GL_COLOR_ATTACHMENT0 + pooled.attachment, GL_TEXTURE_2D,
+			pooled.texture->getTextureID(), 0);
+
+		GLenum status = glCheckFramebufferStatus(GL_DRAW_FRAMEBUFFER);
+		if (status != GL_FRAMEBUFFER_COMPLETE) {
+			Logger::getLogger().logError(__FUNCTION__, __LINE__,
+				"Unable to attach a transient texture of the frame graph!");
+		}
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, bound);
+	}
+
+	void FrameGraph::release(const int &index) {
+		PooledTexture &pooled = this->pool[index];
+
+		// Detach the texture, and destroy its framebuffer if it was the last
+		// one attached to it.
+		int siblings = 0;
+		for (const PooledTexture &other : this->pool)
+			if (other.frameBuffer == pooled.frameBuffer) ++siblings;
+
+		GLuint fbo = pooled.frameBuffer;
+		if (siblings == 1) {
+			glDeleteFramebuffers(1, &fbo);
+		} else {
+			GLint bound;
+			glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &bound);
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo);
+			glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER,
+				GL_COLOR_ATTACHMENT0 + pooled.attachment, GL_TEXTURE_2D,
+				0, 0);
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, bound);
+		}
+
+		this->pool.erase(this->pool.begin() + index);
+	}
+} } }
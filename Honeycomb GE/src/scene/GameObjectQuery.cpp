@@ -0,0 +1,50 @@
+#include "../../include/scene/GameObjectQuery.h"
+
+using Honeycomb::Component::GameComponentID;
+using Honeycomb::Object::GameObject;
+
+namespace Honeycomb { namespace Scene {
+	const std::vector<GameComponentID>& GameObjectQuery::getComponentIDs()
+			const {
+		return this->componentIDs;
+	}
+
+	const std::vector<GameObject*>& GameObjectQuery::getObjects() const {
+		return this->objects;
+	}
+
+	bool GameObjectQuery::matches(const GameObject &object) const {
+		for (const GameComponentID &id : this->componentIDs)
+			if (!object.hasComponent(id)) return false;
+
+		return true;
+	}
+
+	GameObjectQuery::GameObjectQuery(const std::vector<GameComponentID> &ids) :
+			componentIDs(ids) {
+
+	}
+
+	void GameObjectQuery::remove(const GameObject &object) {
+		auto index = this->indices.find(&object);
+		if (index == this->indices.end()) return;
+
+		// Move the last object into the place of the removed one, so that the
+		// list stays packed.
+		GameObject *last = this->objects.back();
+		this->objects[index->second] = last;
+		this->indices[last] = index->second;
+
+		this->objects.pop_back();
+		this->indices.erase(&object);
+	}
+
+	void GameObjectQuery::update(GameObject &object) {
+		if (!this->matches(object)) {
+			this->remove(object);
+		} else if (this->indices.find(&object) == this->indices.end()) {
+			this->indices[&object] = this->objects.size();
+			this->objects.push_back(&object);
+		}
+	}
+} }
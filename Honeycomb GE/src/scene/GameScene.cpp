@@ -1,8 +1,23 @@
 #include "../../include/scene/GameScene.h"
 
+#include <algorithm>
+
+#include "../../include/component/physics/Transform.h"
+#include "../../include/component/render/CameraController.h"
+#include "../../include/job/JobSystem.h"
+
 using Honeycomb::Component::GameComponent;
-using Honeycomb::Object::GameObject;
+using Honeycomb::Component::GameComponentID;
+using Honeycomb::Component::GameComponentPool;
+using Honeycomb::Component::Light::AmbientLight;
 using Honeycomb::Component::Light::BaseLight;
+using Honeycomb::Component::Light::DirectionalLight;
+using Honeycomb::Component::Light::PointLight;
+using Honeycomb::Component::Light::SpotLight;
+using Honeycomb::Component::Physics::Transform;
+using Honeycomb::Component::Render::CameraController;
+using Honeycomb::Job::JobSystem;
+using Honeycomb::Object::GameObject;
 
 namespace Honeycomb { namespace Scene {
 	GameScene* GameScene::activeScene = nullptr;
@@ -16,21 +31,10 @@ namespace Honeycomb { namespace Scene {
 	}
 
 	GameScene::GameScene(const std::string &name) : GameObject(name) {
-		this->scene = this;
 		this->isSelfActive = false;
-	}
 
-	GameObject& GameScene::addChild(std::unique_ptr<GameObject> object) {
-		// Add the object as a child of this, using the GameObject class
-		auto &child = GameObject::addChild(std::move(object));
-
-		// Fetch all of the lights of the object and its children and add them
-		// to the scene's lights list.
-		auto lights = child.getComponentsInheritedInDescendants<BaseLight>();
-		this->sceneLights.insert(this->sceneLights.end(), 
-				lights.begin(), lights.end());
-
-		return child;
+		// The scene is its own scene, so its components are pooled as well
+		this->onAttach(this);
 	}
 
 	std::unique_ptr<GameScene> GameScene::clone() const {
@@ -49,9 +53,11 @@ namespace Honeycomb { namespace Scene {
 		return clone;
 	}
 
-	bool GameScene::getIsActive() const {
-		return GameScene::activeScene == this &&
-			this->isSelfActive;
+	GameComponentPool& GameScene::getComponentPool(const GameComponentID &id) {
+		if (id >= this->componentPools.size())
+			this->componentPools.resize(id + 1);
+
+		return this->componentPools[id];
 	}
 
 	const std::vector<std::reference_wrapper<
@@ -73,23 +79,108 @@ namespace Honeycomb { namespace Scene {
 		GameScene::activeScene = this;
 	}
 
-	std::unique_ptr<GameObject> GameScene::removeChild(GameObject *object) {
-		// Remove the child from this using the GameObject class
-		auto child = GameObject::removeChild(object);
-
-		// Fetch all of the lights of the object and its children and remove 
-		// them from the scene's lights list.
-		auto lights = child->getComponentsInheritedInDescendants<BaseLight>();
-		this->sceneLights.erase(
-			std::remove_if(this->sceneLights.begin(), this->sceneLights.end(),
-				[&](const auto &sceneLight) {
-					return std::find_if(lights.begin(), lights.end(), 
-						[&](const auto &light) {
-							return &light.get() == &sceneLight.get();
-						}) != lights.end();
-				}),
-			this->sceneLights.end());
-
-		return child;
+	void GameScene::onUpdate() {
+		for (auto &componentsOfType : this->parallelUpdates)
+			componentsOfType.clear();
+		this->updateSequential(this->parallelUpdates);
+
+		// The matrices of the Transforms and of the active camera are only
+		// updated once they are read, so update them now, before they are
+		// read by several threads at once.
+		for (auto &componentsOfType : this->parallelUpdates) {
+			for (GameComponent *component : componentsOfType) {
+				GameObject *object = component->getAttached();
+				if (object->hasComponent(GameComponent::
+						getGameComponentTypeID<Transform>()))
+					object->getComponent<Transform>().getMatrixTransformation();
+			}
+		}
+
+		CameraController *camera = CameraController::getActiveCamera();
+		if (camera != nullptr && camera->getAttached() != nullptr)
+			camera->getProjection();
+
+		for (auto &componentsOfType : this->parallelUpdates) {
+			JobSystem::getJobSystem()->parallelFor(
+				(int)componentsOfType.size(), 0,
+				[&componentsOfType](int begin, int end) {
+					for (int i = begin; i < end; ++i)
+						componentsOfType[i]->onUpdate();
+			});
+		}
+
+		for (auto &componentsOfType : this->parallelUpdates) {
+			for (GameComponent *component : componentsOfType)
+				component->onUpdateCommit();
+		}
+	}
+
+	const GameObjectQuery& GameScene::query(std::vector<GameComponentID> ids) {
+		std::sort(ids.begin(), ids.end());
+		ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+		for (auto &query : this->queries) {
+			if (query->getComponentIDs() == ids) return *query;
+		}
+
+		// Create the query and fill it with the matching objects of the scene
+		// (which is only done once, from then on the query is updated as the
+		// scene changes).
+		this->queries.push_back(
+			std::unique_ptr<GameObjectQuery>(new GameObjectQuery(ids)));
+		GameObjectQuery &query = *this->queries.back();
+
+		std::vector<GameObject*> toVisit = { this };
+		while (!toVisit.empty()) {
+			GameObject *current = toVisit.back();
+			toVisit.pop_back();
+
+			query.update(*current);
+			for (auto &child : current->children)
+				toVisit.push_back(child.get());
+		}
+
+		return query;
+	}
+
+	void GameScene::addSceneLight(GameComponent &component) {
+		if (!GameScene::isLight(component.getGameComponentID())) return;
+
+		this->sceneLights.push_back(std::ref(
+			static_cast<BaseLight&>(component)));
+	}
+
+	bool GameScene::calcIsActive() const {
+		return GameScene::activeScene == this &&
+			this->isSelfActive;
+	}
+
+	bool GameScene::isLight(const GameComponentID &id) {
+		return id == GameComponent::getGameComponentTypeID<BaseLight>() ||
+			id == GameComponent::getGameComponentTypeID<AmbientLight>() ||
+			id == GameComponent::getGameComponentTypeID<DirectionalLight>() ||
+			id == GameComponent::getGameComponentTypeID<PointLight>() ||
+			id == GameComponent::getGameComponentTypeID<SpotLight>();
+	}
+
+	void GameScene::removeFromQueries(const GameObject &object) {
+		for (auto &query : this->queries)
+			query->remove(object);
+	}
+
+	void GameScene::removeSceneLight(GameComponent &component) {
+		if (!GameScene::isLight(component.getGameComponentID())) return;
+
+		auto light = std::find_if(
+			this->sceneLights.begin(), this->sceneLights.end(),
+			[&](const std::reference_wrapper<BaseLight> &sceneLight) {
+				return &sceneLight.get() == &component;
+			});
+		if (light != this->sceneLights.end()) this->sceneLights.erase(light);
+	}
+
+	void GameScene::updateQueries(GameObject &object) {
+		for (auto &query : this->queries)
+			query->update(object);
 	}
 } }
@@ -54,7 +54,7 @@ namespace HoneycombTest {
 
 		// Give the plane a textured material
 		auto colorMaterial =
-			this->plane->getComponent<MeshRenderer>().getMaterials()[0];
+			this->plane->getComponent<MeshRenderer>().getWritableMaterial(0);
 		auto colorTexture = Texture2D::newTexture2DShared();
 		colorTexture->
 			setImageDataIO(ImageIO("../Test Game/res/textures/colors.bmp"));
@@ -145,7 +145,7 @@ namespace HoneycombTest {
 		carHeadlightR.getComponent<SpotLight>().getShadow().setShadowType(ShadowType::SHADOW_NONE);
 
 		this->car->getChild("Body").getComponents<MeshRenderer>()[0].get().
-			getMaterials()[1]->getVector3fs().setValue(
+			getWritableMaterial(1)->getVector3fs().setValue(
 			"albedoColor", Vector3f(1.0F, 1.0F, 1.0F));
 
 		auto test1 = this->car->getComponentsInheritedInDescendants<BaseLight>();